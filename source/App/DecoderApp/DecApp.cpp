@@ -574,6 +574,12 @@ void DecApp::writeLineToOutputLog(Picture * pcPic)
 void DecApp::xCreateDecLib()
 {
   initROM();
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+  if( !m_geoWeightsDumpPrefix.empty() )
+  {
+    dumpGeoTemplate( m_geoWeightsDumpPrefix );
+  }
+#endif
 
   // create decoder class
   m_cDecLib.create();
@@ -585,6 +591,19 @@ void DecApp::xCreateDecLib()
 #endif
   );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cDecLib.setStageTimesOutput( m_printStageTimes, m_stageTimesFileName );
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  m_cDecLib.setNumSubstreamThreads( m_numSubstreamThreads );
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  m_cDecLib.setNumFrameThreads( m_numFrameThreads );
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  m_cDecLib.setParseAheadCtus( m_parseAheadCtus );
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  m_cDecLib.setNumLoopFilterThreads( m_numLoopFilterThreads );
+#endif
 
 
   if (!m_outputDecodedSEIMessagesFilename.empty())
@@ -699,6 +718,10 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       {
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
+#if ENABLE_FRAME_PARALLEL_DECODING
+        pcPicTop->waitUntilFinished();
+        pcPicBottom->waitUntilFinished();
+#endif
         if ( !m_reconFileName.empty() )
         {
           const Window &conf = pcPicTop->cs->pps->getConformanceWindow();
@@ -755,6 +778,9 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       {
         // write to file
         numPicsNotYetDisplayed--;
+#if ENABLE_FRAME_PARALLEL_DECODING
+        pcPic->waitUntilFinished();
+#endif
         if (!pcPic->referenced)
         {
           dpbFullness--;
@@ -808,6 +834,9 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
  */
 void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
 {
+#if ENABLE_FRAME_PARALLEL_DECODING
+  m_cDecLib.waitForPictureFinishing();
+#endif
   if(!pcListPic || pcListPic->empty())
   {
     return;
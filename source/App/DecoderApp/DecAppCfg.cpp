@@ -105,6 +105,23 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
 #if JVET_S0257_DUMP_360SEI_MESSAGE
   ("360DumpFile",  m_outputDecoded360SEIMessagesFilename, string(""), "When non empty, output decoded 360 SEI messages to the indicated file.\n")
+#endif
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+  ("DumpGeoWeights",            m_geoWeightsDumpPrefix,                string(""), "When non empty, write the GPM blending weight tables to <prefix>g_geoWeights.txt (linear), <prefix>g_geoTanhWeights.txt and <prefix>g_geoCurveWeights.txt\n")
+#endif
+  ("PrintStageTimes",           m_printStageTimes,                     false,      "Print the per-picture time of the decoding stages: parsing, intra and inter reconstruction (with DMVR, BDOF, OBMC, TM and affine), LMCS, deblocking, SAO, CCSAO and ALF")
+  ("StageTimesFile",            m_stageTimesFileName,                  string(""), "When non empty, write the per-picture time of the decoding stages to the indicated CSV file\n")
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  ("NumSubstreamThreads",       m_numSubstreamThreads,                 1,          "Number of threads decoding the tiles and WPP CTU rows of a slice concurrently (requires entry points)")
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  ("NumFrameThreads",           m_numFrameThreads,                     1,          "Number of pictures decoded concurrently: 2 in-loop filters a picture in a worker thread while the next one is decoded; motion compensation waits for the CTU rows of the reference pictures it reads")
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  ("ParseAheadCtus",            m_parseAheadCtus,                      0,          "Number of CTUs a separate thread parses ahead of their reconstruction, 0: parse and reconstruct in one thread")
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  ("NumLoopFilterThreads",      m_numLoopFilterThreads,                1,          "Number of threads deblocking and adaptive loop filtering the CTU rows of a picture concurrently (single-slice pictures)")
 #endif
   ("ClipOutputVideoToRec709Range",      m_bClipOutputVideoToRec709Range,  false,   "If true then clip output video to the Rec. 709 Range on saving")
   ("PYUV",                      m_packedYUVMode,                       false,      "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.")
@@ -190,6 +207,34 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     msg( ERROR, "No input file specified, aborting\n");
     return false;
   }
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  if( m_numSubstreamThreads < 1 )
+  {
+    msg( ERROR, "NumSubstreamThreads must be at least 1\n" );
+    return false;
+  }
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( m_numFrameThreads < 1 || m_numFrameThreads > 2 )
+  {
+    msg( ERROR, "NumFrameThreads must be 1 or 2\n" );
+    return false;
+  }
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  if( m_parseAheadCtus < 0 )
+  {
+    msg( ERROR, "ParseAheadCtus must not be negative\n" );
+    return false;
+  }
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  if( m_numLoopFilterThreads < 1 )
+  {
+    msg( ERROR, "NumLoopFilterThreads must be at least 1\n" );
+    return false;
+  }
+#endif
 
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
@@ -259,10 +304,27 @@ DecAppCfg::DecAppCfg()
 #if JVET_S0257_DUMP_360SEI_MESSAGE
 , m_outputDecoded360SEIMessagesFilename()
 #endif
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+, m_geoWeightsDumpPrefix()
+#endif
 , m_bClipOutputVideoToRec709Range(false)
 , m_packedYUVMode(false)
 , m_statMode(0)
 , m_mctsCheck(false)
+, m_printStageTimes(false)
+, m_stageTimesFileName()
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+, m_numSubstreamThreads(1)
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+, m_numFrameThreads(1)
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+, m_parseAheadCtus(0)
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+, m_numLoopFilterThreads(1)
+#endif
 {
   for (uint32_t channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
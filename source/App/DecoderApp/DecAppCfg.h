@@ -75,6 +75,9 @@ protected:
 #if JVET_S0257_DUMP_360SEI_MESSAGE
   std::string   m_outputDecoded360SEIMessagesFilename;   ///< filename to output decoded 360 SEI messages to.
 #endif
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+  std::string   m_geoWeightsDumpPrefix;               ///< prefix of the GPM weight table dump files. If empty, the tables are not written.
+#endif
 
 
   bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
@@ -82,6 +85,20 @@ protected:
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
   int           m_statMode;                           ///< Config statistic mode (0 - bit stat, 1 - tool stat, 3 - both)
   bool          m_mctsCheck;
+  bool          m_printStageTimes;                    ///< print the per-picture time of the decoding stages
+  std::string   m_stageTimesFileName;                 ///< CSV file of the per-picture time of the decoding stages. If empty, not written.
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  int           m_numSubstreamThreads;                ///< number of threads decoding the tiles and WPP CTU rows of a slice
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  int           m_numFrameThreads;                    ///< number of pictures decoded concurrently
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  int           m_parseAheadCtus;                     ///< number of CTUs parsed ahead of their reconstruction, 0: no parsing thread
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  int           m_numLoopFilterThreads;               ///< number of threads deblocking and adaptive loop filtering a picture
+#endif
 
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
 #if JVET_AB0082
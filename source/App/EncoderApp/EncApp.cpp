@@ -949,6 +949,13 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseCiipTimd                                       (m_ciipTimd);
 #endif
   m_cEncLib.setUseGeo                                            ( m_Geo );
+#if GPM_CURVE
+  m_cEncLib.setUseGeoCurve                                       ( m_geoCurve );
+  m_cEncLib.setGeoCurvePruning                                   ( m_geoCurvePruning );
+#endif
+#if GPM_BLEND
+  m_cEncLib.setUseGeoTanhBlend                                   ( m_geoTanhBlend );
+#endif
   m_cEncLib.setUseHashME                                         ( m_HashME );
 
   m_cEncLib.setAllowDisFracMMVD                                  ( m_allowDisFracMMVD );
@@ -1418,6 +1425,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setSummaryOutFilename                                ( m_summaryOutFilename );
   m_cEncLib.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
   m_cEncLib.setSummaryVerboseness                                ( m_summaryVerboseness );
+  m_cEncLib.setModeStatsFilename                                 ( m_modeStatsFilename );
   m_cEncLib.setIMV                                               ( m_ImvMode );
   m_cEncLib.setIMV4PelFast                                       ( m_Imv4PelFast );
   m_cEncLib.setDecodeBitstream                                   ( 0, m_decodeBitstreams[0] );
@@ -1432,6 +1440,16 @@ void EncApp::xInitLibCfg()
 #if ENABLE_SPLIT_PARALLELISM
   m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
   m_cEncLib.setForceSingleSplitThread                            ( m_forceSplitSequential );
+#endif
+#if ENABLE_WPP_PARALLELISM
+  m_cEncLib.setNumWppThreads                                     ( m_numWppThreads );
+  m_cEncLib.setEnsureWppBitEqual                                 ( m_ensureWppBitEqual );
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  m_cEncLib.setNumLoopFilterThreads                              ( m_numLoopFilterThreads );
 #endif
   m_cEncLib.setUseALF                                            ( m_alf );
   m_cEncLib.setUseCCALF                                          ( m_ccalf );
@@ -1659,6 +1677,12 @@ void EncApp::xInitLib(bool isFieldCoding)
 
 void EncApp::createLib( const int layerIdx )
 {
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+  if( layerIdx == 0 && !m_geoWeightsDumpPrefix.empty() )
+  {
+    dumpGeoTemplate( m_geoWeightsDumpPrefix );
+  }
+#endif
 #if JVET_AA0146_WRAP_AROUND_FIX
   const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
   UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_sourceWidth, sourceHeight ) );
@@ -826,6 +826,10 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("ModeStatsFilename",                               m_modeStatsFilename,                           string(), "Filename to write the wall time, calls and RD wins of every encoder test mode per CU size and temporal layer to (JSON). If empty, the statistics are not collected.")
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+  ("DumpGeoWeights",                                  m_geoWeightsDumpPrefix,                        string(), "When non empty, write the GPM blending weight tables to <prefix>g_geoWeights.txt (linear), <prefix>g_geoTanhWeights.txt and <prefix>g_geoCurveWeights.txt")
+#endif
   ("Verbosity,v",                                     m_verbosity,                               (int)VERBOSE, "Specifies the level of the verboseness")
 
 #if JVET_O0756_CONFIG_HDRMETRICS || JVET_O0756_CALCULATE_HDRMETRICS
@@ -1171,6 +1175,13 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("CIIPTIMD",                                        m_ciipTimd,                                       true, "Enable CIIP-TIMD mode")
 #endif
   ("Geo",                                             m_Geo,                                            false, "Enable geometric partitioning mode (0:off, 1:on)")
+#if GPM_CURVE
+  ("GeoCurve",                                        m_geoCurve,                                       false, "Enable GPM curve partitions of square CUs (0:off, 1:on)")
+  ("GeoCurvePruning",                                 m_geoCurvePruning,                                    0, "GPM curve split pruning (0:off, 1:skip curves well above the best straight split, 2:also skip curves not better than the straight splits of the same angle)")
+#endif
+#if GPM_BLEND
+  ("GeoTanhBlend",                                    m_geoTanhBlend,                                    true, "Use tanh shaped GPM blending ramps instead of linear ones (0:linear, 1:tanh)")
+#endif
   ("HashME",                                          m_HashME,                                         false, "Enable hash motion estimation (0:off, 1:on)")
 
   ("AllowDisFracMMVD",                                m_allowDisFracMMVD,                               false, "Disable fractional MVD in MMVD mode adaptively")
@@ -1835,6 +1846,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("NumWppExtraLines",                                m_numWppExtraLines,                           0, "Number of additional wpp lines to switch when threads are blocked")
   ("DebugCTU",                                        m_debugCTU,                                  -1, "If DebugBitstream is present, load frames up to this POC from this bitstream. Starting with DebugPOC-frame at CTUline containin debug CTU.")
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
+  ("NumFrameThreads",                                 m_numFrameThreads,                            1, "Number of pictures of a GOP that are compressed concurrently when they do not reference each other")
+  ("NumLoopFilterThreads",                            m_numLoopFilterThreads,                       1, "Number of threads deblocking the CTU rows of a picture concurrently (single-slice pictures)")
   ( "ALF",                                             m_alf,                                    true, "Adaptive Loop Filter\n" )
   ( "CCALF",                                           m_ccalf,                                  true, "Cross-component Adaptive Loop Filter" )
   ( "CCALFQpTh",                                       m_ccalfQpThreshold,                         37, "QP threshold above which encoder reduces CCALF usage")
@@ -3665,8 +3678,54 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_numSplitThreads != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitThreads has to be 1" );
 #endif
 
+#if ENABLE_WPP_PARALLELISM
+  xConfirmPara( m_numWppThreads < 1, "Number of WPP threads cannot be smaller than 1" );
+  if( m_numWppThreads > 1 || m_ensureWppBitEqual )
+  {
+    xConfirmPara( !m_entropyCodingSyncEnabledFlag, "WPP-style parallelism requires WaveFrontSynchro" );
+    xConfirmPara( m_RCEnableRateControl, "WPP-style parallelism cannot be combined with rate control" );
+    xConfirmPara( m_MCTSEncConstraint, "WPP-style parallelism cannot be combined with MCTSEncConstraint" );
+    xConfirmPara( m_gdrEnabled, "WPP-style parallelism cannot be combined with GDR" );
+    xConfirmPara( m_wcgChromaQpControl.enabled, "WPP-style parallelism cannot be combined with WCGPPSEnable" );
+#if ENABLE_QPA_SUB_CTU
+    xConfirmPara( m_bUsePerceptQPA && m_cuQpDeltaSubdiv > 0, "WPP-style parallelism cannot be combined with sub-CTU perceptual QPA" );
+#endif
+  }
+#else
   xConfirmPara( m_numWppThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numWppThreads has to be 1" );
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
+#endif
+
+#if ENABLE_FRAME_PARALLELISM
+  xConfirmPara( m_numFrameThreads < 1, "Number of frame threads cannot be smaller than 1" );
+  if( m_numFrameThreads > 1 )
+  {
+    xConfirmPara( m_RCEnableRateControl, "Frame parallelism cannot be combined with rate control" );
+    xConfirmPara( m_maxLayers > 1, "Frame parallelism cannot be combined with multiple layers" );
+    xConfirmPara( m_isField, "Frame parallelism cannot be combined with field coding" );
+    xConfirmPara( m_compositeRefEnabled, "Frame parallelism cannot be combined with CompositeLTReference" );
+    xConfirmPara( m_gdrEnabled, "Frame parallelism cannot be combined with GDR" );
+    xConfirmPara( m_rprEnabledFlag || m_resChangeInClvsEnabled, "Frame parallelism cannot be combined with reference picture resampling" );
+    xConfirmPara( m_subPicInfoPresentFlag, "Frame parallelism cannot be combined with subpictures" );
+    xConfirmPara( m_MCTSEncConstraint, "Frame parallelism cannot be combined with MCTSEncConstraint" );
+    xConfirmPara( m_wcgChromaQpControl.enabled, "Frame parallelism cannot be combined with WCGPPSEnable" );
+    xConfirmPara( m_uiDeltaQpRD > 0, "Frame parallelism cannot be combined with DeltaQpRD" );
+    xConfirmPara( m_HashME, "Frame parallelism cannot be combined with HashME" );
+#if JVET_Y0240_BIM
+    xConfirmPara( m_bimEnabled, "Frame parallelism cannot be combined with BIM" );
+#endif
+    xConfirmPara( m_switchPOC != -1 || m_fastForwardToPOC != -1 || !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(),
+                  "Frame parallelism cannot be combined with decoding or skipping pictures" );
+  }
+#else
+  xConfirmPara( m_numFrameThreads != 1, "ENABLE_FRAME_PARALLELISM is disabled, numFrameThreads has to be 1" );
+#endif
+
+#if ENABLE_PARALLEL_DEBLOCKING
+  xConfirmPara( m_numLoopFilterThreads < 1, "Number of loop filter threads cannot be smaller than 1" );
+#else
+  xConfirmPara( m_numLoopFilterThreads != 1, "ENABLE_PARALLEL_DEBLOCKING is disabled, numLoopFilterThreads has to be 1" );
+#endif
 
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
@@ -4010,6 +4069,9 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_maxNumGeoCand > GEO_MAX_NUM_UNI_CANDS, "MaxNumGeoCand must be no more than GEO_MAX_NUM_UNI_CANDS." );
   xConfirmPara( m_maxNumGeoCand > m_maxNumMergeCand, "MaxNumGeoCand must be no more than MaxNumMergeCand." );
   xConfirmPara( 0 < m_maxNumGeoCand && m_maxNumGeoCand < 2, "MaxNumGeoCand must be no less than 2 unless MaxNumGeoCand is 0." );
+#if GPM_CURVE
+  xConfirmPara( m_geoCurvePruning < 0 || m_geoCurvePruning > 2, "GeoCurvePruning must be in the range 0 to 2." );
+#endif
 #if JVET_AG0164_AFFINE_GPM
   xConfirmPara( m_maxNumGpmAffCand > GEO_MAX_NUM_UNI_AFF_CANDS, "MaxNumGeoCand must be no more than GEO_MAX_NUM_UNI_CANDS." );
   xConfirmPara( 0 < m_maxNumGpmAffCand && m_maxNumGpmAffCand < 2, "MaxNumGeoCand must be no less than 2 unless MaxNumGeoCand is 0." );
@@ -5587,6 +5649,12 @@ void EncAppCfg::xPrintParameter()
     msg(VERBOSE, "CIIPAffine:%d ", m_useCiipAffine);
 #endif
     msg( VERBOSE, "Geo:%d ", m_Geo );
+#if GPM_CURVE
+    msg( VERBOSE, "GeoCurve:%d ", m_geoCurve );
+#endif
+#if GPM_BLEND
+    msg( VERBOSE, "GeoTanhBlend:%d ", m_geoTanhBlend );
+#endif
     m_allowDisFracMMVD = m_MMVD ? m_allowDisFracMMVD : false;
     if ( m_MMVD )
       msg(VERBOSE, "AllowDisFracMMVD:%d ", m_allowDisFracMMVD);
@@ -5721,6 +5789,8 @@ void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  msg( VERBOSE, "NumFrameThreads:%d ", m_numFrameThreads );
+  msg( VERBOSE, "NumLoopFilterThreads:%d ", m_numLoopFilterThreads );
 
   if (m_resChangeInClvsEnabled)
   {
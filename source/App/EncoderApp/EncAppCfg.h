@@ -519,6 +519,13 @@ protected:
   bool      m_ciipTimd;
 #endif
   bool      m_Geo;
+#if GPM_CURVE
+  bool      m_geoCurve;
+  int       m_geoCurvePruning;
+#endif
+#if GPM_BLEND
+  bool      m_geoTanhBlend;
+#endif
   bool      m_HashME;
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
@@ -687,6 +694,8 @@ protected:
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_numFrameThreads;
+  int       m_numLoopFilterThreads;
 
   int       m_log2MaxTbSize;
   // coding tools (bit-depth)
@@ -1006,6 +1015,10 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  std::string m_modeStatsFilename;                            ///< filename for the per test mode time and RD win statistics (JSON), empty to disable.
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+  std::string m_geoWeightsDumpPrefix;                         ///< prefix of the GPM weight table dump files. If empty, the tables are not written.
+#endif
 
   int         m_verbosity;
 
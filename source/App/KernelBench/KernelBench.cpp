@@ -0,0 +1,1840 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBench.cpp
+    \brief    Micro-benchmark of the SIMD dispatched kernels
+*/
+
+#include "KernelBench.h"
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/AffineGradientSearch.h"
+#include "CommonLib/IbcHashMap.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/LoopFilter.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/Rom.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+#include "CommonLib/TrQuant.h"
+#include "CommonLib/UnitTools.h"
+#if JVET_V0094_BILATERAL_FILTER
+#include "CommonLib/BilateralFilter.h"
+#endif
+
+//! \ingroup KernelBench
+//! \{
+
+// ====================================================================================================================
+// Test data and extension selection
+// ====================================================================================================================
+
+static const int  g_benchBlockSizes[] = { 4, 8, 16, 32, 64 };
+static const int  g_benchBitDepths[]  = { 8, 10 };
+static const int  BENCH_MARGIN        = 8;   ///< samples around a block, covers the 12-tap interpolation filter
+
+static std::vector<Pel> xRandomPels( const size_t numPels, const int minVal, const int maxVal, const uint32_t seed )
+{
+  std::mt19937                       rng( seed );
+  std::uniform_int_distribution<int> dist( minVal, maxVal );
+  std::vector<Pel>                   pels( numPels );
+  for( auto& pel : pels )
+  {
+    pel = Pel( dist( rng ) );
+  }
+  return pels;
+}
+
+static std::vector<int64_t> xBlockResult( const Pel* buf, const int stride, const int width, const int height )
+{
+  std::vector<int64_t> result;
+  result.reserve( width * height );
+  for( int y = 0; y < height; y++, buf += stride )
+  {
+    result.insert( result.end(), buf, buf + width );
+  }
+  return result;
+}
+
+static ClpRng xClpRng( const int bitDepth )
+{
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = ( 1 << bitDepth ) - 1;
+  clpRng.bd  = bitDepth;
+  clpRng.n   = 0;
+  return clpRng;
+}
+
+// the per-module extension mapping follows InitX86.cpp, only the explicitly instantiated extensions are selectable
+
+#if ENABLE_SIMD_OPT_MCIF
+static void xInitVext( InterpolationFilter& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initInterpolationFilterX86<AVX2>();  break;
+  case AVX:   obj._initInterpolationFilterX86<AVX>();   break;
+  case SSE41: obj._initInterpolationFilterX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_BUFFER
+static void xInitVext( PelBufferOps& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initPelBufOpsX86<AVX2>();  break;
+  case AVX:   obj._initPelBufOpsX86<AVX>();   break;
+  case SSE41: obj._initPelBufOpsX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DIST
+static void xInitVext( RdCost& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initRdCostX86<AVX2>();  break;
+  case AVX:   obj._initRdCostX86<AVX>();   break;
+  case SSE41: obj._initRdCostX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_AFFINE_ME
+static void xInitVext( AffineGradientSearch& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initAffineGradientSearchX86<AVX2>();  break;
+  case AVX:   obj._initAffineGradientSearchX86<AVX>();   break;
+  case SSE41: obj._initAffineGradientSearchX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+static void xInitVext( IbcHashMap& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case SSE42: obj._initIbcHashMapX86<SSE42>(); break;
+  default:    break;
+  }
+}
+
+#if TRANSFORM_SIMD_OPT
+static void xInitVext( TrQuant& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initTrQuantX86<AVX2>();  break;
+  case AVX:   obj._initTrQuantX86<AVX>();   break;
+  case SSE42: obj._initTrQuantX86<SSE42>(); break;
+  case SSE41: obj._initTrQuantX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if TRANSFORM_SIMD_OPT && SIGN_PREDICTION
+/// exposes the sign hypothesis cost evaluation, which is only called from the sign prediction
+class BenchTrQuant : public TrQuant
+{
+public:
+  using TrQuant::m_signPredCosts;
+};
+#endif
+
+#if ENABLE_SIMD_TMP
+static void xInitVext( IntraPrediction& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initIntraX86<AVX2>();  break;
+  case AVX:   obj._initIntraX86<AVX>();   break;
+  case SSE42: obj._initIntraX86<SSE42>(); break;
+  case SSE41: obj._initIntraX86<SSE41>(); break;
+  default:    break;
+  }
+}
+
+/// the static kernels of IntraPrediction are only set by the first initIntraX86, the benchmark exchanges them itself
+static void xInitIntraStaticVext( const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  IntraPrediction::_initIntraStaticX86<AVX2>();  break;
+  case AVX:   IntraPrediction::_initIntraStaticX86<AVX>();   break;
+  case SSE42: IntraPrediction::_initIntraStaticX86<SSE42>(); break;
+  case SSE41: IntraPrediction::_initIntraStaticX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_MIP
+/// exposes the matrix multiplication and upsampling of MIP, which are only called from predBlock
+class BenchMatrixIntraPrediction : public MatrixIntraPrediction
+{
+public:
+  using MatrixIntraPrediction::m_reducedPredMul;
+  using MatrixIntraPrediction::m_predUpsampling;
+
+  void initVext( const X86_VEXT vext )
+  {
+    switch( vext )
+    {
+    case AVX2:  _initMatrixIntraPredictionX86<AVX2>();  break;
+    case AVX:   _initMatrixIntraPredictionX86<AVX>();   break;
+    case SSE42: _initMatrixIntraPredictionX86<SSE42>(); break;
+    case SSE41: _initMatrixIntraPredictionX86<SSE41>(); break;
+    default:    break;
+    }
+  }
+};
+#endif
+
+#if ENABLE_SIMD_BILATERAL_FILTER && JVET_V0094_BILATERAL_FILTER
+static void xInitVext( BilateralFilter& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initBilateralFilterX86<AVX2>();  break;
+  case AVX:   obj._initBilateralFilterX86<AVX>();   break;
+  case SSE42: obj._initBilateralFilterX86<SSE42>(); break;
+  case SSE41: obj._initBilateralFilterX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+static void xInitVext( LoopFilter& obj, const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case AVX2:  obj._initLoopFilterX86<AVX2>();  break;
+  case AVX:   obj._initLoopFilterX86<AVX>();   break;
+  case SSE41: obj._initLoopFilterX86<SSE41>(); break;
+  default:    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_SAO
+/// exposes the offset application of the SAO, which is only called from its CTU loops
+class BenchSampleAdaptiveOffset : public SampleAdaptiveOffset
+{
+public:
+  using SampleAdaptiveOffset::offsetBlock;
+#if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER || JVET_W0066_CCSAO
+  using SampleAdaptiveOffset::offsetBlockNoClip;
+#endif
+#if JVET_W0066_CCSAO
+  using SampleAdaptiveOffset::offsetBlockCcSaoNoClip;
+#endif
+
+  void initVext( const X86_VEXT vext, const int maxWidth )
+  {
+    m_signLineBuf1.resize( maxWidth + 1 );
+    m_signLineBuf2.resize( maxWidth + 1 );
+    switch( vext )
+    {
+    case AVX2:  _initSampleAdaptiveOffsetX86<AVX2>();  break;
+    case AVX:   _initSampleAdaptiveOffsetX86<AVX>();   break;
+    case SSE41: _initSampleAdaptiveOffsetX86<SSE41>(); break;
+    default:    break;
+    }
+  }
+};
+#endif
+
+#if ENABLE_SIMD_OPT_ALF && ALF_IMPROVEMENT && JVET_AE0139_ALF_IMPROVED_FIXFILTER && JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+/// exposes the classification buffers of the ALF, which are otherwise only used by its CTU loops
+class BenchAdaptiveLoopFilter : public AdaptiveLoopFilter
+{
+public:
+  using AdaptiveLoopFilter::m_laplacian;
+  using AdaptiveLoopFilter::m_mappingDir;
+  using AdaptiveLoopFilter::usedWindowIdx;
+
+  void initVext( const X86_VEXT vext )
+  {
+    switch( vext )
+    {
+    case AVX2:  _initAdaptiveLoopFilterX86<AVX2>();  break;
+    case AVX:   _initAdaptiveLoopFilterX86<AVX>();   break;
+    case SSE41: _initAdaptiveLoopFilterX86<SSE41>(); break;
+    default:    break;
+    }
+  }
+
+  /// both fixed filter classifications of a block, the 9x9 filters use the small window, the 13x13 ones the big one
+  void classify( AlfClassifier** classifier[NUM_CLASSIFIER], const CPelBuf& src, const Area& blk, const int bitDepth )
+  {
+    m_deriveVariance( src, blk, blk, m_laplacian );
+    m_deriveClassificationLaplacian( src, blk, blk, m_laplacian, ALF_CLASSIFIER_FL );
+    m_calcClass0( classifier[0], blk, blk, usedWindowIdx[0], 1, NUM_DIR_FIX, NUM_ACT_FIX, bitDepth, 2, m_mappingDir, m_laplacian );
+    m_deriveClassificationLaplacianBig( blk, m_laplacian );
+    m_calcClass0( classifier[1], blk, blk, usedWindowIdx[1], 1, NUM_DIR_FIX, NUM_ACT_FIX, bitDepth, 2, m_mappingDir, m_laplacian );
+  }
+};
+
+/// picture planes addressed by rows, as the ALF keeps its classifications and fixed filter outputs
+template<typename T>
+struct BenchPlanes
+{
+  std::vector<T>   data;
+  std::vector<T*>  rows;
+  std::vector<T**> planes;
+  int              stride;
+
+  void create( const int numPlanes, const int width, const int height )
+  {
+    stride = width;
+    data.resize( numPlanes * width * height );
+    rows.resize( numPlanes * height );
+    planes.resize( numPlanes );
+    for( int i = 0; i < numPlanes * height; i++ )
+    {
+      rows[i] = data.data() + i * width;
+    }
+    for( int i = 0; i < numPlanes; i++ )
+    {
+      planes[i] = rows.data() + i * height;
+    }
+  }
+};
+#endif
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KernelBench::KernelBench( X86_VEXT maxVext, double minTimeMs, const std::string& filter )
+  : m_maxVext  ( maxVext )
+  , m_minTimeMs( minTimeMs )
+  , m_filter   ( filter )
+{
+}
+
+const char* KernelBench::getVextName( const X86_VEXT vext )
+{
+  switch( vext )
+  {
+  case SCALAR: return "SCALAR";
+  case SSE41:  return "SSE41";
+  case SSE42:  return "SSE42";
+  case AVX:    return "AVX";
+  case AVX2:   return "AVX2";
+  case AVX512: return "AVX512";
+  default:     return "NA";
+  }
+}
+
+// not covered on purpose, as they need a decoded picture or a fully set up coding unit to give meaningful inputs:
+// the ALF block filters (m_filterNxNBlk, m_gaussFiltering) and the CCALF, the BDOF/PROF/LIC/OBMC buffer operations,
+// the template based IF kernels (sadTM, weightedGeoTplA, weightedSgpm) and the regression based GPM blending
+// (weightedBlendBlk, weightAffineBlk)
+void KernelBench::registerKernels()
+{
+  xAddInterpolationFilterKernels();
+  xAddBufferKernels();
+  xAddRdCostKernels();
+  xAddAffineGradientSearchKernels();
+  xAddIbcHashMapKernels();
+  xAddTrQuantKernels();
+  xAddIntraKernels();
+  xAddBilateralFilterKernels();
+  xAddLoopFilterKernels();
+  xAddSaoKernels();
+  xAddAdaptiveLoopFilterKernels();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+int KernelBench::run()
+{
+  int numMismatches = 0;
+
+  printf( "\n%-30s %7s %5s %-6s %12s %10s %8s  %s\n", "kernel", "size", "bits", "SIMD", "ns/call", "pel/cycle", "speedup", "check" );
+
+  for( BenchKernel& kernel : m_kernels )
+  {
+    if( !m_filter.empty() && kernel.name.find( m_filter ) == std::string::npos )
+    {
+      continue;
+    }
+
+    std::vector<int64_t> reference;
+    double               scalarNs = 0;
+
+    for( const X86_VEXT vext : kernel.vexts )
+    {
+      if( vext > m_maxVext )
+      {
+        break;
+      }
+
+      kernel.select( vext );
+
+      if( kernel.reset )
+      {
+        kernel.reset();
+      }
+      kernel.run();
+      const std::vector<int64_t> output = kernel.result();
+      bool                       match  = true;
+      if( vext == SCALAR )
+      {
+        reference = output;
+      }
+      else
+      {
+        match = output == reference;
+      }
+
+      double nsPerCall     = 0;
+      double cyclesPerCall = 0;
+      xMeasure( kernel, nsPerCall, cyclesPerCall );
+      if( vext == SCALAR )
+      {
+        scalarNs = nsPerCall;
+      }
+
+      const double pelsPerCycle = cyclesPerCall > 0 ? kernel.width * kernel.height / cyclesPerCall : 0;
+      printf( "%-30s %3dx%-3d %5d %-6s %12.1f %10.3f %7.2fx  %s\n", kernel.name.c_str(), kernel.width, kernel.height, kernel.bitDepth,
+              getVextName( vext ), nsPerCall, pelsPerCycle, nsPerCall > 0 ? scalarNs / nsPerCall : 0, match ? "ok" : ( kernel.approx ? "approx" : "MISMATCH" ) );
+      fflush( stdout );
+
+      numMismatches += match || kernel.approx ? 0 : 1;
+    }
+  }
+
+  return numMismatches;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** doubles the number of calls until one run lasts the minimum time, cycles are time stamp counter ticks
+ */
+void KernelBench::xMeasure( BenchKernel& kernel, double& nsPerCall, double& cyclesPerCall )
+{
+  typedef std::chrono::steady_clock Clock;
+
+  for( int64_t numCalls = 1;; numCalls <<= 1 )
+  {
+    if( kernel.reset )
+    {
+      kernel.reset();
+    }
+
+    const Clock::time_point startTime  = Clock::now();
+    const uint64_t          startTicks = __rdtsc();
+    for( int64_t i = 0; i < numCalls; i++ )
+    {
+      kernel.run();
+    }
+    const uint64_t ticks     = __rdtsc() - startTicks;
+    const double   elapsedNs = std::chrono::duration<double, std::nano>( Clock::now() - startTime ).count();
+
+    if( elapsedNs >= m_minTimeMs * 1e6 || numCalls >= ( int64_t( 1 ) << 32 ) )
+    {
+      nsPerCall     = elapsedNs / numCalls;
+      cyclesPerCall = double( ticks ) / numCalls;
+      return;
+    }
+  }
+}
+
+void KernelBench::xAddInterpolationFilterKernels()
+{
+#if ENABLE_SIMD_OPT_MCIF
+  struct State
+  {
+    std::unique_ptr<InterpolationFilter> filter;
+    std::vector<Pel>                     src;
+    std::vector<Pel>                     dst;
+    ClpRng                               clpRng;
+  };
+
+  // the tap variants reached through the public filters: the luma filter, the bilinear filter of the template
+  // matching and DMVR refinements, the chroma filter and the full sample copy
+  struct FilterType
+  {
+    const char* name;
+    ComponentID compID;
+    int         frac;
+    int         nFilterIdx;
+    bool        verToo;
+  };
+  static const FilterType filterTypes[] =
+  {
+    { "",         COMPONENT_Y,  8, 0, true  },
+    { "Bilinear", COMPONENT_Y,  8, 1, true  },
+    { "Chroma",   COMPONENT_Cb, 8, 0, true  },
+    { "Copy",     COMPONENT_Y,  0, 0, false },
+  };
+
+  for( const FilterType& filterType : filterTypes )
+  {
+    for( const int bitDepth : g_benchBitDepths )
+    {
+      for( const int size : g_benchBlockSizes )
+      {
+        for( const bool isVer : { false, true } )
+        {
+          if( isVer && !filterType.verToo )
+          {
+            continue;
+          }
+          const int srcStride = size + 2 * BENCH_MARGIN;
+
+          std::shared_ptr<State> st = std::make_shared<State>();
+          st->src    = xRandomPels( srcStride * srcStride, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+          st->dst.resize( size * size );
+          st->clpRng = xClpRng( bitDepth );
+
+          BenchKernel kernel;
+          kernel.name     = filterType.verToo ? std::string( isVer ? "IF.filterVer" : "IF.filterHor" ) + filterType.name : std::string( "IF.filter" ) + filterType.name;
+          kernel.width    = size;
+          kernel.height   = size;
+          kernel.bitDepth = bitDepth;
+          kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+          kernel.select   = [st]( const X86_VEXT vext ) { st->filter.reset( new InterpolationFilter ); xInitVext( *st->filter, vext ); };
+          kernel.run      = [st, size, srcStride, isVer, filterType]()
+          {
+            const Pel* src = st->src.data() + BENCH_MARGIN * srcStride + BENCH_MARGIN;
+            if( isVer )
+            {
+              st->filter->filterVer( filterType.compID, src, srcStride, st->dst.data(), size, size, size, filterType.frac, true, true, CHROMA_420, st->clpRng, filterType.nFilterIdx );
+            }
+            else
+            {
+              st->filter->filterHor( filterType.compID, src, srcStride, st->dst.data(), size, size, size, filterType.frac, true, CHROMA_420, st->clpRng, filterType.nFilterIdx );
+            }
+          };
+          kernel.result   = [st, size]() { return xBlockResult( st->dst.data(), size, size, size ); };
+          m_kernels.push_back( kernel );
+        }
+      }
+    }
+  }
+
+#if JVET_AA0058_GPM_ADAPTIVE_BLENDING && JVET_Y0065_GPM_INTRA
+  struct GeoState
+  {
+    std::unique_ptr<InterpolationFilter> filter;
+    CUCache                              cuCache;
+    PUCache                              puCache;
+    TUCache                              tuCache;
+    std::unique_ptr<CodingStructure>     cs;
+    SPS                                  sps;
+    PPS                                  pps;
+    std::unique_ptr<PreCalcValues>       pcv;
+    Slice                                slice;
+    PredictionUnit*                      pu;
+    std::vector<Pel>                     src0;
+    std::vector<Pel>                     src1;
+    std::vector<Pel>                     dst;
+  };
+
+  // the luma GPM blending of the two predictions for every mask variant of SPS::getGeoMaskVariant(), the curve
+  // variants blend with the first split direction that has a curve mask at the block size
+  struct GeoMaskType
+  {
+    const char* name;
+    bool        curve;
+    bool        tanh;
+  };
+  static const GeoMaskType geoMaskTypes[] =
+  {
+    { "",           false, false },
+#if GPM_BLEND
+    { ".tanh",      false, true  },
+#endif
+#if GPM_CURVE
+    { ".curve",     true,  false },
+#if GPM_BLEND
+    { ".curveTanh", true,  true  },
+#endif
+#endif
+  };
+  const uint8_t bldIdx = 2;
+
+  for( const GeoMaskType& maskType : geoMaskTypes )
+  {
+    for( const int bitDepth : g_benchBitDepths )
+    {
+      for( int log2Size = GEO_MIN_CU_LOG2; log2Size <= GEO_MAX_CU_LOG2; log2Size++ )
+      {
+        const int size     = 1 << log2Size;
+        const int sizeIdx  = log2Size - GEO_MIN_CU_LOG2;
+        int       splitDir = 0;
+        if( maskType.curve )
+        {
+          while( splitDir < GEO_NUM_PARTITION_MODE && !g_geoMaskView[GEO_NUM_BLEND_SHAPES][splitDir][sizeIdx][sizeIdx].isCurve )
+          {
+            splitDir++;
+          }
+          if( splitDir == GEO_NUM_PARTITION_MODE )
+          {
+            continue;
+          }
+        }
+
+        std::shared_ptr<GeoState> st = std::make_shared<GeoState>();
+        const UnitArea area( CHROMA_400, Area( 0, 0, size, size ) );
+        st->sps.setChromaFormatIdc( CHROMA_400 );
+        st->sps.setBitDepth( CHANNEL_TYPE_LUMA, bitDepth );
+#if GPM_CURVE
+        st->sps.setUseGeoCurve( maskType.curve );
+#endif
+#if GPM_BLEND
+        st->sps.setUseGeoTanhBlend( maskType.tanh );
+#endif
+        st->pcv.reset( new PreCalcValues( st->sps, st->pps, true ) );
+        st->slice.setSPS( &st->sps );
+        st->slice.setPPS( &st->pps );
+        st->slice.getClpRngs().comp[COMPONENT_Y] = xClpRng( bitDepth );
+        st->cs.reset( new CodingStructure( st->cuCache, st->puCache, st->tuCache ) );
+        st->cs->create( area, false, false );
+        st->cs->sps   = &st->sps;
+        st->cs->pps   = &st->pps;
+        st->cs->pcv   = st->pcv.get();
+        st->cs->slice = &st->slice;
+        st->cs->initStructData();
+        CodingUnit& cu = st->cs->addCU( area, CHANNEL_TYPE_LUMA );
+        cu.slice    = &st->slice;
+        cu.predMode = MODE_INTER;
+        st->pu      = &st->cs->addPU( area, CHANNEL_TYPE_LUMA );
+
+        // the predictions are in the intermediate precision of the interpolation
+        const int minVal = -IF_INTERNAL_OFFS;
+        const int maxVal = ( ( ( 1 << bitDepth ) - 1 ) << IF_INTERNAL_FRAC_BITS( bitDepth ) ) - IF_INTERNAL_OFFS;
+        st->src0 = xRandomPels( size * size, minVal, maxVal, size * 16 + bitDepth );
+        st->src1 = xRandomPels( size * size, minVal, maxVal, size * 16 + bitDepth + 1 );
+        st->dst.resize( size * size );
+
+        for( const bool rounded : { false, true } )
+        {
+          BenchKernel kernel;
+          kernel.name     = std::string( rounded ? "IF.weightedGeoBlkRounded" : "IF.weightedGeoBlk" ) + maskType.name;
+          kernel.width    = size;
+          kernel.height   = size;
+          kernel.bitDepth = bitDepth;
+          kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+          kernel.select   = [st]( const X86_VEXT vext ) { st->filter.reset( new InterpolationFilter ); xInitVext( *st->filter, vext ); };
+          kernel.run      = [st, size, splitDir, bldIdx, rounded]()
+          {
+            PelUnitBuf dst ( CHROMA_400, PelBuf( st->dst.data(),  size, size, size ) );
+            PelUnitBuf src0( CHROMA_400, PelBuf( st->src0.data(), size, size, size ) );
+            PelUnitBuf src1( CHROMA_400, PelBuf( st->src1.data(), size, size, size ) );
+            if( rounded )
+            {
+              st->filter->weightedGeoBlkRounded( *st->pu, size, size, COMPONENT_Y, splitDir, bldIdx, dst, src0, src1 );
+            }
+            else
+            {
+              st->filter->weightedGeoBlk( *st->pu, size, size, COMPONENT_Y, splitDir, bldIdx, dst, src0, src1 );
+            }
+          };
+          kernel.result   = [st, size]() { return xBlockResult( st->dst.data(), size, size, size ); };
+          m_kernels.push_back( kernel );
+        }
+      }
+    }
+  }
+#endif
+#endif
+}
+
+void KernelBench::xAddBufferKernels()
+{
+#if ENABLE_SIMD_OPT_BUFFER
+  struct State
+  {
+    std::unique_ptr<PelBufferOps> ops;
+    std::vector<Pel>              src0;
+    std::vector<Pel>              src1;
+    std::vector<Pel>              dst;
+    ClpRng                        clpRng;
+    int64_t                       sum;
+  };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      std::shared_ptr<State> st = std::make_shared<State>();
+      st->src0   = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->src1   = xRandomPels( size * size, -( 1 << bitDepth ), ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 1 );
+      st->dst.resize( size * size );
+      st->clpRng = xClpRng( bitDepth );
+      st->sum    = 0;
+
+      BenchKernel kernel;
+      kernel.name     = "Buffer.reco";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->ops.reset( new PelBufferOps ); xInitVext( *st->ops, vext ); };
+      kernel.run      = [st, size]()
+      {
+        ( ( size & 7 ) == 0 ? st->ops->reco8 : st->ops->reco4 )( st->src0.data(), size, st->src1.data(), size, st->dst.data(), size, size, size, st->clpRng );
+      };
+      kernel.result   = [st, size]() { return xBlockResult( st->dst.data(), size, size, size ); };
+      m_kernels.push_back( kernel );
+
+#if TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM
+      kernel.name     = "Buffer.sumOfDifference";
+      kernel.run      = [st, size, bitDepth]()
+      {
+        st->sum = st->ops->getSumOfDifference( st->src0.data(), size, st->dst.data(), size, size, size, 0, bitDepth );
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( 1, st->sum ); };
+      m_kernels.push_back( kernel );
+#endif
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddRdCostKernels()
+{
+#if ENABLE_SIMD_OPT_DIST
+  struct State
+  {
+    std::unique_ptr<RdCost> rdCost;
+    DistParam               distParam;
+    std::vector<Pel>        org;
+    std::vector<Pel>        cur;
+    std::vector<Distortion> dist;
+  };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      for( int kernelIdx = 0; kernelIdx < 3; kernelIdx++ )
+      {
+        const bool isGeo = kernelIdx == 2;
+        if( isGeo && ( size < GEO_MIN_CU_SIZE || size > GEO_MAX_CU_SIZE ) )
+        {
+          continue;
+        }
+
+        std::shared_ptr<State> st = std::make_shared<State>();
+        st->org = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+        st->cur = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 1 );
+        st->dist.resize( isGeo ? GEO_NUM_PARTITION_MODE : 1 );
+
+        BenchKernel kernel;
+        kernel.name     = kernelIdx == 0 ? "RdCost.SAD" : ( kernelIdx == 1 ? "RdCost.HAD" : "RdCost.geoSADAllSplits" );
+        kernel.width    = size;
+        kernel.height   = size;
+        kernel.bitDepth = bitDepth;
+        kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+        kernel.select   = [st, size, bitDepth, kernelIdx]( const X86_VEXT vext )
+        {
+          st->rdCost.reset( new RdCost );
+          xInitVext( *st->rdCost, vext );
+          st->rdCost->setDistParam( st->distParam, CPelBuf( st->org.data(), size, Size( size, size ) ), CPelBuf( st->cur.data(), size, Size( size, size ) ),
+                                    bitDepth, COMPONENT_Y, kernelIdx == 1 );
+        };
+        if( isGeo )
+        {
+          kernel.run    = [st]() { st->rdCost->getGeoSADAllSplits( st->distParam, 0, st->dist.data() ); };
+        }
+        else
+        {
+          kernel.run    = [st]() { st->dist[0] = st->distParam.distFunc( st->distParam ); };
+        }
+        kernel.result   = [st]() { return std::vector<int64_t>( st->dist.begin(), st->dist.end() ); };
+        m_kernels.push_back( kernel );
+      }
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddAffineGradientSearchKernels()
+{
+#if ENABLE_SIMD_OPT_AFFINE_ME && AFFINE_ENC_OPT
+  struct State
+  {
+    std::unique_ptr<AffineGradientSearch> search;
+    std::vector<Pel>                      residue;
+    std::vector<Pel>                      derivate[2];
+    int64_t                               equalCoeff[7][7];
+  };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      if( size < 8 )
+      {
+        continue;
+      }
+
+      std::shared_ptr<State> st = std::make_shared<State>();
+      st->residue     = xRandomPels( size * size, -( 1 << bitDepth ), ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->derivate[0] = xRandomPels( size * size, -( 1 << ( bitDepth - 2 ) ), ( 1 << ( bitDepth - 2 ) ) - 1, size * 16 + bitDepth + 1 );
+      st->derivate[1] = xRandomPels( size * size, -( 1 << ( bitDepth - 2 ) ), ( 1 << ( bitDepth - 2 ) ) - 1, size * 16 + bitDepth + 2 );
+
+      const int shift = 6 - 1 - std::max<int>( 2, IF_INTERNAL_PREC - bitDepth );
+
+      BenchKernel kernel;
+      kernel.name     = "Affine.equalCoeff";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->search.reset( new AffineGradientSearch ); xInitVext( *st->search, vext ); };
+      // the SIMD kernel takes one x per 4 samples and one y per 2 rows and shifts the residue before the product
+      kernel.approx   = true;
+      kernel.run      = [st, size, shift]()
+      {
+        Pel* derivate[2] = { st->derivate[0].data(), st->derivate[1].data() };
+        ::memset( st->equalCoeff, 0, sizeof( st->equalCoeff ) );
+        st->search->m_EqualCoeffComputer( st->residue.data(), size, derivate, size, st->equalCoeff, size, size, true, shift );
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( &st->equalCoeff[0][0], &st->equalCoeff[0][0] + 7 * 7 ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddIbcHashMapKernels()
+{
+  struct State
+  {
+    std::unique_ptr<IbcHashMap> hashMap;
+    std::vector<Pel>            src;
+    uint32_t                    crc;
+  };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      std::shared_ptr<State> st = std::make_shared<State>();
+      st->src = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->crc = 0;
+
+      BenchKernel kernel;
+      kernel.name     = "IbcHashMap.crc32c";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE42 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->hashMap.reset( new IbcHashMap ); xInitVext( *st->hashMap, vext ); };
+      kernel.run      = [st]()
+      {
+        uint32_t crc = 0;
+        for( const Pel pel : st->src )
+        {
+          crc = st->hashMap->m_computeCrc32c( crc, pel );
+        }
+        st->crc = crc;
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( 1, st->crc ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+}
+
+void KernelBench::xAddTrQuantKernels()
+{
+#if TRANSFORM_SIMD_OPT && INTRA_TRANS_ENC_OPT && JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  struct State
+  {
+    std::unique_ptr<TrQuant> trQuant;
+    std::vector<TCoeff>      src;
+    std::vector<TCoeff>      dst;
+  };
+
+  // LFNST kernels are bit depth independent, the coefficients cover the 16-bit dynamic range
+  for( const int size : { 4, 8, 16 } )
+  {
+    for( const bool isInv : { false, true } )
+    {
+#if JVET_W0119_LFNST_EXTENSION
+      const int zeroOutSize = size > 8 ? L16H : ( size > 4 ? L8H : 16 );
+#else
+      const int zeroOutSize = 16;
+#endif
+      std::shared_ptr<State> st = std::make_shared<State>();
+      std::mt19937                       rng( size * 2 + isInv );
+      std::uniform_int_distribution<int> dist( -( 1 << 10 ), ( 1 << 10 ) - 1 );
+      st->src.resize( 128 );
+      st->dst.resize( 128 );
+      for( auto& coeff : st->src )
+      {
+        coeff = dist( rng );
+      }
+
+      BenchKernel kernel;
+      kernel.name     = isInv ? "TrQuant.invLfnst" : "TrQuant.fwdLfnst";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = 0;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext )
+      {
+        st->trQuant.reset( new TrQuant );
+#if T0196_SELECTIVE_RDOQ
+        st->trQuant->init( nullptr, MAX_TB_SIZEY, false, false, false, false );
+#else
+        st->trQuant->init( nullptr, MAX_TB_SIZEY, false, false, false );
+#endif
+        xInitVext( *st->trQuant, vext );
+      };
+      kernel.run      = [st, size, isInv, zeroOutSize]()
+      {
+        if( isInv )
+        {
+          st->trQuant->invLfnstNxN( st->src.data(), st->dst.data(), 0, 0, size, zeroOutSize, 15 );
+        }
+        else
+        {
+          st->trQuant->fwdLfnstNxN( st->src.data(), st->dst.data(), 0, 0, size, zeroOutSize );
+        }
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( st->dst.begin(), st->dst.end() ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+#endif
+#if TRANSFORM_SIMD_OPT && SIGN_PREDICTION
+  struct SignPredState
+  {
+    std::unique_ptr<BenchTrQuant> trQuant;
+    std::vector<Pel>              border;
+    std::vector<Pel>              initTemplate;
+    std::vector<Pel>              resiTemplate;
+    std::vector<Pel>              signTemplates;
+    std::vector<uint32_t>         costs;
+  };
+
+  // all hypotheses of the maximum number of predicted signs over the left and top border of a size x size block,
+  // the residual template is updated in place and restored by reset
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      const int length = 2 * size;
+      std::shared_ptr<SignPredState> st = std::make_shared<SignPredState>();
+      st->border        = xRandomPels( length, -( 1 << bitDepth ), ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->initTemplate  = xRandomPels( length, -( 1 << bitDepth ), ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 1 );
+      st->signTemplates = xRandomPels( length * SIGN_PRED_MAX_NUM, -( 1 << ( bitDepth - 2 ) ), ( 1 << ( bitDepth - 2 ) ) - 1, size * 16 + bitDepth + 2 );
+      st->costs.resize( 1 << SIGN_PRED_MAX_NUM );
+
+      BenchKernel kernel;
+      kernel.name     = "TrQuant.signPredCosts";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext )
+      {
+        st->trQuant.reset( new BenchTrQuant );
+#if T0196_SELECTIVE_RDOQ
+        st->trQuant->init( nullptr, MAX_TB_SIZEY, false, false, false, false );
+#else
+        st->trQuant->init( nullptr, MAX_TB_SIZEY, false, false, false );
+#endif
+        xInitVext( *st->trQuant, vext );
+      };
+      kernel.reset    = [st]() { st->resiTemplate = st->initTemplate; };
+      kernel.run      = [st, length]()
+      {
+        st->trQuant->m_signPredCosts( st->border.data(), st->resiTemplate.data(), st->signTemplates.data(), length, 0, length, SIGN_PRED_MAX_NUM, st->costs.data() );
+      };
+      kernel.result   = [st]()
+      {
+        std::vector<int64_t> result( st->costs.begin(), st->costs.end() );
+        result.insert( result.end(), st->resiTemplate.begin(), st->resiTemplate.end() );
+        return result;
+      };
+      m_kernels.push_back( kernel );
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddIntraKernels()
+{
+#if ENABLE_SIMD_TMP && INTRA_TRANS_ENC_OPT && ( JVET_W0123_TIMD_FUSION || ENABLE_DIMD )
+  struct State
+  {
+    std::unique_ptr<IntraPrediction> intraPred;
+    std::vector<Pel>                 init;
+    std::vector<Pel>                 dst;
+    std::vector<Pel>                 src0;
+    std::vector<Pel>                 src1;
+  };
+
+  // both blendings accumulate into the destination, reset restores it before every measurement
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      for( const bool isDimd : { false, true } )
+      {
+#if !JVET_W0123_TIMD_FUSION
+        if( !isDimd )
+        {
+          continue;
+        }
+#endif
+#if !ENABLE_DIMD
+        if( isDimd )
+        {
+          continue;
+        }
+#endif
+        std::shared_ptr<State> st = std::make_shared<State>();
+        st->init = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+        st->src0 = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 1 );
+        st->src1 = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 2 );
+
+        BenchKernel kernel;
+        kernel.name     = isDimd ? "Intra.dimdBlending" : "Intra.timdBlending";
+        kernel.width    = size;
+        kernel.height   = size;
+        kernel.bitDepth = bitDepth;
+        kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+        kernel.select   = [st]( const X86_VEXT vext )
+        {
+          // the scalar blendings are only set by IntraPrediction::init, which needs a full picture setup
+          st->intraPred.reset( new IntraPrediction );
+#if ENABLE_DIMD
+          st->intraPred->m_dimdBlending = IntraPrediction::dimdBlending;
+#endif
+#if JVET_W0123_TIMD_FUSION
+          st->intraPred->m_timdBlending = IntraPrediction::timdBlending;
+#endif
+          xInitVext( *st->intraPred, vext );
+        };
+        kernel.reset    = [st]() { st->dst = st->init; };
+        kernel.run      = [st, size, isDimd]()
+        {
+#if ENABLE_DIMD
+          if( isDimd )
+          {
+            st->intraPred->m_dimdBlending( st->dst.data(), size, st->src0.data(), size, st->src1.data(), size, 22, 21, 21, size, size );
+            return;
+          }
+#endif
+#if JVET_W0123_TIMD_FUSION
+          st->intraPred->m_timdBlending( st->dst.data(), size, st->src0.data(), size, 40, 24, size, size );
+#endif
+        };
+        kernel.result   = [st, size]() { return xBlockResult( st->dst.data(), size, size, size ); };
+        m_kernels.push_back( kernel );
+      }
+    }
+  }
+#endif
+#if ENABLE_SIMD_MIP
+  struct MipState
+  {
+    std::unique_ptr<BenchMatrixIntraPrediction> mip;
+    std::vector<int>                            input;
+    std::vector<uint8_t>                        matrix;
+    std::vector<int>                            reduced;
+    std::vector<int>                            refTop;
+    std::vector<int>                            refLeft;
+    std::vector<int>                            dst;
+  };
+
+  // one reduced prediction per MIP size id and the upsampling of the reduced prediction of square blocks
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int sizeId : { 0, 1, 2 } )
+    {
+      const int numOutputs = sizeId < 2 ? 16 : 64;
+      const int size       = 4 << sizeId;
+      std::shared_ptr<MipState> st = std::make_shared<MipState>();
+      std::mt19937                       rng( sizeId * 16 + bitDepth );
+      std::uniform_int_distribution<int> dist( -( 1 << bitDepth ) + 1, ( 1 << bitDepth ) - 1 );
+      st->input.resize( 8 );
+      for( auto& in : st->input )
+      {
+        in = dist( rng );
+      }
+      if( sizeId == 2 )
+      {
+        st->input[0] = 0;
+      }
+      st->matrix.resize( numOutputs * 8 );
+      for( auto& weight : st->matrix )
+      {
+        weight = uint8_t( rng() & 127 );
+      }
+      st->reduced.resize( numOutputs );
+
+      BenchKernel kernel;
+      kernel.name     = "Intra.mipReducedPredMul";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->mip.reset( new BenchMatrixIntraPrediction ); st->mip->initVext( vext ); };
+      kernel.run      = [st, sizeId, bitDepth]()
+      {
+        st->mip->m_reducedPredMul( st->reduced.data(), st->input.data(), st->matrix.data(), sizeId, 32 - 8 * st->input[1], 1 << ( bitDepth - 1 ), bitDepth );
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( st->reduced.begin(), st->reduced.end() ); };
+      m_kernels.push_back( kernel );
+    }
+
+    for( const int size : g_benchBlockSizes )
+    {
+      if( size == 4 )
+      {
+        continue;
+      }
+      const int reducedPredSize = size == 8 ? 4 : 8;
+      std::shared_ptr<MipState> st = std::make_shared<MipState>();
+      std::mt19937                       rng( size * 16 + bitDepth );
+      std::uniform_int_distribution<int> dist( 0, ( 1 << bitDepth ) - 1 );
+      st->reduced.resize( reducedPredSize * reducedPredSize );
+      st->refTop.resize( size );
+      st->refLeft.resize( size );
+      for( auto* buf : { &st->reduced, &st->refTop, &st->refLeft } )
+      {
+        for( auto& sample : *buf )
+        {
+          sample = dist( rng );
+        }
+      }
+      st->dst.resize( size * size );
+
+      BenchKernel kernel;
+      kernel.name     = "Intra.mipPredUpsampling";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->mip.reset( new BenchMatrixIntraPrediction ); st->mip->initVext( vext ); };
+      kernel.run      = [st, size, reducedPredSize]()
+      {
+        const unsigned int upsmpFactor = size / reducedPredSize;
+        st->mip->m_predUpsampling( st->dst.data(), st->reduced.data(), st->refTop.data(), st->refLeft.data(), size, size, reducedPredSize, upsmpFactor, upsmpFactor );
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( st->dst.begin(), st->dst.end() ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+#endif
+#if ENABLE_SIMD_TMP && ENABLE_SIMD_DIMD
+  struct DimdState
+  {
+    std::vector<Pel> reco;
+    std::vector<int> histogram;
+  };
+
+  // gradient histogram of a whole block as in the DIMD derivation from a prediction, the Sobel window reads one
+  // sample around the block
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      const int stride = size + 2;
+      std::shared_ptr<DimdState> st = std::make_shared<DimdState>();
+      st->reco = xRandomPels( stride * stride, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+
+      BenchKernel kernel;
+      kernel.name     = "Intra.dimdHistogram";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = []( const X86_VEXT vext )
+      {
+#if JVET_AG0061_INTER_LFNST_NSPT
+        IntraPrediction::m_buildHistogram = buildHistogram;
+#else
+        IntraPrediction::m_buildHistogram = IntraPrediction::buildHistogram;
+#endif
+        xInitIntraStaticVext( vext );
+      };
+      kernel.run      = [st, size, stride]()
+      {
+        // the histogram is cleared in every call, the amplitudes would overflow over the measurement otherwise
+        st->histogram.assign( NUM_LUMA_MODE, 0 );
+        IntraPrediction::m_buildHistogram( st->reco.data() + stride + 1, stride, size, size, st->histogram.data(), 0, size, size );
+      };
+      kernel.result   = [st]() { return std::vector<int64_t>( st->histogram.begin(), st->histogram.end() ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+
+  // the above template of the DIMD derivation from the reconstruction, one or two rows over the block width
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int numRows : { 1, 2 } )
+    {
+      for( const int size : g_benchBlockSizes )
+      {
+        const int stride = size + 2;
+        std::shared_ptr<DimdState> st = std::make_shared<DimdState>();
+        st->reco = xRandomPels( stride * ( numRows + 2 ), 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + numRows );
+
+        BenchKernel kernel;
+        kernel.name     = numRows > 1 ? "Intra.dimdHistogram.above2" : "Intra.dimdHistogram.above1";
+        kernel.width    = size;
+        kernel.height   = numRows;
+        kernel.bitDepth = bitDepth;
+        kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+        kernel.select   = []( const X86_VEXT vext )
+        {
+#if JVET_AG0061_INTER_LFNST_NSPT
+          IntraPrediction::m_buildHistogram = buildHistogram;
+#else
+          IntraPrediction::m_buildHistogram = IntraPrediction::buildHistogram;
+#endif
+          xInitIntraStaticVext( vext );
+        };
+        kernel.run      = [st, size, stride, numRows]()
+        {
+          st->histogram.assign( NUM_LUMA_MODE, 0 );
+          IntraPrediction::m_buildHistogram( st->reco.data() + stride + 1, stride, numRows, size, st->histogram.data(), 2, size, size );
+        };
+        kernel.result   = [st]() { return std::vector<int64_t>( st->histogram.begin(), st->histogram.end() ); };
+        m_kernels.push_back( kernel );
+      }
+    }
+  }
+#endif
+#if ENABLE_SIMD_TMP && ENABLE_SIMD_CCCM
+  struct CccmState
+  {
+    Pel        cols[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_MAX];
+    Pel        cb[CCCM_REF_SAMPLES_MAX];
+    Pel        cr[CCCM_REF_SAMPLES_MAX];
+    TCccmCoeff ata[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX];
+    TCccmCoeff atcb[CCCM_NUM_PARAMS_MAX];
+    TCccmCoeff atcr[CCCM_NUM_PARAMS_MAX];
+  };
+
+  // correlations of a CCCM model with both chroma targets, the reference area is a window of six lines around
+  // a square block
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      for( const int numParams : { CCCM_NUM_PARAMS, CCCM_NO_SUB_NUM_PARAMS } )
+      {
+        const int sampleNum = std::min( CCCM_REF_SAMPLES_MAX, 2 * CCCM_WINDOW_SIZE * ( 2 * size + CCCM_WINDOW_SIZE ) );
+        std::shared_ptr<CccmState> st = std::make_shared<CccmState>();
+        for( int coli = 0; coli < numParams; coli++ )
+        {
+          const std::vector<Pel> col = xRandomPels( sampleNum, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + coli );
+          std::copy( col.begin(), col.end(), st->cols[coli] );
+        }
+        const std::vector<Pel> cb = xRandomPels( sampleNum, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 32 );
+        const std::vector<Pel> cr = xRandomPels( sampleNum, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 33 );
+        std::copy( cb.begin(), cb.end(), st->cb );
+        std::copy( cr.begin(), cr.end(), st->cr );
+
+        BenchKernel kernel;
+        kernel.name     = numParams == CCCM_NUM_PARAMS ? "Intra.cccmCovariance7" : "Intra.cccmCovariance11";
+        kernel.width    = size;
+        kernel.height   = size;
+        kernel.bitDepth = bitDepth;
+        kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+        kernel.select   = []( const X86_VEXT vext )
+        {
+          CccmCovariance::m_calcCovariance = CccmCovariance::calcCovariance;
+          xInitIntraStaticVext( vext );
+        };
+        kernel.run      = [st, numParams, sampleNum]()
+        {
+          CccmCovariance::m_calcCovariance( st->cols, st->cb, st->cr, numParams, sampleNum, st->ata, st->atcb, st->atcr );
+        };
+        kernel.result   = [st, numParams]()
+        {
+          std::vector<int64_t> result;
+          for( int coli0 = 0; coli0 < numParams; coli0++ )
+          {
+            result.insert( result.end(), st->ata[coli0] + coli0, st->ata[coli0] + numParams );
+            result.push_back( st->atcb[coli0] );
+            result.push_back( st->atcr[coli0] );
+          }
+          return result;
+        };
+        m_kernels.push_back( kernel );
+      }
+    }
+  }
+#endif
+#if ENABLE_SIMD_TMP && ENABLE_SIMD_TIMD
+  struct TimdState
+  {
+    std::vector<Pel> refMain;
+    std::vector<Pel> dst;
+    ClpRng           clpRng;
+  };
+
+  // angular prediction of an above-left template with 4 lines as in the TIMD derivation, the above part and the left
+  // part are predicted in separate calls like in xPredTimdIntraAng
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      const int tmplSize       = 4;
+      const int realSize       = size + tmplSize;
+      const int intraPredAngle = 23;
+      std::shared_ptr<TimdState> st = std::make_shared<TimdState>();
+      st->refMain = xRandomPels( 2 * realSize + ( realSize * intraPredAngle >> 6 ) + 4, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->dst.assign( realSize * realSize, 0 );
+      st->clpRng = xClpRng( bitDepth );
+
+      BenchKernel kernel;
+      kernel.name     = "Intra.timdAngLuma";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = []( const X86_VEXT vext )
+      {
+        IntraPrediction::m_timdAngLuma = IntraPrediction::xIntraPredTimdAngLuma;
+        xInitIntraStaticVext( vext );
+      };
+      kernel.run      = [st, tmplSize, realSize, intraPredAngle]()
+      {
+        IntraPrediction::m_timdAngLuma( st->dst.data(), realSize, st->refMain.data(), realSize, tmplSize, intraPredAngle, intraPredAngle, st->clpRng, tmplSize, 0 );
+        IntraPrediction::m_timdAngLuma( st->dst.data(), realSize, st->refMain.data(), tmplSize, realSize, intraPredAngle * ( tmplSize + 1 ), intraPredAngle, st->clpRng, 0, tmplSize );
+      };
+      kernel.result   = [st, realSize]() { return xBlockResult( st->dst.data(), realSize, realSize, realSize ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddBilateralFilterKernels()
+{
+#if ENABLE_SIMD_BILATERAL_FILTER && JVET_V0094_BILATERAL_FILTER && JVET_AF0112_BIF_DYNAMIC_SCALING
+  struct State
+  {
+    std::unique_ptr<BilateralFilter> filter;
+    std::vector<Pel>                 block;
+    int                              bfac;
+  };
+
+  // the LUT parameter derivation is where the MAD kernel is dispatched from
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      std::shared_ptr<State> st = std::make_shared<State>();
+      st->block = xRandomPels( size * size, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->bfac  = 0;
+
+      BenchKernel kernel;
+      kernel.name     = "BIF.calcMAD";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, SSE42, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->filter.reset( new BilateralFilter ); xInitVext( *st->filter, vext ); };
+      kernel.run      = [st, size]() { st->filter->getFilterLutParameters( st->block.data(), size, size, size, MODE_INTRA, 32, st->bfac ); };
+      kernel.result   = [st]() { return std::vector<int64_t>( 1, st->bfac ); };
+      m_kernels.push_back( kernel );
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddLoopFilterKernels()
+{
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+  static const int BLOCK_SIZE = 64;
+  static const int EDGE_STEP  = 8;   ///< distance of the edges, the long filter reads 8 samples on each side
+
+  struct Segment
+  {
+    int  pos;
+    int  tc;
+    int  beta;
+    int  maxFilterLengthP;
+    int  maxFilterLengthQ;
+    bool partPNoFilter;
+    bool partQNoFilter;
+    bool chromaHorCTBBoundary;
+  };
+  struct State
+  {
+    std::unique_ptr<LoopFilter> filter;
+    std::vector<Pel>            init;
+    std::vector<Pel>            block;
+    std::vector<Segment>        segments;
+  };
+
+  // blocks of smooth ramps with a step at the edges, so that the decisions select every filter
+  static const int filterLengths[][2] = { { 7, 7 }, { 7, 5 }, { 5, 7 }, { 7, 3 }, { 3, 7 }, { 5, 5 }, { 5, 3 }, { 3, 3 }, { 2, 3 }, { 1, 1 } };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const bool isChroma : { false, true } )
+    {
+      for( const bool verEdge : { true, false } )
+      {
+        std::shared_ptr<State> st = std::make_shared<State>();
+        std::mt19937           rng( bitDepth * 4 + ( isChroma ? 2 : 0 ) + ( verEdge ? 1 : 0 ) );
+        const int              numLines = isChroma && verEdge ? 2 : 4;
+        const int              shift    = bitDepth - 8;
+
+        st->init.resize( BLOCK_SIZE * BLOCK_SIZE );
+        std::vector<Pel> noise = xRandomPels( BLOCK_SIZE * BLOCK_SIZE, 0, 2 << shift, bitDepth );
+        for( int y = 0; y < BLOCK_SIZE; y++ )
+        {
+          for( int x = 0; x < BLOCK_SIZE; x++ )
+          {
+            const int blkIdx = verEdge ? x / EDGE_STEP : y / EDGE_STEP;
+            const int base   = ( 64 + 16 * ( blkIdx % 5 ) + ( blkIdx & 1 ? 3 : -3 ) * ( ( verEdge ? x : y ) % EDGE_STEP ) ) << shift;
+            st->init[y * BLOCK_SIZE + x] = Pel( base + noise[y * BLOCK_SIZE + x] );
+          }
+        }
+
+        for( int edge = EDGE_STEP; edge < BLOCK_SIZE; edge += EDGE_STEP )
+        {
+          for( int line = 0; line < BLOCK_SIZE; line += numLines )
+          {
+            const int qp     = 20 + int( rng() % 32 );
+            const int lenIdx = int( rng() % ( sizeof( filterLengths ) / sizeof( filterLengths[0] ) ) );
+            Segment   seg;
+            seg.pos                  = verEdge ? line * BLOCK_SIZE + edge : edge * BLOCK_SIZE + line;
+            seg.tc                   = ( 1 + int( rng() % 12 ) ) << shift;
+            seg.beta                 = LoopFilter::getBeta( qp ) << shift;
+            seg.maxFilterLengthP     = isChroma ? ( lenIdx & 1 ? 3 : 1 ) : filterLengths[lenIdx][0];
+            seg.maxFilterLengthQ     = isChroma ? ( lenIdx & 2 ? 3 : 1 ) : filterLengths[lenIdx][1];
+            seg.partPNoFilter        = rng() % 8 == 0;
+            seg.partQNoFilter        = rng() % 8 == 0;
+            seg.chromaHorCTBBoundary = !verEdge && rng() % 2 == 0;
+            st->segments.push_back( seg );
+          }
+        }
+
+        BenchKernel kernel;
+        kernel.name     = std::string( isChroma ? "DBF.chroma" : "DBF.luma" ) + ( verEdge ? "Ver" : "Hor" );
+        kernel.width    = BLOCK_SIZE;
+        kernel.height   = BLOCK_SIZE;
+        kernel.bitDepth = bitDepth;
+        kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+        kernel.select   = [st]( const X86_VEXT vext ) { st->filter.reset( new LoopFilter ); xInitVext( *st->filter, vext ); };
+        kernel.reset    = [st]() { st->block = st->init; };
+        kernel.run      = [st, isChroma, verEdge, numLines, bitDepth]()
+        {
+          const ClpRng clpRng = xClpRng( bitDepth );
+          for( const Segment& seg : st->segments )
+          {
+            Pel* src = st->block.data() + seg.pos;
+            if( isChroma )
+            {
+              st->filter->deblockChromaSegment( src, BLOCK_SIZE, verEdge, numLines, numLines - 1, seg.tc, seg.beta, seg.maxFilterLengthP >= 3 && seg.maxFilterLengthQ >= 3,
+                                                seg.chromaHorCTBBoundary, seg.partPNoFilter, seg.partQNoFilter, clpRng );
+            }
+            else
+            {
+              st->filter->deblockLumaSegment( src, BLOCK_SIZE, verEdge, seg.tc, seg.beta, seg.maxFilterLengthP, seg.maxFilterLengthQ, seg.maxFilterLengthP > 3, seg.maxFilterLengthQ > 3,
+                                              seg.partPNoFilter, seg.partQNoFilter, clpRng );
+            }
+          }
+        };
+        kernel.result   = [st]() { return xBlockResult( st->block.data(), BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE ); };
+        m_kernels.push_back( kernel );
+      }
+    }
+  }
+#endif
+}
+
+void KernelBench::xAddSaoKernels()
+{
+#if ENABLE_SIMD_SAO
+  static const int BLOCK_SIZE = 64;
+  static const int STRIDE     = BLOCK_SIZE + 2 * BENCH_MARGIN;
+
+  struct State
+  {
+    std::unique_ptr<BenchSampleAdaptiveOffset> sao;
+    std::vector<Pel>                           src;
+    std::vector<Pel>                           init;
+    std::vector<Pel>                           dst;
+  };
+
+  static const struct
+  {
+    int         typeIdx;
+    const char* name;
+  } saoTypes[] = { { SAO_TYPE_EO_0, "SAO.edge0" }, { SAO_TYPE_EO_90, "SAO.edge90" }, { SAO_TYPE_EO_135, "SAO.edge135" }, { SAO_TYPE_EO_45, "SAO.edge45" }, { SAO_TYPE_BO, "SAO.band" } };
+
+  // CTUs inside the picture, clipped at the right and bottom picture border and chroma CTUs of a narrow border
+  static const struct
+  {
+    int width;
+    int height;
+  } saoSizes[] = { { BLOCK_SIZE, BLOCK_SIZE }, { 60, 36 }, { 4, 8 } };
+
+  // neighbour CTUs at the picture, slice and tile borders, the edge classes skip the samples next to the missing ones
+  static const struct
+  {
+    const char* suffix;
+    bool        left;
+    bool        right;
+    bool        above;
+    bool        below;
+  } saoAvails[] = { { "", true, true, true, true }, { ".noTL", false, true, false, true }, { ".noBR", true, false, true, false }, { ".none", false, false, false, false } };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const auto& saoType : saoTypes )
+    {
+      const int typeIdx = saoType.typeIdx;
+      // the edge classes need flat areas, the samples take few values around mid-grey
+      std::shared_ptr<State> st = std::make_shared<State>();
+      st->src  = typeIdx == SAO_TYPE_BO ? xRandomPels( STRIDE * STRIDE, 0, ( 1 << bitDepth ) - 1, bitDepth * 8 + typeIdx )
+                                        : xRandomPels( STRIDE * STRIDE, 1 << ( bitDepth - 1 ), ( 1 << ( bitDepth - 1 ) ) + 3, bitDepth * 8 + typeIdx );
+      st->init = xRandomPels( STRIDE * STRIDE, 0, ( 1 << bitDepth ) - 1, bitDepth * 8 + typeIdx + 1 );
+
+      // offsets of the 4 edge classes or of 4 consecutive bands
+      const int maxOffset = 7 << ( bitDepth - 8 );
+      std::array<int, MAX_NUM_SAO_CLASSES> offset{};
+      if( typeIdx == SAO_TYPE_BO )
+      {
+        offset[ 9] = maxOffset;
+        offset[10] = -maxOffset;
+        offset[11] = 2;
+        offset[12] = -2;
+      }
+      else
+      {
+        offset[0] = maxOffset;
+        offset[1] = 2;
+        offset[3] = -2;
+        offset[4] = -maxOffset;
+      }
+
+      for( const auto& size : saoSizes )
+      {
+        for( const auto& avail : saoAvails )
+        {
+          // the band offsets do not depend on the neighbours, the missing neighbours are checked on full CTUs
+          if( avail.left + avail.right + avail.above + avail.below < 4 && ( typeIdx == SAO_TYPE_BO || size.width != BLOCK_SIZE ) )
+          {
+            continue;
+          }
+          for( const bool clip : { true, false } )
+          {
+#if !( JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER || JVET_W0066_CCSAO )
+            if( !clip )
+            {
+              continue;
+            }
+#endif
+            const int  width  = size.width;
+            const int  height = size.height;
+            const bool left   = avail.left;
+            const bool right  = avail.right;
+            const bool above  = avail.above;
+            const bool below  = avail.below;
+
+            BenchKernel kernel;
+            kernel.name     = std::string( saoType.name ) + avail.suffix + ( clip ? "" : ".noClip" );
+            kernel.width    = width;
+            kernel.height   = height;
+            kernel.bitDepth = bitDepth;
+            kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+            kernel.select   = [st]( const X86_VEXT vext ) { st->sao.reset( new BenchSampleAdaptiveOffset ); st->sao->initVext( vext, BLOCK_SIZE ); };
+            kernel.reset    = [st]() { st->dst = st->init; };
+            kernel.run      = [st, typeIdx, offset, bitDepth, width, height, left, right, above, below, clip]()
+            {
+              const ClpRng clpRng = xClpRng( bitDepth );
+              const int    pos    = BENCH_MARGIN * STRIDE + BENCH_MARGIN;
+              int          blkOffset[MAX_NUM_SAO_CLASSES];
+              int          horVirBndryPos[] = { -1, -1, -1 };
+              int          verVirBndryPos[] = { -1, -1, -1 };
+              std::copy( offset.begin(), offset.end(), blkOffset );
+              if( clip )
+              {
+                st->sao->offsetBlock( bitDepth, clpRng, typeIdx, blkOffset, st->src.data() + pos, st->dst.data() + pos, STRIDE, STRIDE, width, height,
+                                      left, right, above, below, above && left, above && right, below && left, below && right, false, horVirBndryPos, verVirBndryPos, 0, 0 );
+              }
+#if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER || JVET_W0066_CCSAO
+              else
+              {
+                st->sao->offsetBlockNoClip( bitDepth, clpRng, typeIdx, blkOffset, st->src.data() + pos, st->dst.data() + pos, STRIDE, STRIDE, width, height,
+                                            left, right, above, below, above && left, above && right, below && left, below && right
+#if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
+                                          , false, horVirBndryPos, verVirBndryPos, 0, 0
+#endif
+                                          );
+              }
+#endif
+            };
+            kernel.result   = [st]() { return xBlockResult( st->dst.data(), STRIDE, STRIDE, STRIDE ); };
+            m_kernels.push_back( kernel );
+          }
+        }
+      }
+    }
+
+#if JVET_W0066_CCSAO
+    // band classification of a luma and a chroma block from a luma candidate position (3x3 around the collocated luma
+    // sample, 4 is the collocated one); the positions left, right and below the collocated sample shrink the
+    // classified rectangle where the neighbour CTU is missing
+    static const struct
+    {
+      ChromaFormat chromaFormat;
+      const char*  name;
+      int          candPosY;
+      bool         missingNeighbour;
+      int          bandNumY;
+    } ccSaoCases[] = { { CHROMA_420, ".420.pos4",    4, false,  4 }, { CHROMA_420, ".420.pos4.b16", 4, false, 16 },
+                       { CHROMA_420, ".420.pos1",    1, false,  4 }, { CHROMA_420, ".420.pos3",     3, false,  4 },
+                       { CHROMA_420, ".420.pos3.nb", 3, true,   4 }, { CHROMA_420, ".420.pos5.nb",  5, true,   4 },
+                       { CHROMA_420, ".420.pos7.nb", 7, true,   4 }, { CHROMA_422, ".422.pos4",     4, false,  4 },
+                       { CHROMA_444, ".444.pos4",    4, false,  4 } };
+
+    for( const auto& ccSao : ccSaoCases )
+    {
+      for( const ComponentID compID : { COMPONENT_Y, COMPONENT_Cb } )
+      {
+        const ChromaFormat chromaFormat = ccSao.chromaFormat;
+        const int          candPosY     = ccSao.candPosY;
+        const int          bandNumY     = ccSao.bandNumY;
+        const int          width        = compID == COMPONENT_Y ? BLOCK_SIZE : BLOCK_SIZE >> getChannelTypeScaleX( CHANNEL_TYPE_CHROMA, chromaFormat );
+        const int          height       = compID == COMPONENT_Y ? BLOCK_SIZE : BLOCK_SIZE >> getChannelTypeScaleY( CHANNEL_TYPE_CHROMA, chromaFormat );
+        // the side of the candidate position is missing: left for 3, right for 5, below for 7
+        const bool         left         = !( ccSao.missingNeighbour && candPosY == 3 );
+        const bool         right        = !( ccSao.missingNeighbour && candPosY == 5 );
+        const bool         below        = !( ccSao.missingNeighbour && candPosY == 7 );
+
+        // luma, Cb and Cr planes
+        std::shared_ptr<State> st = std::make_shared<State>();
+        st->src  = xRandomPels( 3 * STRIDE * STRIDE, 0, ( 1 << bitDepth ) - 1, bitDepth * 8 + 5 + compID + candPosY * 3 );
+        st->init = xRandomPels( STRIDE * STRIDE, 0, ( 1 << bitDepth ) - 1, bitDepth * 8 + 7 + compID );
+
+        std::array<short, MAX_CCSAO_CLASS_NUM> offset;
+        for( int i = 0; i < MAX_CCSAO_CLASS_NUM; i++ )
+        {
+          offset[i] = short( ( i * 7 ) % 15 - 7 );
+        }
+
+        BenchKernel kernel;
+        kernel.name     = std::string( compID == COMPONENT_Y ? "CCSAO.bandLuma" : "CCSAO.bandChroma" ) + ccSao.name;
+        kernel.width    = width;
+        kernel.height   = height;
+        kernel.bitDepth = bitDepth;
+        kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+        kernel.select   = [st]( const X86_VEXT vext ) { st->sao.reset( new BenchSampleAdaptiveOffset ); st->sao->initVext( vext, BLOCK_SIZE ); };
+        kernel.reset    = [st]() { st->dst = st->init; };
+        kernel.run      = [st, compID, chromaFormat, candPosY, bandNumY, width, height, left, right, below, offset, bitDepth]()
+        {
+          const ClpRng clpRng = xClpRng( bitDepth );
+          const int    pos    = BENCH_MARGIN * STRIDE + BENCH_MARGIN;
+          const Pel*   srcY   = st->src.data() + pos;
+          const Pel*   srcU   = srcY + STRIDE * STRIDE;
+          const Pel*   srcV   = srcU + STRIDE * STRIDE;
+#if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
+          int          horVirBndryPos[] = { -1, -1, -1 };
+          int          verVirBndryPos[] = { -1, -1, -1 };
+#endif
+          // up to 16 luma bands by 2 bands of each chroma component, at most 64 classes
+          st->sao->offsetBlockCcSaoNoClip( compID, chromaFormat, bitDepth, clpRng, candPosY, bandNumY, 2, 2, offset.data(), srcY, srcU, srcV, st->dst.data() + pos,
+                                           STRIDE, STRIDE, STRIDE, STRIDE, width, height, left, right, true, below, left, right, below && left, below && right
+#if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
+                                         , false, horVirBndryPos, verVirBndryPos, 0, 0
+#endif
+                                         );
+        };
+        kernel.result   = [st]() { return xBlockResult( st->dst.data(), STRIDE, STRIDE, STRIDE ); };
+        m_kernels.push_back( kernel );
+      }
+    }
+#endif
+  }
+#endif
+}
+
+void KernelBench::xAddAdaptiveLoopFilterKernels()
+{
+#if ENABLE_SIMD_OPT_ALF && ALF_IMPROVEMENT && JVET_AE0139_ALF_IMPROVED_FIXFILTER && JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+  static const int ALF_MARGIN    = 16;  ///< covers the classification windows and the 13x13 fixed filter
+  static const int RESULT_PAD    = ALF_PADDING_SIZE_FIXED_RESULTS;
+  static const int FIXED_QP_IND  = 3;
+
+  struct State
+  {
+    std::unique_ptr<BenchAdaptiveLoopFilter> alf;
+    std::vector<Pel>                         src;
+    std::vector<Pel>                         srcBeforeDb;
+    std::vector<Pel>                         srcResi;
+    BenchPlanes<AlfClassifier>                    classes;     ///< scalar classification, input of the fixed filters
+    BenchPlanes<AlfClassifier>                    classified;  ///< output of the classification kernels
+    BenchPlanes<Pel>                              fixedResults;
+    BenchPlanes<Pel>                              resiResults;
+    std::array<short, NUM_CLASSES_FIX>       classIndFixed;
+    Pel                                      clippingValues[4];
+  };
+
+  for( const int bitDepth : g_benchBitDepths )
+  {
+    for( const int size : g_benchBlockSizes )
+    {
+      // the fixed filters are applied to 2x2 classes by 8 samples wide steps
+      if( size < 8 )
+      {
+        continue;
+      }
+
+      const int  srcStride = size + 2 * ALF_MARGIN;
+      const int  srcOffset = ALF_MARGIN * srcStride + ALF_MARGIN;
+      const Area blk( 0, 0, size, size );
+
+      std::shared_ptr<State> st = std::make_shared<State>();
+      st->src         = xRandomPels( srcStride * srcStride, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth );
+      st->srcBeforeDb = xRandomPels( srcStride * srcStride, 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 1 );
+      st->srcResi     = xRandomPels( srcStride * srcStride, -( 1 << ( bitDepth - 2 ) ), 1 << ( bitDepth - 2 ), size * 16 + bitDepth + 2 );
+      st->classes.create( NUM_CLASSIFIER, size, size );
+      st->classified.create( NUM_CLASSIFIER, size, size );
+      st->resiResults.create( EXT_LENGTH, size, size );
+
+      // the 13x13 filters take the output of the first 9x9 filter set, including its padding
+      st->fixedResults.create( EXT_LENGTH << 1, size + 2 * RESULT_PAD, size + 2 * RESULT_PAD );
+      const std::vector<Pel> fixedInit = xRandomPels( st->fixedResults.data.size(), 0, ( 1 << bitDepth ) - 1, size * 16 + bitDepth + 3 );
+      std::copy( fixedInit.begin(), fixedInit.end(), st->fixedResults.data.begin() );
+
+      // the class to filter mapping is generated with the fixed filter coefficients, spread the classes over all filters
+      for( int i = 0; i < NUM_CLASSES_FIX; i++ )
+      {
+        st->classIndFixed[i] = short( ( i * 7 ) % NUM_FIXED_FILTERS );
+      }
+      st->clippingValues[0] = 1 << bitDepth;
+      for( int i = 1; i < 4; i++ )
+      {
+        st->clippingValues[i] = 1 << ( 7 - 2 * i + bitDepth - 8 );
+      }
+
+      // the kernels are still the scalar ones at registration
+      BenchAdaptiveLoopFilter().classify( st->classes.planes.data(), CPelBuf( st->src.data() + srcOffset, srcStride, size, size ), blk, bitDepth );
+
+      BenchKernel kernel;
+      kernel.name     = "ALF.classify";
+      kernel.width    = size;
+      kernel.height   = size;
+      kernel.bitDepth = bitDepth;
+      kernel.vexts    = { SCALAR, SSE41, AVX, AVX2 };
+      kernel.select   = [st]( const X86_VEXT vext ) { st->alf.reset( new BenchAdaptiveLoopFilter ); st->alf->initVext( vext ); };
+      kernel.run      = [st, srcStride, srcOffset, size, blk, bitDepth]()
+      {
+        st->alf->classify( st->classified.planes.data(), CPelBuf( st->src.data() + srcOffset, srcStride, size, size ), blk, bitDepth );
+      };
+      kernel.result   = [st]()
+      {
+        return std::vector<int64_t>( st->classified.data.begin(), st->classified.data.end() );
+      };
+      m_kernels.push_back( kernel );
+
+      // the first 9x9 set writes the second output, the first one is the input of the 13x13 filters
+      for( const int dirWindSize : { 0, 1 } )
+      {
+        const int fixedFiltInd = dirWindSize == 0 ? 1 : EXT_LENGTH;
+
+        kernel.name   = dirWindSize == 0 ? "ALF.fixFilter9x9Db9" : "ALF.fixFilter13x13Db9";
+        kernel.run    = [st, srcStride, srcOffset, size, blk, bitDepth, dirWindSize, fixedFiltInd]()
+        {
+          const CPelBuf src( st->src.data() + srcOffset, srcStride, size, size );
+          const CPelBuf srcBeforeDb( st->srcBeforeDb.data() + srcOffset, srcStride, size, size );
+          ( dirWindSize == 0 ? st->alf->m_fixFilter9x9Db9Blk : st->alf->m_fixFilter13x13Db9Blk )( st->classes.planes[dirWindSize], src, blk, blk, srcBeforeDb, st->fixedResults.planes.data(), size,
+                                                                                                 fixedFiltInd, st->classIndFixed.data(), FIXED_QP_IND, dirWindSize, xClpRng( bitDepth ), st->clippingValues );
+        };
+        kernel.result = [st, size, fixedFiltInd]()
+        {
+          const int stride = st->fixedResults.stride;
+          return xBlockResult( st->fixedResults.planes[fixedFiltInd][0] + RESULT_PAD * stride + RESULT_PAD, stride, size, size );
+        };
+        m_kernels.push_back( kernel );
+      }
+
+#if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
+      kernel.name   = "ALF.filterResi9x9";
+      kernel.run    = [st, srcStride, srcOffset, size, blk, bitDepth]()
+      {
+        st->alf->m_filterResi9x9Blk( st->classes.planes[0], CPelBuf( st->srcResi.data() + srcOffset, srcStride, size, size ), blk, blk, st->resiResults.planes.data(), size, 0,
+                                     st->classIndFixed.data(), FIXED_QP_IND, 0, xClpRng( bitDepth ), st->clippingValues );
+      };
+      kernel.result = [st, size]() { return xBlockResult( st->resiResults.planes[0][0], size, size, size ); };
+      m_kernels.push_back( kernel );
+#endif
+    }
+  }
+#endif
+}
+
+//! \}
+
+#endif // ENABLE_SIMD_OPT && TARGET_SIMD_X86
@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBench.h
+    \brief    Micro-benchmark of the SIMD dispatched kernels (header)
+*/
+
+#ifndef __KERNELBENCH__
+#define __KERNELBENCH__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "CommonLib/CommonDef.h"
+
+//! \ingroup KernelBench
+//! \{
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// one kernel of one module at a fixed block size and bit depth
+struct BenchKernel
+{
+  std::string                         name;
+  int                                 width;
+  int                                 height;
+  int                                 bitDepth;
+  std::vector<X86_VEXT>               vexts;   ///< instantiated extensions of the module, SCALAR first
+  std::function<void( X86_VEXT )>     select;  ///< (re)builds the module with the function pointers of an extension
+  std::function<void()>               reset;   ///< restores the inputs of kernels working in place
+  std::function<void()>               run;     ///< one call of the kernel
+  std::function<std::vector<int64_t>()> result; ///< output of the last call, compared against the scalar one
+  bool                                approx = false; ///< SIMD kernel approximates the scalar one, differences are not counted
+};
+
+/// micro-benchmark driver: times every kernel for each extension up to the CPU's and checks it against SCALAR
+class KernelBench
+{
+public:
+  KernelBench( X86_VEXT maxVext, double minTimeMs, const std::string& filter );
+
+  void  registerKernels();
+  int   run();  ///< returns the number of kernels whose SIMD output differs from the scalar one
+
+  static const char* getVextName( X86_VEXT vext );
+
+private:
+  void  xAddInterpolationFilterKernels();
+  void  xAddBufferKernels();
+  void  xAddRdCostKernels();
+  void  xAddAffineGradientSearchKernels();
+  void  xAddIbcHashMapKernels();
+  void  xAddTrQuantKernels();
+  void  xAddIntraKernels();
+  void  xAddBilateralFilterKernels();
+  void  xAddLoopFilterKernels();
+  void  xAddSaoKernels();
+  void  xAddAdaptiveLoopFilterKernels();
+
+  void  xMeasure( BenchKernel& kernel, double& nsPerCall, double& cyclesPerCall );
+
+  X86_VEXT                 m_maxVext;
+  double                   m_minTimeMs;
+  std::string              m_filter;
+  std::vector<BenchKernel> m_kernels;
+};
+
+#endif // ENABLE_SIMD_OPT && TARGET_SIMD_X86
+
+//! \}
+
+#endif // __KERNELBENCH__
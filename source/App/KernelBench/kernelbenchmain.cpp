@@ -0,0 +1,132 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     kernelbenchmain.cpp
+    \brief    SIMD kernel micro-benchmark main
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include "KernelBench.h"
+#include "CommonLib/Rom.h"
+#include "Utilities/program_options_lite.h"
+
+namespace po = df::program_options_lite;
+
+//! \ingroup KernelBench
+//! \{
+
+// ====================================================================================================================
+// Main function
+// ====================================================================================================================
+
+int main( int argc, char* argv[] )
+{
+  // print information
+  fprintf( stdout, "\n" );
+  fprintf( stdout, "VVCSoftware: VTM Kernel Benchmark Version %s ", VTM_VERSION );
+  fprintf( stdout, NVM_ONOS );
+  fprintf( stdout, NVM_COMPILEDBY );
+  fprintf( stdout, NVM_BITS );
+  fprintf( stdout, "\n" );
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+  bool        doHelp = false;
+  std::string simd;
+  std::string filter;
+  double      minTimeMs = 0;
+
+  po::Options opts;
+  opts.addOptions()
+  ("help",     doHelp,    false,          "this help text")
+  ("SIMD",     simd,      std::string(""), "highest SIMD extension to benchmark (SSE41, SSE42, AVX, AVX2), default: highest supported by the CPU")
+  ("Kernel",   filter,    std::string(""), "only benchmark the kernels whose name contains this string, e.g. IF. or RdCost.SAD")
+  ("MinTime",  minTimeMs, 20.0,           "minimum measurement time in ms per kernel, block size and SIMD extension")
+  ;
+
+  po::setDefaults( opts );
+  po::ErrorReporter err;
+  po::scanArgv( opts, argc, ( const char** ) argv, err );
+  if( doHelp )
+  {
+    po::doHelp( std::cout, opts );
+    return EXIT_SUCCESS;
+  }
+  if( err.is_errored )
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the module constructors keep their scalar function pointers, the benchmark selects every extension explicitly
+  read_x86_extension_flags( "SCALAR" );
+
+  const X86_VEXT cpuVext = _get_x86_extensions();
+  X86_VEXT       maxVext = cpuVext;
+  if( !simd.empty() )
+  {
+    int vext = SCALAR;
+    while( vext <= AVX512 && simd != KernelBench::getVextName( X86_VEXT( vext ) ) )
+    {
+      vext++;
+    }
+    if( vext > AVX512 )
+    {
+      std::cerr << "Unknown SIMD extension: " << simd << std::endl;
+      return EXIT_FAILURE;
+    }
+    maxVext = std::min( X86_VEXT( vext ), cpuVext );
+  }
+  fprintf( stdout, "CPU: %s, benchmarking up to %s\n", KernelBench::getVextName( cpuVext ), KernelBench::getVextName( maxVext ) );
+
+  initROM();
+
+  KernelBench kernelBench( maxVext, minTimeMs, filter );
+  kernelBench.registerKernels();
+  const int numMismatches = kernelBench.run();
+
+  destroyROM();
+
+  if( numMismatches )
+  {
+    printf( "\n***ERROR*** %d SIMD kernel results differ from the scalar ones\n", numMismatches );
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+#else
+  printf( "KernelBench requires ENABLE_SIMD_OPT on an x86 target\n" );
+  return EXIT_FAILURE;
+#endif
+}
+
+//! \}
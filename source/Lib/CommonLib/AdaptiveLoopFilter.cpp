@@ -44,6 +44,13 @@
 #include <array>
 #include <cmath>
 
+#if ENABLE_PARALLEL_ALF
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
 constexpr int AdaptiveLoopFilter::AlfNumClippingValues[];
 
 AdaptiveLoopFilter::AdaptiveLoopFilter()
@@ -73,6 +80,9 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
       m_laplacianPtr[i][j] = m_laplacianData[i][j];
     }
   }
+#if ENABLE_PARALLEL_ALF
+  m_numThreads = 1;
+#endif
 
 #if ALF_IMPROVEMENT
   int ind = 0;
@@ -591,11 +601,6 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
   const PreCalcValues& pcv = *cs.pcv;
 
   int ctuIdx = 0;
-  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
-  int numHorVirBndry = 0, numVerVirBndry = 0;
-  int horVirBndryPos[] = { 0, 0, 0 };
-  int verVirBndryPos[] = { 0, 0, 0 };
-
 #if ALF_IMPROVEMENT
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
   int fixedFilterSetIdx = cs.slice->getTileGroupAlfFixedFilterSetIdx( COMPONENT_Y );
@@ -605,6 +610,18 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 #endif
 #endif
 
+#if ENABLE_PARALLEL_ALF
+  if( useParallelCtus( cs ) )
+  {
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+    filterCtusParallel( cs, fixedFilterSetIdx, fixedFilterSetIdxChroma );
+#else
+    filterCtusParallel( cs, fixedFilterSetIdx );
+#endif
+    return;
+  }
+#endif
+
   for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
     for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
@@ -629,345 +646,393 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
       }
       lastSliceIdx = cu->slice->getSliceID();
 
-      const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
-      const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
-      bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
-      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-      {
-        ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
-        if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+      filterCtu( cs, cu, xPos, yPos, ctuIdx, alfCtuFilterIndex
+#if ALF_IMPROVEMENT
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+               , fixedFilterSetIdx, fixedFilterSetIdxChroma
+#else
+               , fixedFilterSetIdx
+#endif
+               , m_laplacian
+#endif
+               );
+      ctuIdx++;
+    }
+#if ENABLE_FRAME_PARALLEL_DECODING
+    if( m_rowsFiltered )
+    {
+      m_rowsFiltered( ( yPos >> pcv.maxCUHeightLog2 ) + 1 );
+    }
+#endif
+  }
+}
+
+void AdaptiveLoopFilter::filterCtu( CodingStructure& cs, const CodingUnit* cu, const int xPos, const int yPos, const int ctuIdx, const short* alfCtuFilterIndex
+#if ALF_IMPROVEMENT
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+                                  , const int fixedFilterSetIdx, const int fixedFilterSetIdxChroma[2]
+#else
+                                  , const int fixedFilterSetIdx
+#endif
+                                  , uint32_t** laplacian[NUM_DIRECTIONS]
+#endif
+                                  )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  PelUnitBuf recYuv = cs.getRecoBuf();
+  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
+#if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
+  PelUnitBuf tmpYuvBeforeDb = m_tempBufBeforeDb.getBuf( cs.area );
+#endif
+#if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
+  PelUnitBuf tmpYuvResi = m_tempBufResi.getBuf( cs.area );
+#endif
+
+  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
+  int numHorVirBndry = 0, numVerVirBndry = 0;
+  int horVirBndryPos[] = { 0, 0, 0 };
+  int verVirBndryPos[] = { 0, 0, 0 };
+
+  const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
+  const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
+  bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
+  for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+  {
+    ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
+    if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+    {
+      ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
+    }
+  }
+  int rasterSliceAlfPad = 0;
+  if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+  {
+    int yStart = yPos;
+    for( int i = 0; i <= numHorVirBndry; i++ )
+    {
+      const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+      const int h = yEnd - yStart;
+      const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
+      const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
+      int xStart = xPos;
+      for( int j = 0; j <= numVerVirBndry; j++ )
+      {
+        const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+        const int w = xEnd - xStart;
+        const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
+        const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
+        const int wBuf = w + ( clipL ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipR ? 0 : MAX_ALF_PADDING_SIZE );
+        const int hBuf = h + ( clipT ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipB ? 0 : MAX_ALF_PADDING_SIZE );
+        PelUnitBuf buf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+        buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - ( clipL ? 0 : MAX_ALF_PADDING_SIZE ), yStart - ( clipT ? 0 : MAX_ALF_PADDING_SIZE ), wBuf, hBuf ) ) ) );
+        // pad top-left unavailable samples for raster slice
+        if( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
         {
-          ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
+          buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
         }
-      }
-      int rasterSliceAlfPad = 0;
-      if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
-      {
-        int yStart = yPos;
-        for( int i = 0; i <= numHorVirBndry; i++ )
-        {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
-          const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
-          int xStart = xPos;
-          for( int j = 0; j <= numVerVirBndry; j++ )
-          {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
-            const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
-            const int wBuf = w + ( clipL ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipR ? 0 : MAX_ALF_PADDING_SIZE );
-            const int hBuf = h + ( clipT ? 0 : MAX_ALF_PADDING_SIZE ) + ( clipB ? 0 : MAX_ALF_PADDING_SIZE );
-            PelUnitBuf buf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-            buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - ( clipL ? 0 : MAX_ALF_PADDING_SIZE ), yStart - ( clipT ? 0 : MAX_ALF_PADDING_SIZE ), wBuf, hBuf ) ) ) );
-            // pad top-left unavailable samples for raster slice
-            if( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-            {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
-            }
 
-            // pad bottom-right unavailable samples for raster slice
-            if( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-            {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
-            }
+        // pad bottom-right unavailable samples for raster slice
+        if( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+        {
+          buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
+        }
 #if JVET_AA0095_ALF_LONGER_FILTER 
-            mirroredPaddingForAlf(cs, buf, MAX_ALF_PADDING_SIZE, true, true);
+        mirroredPaddingForAlf(cs, buf, MAX_ALF_PADDING_SIZE, true, true);
 #else
-            buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
+        buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
 #endif
-            buf = buf.subBuf( UnitArea( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+        buf = buf.subBuf( UnitArea( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
 
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
 #if JVET_AF0197_LUMA_RESIDUAL_TAP_IN_CCALF
-            PelUnitBuf bufResi = m_tempBufResi2.subBuf(UnitArea(CHROMA_400, Area(0, 0, wBuf, hBuf)));
-            bufResi.copyFrom(tmpYuvResi.subBuf(UnitArea(CHROMA_400, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
+        PelUnitBuf bufResi = m_tempBufResi2.subBuf(UnitArea(CHROMA_400, Area(0, 0, wBuf, hBuf)));
+        bufResi.copyFrom(tmpYuvResi.subBuf(UnitArea(CHROMA_400, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
 #else
-            PelUnitBuf bufResi = m_tempBufResi2.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
-            bufResi.copyFrom(tmpYuvResi.subBuf(UnitArea(cs.area.chromaFormat, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
+        PelUnitBuf bufResi = m_tempBufResi2.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
+        bufResi.copyFrom(tmpYuvResi.subBuf(UnitArea(cs.area.chromaFormat, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
 #endif
-            // pad top-left unavailable samples for raster slice
-            if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
-            {
-              bufResi.padBorderPel(MAX_ALF_PADDING_SIZE, 1);
-            }
+        // pad top-left unavailable samples for raster slice
+        if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
+        {
+          bufResi.padBorderPel(MAX_ALF_PADDING_SIZE, 1);
+        }
 
-            // pad bottom-right unavailable samples for raster slice
-            if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
-            {
-              bufResi.padBorderPel(MAX_ALF_PADDING_SIZE, 2);
-            }
+        // pad bottom-right unavailable samples for raster slice
+        if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
+        {
+          bufResi.padBorderPel(MAX_ALF_PADDING_SIZE, 2);
+        }
 #if JVET_AA0095_ALF_LONGER_FILTER
-            mirroredPaddingForAlf(cs, bufResi, MAX_ALF_PADDING_SIZE, true, false);
+        mirroredPaddingForAlf(cs, bufResi, MAX_ALF_PADDING_SIZE, true, false);
 #else
-            bufResi.extendBorderPel(MAX_ALF_PADDING_SIZE);
+        bufResi.extendBorderPel(MAX_ALF_PADDING_SIZE);
 #endif
-            bufResi = bufResi.subBuf(UnitArea(cs.area.chromaFormat, Area(clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h)));
+        bufResi = bufResi.subBuf(UnitArea(cs.area.chromaFormat, Area(clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h)));
 #endif
 
-            if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
-            {
-              const Area blkSrc( 0, 0, w, h );
-              const Area blkDst( xStart, yStart, w, h );
-              short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+        if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+        {
+          const Area blkSrc( 0, 0, w, h );
+          const Area blkDst( xStart, yStart, w, h );
+          short filterSetIndex = alfCtuFilterIndex[ctuIdx];
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
-              PelUnitBuf bufDb = m_tempBufBeforeDb2.subBuf(UnitArea(CHROMA_400, Area(0, 0, wBuf, hBuf)));
-              bufDb.copyFrom(m_tempBufBeforeDb.subBuf(UnitArea(CHROMA_400, Area(xStart - (clipL ? 0 : NUM_DB_PAD), yStart - (clipT ? 0 : NUM_DB_PAD), wBuf, hBuf))));
-              // pad top-left unavailable samples for raster slice
-              if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
-              {
-                bufDb.padBorderPel(NUM_DB_PAD, 1);
-              }
-              // pad bottom-right unavailable samples for raster slice
-              if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
-              {
-                bufDb.padBorderPel(NUM_DB_PAD, 2);
-              }
-              bufDb.extendBorderPel(NUM_DB_PAD);
-              bufDb = bufDb.subBuf(UnitArea(CHROMA_400, Area(clipL ? 0 : NUM_DB_PAD, clipT ? 0 : NUM_DB_PAD, w, h)));
+          PelUnitBuf bufDb = m_tempBufBeforeDb2.subBuf(UnitArea(CHROMA_400, Area(0, 0, wBuf, hBuf)));
+          bufDb.copyFrom(m_tempBufBeforeDb.subBuf(UnitArea(CHROMA_400, Area(xStart - (clipL ? 0 : NUM_DB_PAD), yStart - (clipT ? 0 : NUM_DB_PAD), wBuf, hBuf))));
+          // pad top-left unavailable samples for raster slice
+          if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
+          {
+            bufDb.padBorderPel(NUM_DB_PAD, 1);
+          }
+          // pad bottom-right unavailable samples for raster slice
+          if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
+          {
+            bufDb.padBorderPel(NUM_DB_PAD, 2);
+          }
+          bufDb.extendBorderPel(NUM_DB_PAD);
+          bufDb = bufDb.subBuf(UnitArea(CHROMA_400, Area(clipL ? 0 : NUM_DB_PAD, clipT ? 0 : NUM_DB_PAD, w, h)));
 #endif
 #if JVET_X0071_ALF_BAND_CLASSIFIER
-              deriveClassification( m_classifier, buf.get(COMPONENT_Y), 
+          deriveClassification( m_classifier, buf.get(COMPONENT_Y), 
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
-                m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS] == ALF_FILTER_13_EXT_DB_RESI, bufResi.get(COMPONENT_Y),
+            m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS] == ALF_FILTER_13_EXT_DB_RESI, bufResi.get(COMPONENT_Y),
 #endif
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
-                bufDb.get(COMPONENT_Y), 0,
+            bufDb.get(COMPONENT_Y), 0,
 #endif
-                blkDst, blkSrc, cs, 
+            blkDst, blkSrc, cs, 
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
-                -1,
+            -1,
 #else
-                filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1, 
+            filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1, 
 #endif
-                filterSetIndex < NUM_FIXED_FILTER_SETS ? -1 : m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][m_ctuAlternative[COMPONENT_Y][ctuIdx]] );
+            filterSetIndex < NUM_FIXED_FILTER_SETS ? -1 : m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][m_ctuAlternative[COMPONENT_Y][ctuIdx]], laplacian );
 #else
-              deriveClassification( m_classifier, buf.get( COMPONENT_Y ), blkDst, blkSrc 
+          deriveClassification( m_classifier, buf.get( COMPONENT_Y ), blkDst, blkSrc 
 #if ALF_IMPROVEMENT
-              , cs, filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1
+          , cs, filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1
 #endif
-              );
+          );
 #endif
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-              paddingFixedFilterResultsCtu( m_fixFilterResult[COMPONENT_Y], m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 0 );
-              if( filterSetIndex != 0 )
-              {
-                deriveFixedFilterResults( m_classifier, buf.get(COMPONENT_Y), bufDb.get(COMPONENT_Y), blkDst, blkSrc, cs, 1, fixedFilterSetIdx );
-                paddingFixedFilterResultsCtu( m_fixFilterResult[COMPONENT_Y], m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 1 );
-              }
+          paddingFixedFilterResultsCtu( m_fixFilterResult[COMPONENT_Y], m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 0 );
+          if( filterSetIndex != 0 )
+          {
+            deriveFixedFilterResults( m_classifier, buf.get(COMPONENT_Y), bufDb.get(COMPONENT_Y), blkDst, blkSrc, cs, 1, fixedFilterSetIdx );
+            paddingFixedFilterResultsCtu( m_fixFilterResult[COMPONENT_Y], m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 1 );
+          }
 #else
-              paddingFixedFilterResultsCtu( m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 0 );
-              if( filterSetIndex != 0 )
-              {
-                deriveFixedFilterResults( m_classifier, buf.get(COMPONENT_Y), bufDb.get(COMPONENT_Y), blkDst, blkSrc, cs, 1, fixedFilterSetIdx );
-                paddingFixedFilterResultsCtu( m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 1 );
-              }
+          paddingFixedFilterResultsCtu( m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 0 );
+          if( filterSetIndex != 0 )
+          {
+            deriveFixedFilterResults( m_classifier, buf.get(COMPONENT_Y), bufDb.get(COMPONENT_Y), blkDst, blkSrc, cs, 1, fixedFilterSetIdx );
+            paddingFixedFilterResultsCtu( m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst, 1 );
+          }
 #endif
 #endif
-              short *coeff;
+          short *coeff;
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-              Pel *clip;
+          Pel *clip;
 #else
-              short *clip;
+          short *clip;
 #endif
 #if ALF_IMPROVEMENT
-              if( filterSetIndex < NUM_FIXED_FILTER_SETS )
-              {
+          if( filterSetIndex < NUM_FIXED_FILTER_SETS )
+          {
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-                copyFixedFilterResults(recYuv, blkDst, COMPONENT_Y, m_fixFilterResult[COMPONENT_Y], fixedFilterSetIdx, filterSetIndex);
+            copyFixedFilterResults(recYuv, blkDst, COMPONENT_Y, m_fixFilterResult[COMPONENT_Y], fixedFilterSetIdx, filterSetIndex);
 #else
-                copyFixedFilterResults(recYuv, blkDst, COMPONENT_Y, m_fixFilterResult, fixedFilterSetIdx, filterSetIndex);
+            copyFixedFilterResults(recYuv, blkDst, COMPONENT_Y, m_fixFilterResult, fixedFilterSetIdx, filterSetIndex);
 #endif
-              }
-              else
-              {
-                uint8_t alt_num = m_ctuAlternative[COMPONENT_Y][ctuIdx];
+          }
+          else
+          {
+            uint8_t alt_num = m_ctuAlternative[COMPONENT_Y][ctuIdx];
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-                char coeffBits = m_coeffBitsApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+            char coeffBits = m_coeffBitsApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
 #endif
-                coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
-                clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
-                AlfFilterType filterTypeCtb = m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+            clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+            AlfFilterType filterTypeCtb = m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
 #if !JVET_AE0139_ALF_IMPROVED_FIXFILTER
-                if( m_isFixedFilterPaddedPerCtu )
-                {
-                  paddingFixedFilterResultsCtu(m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst);
-                }
+            if( m_isFixedFilterPaddedPerCtu )
+            {
+              paddingFixedFilterResultsCtu(m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blkDst);
+            }
 #endif
-                m_ctuEnableOnlineLumaFlag[ctuIdx] = numFixedFilters(filterTypeCtb) > 1 ? true : false;
+            m_ctuEnableOnlineLumaFlag[ctuIdx] = numFixedFilters(filterTypeCtb) > 1 ? true : false;
 #endif
 #if JVET_X0071_ALF_BAND_CLASSIFIER
-                int classifierIdx = m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+            int classifierIdx = m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
-                PelUnitBuf bufDb = m_tempBufBeforeDb2.subBuf( UnitArea( CHROMA_400, Area( 0, 0, wBuf, hBuf ) ) );
+            PelUnitBuf bufDb = m_tempBufBeforeDb2.subBuf( UnitArea( CHROMA_400, Area( 0, 0, wBuf, hBuf ) ) );
 #if JVET_AA0095_ALF_LONGER_FILTER
-                if( filterTypeCtb == ALF_FILTER_9_EXT_DB || filterTypeCtb == ALF_FILTER_13_EXT_DB
+            if( filterTypeCtb == ALF_FILTER_9_EXT_DB || filterTypeCtb == ALF_FILTER_13_EXT_DB
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
-                    || filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI || filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI_DIRECT
-#endif
-                  )
-#else
-                if( filterTypeCtb == ALF_FILTER_9_EXT_DB )
-#endif
-                {
-                  bufDb.copyFrom(m_tempBufBeforeDb.subBuf( UnitArea( CHROMA_400, Area( xStart - ( clipL ? 0 : NUM_DB_PAD ), yStart - ( clipT ? 0 : NUM_DB_PAD ), wBuf, hBuf ) ) ) );
-                  // pad top-left unavailable samples for raster slice
-                  if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-                  {
-                    bufDb.padBorderPel( NUM_DB_PAD, 1 );
-                  }
-                  // pad bottom-right unavailable samples for raster slice
-                  if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-                  {
-                    bufDb.padBorderPel( NUM_DB_PAD, 2 );
-                  }
+                || filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI || filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI_DIRECT
+#endif
+              )
+#else
+            if( filterTypeCtb == ALF_FILTER_9_EXT_DB )
+#endif
+            {
+              bufDb.copyFrom(m_tempBufBeforeDb.subBuf( UnitArea( CHROMA_400, Area( xStart - ( clipL ? 0 : NUM_DB_PAD ), yStart - ( clipT ? 0 : NUM_DB_PAD ), wBuf, hBuf ) ) ) );
+              // pad top-left unavailable samples for raster slice
+              if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
+              {
+                bufDb.padBorderPel( NUM_DB_PAD, 1 );
+              }
+              // pad bottom-right unavailable samples for raster slice
+              if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+              {
+                bufDb.padBorderPel( NUM_DB_PAD, 2 );
+              }
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
-                  mirroredPaddingForAlf( cs, bufDb, NUM_DB_PAD, true, false );
+              mirroredPaddingForAlf( cs, bufDb, NUM_DB_PAD, true, false );
 #else
-                  bufDb.extendBorderPel( NUM_DB_PAD );
+              bufDb.extendBorderPel( NUM_DB_PAD );
 #endif
-                  bufDb = bufDb.subBuf( UnitArea( CHROMA_400, Area( clipL ? 0 : NUM_DB_PAD, clipT ? 0 : NUM_DB_PAD, w, h ) ) );
-                }
+              bufDb = bufDb.subBuf( UnitArea( CHROMA_400, Area( clipL ? 0 : NUM_DB_PAD, clipT ? 0 : NUM_DB_PAD, w, h ) ) );
+            }
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
-                PelUnitBuf bufResi = m_tempBufResi2.subBuf(UnitArea(CHROMA_400, Area(0, 0, wBuf, hBuf)));
-                if (filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI || filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI_DIRECT
+            PelUnitBuf bufResi = m_tempBufResi2.subBuf(UnitArea(CHROMA_400, Area(0, 0, wBuf, hBuf)));
+            if (filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI || filterTypeCtb == ALF_FILTER_13_EXT_DB_RESI_DIRECT
 #if JVET_AD0222_ALF_RESI_CLASS
-                    || classifierIdx == 2
-#endif
-                  )
-                {
-                  bufResi.copyFrom( m_tempBufResi.subBuf(UnitArea(CHROMA_400, Area(xStart - (clipL ? 0 : NUM_RESI_PAD), yStart - (clipT ? 0 : NUM_RESI_PAD), wBuf, hBuf))));
-                  // pad top-left unavailable samples for raster slice
-                  if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
-                  {
-                    bufResi.padBorderPel(NUM_RESI_PAD, 1);
-                  }
-                  // pad bottom-right unavailable samples for raster slice
-                  if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
-                  {
-                    bufResi.padBorderPel(NUM_RESI_PAD, 2);
-                  }
-                  bufResi.extendBorderPel(NUM_RESI_PAD);
-                  bufResi = bufResi.subBuf(UnitArea(CHROMA_400, Area(clipL ? 0 : NUM_RESI_PAD, clipT ? 0 : NUM_RESI_PAD, w, h)));
-                }
+                || classifierIdx == 2
+#endif
+              )
+            {
+              bufResi.copyFrom( m_tempBufResi.subBuf(UnitArea(CHROMA_400, Area(xStart - (clipL ? 0 : NUM_RESI_PAD), yStart - (clipT ? 0 : NUM_RESI_PAD), wBuf, hBuf))));
+              // pad top-left unavailable samples for raster slice
+              if (xStart == xPos && yStart == yPos && (rasterSliceAlfPad & 1))
+              {
+                bufResi.padBorderPel(NUM_RESI_PAD, 1);
+              }
+              // pad bottom-right unavailable samples for raster slice
+              if (xEnd == xPos + width && yEnd == yPos + height && (rasterSliceAlfPad & 2))
+              {
+                bufResi.padBorderPel(NUM_RESI_PAD, 2);
+              }
+              bufResi.extendBorderPel(NUM_RESI_PAD);
+              bufResi = bufResi.subBuf(UnitArea(CHROMA_400, Area(clipL ? 0 : NUM_RESI_PAD, clipT ? 0 : NUM_RESI_PAD, w, h)));
+            }
 #endif
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
-                deriveGaussResults( bufDb.get(COMPONENT_Y), blkDst, blkSrc, cs, 0, 0 );
-                if( m_isFixedFilterPaddedPerCtu )
-                {
-                  for(int gaussIdx = 0; gaussIdx < NUM_GAUSS_FILTERED_SOURCE; gaussIdx++)
-                  {
-                    paddingGaussResultsCtu(m_gaussPic, m_gaussCtu, gaussIdx, blkDst);
-                  }
-                }
+            deriveGaussResults( bufDb.get(COMPONENT_Y), blkDst, blkSrc, cs, 0, 0 );
+            if( m_isFixedFilterPaddedPerCtu )
+            {
+              for(int gaussIdx = 0; gaussIdx < NUM_GAUSS_FILTERED_SOURCE; gaussIdx++)
+              {
+                paddingGaussResultsCtu(m_gaussPic, m_gaussCtu, gaussIdx, blkDst);
+              }
+            }
 #endif
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-                alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
+            alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
 #else
-                alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
+            alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
 #endif
 #else
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-                alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
+            alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
 #else
-                alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
+            alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
 #endif
 #endif
 #else
-                alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y,  coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu);
+            alfFiltering(m_classifier[classifierIdx], recYuv, bufDb, bufResi, buf, blkDst, blkSrc, COMPONENT_Y,  coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu);
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier[classifierIdx], recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+            alfFiltering( m_classifier[classifierIdx], recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-                alfFiltering( m_classifier[classifierIdx], recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+            alfFiltering( m_classifier[classifierIdx], recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier[classifierIdx], recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+            alfFiltering( m_classifier[classifierIdx], recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-                alfFiltering( m_classifier[classifierIdx], recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+            alfFiltering( m_classifier[classifierIdx], recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #endif
 #else
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier, recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+            alfFiltering( m_classifier, recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-                alfFiltering( m_classifier, recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+            alfFiltering( m_classifier, recYuv, bufDb, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+            alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-                alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+            alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #endif
 #endif
-              }
+          }
 #else
-              if( filterSetIndex >= NUM_FIXED_FILTER_SETS )
-              {
-                coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-                clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-              }
-              else
-              {
-                coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-                clip = m_clipDefault;
-              }
-              m_filter7x7Blk( m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos );
-#endif
+          if( filterSetIndex >= NUM_FIXED_FILTER_SETS )
+          {
+            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+            clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+          }
+          else
+          {
+            coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+            clip = m_clipDefault;
           }
+          m_filter7x7Blk( m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos );
+#endif
+      }
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-            if( m_ctuEnableFlag[COMPONENT_Cb][ctuIdx] || m_ctuEnableFlag[COMPONENT_Cr][ctuIdx] )
+        if( m_ctuEnableFlag[COMPONENT_Cb][ctuIdx] || m_ctuEnableFlag[COMPONENT_Cr][ctuIdx] )
+        {
+          PelUnitBuf bufDb = m_tempBufBeforeDb2.subBuf( UnitArea( m_chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+          bufDb.copyFrom(m_tempBufBeforeDb.subBuf( UnitArea( m_chromaFormat, Area( xStart - ( clipL ? 0 : NUM_DB_PAD ), yStart - ( clipT ? 0 : NUM_DB_PAD ), wBuf, hBuf ) ) ) );
+          // pad top-left unavailable samples for raster slice
+          if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
+          {
+            bufDb.padBorderPel( NUM_DB_PAD, 1 );
+          }
+          // pad bottom-right unavailable samples for raster slice
+          if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+          {
+            bufDb.padBorderPel( NUM_DB_PAD, 2 );
+          }
+          mirroredPaddingForAlf( cs, bufDb, NUM_DB_PAD, false, true );
+          bufDb = bufDb.subBuf( UnitArea( m_chromaFormat, Area( clipL ? 0 : NUM_DB_PAD, clipT ? 0 : NUM_DB_PAD, w, h ) ) );
+          for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+          {
+            ComponentID compID = ComponentID( compIdx );
+            const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+            const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+            if( m_ctuEnableFlag[compIdx][ctuIdx] )
             {
-              PelUnitBuf bufDb = m_tempBufBeforeDb2.subBuf( UnitArea( m_chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-              bufDb.copyFrom(m_tempBufBeforeDb.subBuf( UnitArea( m_chromaFormat, Area( xStart - ( clipL ? 0 : NUM_DB_PAD ), yStart - ( clipT ? 0 : NUM_DB_PAD ), wBuf, hBuf ) ) ) );
-              // pad top-left unavailable samples for raster slice
-              if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-              {
-                bufDb.padBorderPel( NUM_DB_PAD, 1 );
-              }
-              // pad bottom-right unavailable samples for raster slice
-              if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-              {
-                bufDb.padBorderPel( NUM_DB_PAD, 2 );
-              }
-              mirroredPaddingForAlf( cs, bufDb, NUM_DB_PAD, false, true );
-              bufDb = bufDb.subBuf( UnitArea( m_chromaFormat, Area( clipL ? 0 : NUM_DB_PAD, clipT ? 0 : NUM_DB_PAD, w, h ) ) );
-              for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-              {
-                ComponentID compID = ComponentID( compIdx );
-                const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-                const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
-                if( m_ctuEnableFlag[compIdx][ctuIdx] )
-                {
-                  const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
-                  const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
-                  deriveFixedFilterChroma(m_classifier, buf, bufDb, blkSrc, blkDst, cs, fixedFilterSetIdxChroma[compIdx - 1], compID);
-                }
-              }              
+              const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
+              const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
+              deriveFixedFilterChroma(m_classifier, buf, bufDb, blkSrc, blkDst, cs, fixedFilterSetIdxChroma[compIdx - 1], compID, laplacian);
             }
+          }              
+        }
 #endif
-            for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-            {
-              ComponentID compID = ComponentID( compIdx );
-              const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-              const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+        for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+        {
+          ComponentID compID = ComponentID( compIdx );
+          const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+          const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
 
-              if( m_ctuEnableFlag[compIdx][ctuIdx] )
-              {
-                const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
-                const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
-                uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+          if( m_ctuEnableFlag[compIdx][ctuIdx] )
+          {
+            const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
+            const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
+            uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
 #if ALF_IMPROVEMENT
 #if JVET_X0071_ALF_BAND_CLASSIFIER
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
@@ -975,269 +1040,269 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-                alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], nullptr, fixedFilterSetIdxChroma[compIdx - 1], nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
+            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], nullptr, fixedFilterSetIdxChroma[compIdx - 1], nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
 #else
-                alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], nullptr, fixedFilterSetIdxChroma[compIdx - 1], nullptr, false, m_gaussPic, m_gaussCtu);
+            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], nullptr, fixedFilterSetIdxChroma[compIdx - 1], nullptr, false, m_gaussPic, m_gaussCtu);
 #endif
 #else
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-                alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
+            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
 #else                
-                alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu);
+            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu);
 #endif
 #endif
 #else
-                alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false);
+            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false);
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
+            alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
 #else
-                alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
+            alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
 #endif
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier[0], recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
+            alfFiltering( m_classifier[0], recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
 #else
-                alfFiltering( m_classifier[0], recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
+            alfFiltering( m_classifier[0], recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
 #endif
 #endif
 #else
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
+            alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
 #else
-                alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
+            alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-                alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
+            alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1, nullptr, false );
 #else
-                alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
+            alfFiltering( m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, -1 );
 #endif
 #endif
 #endif
 #else
-                m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight, m_alfVBChmaPos );
+            m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight, m_alfVBChmaPos );
 #endif
-              }
-              if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-              {
-                const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
+          }
+          if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+          {
+            const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
-                if (filterIdx != 0)
-                {
-                  const Area blkSrc(0, 0, w, h);
-                  Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
+            if (filterIdx != 0)
+            {
+              const Area blkSrc(0, 0, w, h);
+              Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
 
-                  const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
+              const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 #if ALF_IMPROVEMENT
 #if JVET_AF0197_LUMA_RESIDUAL_TAP_IN_CCALF
-                  m_filterCcAlf( recYuv.get( compID ), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, bufResi, m_alfClippingValues[CHANNEL_TYPE_LUMA] );
+              m_filterCcAlf( recYuv.get( compID ), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, bufResi, m_alfClippingValues[CHANNEL_TYPE_LUMA] );
 #else
-                  m_filterCcAlf( recYuv.get( compID ), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs );
+              m_filterCcAlf( recYuv.get( compID ), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs );
 #endif
 #else
-                  m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+              m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
 #endif
-                }
-              }
             }
-
-            xStart = xEnd;
           }
-
-          yStart = yEnd;
         }
+
+        xStart = xEnd;
       }
-      else
-      {
-        const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
-        if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
-        {
-          Area blk( xPos, yPos, width, height );
-          short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+
+      yStart = yEnd;
+    }
+  }
+  else
+  {
+    const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+    if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+    {
+      Area blk( xPos, yPos, width, height );
+      short filterSetIndex = alfCtuFilterIndex[ctuIdx];
 #if JVET_X0071_ALF_BAND_CLASSIFIER
-          deriveClassification( m_classifier, tmpYuv.get(COMPONENT_Y), 
+      deriveClassification( m_classifier, tmpYuv.get(COMPONENT_Y), 
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
-            m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS] == ALF_FILTER_13_EXT_DB_RESI, tmpYuvResi.get(COMPONENT_Y),
+        m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS] == ALF_FILTER_13_EXT_DB_RESI, tmpYuvResi.get(COMPONENT_Y),
 #endif
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
-            tmpYuvBeforeDb.get( COMPONENT_Y ), m_ctuPadFlag[ctuIdx],
+        tmpYuvBeforeDb.get( COMPONENT_Y ), m_ctuPadFlag[ctuIdx],
 #endif
-            blk, blk, cs,
+        blk, blk, cs,
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
-            - 1,
+        - 1,
 #else
-            filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1, 
+        filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1, 
 #endif
-            filterSetIndex < NUM_FIXED_FILTER_SETS ? -1 : m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][m_ctuAlternative[COMPONENT_Y][ctuIdx]] );
+        filterSetIndex < NUM_FIXED_FILTER_SETS ? -1 : m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][m_ctuAlternative[COMPONENT_Y][ctuIdx]], laplacian );
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
-          if( filterSetIndex != 0 )
-          {
+      if( filterSetIndex != 0 )
+      {
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-            deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult[COMPONENT_Y], tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, m_laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 0 );
+        deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult[COMPONENT_Y], tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 0 );
 #else
-            deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult, tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, m_laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 0 );
+        deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult, tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 0 );
 #endif
-            deriveFixedFilterResults( m_classifier, tmpYuv.get( COMPONENT_Y ), m_tempBufBeforeDb.get( COMPONENT_Y ), blk, blk, cs, 1, fixedFilterSetIdx );
+        deriveFixedFilterResults( m_classifier, tmpYuv.get( COMPONENT_Y ), m_tempBufBeforeDb.get( COMPONENT_Y ), blk, blk, cs, 1, fixedFilterSetIdx );
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-            deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult[COMPONENT_Y], tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, m_laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 1 );
+        deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult[COMPONENT_Y], tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 1 );
 #else
-            deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult, tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, m_laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 1 );
+        deriveFixedFilterResultsCtuBoundary( m_classifier, m_fixFilterResult, tmpYuv.get( COMPONENT_Y ), tmpYuvBeforeDb.get( COMPONENT_Y ), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 1 );
 #endif
-        }
+    }
 #endif
 #else
-          deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk 
+      deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk 
 #if ALF_IMPROVEMENT
-            , cs, filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1
+        , cs, filterSetIndex < NUM_FIXED_FILTER_SETS ? filterSetIndex : -1
 #endif
-          );      
+      );      
 #endif
-          short *coeff;
+      short *coeff;
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-          Pel *clip;
+      Pel *clip;
 #else
-          short *clip;
+      short *clip;
 #endif
 #if ALF_IMPROVEMENT
-          if( filterSetIndex < NUM_FIXED_FILTER_SETS )
-          {
+      if( filterSetIndex < NUM_FIXED_FILTER_SETS )
+      {
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-            copyFixedFilterResults( recYuv, blk, COMPONENT_Y, m_fixFilterResult[COMPONENT_Y], fixedFilterSetIdx, filterSetIndex );
+        copyFixedFilterResults( recYuv, blk, COMPONENT_Y, m_fixFilterResult[COMPONENT_Y], fixedFilterSetIdx, filterSetIndex );
 #else
-            copyFixedFilterResults( recYuv, blk, COMPONENT_Y, m_fixFilterResult, fixedFilterSetIdx, filterSetIndex );
+        copyFixedFilterResults( recYuv, blk, COMPONENT_Y, m_fixFilterResult, fixedFilterSetIdx, filterSetIndex );
 #endif
-          }
-          else
-          {
-            uint8_t alt_num = m_ctuAlternative[COMPONENT_Y][ctuIdx];
-            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
-            clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
-            AlfFilterType filterTypeCtb = m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+      }
+      else
+      {
+        uint8_t alt_num = m_ctuAlternative[COMPONENT_Y][ctuIdx];
+        coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+        clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+        AlfFilterType filterTypeCtb = m_filterTypeApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            if( m_isFixedFilterPaddedPerCtu )
-            {
+        if( m_isFixedFilterPaddedPerCtu )
+        {
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-              paddingFixedFilterResultsCtu(m_fixFilterResult[COMPONENT_Y], m_fixedFilterResultPerCtu, fixedFilterSetIdx, blk, 1);
+          paddingFixedFilterResultsCtu(m_fixFilterResult[COMPONENT_Y], m_fixedFilterResultPerCtu, fixedFilterSetIdx, blk, 1);
 #else
-              paddingFixedFilterResultsCtu(m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blk, 1);
+          paddingFixedFilterResultsCtu(m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blk, 1);
 #endif
 #else
-              paddingFixedFilterResultsCtu(m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blk);
+          paddingFixedFilterResultsCtu(m_fixFilterResult, m_fixedFilterResultPerCtu, fixedFilterSetIdx, blk);
 #endif
-            }
-            else
-            {
+        }
+        else
+        {
 #if JVET_X0071_ALF_BAND_CLASSIFIER
 #if !JVET_AE0139_ALF_IMPROVED_FIXFILTER
-              deriveFixedFilterResultsCtuBoundary(m_classifier[0], m_fixFilterResult, tmpYuv.get(COMPONENT_Y), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, m_laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx);
+          deriveFixedFilterResultsCtuBoundary(m_classifier[0], m_fixFilterResult, tmpYuv.get(COMPONENT_Y), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx);
 #endif
 #else
-              deriveFixedFilterResultsCtuBoundary(m_classifier, m_fixFilterResult, tmpYuv.get(COMPONENT_Y), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, m_laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx);
+          deriveFixedFilterResultsCtuBoundary(m_classifier, m_fixFilterResult, tmpYuv.get(COMPONENT_Y), blk, m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), fixedFilterSetIdx, m_mappingDir, laplacian, m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx);
 #endif
-            }
-            m_ctuEnableOnlineLumaFlag[ctuIdx] = numFixedFilters(filterTypeCtb) > 1 ? true : false;
+        }
+        m_ctuEnableOnlineLumaFlag[ctuIdx] = numFixedFilters(filterTypeCtb) > 1 ? true : false;
 #endif
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
-            deriveGaussResults( tmpYuvBeforeDb.get(COMPONENT_Y), blk, blk, cs, 0, 0 );
-            if( m_isFixedFilterPaddedPerCtu )
-            {
-              for(int gaussIdx = 0; gaussIdx < NUM_GAUSS_FILTERED_SOURCE; gaussIdx++)
-              {
-                paddingGaussResultsCtu(m_gaussPic, m_gaussCtu, gaussIdx, blk);
-              }
-            }
-            else
-            {
-              deriveGaussResultsCtuBoundary(m_gaussPic, tmpYuvBeforeDb.get(COMPONENT_Y), blk, cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 0, 0 );
-            }
+        deriveGaussResults( tmpYuvBeforeDb.get(COMPONENT_Y), blk, blk, cs, 0, 0 );
+        if( m_isFixedFilterPaddedPerCtu )
+        {
+          for(int gaussIdx = 0; gaussIdx < NUM_GAUSS_FILTERED_SOURCE; gaussIdx++)
+          {
+            paddingGaussResultsCtu(m_gaussPic, m_gaussCtu, gaussIdx, blk);
+          }
+        }
+        else
+        {
+          deriveGaussResultsCtuBoundary(m_gaussPic, tmpYuvBeforeDb.get(COMPONENT_Y), blk, cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], m_ctuEnableFlag[COMPONENT_Y], m_ctuEnableOnlineLumaFlag, ctuIdx, 0, 0 );
+        }
 #endif
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-            char coeffBits = m_coeffBitsApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+        char coeffBits = m_coeffBitsApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
 #endif
 #if JVET_X0071_ALF_BAND_CLASSIFIER
-            int classifierIdx = m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
+        int classifierIdx = m_classifierIdxApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS][alt_num];
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-            alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
+        alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
 #else
-            alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
+        alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult[COMPONENT_Y], m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
 #endif
 #else
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-            alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
+        alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu, coeffBits);
 #else
-            alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
+        alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu, m_gaussPic, m_gaussCtu);
 #endif
 #endif
 #else
-            alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu);
+        alfFiltering(m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, m_fixFilterResiResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu);
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+        alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-            alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+        alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+        alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-            alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+        alfFiltering( m_classifier[classifierIdx], recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #endif
 #else
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+        alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-            alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+        alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
+        alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx, m_fixedFilterResultPerCtu, m_isFixedFilterPaddedPerCtu );
 #else
-            alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
+        alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, filterTypeCtb, m_fixFilterResult, fixedFilterSetIdx );
 #endif
 #endif
 #endif
-          }
+      }
 #else
-          if( filterSetIndex >= NUM_FIXED_FILTER_SETS )
-          {
-            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-            clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-          }
-          else
-          {
-            coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-            clip = m_clipDefault;
-          }
-          m_filter7x7Blk( m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos );
+      if( filterSetIndex >= NUM_FIXED_FILTER_SETS )
+      {
+        coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+        clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+      }
+      else
+      {
+        coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+        clip = m_clipDefault;
+      }
+      m_filter7x7Blk( m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos );
 #endif
-        }
+    }
 
-        for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-        {
-          ComponentID compID = ComponentID( compIdx );
-          const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-          const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+    for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+    {
+      ComponentID compID = ComponentID( compIdx );
+      const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+      const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
 
-          if (m_ctuEnableFlag[compIdx][ctuIdx])
-          {
-            Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-            uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+      if (m_ctuEnableFlag[compIdx][ctuIdx])
+      {
+        Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+        uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-            deriveFixedFilterChroma(m_classifier, tmpYuv, tmpYuvBeforeDb, blk, blk, cs, fixedFilterSetIdxChroma[compIdx - 1], compID);
-            deriveFixedFilterResultsCtuBoundaryChroma(m_classifier, m_fixFilterResult[compIdx], tmpYuv.get(compID), tmpYuvBeforeDb.get(compID), blk, m_inputBitDepth[CHANNEL_TYPE_CHROMA], cs, m_clpRngs.comp[compID], m_alfClippingValues[CHANNEL_TYPE_CHROMA], cs.slice->getSliceQp() + cs.slice->getSliceChromaQpDelta(compID), fixedFilterSetIdxChroma[compIdx - 1], m_mappingDir, m_laplacian, m_ctuEnableFlag[compIdx], ctuIdx);
+        deriveFixedFilterChroma(m_classifier, tmpYuv, tmpYuvBeforeDb, blk, blk, cs, fixedFilterSetIdxChroma[compIdx - 1], compID, laplacian);
+        deriveFixedFilterResultsCtuBoundaryChroma(m_classifier, m_fixFilterResult[compIdx], tmpYuv.get(compID), tmpYuvBeforeDb.get(compID), blk, m_inputBitDepth[CHANNEL_TYPE_CHROMA], cs, m_clpRngs.comp[compID], m_alfClippingValues[CHANNEL_TYPE_CHROMA], cs.slice->getSliceQp() + cs.slice->getSliceChromaQpDelta(compID), fixedFilterSetIdxChroma[compIdx - 1], m_mappingDir, laplacian, m_ctuEnableFlag[compIdx], ctuIdx);
 #endif
 #if ALF_IMPROVEMENT
 #if JVET_X0071_ALF_BAND_CLASSIFIER
@@ -1246,81 +1311,242 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 #if JVET_AD0222_ADDITONAL_ALF_FIXFILTER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], m_fixFilterResiResult, fixedFilterSetIdxChroma[compIdx-1], nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
+        alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], m_fixFilterResiResult, fixedFilterSetIdxChroma[compIdx-1], nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
 #else
-            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], m_fixFilterResiResult, fixedFilterSetIdxChroma[compIdx-1], nullptr, false, m_gaussPic, m_gaussCtu);
+        alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, m_fixFilterResult[compIdx], m_fixFilterResiResult, fixedFilterSetIdxChroma[compIdx-1], nullptr, false, m_gaussPic, m_gaussCtu);
 #endif
 #else
 #if JVET_AG0158_ALF_LUMA_COEFF_PRECISION
-            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
+        alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu, m_NUM_BITS_CHROMA);
 #else
-            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu);
+        alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false, m_gaussPic, m_gaussCtu);
 #endif
 #endif
 #else
-            alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false);
+        alfFiltering(m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuvResi, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma, nullptr, nullptr, -1, nullptr, false);
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
+        alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
 #else
-            alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
+        alfFiltering( m_classifier[0], recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
 #endif
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier[0], recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
+        alfFiltering( m_classifier[0], recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
 #else
-            alfFiltering( m_classifier[0], recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
+        alfFiltering( m_classifier[0], recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
 #endif
 #endif
 #else
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
+        alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
 #else
-            alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
+        alfFiltering( m_classifier, recYuv, tmpYuvBeforeDb, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
 #endif
 #else
 #if JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS
-            alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
+        alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1, nullptr, false );
 #else
-            alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
+        alfFiltering( m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_filterTypeApsChroma  , nullptr, -1 );
 #endif
 #endif
 #endif
 #else
-            m_filter5x5Blk( m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight, m_alfVBChmaPos );
+        m_filter5x5Blk( m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight, m_alfVBChmaPos );
 #endif
-          }
-          if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-          {
-            const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
+      }
+      if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+      {
+        const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
-            if (filterIdx != 0)
-            {
-              Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-              Area blkSrc(xPos, yPos, width, height);
+        if (filterIdx != 0)
+        {
+          Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+          Area blkSrc(xPos, yPos, width, height);
 
-              const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
+          const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 
 #if ALF_IMPROVEMENT
 #if JVET_AF0197_LUMA_RESIDUAL_TAP_IN_CCALF
-              m_filterCcAlf( recYuv.get( compID ), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, tmpYuvResi, m_alfClippingValues[CHANNEL_TYPE_LUMA] );
+          m_filterCcAlf( recYuv.get( compID ), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, tmpYuvResi, m_alfClippingValues[CHANNEL_TYPE_LUMA] );
 #else
-              m_filterCcAlf( recYuv.get( compID ), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs );
+          m_filterCcAlf( recYuv.get( compID ), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs );
 #endif
 #else
-              m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+          m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
 #endif
-            }
+        }
+      }
+    }
+  }
+}
+
+#if ENABLE_PARALLEL_ALF
+AdaptiveLoopFilter::LaplacianBuf::LaplacianBuf()
+{
+  for( size_t i = 0; i < NUM_DIRECTIONS; i++ )
+  {
+    laplacian[i] = laplacianPtr[i];
+    for( size_t j = 0; j < sizeof( laplacianPtr[i] ) / sizeof( laplacianPtr[i][0] ); j++ )
+    {
+      laplacianPtr[i][j] = laplacianData[i][j];
+    }
+  }
+}
+
+bool AdaptiveLoopFilter::useParallelCtus( CodingStructure& cs )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  if( m_numThreads < 2 || pcv.heightInCtus < 2 || m_isFixedFilterPaddedPerCtu )
+  {
+    return false;
+  }
+
+  // the threads share the slice of the coding structure and filter in place: all CTUs have to be in the same slice and none of them
+  // may be filtered through the per-CTU copies made at virtual, tile and subpicture boundaries
+  const Slice* slice = cs.getCU( Position( 0, 0 ), CH_L )->slice;
+  bool clipTop, clipBottom, clipLeft, clipRight;
+  int  numHorVirBndry, numVerVirBndry, rasterSliceAlfPad;
+  int  horVirBndryPos[3], verVirBndryPos[3];
+  for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  {
+    for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+    {
+      const int width  = std::min<int>( pcv.maxCUWidth, pcv.lumaWidth - xPos );
+      const int height = std::min<int>( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+      if( cs.getCU( Position( xPos, yPos ), CH_L )->slice != slice
+        || isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+void AdaptiveLoopFilter::filterCtusParallel( CodingStructure& cs, const int fixedFilterSetIdx, const int fixedFilterSetIdxChroma[2] )
+#else
+void AdaptiveLoopFilter::filterCtusParallel( CodingStructure& cs, const int fixedFilterSetIdx )
+#endif
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  Slice* slice = cs.getCU( Position( 0, 0 ), CH_L )->slice;
+  const bool chromaEnabled = slice->getTileGroupAlfEnabledFlag( COMPONENT_Cb ) || slice->getTileGroupAlfEnabledFlag( COMPONENT_Cr );
+  if( !slice->getTileGroupAlfEnabledFlag( COMPONENT_Y ) && !chromaEnabled )
+  {
+    return;
+  }
+
+  cs.slice = slice;
+  reconstructCoeffAPSs( cs, true, chromaEnabled, false );
+  const short* alfCtuFilterIndex = slice->getPic()->getAlfCtbFilterIndex();
+  m_ccAlfFilterParam = slice->m_ccAlfFilterParam;
+
+  const int numThreads = std::min<int>( m_numThreads, pcv.heightInCtus );
+  while( (int) m_threadLaplacian.size() < numThreads - 1 )
+  {
+    m_threadLaplacian.emplace_back( new LaplacianBuf );
+  }
+
+  // a CTU reads and writes the fixed filter results, classes and flags of its 8 neighbours: with a lag of two CTUs between
+  // consecutive rows, CTUs filtered concurrently are at least three CTUs apart and each one sees its neighbours in raster order
+  std::vector<int>        filtered( pcv.heightInCtus, 0 );   ///< number of CTUs of each row filtered
+  std::mutex              progressLock;
+  std::condition_variable progressChanged;
+  std::exception_ptr      failure;
+  bool                    failed  = false;
+  int                     nextRow = 0;
+
+  auto filterRows = [&]( uint32_t*** laplacian )
+  {
+    while( true )
+    {
+      int y;
+      {
+        std::lock_guard<std::mutex> lock( progressLock );
+        if( failed || nextRow == pcv.heightInCtus )
+        {
+          return;
+        }
+        y = nextRow++;
+      }
+
+      for( int x = 0; x < pcv.widthInCtus; x++ )
+      {
+        if( y > 0 )
+        {
+          const int above = std::min( x + 3, (int) pcv.widthInCtus );
+          std::unique_lock<std::mutex> lock( progressLock );
+          progressChanged.wait( lock, [&]() { return failed || filtered[y - 1] >= above; } );
+          if( failed )
+          {
+            return;
           }
         }
+
+        const int ctuIdx = y * pcv.widthInCtus + x;
+        const int xPos   = x << pcv.maxCUWidthLog2;
+        const int yPos   = y << pcv.maxCUHeightLog2;
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+        filterCtu( cs, cs.getCU( Position( xPos, yPos ), CH_L ), xPos, yPos, ctuIdx, alfCtuFilterIndex, fixedFilterSetIdx, fixedFilterSetIdxChroma, laplacian );
+#else
+        filterCtu( cs, cs.getCU( Position( xPos, yPos ), CH_L ), xPos, yPos, ctuIdx, alfCtuFilterIndex, fixedFilterSetIdx, laplacian );
+#endif
+
+        {
+          std::lock_guard<std::mutex> lock( progressLock );
+          filtered[y] = x + 1;
+#if ENABLE_FRAME_PARALLEL_DECODING
+          // a row completes only after the row above, reporting under the lock keeps that order
+          if( x + 1 == (int) pcv.widthInCtus && m_rowsFiltered )
+          {
+            m_rowsFiltered( y + 1 );
+          }
+#endif
+        }
+        progressChanged.notify_all();
       }
-      ctuIdx++;
     }
+  };
+
+  auto runThread = [&]( uint32_t*** laplacian )
+  {
+    try
+    {
+      filterRows( laplacian );
+    }
+    catch( ... )
+    {
+      std::lock_guard<std::mutex> lock( progressLock );
+      if( !failed )
+      {
+        failure = std::current_exception();
+        failed  = true;
+      }
+      progressChanged.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for( int tId = 1; tId < numThreads; tId++ )
+  {
+    threads.emplace_back( runThread, m_threadLaplacian[tId - 1]->laplacian );
+  }
+  runThread( m_laplacian );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+  if( failure )
+  {
+    std::rethrow_exception( failure );
   }
 }
+#endif
 
 void AdaptiveLoopFilter::reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo)
 {
@@ -2545,7 +2771,7 @@ void AdaptiveLoopFilter::deriveFixFilterResultsBlkChroma(AlfClassifier ***classi
   }
 }
 
-void AdaptiveLoopFilter::deriveFixedFilterChroma( AlfClassifier*** classifier, const PelUnitBuf& src, const PelUnitBuf& srcBeforeDb, const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, ComponentID compID )
+void AdaptiveLoopFilter::deriveFixedFilterChroma( AlfClassifier*** classifier, const PelUnitBuf& src, const PelUnitBuf& srcBeforeDb, const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, ComponentID compID, uint32_t **laplacian[NUM_DIRECTIONS] )
 {
   if( m_chromaFormat != CHROMA_400 )
   {    
@@ -2562,7 +2788,7 @@ void AdaptiveLoopFilter::deriveFixedFilterChroma( AlfClassifier*** classifier, c
           {
             continue;
           }
-          deriveFixFilterResultsBlkChroma(classifier, m_fixFilterResult[compIdx], src.get(compId), srcBeforeDb.get(compId), currCU.blocks[compId], currCU.blocks[compId], m_inputBitDepth[CHANNEL_TYPE_CHROMA], cs, m_clpRngs.comp[compId], m_alfClippingValues[CHANNEL_TYPE_CHROMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(compId), m_mappingDir, m_laplacian);
+          deriveFixFilterResultsBlkChroma(classifier, m_fixFilterResult[compIdx], src.get(compId), srcBeforeDb.get(compId), currCU.blocks[compId], currCU.blocks[compId], m_inputBitDepth[CHANNEL_TYPE_CHROMA], cs, m_clpRngs.comp[compId], m_alfClippingValues[CHANNEL_TYPE_CHROMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(compId), m_mappingDir, laplacian);
         }
       }
     }
@@ -2586,7 +2812,7 @@ void AdaptiveLoopFilter::deriveFixedFilterChroma( AlfClassifier*** classifier, c
             {
               continue;
             }
-            deriveFixFilterResultsBlkChroma( classifier, m_fixFilterResult[compIdx], src.get(compId), srcBeforeDb.get(compId) , Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_CHROMA], cs, m_clpRngs.comp[compId], m_alfClippingValues[CHANNEL_TYPE_CHROMA], qp[compIdx - 1], cs.slice->getTileGroupAlfFixedFilterSetIdx(compId), m_mappingDir, m_laplacian );
+            deriveFixFilterResultsBlkChroma( classifier, m_fixFilterResult[compIdx], src.get(compId), srcBeforeDb.get(compId) , Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_CHROMA], cs, m_clpRngs.comp[compId], m_alfClippingValues[CHANNEL_TYPE_CHROMA], qp[compIdx - 1], cs.slice->getTileGroupAlfFixedFilterSetIdx(compId), m_mappingDir, laplacian );
           }
         }
       }
@@ -2603,7 +2829,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier*** classifier, cons
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
   const CPelBuf& srcLumaBeforeDb, const uint8_t ctuPadFlag,
 #endif
-  const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, const int multipleClassifierIdx )
+  const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, const int multipleClassifierIdx, uint32_t **laplacian[NUM_DIRECTIONS] )
 #else
 void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk 
 #if ALF_IMPROVEMENT
@@ -2620,7 +2846,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
     {
 #if JVET_X0071_ALF_BAND_CLASSIFIER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-      deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult[COMPONENT_Y], srcLuma, bResiFixed, m_fixFilterResiResult, srcResiLuma, srcLumaBeforeDb, 0, Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(COMPONENT_Y), m_mappingDir, m_laplacian, classifierIdx, multipleClassifierIdx );
+      deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult[COMPONENT_Y], srcLuma, bResiFixed, m_fixFilterResiResult, srcResiLuma, srcLumaBeforeDb, 0, Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(COMPONENT_Y), m_mappingDir, laplacian, classifierIdx, multipleClassifierIdx );
 #else
       deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult, srcLuma, 
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
@@ -2629,7 +2855,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
         srcLumaBeforeDb, 0,
 #endif
-        Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(), m_mappingDir, m_laplacian, classifierIdx, multipleClassifierIdx );
+        Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(), m_mappingDir, laplacian, classifierIdx, multipleClassifierIdx );
 #endif
 #else
       deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult, srcLuma, Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), Area(currCU.lumaPos().x, currCU.lumaPos().y, currCU.lwidth(), currCU.lheight()), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], currCU.qp, cs.slice->getTileGroupAlfFixedFilterSetIdx(), m_mappingDir, m_laplacian, classifierIdx );
@@ -2649,7 +2875,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
         int nWidth = std::min( j + m_CLASSIFICATION_BLK_SIZE, width ) - j;
 #if JVET_X0071_ALF_BAND_CLASSIFIER
 #if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
-        deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult[COMPONENT_Y], srcLuma, bResiFixed, m_fixFilterResiResult, srcResiLuma, srcLumaBeforeDb, ( j == blk.pos().x && i == blk.pos().y ) ? ctuPadFlag : 0, Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), cs.slice->getTileGroupAlfFixedFilterSetIdx(COMPONENT_Y), m_mappingDir, m_laplacian, classifierIdx, multipleClassifierIdx );
+        deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult[COMPONENT_Y], srcLuma, bResiFixed, m_fixFilterResiResult, srcResiLuma, srcLumaBeforeDb, ( j == blk.pos().x && i == blk.pos().y ) ? ctuPadFlag : 0, Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), cs.slice->getTileGroupAlfFixedFilterSetIdx(COMPONENT_Y), m_mappingDir, laplacian, classifierIdx, multipleClassifierIdx );
 #else
         deriveClassificationAndFixFilterResultsBlk(classifier, m_fixFilterResult, srcLuma, 
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
@@ -2658,7 +2884,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
           srcLumaBeforeDb, ( j == blk.pos().x && i == blk.pos().y ) ? ctuPadFlag : 0,
 #endif
-          Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), cs.slice->getTileGroupAlfFixedFilterSetIdx(), m_mappingDir, m_laplacian, classifierIdx, multipleClassifierIdx );
+          Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), cs.slice->getTileGroupAlfFixedFilterSetIdx(), m_mappingDir, laplacian, classifierIdx, multipleClassifierIdx );
 #endif
 #else
         deriveClassificationAndFixFilterResultsBlk( classifier, m_fixFilterResult, srcLuma, Area(j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA], cs, m_clpRngs.comp[COMPONENT_Y], m_alfClippingValues[CHANNEL_TYPE_LUMA], cs.slice->getSliceQp(), cs.slice->getTileGroupAlfFixedFilterSetIdx(), m_mappingDir, m_laplacian, classifierIdx );
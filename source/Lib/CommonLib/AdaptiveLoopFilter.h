@@ -43,6 +43,14 @@
 #include "Unit.h"
 #include "UnitTools.h"
 
+#if ENABLE_PARALLEL_ALF
+#include <memory>
+#include <vector>
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+#include <functional>
+#endif
+
 #if ALF_IMPROVEMENT
 typedef       short           AlfClassifier;         
 #else
@@ -136,6 +144,13 @@ public:
   void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfParam& alfParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
+#if ENABLE_PARALLEL_ALF
+  void setNumThreads( int numThreads ) { m_numThreads = numThreads; }
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  /// called with the number of CTU rows at the top of the picture that ALFProcess has completed, in increasing order
+  void setRowsFilteredCallback( std::function<void( int )> callback ) { m_rowsFiltered = std::move( callback ); }
+#endif
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
 #if RPR_ENABLE
@@ -181,7 +196,7 @@ public:
   void deriveFixedFilterResultsCtuBoundaryChroma(AlfClassifier ***classifier, Pel ***fixedFilterResults, const CPelBuf &src, const CPelBuf &srcBeforeDb, const Area &blkDst, const int bits, CodingStructure& cs, const ClpRng &clpRng, const Pel clippingValues[4], int qp, int fixedFilterSetIdx, int mappingDir[NUM_DIR_FIX][NUM_DIR_FIX], uint32_t **laplacian[NUM_DIRECTIONS], uint8_t* ctuEnableFlag, int ctuIdx);
   void deriveFixedFilterResultsPerBlkChroma(AlfClassifier ***classifier, Pel ***fixedFilterResults, const CPelBuf &src, const CPelBuf &srcBeforeDb, const Area &blk, const int bits, CodingStructure& cs, const ClpRng &clpRng, const Pel clippingValues[4], int qp, int fixedFilterSetIdx, int mappingDir[NUM_DIR_FIX][NUM_DIR_FIX], uint32_t **laplacian[NUM_DIRECTIONS]);
   void deriveFixFilterResultsBlkChroma( AlfClassifier ***classifier, Pel ***fixedFilterResults, const CPelBuf &src, const CPelBuf &srcBeforeDb, const Area &blkDst, const Area &blk, const int bits, CodingStructure& cs, const ClpRng &clpRng, const Pel clippingValues[4], int qp, int fixedFilterSetIdx, int mappingDir[NUM_DIR_FIX][NUM_DIR_FIX], uint32_t **laplacian[NUM_DIRECTIONS] );
-  void deriveFixedFilterChroma(AlfClassifier*** classifier, const PelUnitBuf& src, const PelUnitBuf& srcBeforeDb, const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, ComponentID compID);
+  void deriveFixedFilterChroma(AlfClassifier*** classifier, const PelUnitBuf& src, const PelUnitBuf& srcBeforeDb, const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, ComponentID compID, uint32_t **laplacian[NUM_DIRECTIONS]);
   void alfFixedFilterBlkNonSimd(AlfClassifier **classifier, const CPelBuf &src, const Area &curBlk, const Area &blkDst, const CPelBuf &srcBeforeDb, Pel ***fixedFilterResults, int picWidth, const int fixedFiltInd, int fixedFiltQpInd, int dirWindSize, const ClpRng &clpRng, const Pel clippingValues[4], bool isLuma);
   void alfFixedFilterBlk(AlfClassifier **classifier, const CPelBuf &src, const Area &curBlk, const Area &blkDst, const CPelBuf &srcBeforeDb, Pel ***fixedFilterResults, int picWidth, const int fixedFiltInd, int fixedFiltQpInd, int dirWindSize, const ClpRng &clpRng, const Pel clippingValues[4], bool isLuma);
   template<AlfFixedFilterType filtType>
@@ -254,7 +269,7 @@ public:
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
                             const CPelBuf& srcLumaBeforeDb, const uint8_t ctuPadFlag,
 #endif
-    const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, const int multipleClassifierIdx );
+    const Area& blkDst, const Area& blk, CodingStructure &cs, const int classifierIdx, const int multipleClassifierIdx, uint32_t **laplacian[NUM_DIRECTIONS] );
 #else
   void deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk
 #if ALF_IMPROVEMENT
@@ -675,6 +690,24 @@ public:
 
 protected:
   bool isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad );
+  void filterCtu( CodingStructure& cs, const CodingUnit* cu, const int xPos, const int yPos, const int ctuIdx, const short* alfCtuFilterIndex
+#if ALF_IMPROVEMENT
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+                , const int fixedFilterSetIdx, const int fixedFilterSetIdxChroma[2]
+#else
+                , const int fixedFilterSetIdx
+#endif
+                , uint32_t** laplacian[NUM_DIRECTIONS]
+#endif
+                );
+#if ENABLE_PARALLEL_ALF
+  bool useParallelCtus( CodingStructure& cs );
+#if JVET_AG0157_ALF_CHROMA_FIXED_FILTER
+  void filterCtusParallel( CodingStructure& cs, const int fixedFilterSetIdx, const int fixedFilterSetIdxChroma[2] );
+#else
+  void filterCtusParallel( CodingStructure& cs, const int fixedFilterSetIdx );
+#endif
+#endif
   static constexpr int   m_scaleBits = 7; // 8-bits
   CcAlfFilterParam       m_ccAlfFilterParam;
   uint8_t*               m_ccAlfFilterControl[2];
@@ -771,10 +804,24 @@ protected:
   uint32_t**                   m_laplacian[NUM_DIRECTIONS];
   uint32_t *                   m_laplacianPtr[NUM_DIRECTIONS][(m_CLASSIFICATION_BLK_SIZE + 10) >> 1];
   uint32_t                     m_laplacianData[NUM_DIRECTIONS][(m_CLASSIFICATION_BLK_SIZE + 10)>>1][((m_CLASSIFICATION_BLK_SIZE + 16)>>1) + 8];
+#if ENABLE_PARALLEL_ALF
+  struct LaplacianBuf                                                      ///< classification scratch of a thread filtering CTUs
+  {
+    LaplacianBuf();
+    uint32_t**                 laplacian[NUM_DIRECTIONS];
+    uint32_t *                 laplacianPtr[NUM_DIRECTIONS][(m_CLASSIFICATION_BLK_SIZE + 10) >> 1];
+    uint32_t                   laplacianData[NUM_DIRECTIONS][(m_CLASSIFICATION_BLK_SIZE + 10) >> 1][((m_CLASSIFICATION_BLK_SIZE + 16) >> 1) + 8];
+  };
+  int                          m_numThreads;                                ///< number of threads filtering the CTUs of a picture
+  std::vector<std::unique_ptr<LaplacianBuf>> m_threadLaplacian;             ///< classification scratch of the additional threads
+#endif
 #else
   int**                        m_laplacian[NUM_DIRECTIONS];
   int *                        m_laplacianPtr[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5];
   int                          m_laplacianData[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5][m_CLASSIFICATION_BLK_SIZE + 5];
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  std::function<void( int )>   m_rowsFiltered;                              ///< reports the CTU rows completed by ALFProcess
 #endif
   uint8_t*                     m_ctuEnableFlag[MAX_NUM_COMPONENT];
   uint8_t*                     m_ctuAlternative[MAX_NUM_COMPONENT];
@@ -54,17 +54,54 @@ const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
   { {2,2}, {2,2}, {2,2} }   // 4:4:4
 };
 
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+void CtuRowHistory::store( const CodingStructure& cs )
+{
+  motionLut = cs.motionLut;
+#if JVET_AD0188_CCP_MERGE
+  ccpLut    = cs.ccpLut;
+#endif
+#if JVET_AG0058_EIP
+  eipLut    = cs.eipLut;
+#endif
+  prevPLT   = cs.prevPLT;
+}
+
+void CtuRowHistory::load( CodingStructure& cs ) const
+{
+  cs.motionLut = motionLut;
+#if JVET_AD0188_CCP_MERGE
+  cs.ccpLut    = ccpLut;
+#endif
+#if JVET_AG0058_EIP
+  cs.eipLut    = eipLut;
+#endif
+  cs.prevPLT   = prevPLT;
+}
+#endif
+
 // ---------------------------------------------------------------------------
 // coding structure method definitions
 // ---------------------------------------------------------------------------
 
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+thread_local CtuRowHistory* CodingStructure::s_threadHistory = nullptr;
+
+#endif
+
 CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tuCache)
   : area      ()
   , picture   ( nullptr )
   , parent    ( nullptr )
   , bestCS    ( nullptr )
   , m_isTopLayer(false)
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  , m_useThreadHistory( false )
+#endif
   , m_isTuEnc ( false )
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+  , m_breakCUChain( false )
+#endif
   , m_cuCache ( cuCache )
   , m_puCache ( puCache )
   , m_tuCache ( tuCache )
@@ -1413,6 +1450,13 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
   cu->modeType = modeType;
 #endif
   CodingUnit *prevCU = m_numCUs > 0 ? cus.back() : nullptr;
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+  if( m_breakCUChain )
+  {
+    prevCU         = nullptr;
+    m_breakCUChain = false;
+  }
+#endif
 
   if( prevCU )
   {
@@ -2147,22 +2191,22 @@ void CodingStructure::setPrevPLT(PLTBuf predictor)
 {
   for (int comp = 0; comp < MAX_NUM_CHANNEL_TYPE; comp++)
   {
-    prevPLT.curPLTSize[comp] = predictor.curPLTSize[comp];
+    getPrevPLT().curPLTSize[comp] = predictor.curPLTSize[comp];
   }
   for (int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
   {
-    memcpy(prevPLT.curPLT[comp], predictor.curPLT[comp], MAXPLTPREDSIZE * sizeof(Pel));
+    memcpy(getPrevPLT().curPLT[comp], predictor.curPLT[comp], MAXPLTPREDSIZE * sizeof(Pel));
   }
 }
 void CodingStructure::storePrevPLT(PLTBuf& predictor)
 {
   for (int comp = 0; comp < MAX_NUM_CHANNEL_TYPE; comp++)
   {
-    predictor.curPLTSize[comp] = prevPLT.curPLTSize[comp];
+    predictor.curPLTSize[comp] = getPrevPLT().curPLTSize[comp];
   }
   for (int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
   {
-    memcpy(predictor.curPLT[comp], prevPLT.curPLT[comp], MAXPLTPREDSIZE * sizeof(Pel));
+    memcpy(predictor.curPLT[comp], getPrevPLT().curPLT[comp], MAXPLTPREDSIZE * sizeof(Pel));
   }
 }
 
@@ -2904,6 +2948,55 @@ void CodingStructure::clearCUs()
   m_numCUs = 0;
 }
 
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+template<class T>
+static void sortUnitsByCtu( std::vector<T*>& units, const unsigned first, const std::vector<int>& ctuRank, const PreCalcValues& pcv, std::vector<unsigned>& newIdx )
+{
+  auto ctuOf = [&]( const T* unit )
+  {
+    const Position pos = recalcPosition( pcv.chrFormat, unit->chType, CHANNEL_TYPE_LUMA, unit->blocks[unit->chType].pos() );
+    return ctuRank[( pos.y >> pcv.maxCUHeightLog2 ) * pcv.widthInCtus + ( pos.x >> pcv.maxCUWidthLog2 )];
+  };
+  std::stable_sort( units.begin() + first, units.end(), [&]( const T* a, const T* b ) { return ctuOf( a ) < ctuOf( b ); } );
+
+  newIdx.resize( units.size() + 1 );
+  newIdx[0] = 0;
+  for( unsigned i = 0; i < units.size(); i++ )
+  {
+    newIdx[units[i]->idx] = i + 1;
+    units[i]->idx         = i + 1;
+  }
+}
+
+/** Restores the coding order of the units added from CTUs compressed in parallel.
+ *  The units from 'first' on are stably sorted by the rank of their CTU, the index maps are rewritten accordingly.
+ */
+void CodingStructure::sortUnitsInCtuOrder( const unsigned firstCU, const unsigned firstPU, const unsigned firstTU, const std::vector<int>& ctuRank )
+{
+  std::vector<unsigned> newCuIdx, newPuIdx, newTuIdx;
+  sortUnitsByCtu( cus, firstCU, ctuRank, *pcv, newCuIdx );
+  sortUnitsByCtu( pus, firstPU, ctuRank, *pcv, newPuIdx );
+  sortUnitsByCtu( tus, firstTU, ctuRank, *pcv, newTuIdx );
+
+  const int numCh = ::getNumberValidChannels( area.chromaFormat );
+  for( int i = 0; i < numCh; i++ )
+  {
+    const size_t mapSize = unitScale[i].scaleArea( area.blocks[i].area() );
+    for( size_t j = 0; j < mapSize; j++ )
+    {
+      m_cuIdx[i][j] = newCuIdx[m_cuIdx[i][j]];
+      m_puIdx[i][j] = newPuIdx[m_puIdx[i][j]];
+      m_tuIdx[i][j] = newTuIdx[m_tuIdx[i][j]];
+    }
+  }
+
+  for( size_t i = firstCU > 0 ? firstCU - 1 : 0; i < cus.size(); i++ )
+  {
+    cus[i]->next = i + 1 < cus.size() ? cus[i + 1] : nullptr;
+  }
+}
+#endif
+
 MotionBuf CodingStructure::getMotionBuf( const Area& _area )
 {
 #if JVET_Z0118_GDR
@@ -3238,7 +3331,7 @@ const CIpmBuf CodingStructure::getIpmBuf(const Area& _area, PictureType pt) cons
 uint8_t& CodingStructure::getIpmInfo(const Position& pos, PictureType pt)
 {
 #if JVET_Z0118_GDR
-  static uint8_t constIpm = 0;
+  static thread_local uint8_t constIpm = 0;
   
   if (!picContain(pos))
   {
@@ -3433,7 +3526,9 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const C
   int ctuSizeBit = floorLog2(curCu.cs->sps->getMaxCUWidth());
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curCu.chromaFormat );
   int xCurr = curCu.blocks[_chType].x << getChannelTypeScaleX( _chType, curCu.chromaFormat );
-  bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
+  int yNbY  = pos.y << getChannelTypeScaleY( _chType, curCu.chromaFormat );
+  int yCurr = curCu.blocks[_chType].y << getChannelTypeScaleY( _chType, curCu.chromaFormat );
+  bool addCheck = (wavefrontsEnabled && ((xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 || (yNbY >> ctuSizeBit) > (yCurr >> ctuSizeBit))) ? false : true;
   if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || cu->idx <= curCu.idx ) && addCheck)
   {
 #if JVET_Z0118_GDR
@@ -3467,7 +3562,9 @@ const CodingUnit* CodingStructure::getCURestricted(const Position &pos, const Po
   int ctuSizeBit = floorLog2(this->sps->getMaxCUWidth());
   int xNbY = pos.x << getChannelTypeScaleX(_chType, this->area.chromaFormat);
   int xCurr = curPos.x << getChannelTypeScaleX(_chType, this->area.chromaFormat);
-  bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1) ? false : true;
+  int yNbY = pos.y << getChannelTypeScaleY(_chType, this->area.chromaFormat);
+  int yCurr = curPos.y << getChannelTypeScaleY(_chType, this->area.chromaFormat);
+  bool addCheck = (wavefrontsEnabled && ((xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 || (yNbY >> ctuSizeBit) > (yCurr >> ctuSizeBit))) ? false : true;
 
 #if JVET_Z0118_GDR
   if (m_gdrEnabled)
@@ -3494,7 +3591,9 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
   int ctuSizeBit = floorLog2(curPu.cs->sps->getMaxCUWidth());
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curPu.chromaFormat );
   int xCurr = curPu.blocks[_chType].x << getChannelTypeScaleX( _chType, curPu.chromaFormat );
-  bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
+  int yNbY  = pos.y << getChannelTypeScaleY( _chType, curPu.chromaFormat );
+  int yCurr = curPu.blocks[_chType].y << getChannelTypeScaleY( _chType, curPu.chromaFormat );
+  bool addCheck = (wavefrontsEnabled && ((xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 || (yNbY >> ctuSizeBit) > (yCurr >> ctuSizeBit))) ? false : true;
   if (pu && CU::isSameSliceAndTile(*pu->cu, *curPu.cu) && (pu->cs != curPu.cs || pu->idx <= curPu.idx) && addCheck)
   {
 #if JVET_Z0118_GDR
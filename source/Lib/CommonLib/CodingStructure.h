@@ -71,6 +71,26 @@ enum PictureType
 };
 extern XUCache g_globalUnitCache;
 
+class CodingStructure;
+
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+/// state of the history based predictors carried along a CTU row or substream processed by one thread
+struct CtuRowHistory
+{
+  LutMotionCand motionLut;
+#if JVET_AD0188_CCP_MERGE
+  LutCCP        ccpLut;
+#endif
+#if JVET_AG0058_EIP
+  LutEIP        eipLut;
+#endif
+  PLTBuf        prevPLT;
+
+  void store( const CodingStructure& cs );
+  void load( CodingStructure& cs ) const;
+};
+#endif
+
 // ---------------------------------------------------------------------------
 // coding structure
 // ---------------------------------------------------------------------------
@@ -241,6 +261,14 @@ public:
   void clearTUs();
   void clearPUs();
   void clearCUs();
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+  void sortUnitsInCtuOrder( const unsigned firstCU, const unsigned firstPU, const unsigned firstTU, const std::vector<int>& ctuRank );
+#endif
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+  // the next CU added is not linked to the last one, so that a CTU read concurrently keeps the end of its CU chain
+  // while the next CTU is added; sortUnitsInCtuOrder() links the CUs again
+  void breakCUChain() { m_breakCUChain = true; }
+#endif
 #if !INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
   const int signalModeCons( const PartSplit split, Partitioner &partitioner, const ModeType modeTypeParent ) const;
   void clearCuPuTuIdxMap  ( const UnitArea &_area, uint32_t numCu, uint32_t numPu, uint32_t numTu, uint32_t* pOffset );
@@ -287,14 +315,52 @@ public:
 #endif
 
   PLTBuf prevPLT;
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  // the history based predictors: the history of the substream the calling thread decodes, bound by setThreadHistory(),
+  // while the substreams of this structure are decoded concurrently, the members otherwise
+  LutMotionCand&       getMotionLut()       { return m_useThreadHistory ? s_threadHistory->motionLut : motionLut; }
+  const LutMotionCand& getMotionLut() const { return m_useThreadHistory ? s_threadHistory->motionLut : motionLut; }
+#if JVET_AD0188_CCP_MERGE
+  LutCCP&              getCcpLut()          { return m_useThreadHistory ? s_threadHistory->ccpLut    : ccpLut; }
+  const LutCCP&        getCcpLut()    const { return m_useThreadHistory ? s_threadHistory->ccpLut    : ccpLut; }
+#endif
+#if JVET_AG0058_EIP
+  LutEIP&              getEipLut()          { return m_useThreadHistory ? s_threadHistory->eipLut    : eipLut; }
+  const LutEIP&        getEipLut()    const { return m_useThreadHistory ? s_threadHistory->eipLut    : eipLut; }
+#endif
+  PLTBuf&              getPrevPLT()         { return m_useThreadHistory ? s_threadHistory->prevPLT   : prevPLT; }
+  const PLTBuf&        getPrevPLT()   const { return m_useThreadHistory ? s_threadHistory->prevPLT   : prevPLT; }
+  static void          setThreadHistory( CtuRowHistory* history ) { s_threadHistory = history; }
+  void                 useThreadHistory( const bool use )         { m_useThreadHistory = use; }
+#else
+  LutMotionCand&       getMotionLut()       { return motionLut; }
+  const LutMotionCand& getMotionLut() const { return motionLut; }
+#if JVET_AD0188_CCP_MERGE
+  LutCCP&              getCcpLut()          { return ccpLut; }
+  const LutCCP&        getCcpLut()    const { return ccpLut; }
+#endif
+#if JVET_AG0058_EIP
+  LutEIP&              getEipLut()          { return eipLut; }
+  const LutEIP&        getEipLut()    const { return eipLut; }
+#endif
+  PLTBuf&              getPrevPLT()         { return prevPLT; }
+  const PLTBuf&        getPrevPLT()   const { return prevPLT; }
+#endif
   void resetPrevPLT(PLTBuf& prevPLT);
   void reorderPrevPLT(PLTBuf& prevPLT, uint8_t curPLTSize[MAX_NUM_CHANNEL_TYPE], Pel curPLT[MAX_NUM_COMPONENT][MAXPLTSIZE], bool reuseflag[MAX_NUM_CHANNEL_TYPE][MAXPLTPREDSIZE], uint32_t compBegin, uint32_t numComp, bool jointPLT);
   void setPrevPLT(PLTBuf predictor);
   void storePrevPLT(PLTBuf& predictor);
 private:
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  static thread_local CtuRowHistory* s_threadHistory;
+  bool m_useThreadHistory;
+#endif
 
   // needed for TU encoding
   bool m_isTuEnc;
+#if ENABLE_WPP_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+  bool m_breakCUChain;
+#endif
 
   unsigned *m_cuIdx   [MAX_NUM_CHANNEL_TYPE];
   unsigned *m_puIdx   [MAX_NUM_CHANNEL_TYPE];
@@ -1374,7 +1374,16 @@ static const int GEO_CURVE_MAX_CU_LOG2 = 6;
 static const int GEO_CURVE_MIN_CU_SIZE = 1 << GEO_CURVE_MIN_CU_LOG2;
 static const int GEO_CURVE_MAX_CU_SIZE = 1 << GEO_CURVE_MAX_CU_LOG2;
 static const int GEO_CURVE_MIN_CU_IDX = 1;
+static const int GEO_NUM_PARTITION_SHAPES = 2; // straight and curve partitions
+#else
+static const int GEO_NUM_PARTITION_SHAPES = 1;
+#endif
+#if GPM_BLEND
+static const int GEO_NUM_BLEND_SHAPES = 2;     // linear and tanh blending ramps
+#else
+static const int GEO_NUM_BLEND_SHAPES = 1;
 #endif
+static const int GEO_NUM_MASK_VARIANTS = GEO_NUM_PARTITION_SHAPES * GEO_NUM_BLEND_SHAPES; // see SPS::getGeoMaskVariant()
 
 #if JVET_AB0155_SGPM
 static const int GEO_MIN_CU_LOG2_EX         = 2;
@@ -1566,6 +1575,9 @@ static const int SIGN_PRED_FREQ_RANGE   = 4; ///< not configurable
 #endif
 static const int SIGN_PRED_SHIFT        = 8; ///< not configurable
 static const int SIGN_PRED_OFFSET       = 1 << ( SIGN_PRED_SHIFT - 1 ); ///< not configurable
+#if JVET_Y0141_SIGN_PRED_IMPROVE
+static const int SIGN_PRED_NUM_AREAS    = 4; ///< log2 of the sign prediction area is 2..5
+#endif
 #endif
 #if MULTI_HYP_PRED
 static const auto MULTI_HYP_PRED_MAX_CANDS =                     4;
@@ -1575,6 +1587,7 @@ static const auto MULTI_HYP_PRED_SEARCH_RANGE =                 16;
 #endif
 #if NON_ADJACENT_MRG_CAND || TM_AMVP
 static const auto NADISTANCE_LEVEL =                             4;
+static const auto NADISTANCE_LEVEL_MAX =                         7; // distance levels of the longest non-adjacent spatial candidate lists
 #endif
 #if JVET_Y0134_TMVP_NAMVP_CAND_REORDERING && JVET_W0090_ARMC_TM
 static const auto TMVP_DISTANCE_LEVEL =                          5;
@@ -1781,6 +1794,7 @@ typedef enum{
 #ifdef TARGET_SIMD_X86
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
+X86_VEXT _get_x86_extensions(); ///< highest extension supported by the CPU, independent of the latched SIMD selection
 #endif
 
 #endif //ENABLE_SIMD_OPT
@@ -2002,7 +2016,9 @@ static inline int getProcStatusValue(const char* key)
 
 #if ENABLE_SPLIT_PARALLELISM
 #include <omp.h>
+#endif
 
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #define PARL_PARAM(DEF) , DEF
 #define PARL_PARAM0(DEF) DEF
 #else
@@ -42,6 +42,9 @@
 #include "Slice.h"
 
 #include <vector>
+#if ENABLE_FRAME_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+#include <mutex>
+#endif
 
 static constexpr int     PROB_BITS   = 15;   // Nominal number of bits to represent probabilities
 #if EC_HIGH_PRECISION
@@ -1297,23 +1300,40 @@ public:
     m_stateBuf[1].clear();
   }
 
+#if ENABLE_FRAME_PARALLELISM
+  int  getNumEntries( SliceType t ) const                      { return t == I_SLICE ? 0 : (int) m_stateBuf[t].size(); }
+  bool hasEntry( SliceType t, int tLayer, int qp ) const       { return t != I_SLICE && m_stateBuf[t].count( std::make_pair( tLayer, qp ) ) > 0; }
+#endif
+
 private:
   std::map<std::pair<int, int>, CtxStateArray> m_stateBuf[2];
 };
 
+#if ENABLE_FRAME_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+#define STORE_LOCK std::lock_guard<std::mutex> storeLock( m_mutex )
+#else
+#define STORE_LOCK
+#endif
+
 class CABACDataStore
 {
 public:
 
 #if JVET_AG0196_CABAC_RETRAIN
-  bool loadCtxStates( Slice* slice, Ctx& ctx ) { return m_ctxStateStore.loadCtx( slice, ctx ); }
+  bool loadCtxStates( Slice* slice, Ctx& ctx ) { STORE_LOCK; return m_ctxStateStore.loadCtx( slice, ctx ); }
 #else
-  bool loadCtxStates( const Slice* slice, Ctx& ctx ) { return m_ctxStateStore.loadCtx( slice, ctx ); }
+  bool loadCtxStates( const Slice* slice, Ctx& ctx ) { STORE_LOCK; return m_ctxStateStore.loadCtx( slice, ctx ); }
+#endif
+  void storeCtxStates( const Slice* slice, const Ctx& ctx ) { STORE_LOCK; m_ctxStateStore.storeCtx( slice, ctx ); }
+
+#if ENABLE_FRAME_PARALLELISM
+  int  getNumEntries( SliceType t )                      { STORE_LOCK; return m_ctxStateStore.getNumEntries( t ); }
+  bool hasEntry( SliceType t, int tLayer, int qp )       { STORE_LOCK; return m_ctxStateStore.hasEntry( t, tLayer, qp ); }
 #endif
-  void storeCtxStates( const Slice* slice, const Ctx& ctx ) { m_ctxStateStore.storeCtx( slice, ctx ); }
 
   void updateBufferState( const Slice* slice )
   {
+    STORE_LOCK;
 #if JVET_AD0206_CABAC_INIT_AT_GDR
     if( slice->getPendingRasInit() || slice->isInterGDR() )
 #else
@@ -1325,7 +1345,12 @@ public:
   }
 private:
   CtxStateStore       m_ctxStateStore;
+#if ENABLE_FRAME_PARALLELISM || ENABLE_PARALLEL_SUBSTREAM_DECODING
+  std::mutex          m_mutex;                                  ///< the store is shared by the pictures compressed or the substreams decoded concurrently
+#endif
 };
+
+#undef STORE_LOCK
 #endif
 
 #endif
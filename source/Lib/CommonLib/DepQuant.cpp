@@ -3056,8 +3056,17 @@ void DepQuant::getPredictedSigns(TransformUnit &tu, const ComponentID compID,
       }
       state = int((stateTransTab >> (4 * (2 * state + (level & 1)))) & 15);
     }
-    std::stable_sort(predSignsXYLevel.begin(), predSignsXYLevel.end(),
-                     [](const PositionWithLevel &a, const PositionWithLevel &b) { return a.level > b.level; });
+    // stable order by decreasing level; std::stable_sort may allocate a temporary buffer, sort indices instead
+    uint16_t order[32 * 32];
+    const int numLevels = (int) predSignsXYLevel.size();
+    for (int idx = 0; idx < numLevels; idx++)
+    {
+      order[idx] = idx;
+    }
+    std::sort(order, order + numLevels, [&predSignsXYLevel](const uint16_t a, const uint16_t b) {
+      return predSignsXYLevel[a].level > predSignsXYLevel[b].level
+             || (predSignsXYLevel[a].level == predSignsXYLevel[b].level && a < b);
+    });
 
     IdxBuf bufSignsScanIdx = tu.getCoeffSignsScanIdx(compID);
 
@@ -3069,9 +3078,9 @@ void DepQuant::getPredictedSigns(TransformUnit &tu, const ComponentID compID,
     const int32_t maxNumPredSigns =
       lfnstEnabled ? std::min<int>(4, tu.cs->sps->getNumPredSigns()) : tu.cs->sps->getNumPredSigns();
 
-    for (int idx = 0; idx < predSignsXYLevel.size(); idx++)
+    for (int idx = 0; idx < numLevels; idx++)
     {
-      const PositionWithLevel &pos = predSignsXYLevel[idx];
+      const PositionWithLevel &pos = predSignsXYLevel[order[idx]];
 
       bufSignsScanIdx.at(pos.x, pos.y) = idx;
 
@@ -46,8 +46,8 @@
  // ====================================================================================================================
 
 int TComHash::m_blockSizeToIndex[65][65];
-TCRCCalculatorLight TComHash::m_crcCalculator1(24, 0x5D6DCB);
-TCRCCalculatorLight TComHash::m_crcCalculator2(24, 0x864CFB);
+thread_local TCRCCalculatorLight TComHash::m_crcCalculator1(24, 0x5D6DCB);
+thread_local TCRCCalculatorLight TComHash::m_crcCalculator2(24, 0x864CFB);
 
 TCRCCalculatorLight::TCRCCalculatorLight(uint32_t bits, uint32_t truncPoly)
 {
@@ -129,8 +129,8 @@ private:
   static const int m_blockSizeBits = 3;
   static int m_blockSizeToIndex[65][65];
 
-  static TCRCCalculatorLight m_crcCalculator1;
-  static TCRCCalculatorLight m_crcCalculator2;
+  static thread_local TCRCCalculatorLight m_crcCalculator1;
+  static thread_local TCRCCalculatorLight m_crcCalculator2;
 };
 
 #endif // __HASH__
@@ -146,6 +146,7 @@ InterPrediction::InterPrediction()
 #if JVET_AF0057
   dmvrEnableEncoderCheck = false;
 #endif
+  m_stageTimes = nullptr;
   for( uint32_t ch = 0; ch < MAX_NUM_COMPONENT; ch++ )
   {
     for( uint32_t refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
@@ -919,7 +920,7 @@ int InterPrediction::deriveInterDimdMode(const CodingUnit cu, CPelBuf predBuf)
   int piHistogramClean[NUM_LUMA_MODE] = { 0 };
 
   pPred = pPred + iStride + 1;
-  sigcnt += buildHistogram(pPred, iStride, height - 2, width - 2, piHistogramClean, 0, width - 2, height - 2);
+  sigcnt += IntraPrediction::m_buildHistogram(pPred, iStride, height - 2, width - 2, piHistogramClean, 0, width - 2, height - 2);
 
   int firstAmp = 0, curAmp = 0;
   int firstMode = 0, curMode = 0;
@@ -3699,6 +3700,47 @@ void InterPrediction::xPredWoRefinement(PredictionUnit& pu, PelUnitBuf &pcYuvPre
 }
 #endif
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+// The reference picture may still be filtered by the decoder worker thread, which publishes its progress per CTU row.
+// Wait for the rows below the fetched block, including the interpolation filter, BDOF and DMVR/TM search margins. The
+// picture margins are padded once the whole picture is finished, fetches reaching outside of the picture, RPR and
+// wrap-around wait for that.
+void InterPrediction::xWaitForRefRows( const ComponentID compID, const PredictionUnit& pu, const Picture* refPic, const Mv& mv, const int width, const int height, const std::pair<int, int>& scalingRatio ) const
+{
+  if( refPic->isFinished() )
+  {
+    return;
+  }
+
+  if( scalingRatio != SCALE_1X || refPic->isWrapAroundEnabled( pu.cs->pps ) )
+  {
+    refPic->waitUntilFinished();
+    return;
+  }
+
+  int margin = ( NTAPS_LUMA( 0 ) >> 1 ) + BIO_EXTEND_SIZE + 1;
+#if MULTI_PASS_DMVR
+  margin += BDMVR_INTME_RANGE;
+#elif TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM
+  margin += TM_SEARCH_RANGE;
+#endif
+
+  const int scaleX = ::getComponentScaleX( compID, pu.chromaFormat );
+  const int scaleY = ::getComponentScaleY( compID, pu.chromaFormat );
+  const int left   = ( pu.blocks[compID].x << scaleX ) + ( mv.getHor() >> MV_FRACTIONAL_BITS_INTERNAL ) - margin;
+  const int top    = ( pu.blocks[compID].y << scaleY ) + ( mv.getVer() >> MV_FRACTIONAL_BITS_INTERNAL ) - margin;
+  const int right  = ( ( pu.blocks[compID].x + width ) << scaleX ) + ( mv.getHor() >> MV_FRACTIONAL_BITS_INTERNAL ) + 1 + margin;
+  const int bottom = ( ( pu.blocks[compID].y + height ) << scaleY ) + ( mv.getVer() >> MV_FRACTIONAL_BITS_INTERNAL ) + 1 + margin;
+
+  if( left < 0 || top < 0 || right > (int) pu.cs->pps->getPicWidthInLumaSamples() || bottom > (int) pu.cs->pps->getPicHeightInLumaSamples() )
+  {
+    refPic->waitUntilFinished();
+    return;
+  }
+  refPic->waitForReconstructedRows( bottom );
+}
+#endif
+
 void InterPrediction::xPredInterBlk ( const ComponentID& compID, const PredictionUnit& pu, const Picture* refPic, const Mv& _mv, PelUnitBuf& dstPic, const bool& bi, const ClpRng& clpRng
                                      , const bool& bioApplied
                                      , bool isIBC
@@ -3720,6 +3762,12 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
 #endif
                                     )
 {
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( !isIBC )
+  {
+    xWaitForRefRows( compID, pu, refPic, _mv, dmvrWidth ? dmvrWidth : pu.blocks[compID].width, std::max<int>( dmvrHeight, pu.blocks[compID].height ), scalingRatio );
+  }
+#endif
 #if JVET_AG0276_LIC_BDOF_BDMVR
   if (bioApplied == true && pu.cu->licFlag == true && isAML == false && isIBC == false && fastOBMC == false && bilinearMC == false)
   {
@@ -4708,6 +4756,7 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
 #endif
 #endif
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_AFFINE );
 
   JVET_J0090_SET_REF_PICTURE( refPic, compID );
   const ChromaFormat chFmt = pu.chromaFormat;
@@ -5866,6 +5915,7 @@ void InterPrediction::applyBiOptFlow(const PredictionUnit &pu, const CPelUnitBuf
 #endif
 #endif
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_BDOF );
 #if JVET_AE0046_BI_GPM
   if (m_lumaBdofReady)
   {
@@ -7892,6 +7942,7 @@ void InterPrediction::motionCompensation( PredictionUnit &pu, const RefPicList &
 */
 void InterPrediction::subBlockOBMC(PredictionUnit  &pu, PelUnitBuf* pDst)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_OBMC );
   if (
     pu.cs->sps->getUseOBMC() == false
     || pu.cu->obmcFlag == false
@@ -8850,7 +8901,7 @@ void InterPrediction::deriveGpmSplitMode(PredictionUnit& pu, MergeCtx &geoMrgCtx
 #if JVET_AG0112_REGRESSION_BASED_GPM_BLENDING
 std::pair<int8_t,int8_t> InterPrediction::getGeoBlendCandIndexes( const int idxCand, std::vector<int8_t>& listMergeCand0, std::vector<int8_t>& listMergeCand1, int8_t* nbZscanPairList )
 {
-  static std::vector< std::pair<int8_t, int8_t> > zscanPairList;
+  static thread_local std::vector< std::pair<int8_t, int8_t> > zscanPairList;
   std::pair<int8_t, int8_t>  pair = { NOT_VALID, NOT_VALID };
 
   int8_t numMergeCand0 = (int8_t)listMergeCand0.size();
@@ -10557,6 +10608,7 @@ void InterPrediction::xinitMC(PredictionUnit& pu, const ClpRngs &clpRngs)
 
 void InterPrediction::xProcessDMVR(PredictionUnit& pu, PelUnitBuf &pcYuvDst, const ClpRngs &clpRngs, const bool bioApplied)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_DMVR );
 #if MULTI_PASS_DMVR
   CHECK( true, "DMVR is removed when MULTI_PASS_DMVR is turned on." );
 #else
@@ -12907,7 +12959,7 @@ Distortion InterPrediction::deriveBcwBlending( PredictionUnit& pu, bool bUniDir[
 
 
   Pel(*A)[CCCM_REF_SAMPLES_MAX] = m_pcIntraPred->m_a;
-  static Pel Y[BCW_MAX_REF_SAMPLES];
+  static thread_local Pel Y[BCW_MAX_REF_SAMPLES];
 
   int iTempFirst  = m_bAMLTemplateAvailabe[0] ? 0 : 1;
   int iTempLast   = m_bAMLTemplateAvailabe[1] ? 2 : 1;
@@ -19696,7 +19748,7 @@ void InterPrediction::xLocalIlluComp(const PredictionUnit& pu,
 #endif
   int numTemplate[2] = { 0 , 0 }; // 0:Above, 1:Left
 #if JVET_AG0276_NLIC
-  static int shift_s, scale_s, offset_s;
+  static thread_local int shift_s, scale_s, offset_s;
   if (!m_skipDoLic)
 #endif
 #if JVET_AA0146_WRAP_AROUND_FIX
@@ -21360,6 +21412,7 @@ void TplMatchingCtrl::deriveMvUni2Pel(int step)
 }
 Distortion InterPrediction::deriveTMMv2Pel(const PredictionUnit& pu, int step, bool fillCurTpl, Distortion curBestCost, RefPicList eRefList, int refIdx, int maxSearchRounds, Mv& mv, const MvField* otherMvf)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_TM );
   CHECK(refIdx < 0, "Invalid reference index for TM");
   const CodingUnit& cu = *pu.cu;
 #if JVET_Z0084_IBC_TM
@@ -21447,6 +21500,7 @@ Distortion InterPrediction::deriveTMMv2Pel(const PredictionUnit& pu, int step, b
 }
 void InterPrediction::deriveSubTmvpTMMv(PredictionUnit& pu)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_TM );
   Distortion minCostUni[NUM_REF_PIC_LIST_01] = { std::numeric_limits<Distortion>::max(), std::numeric_limits<Distortion>::max() };
 
   for (int iRefList = 0; iRefList < (pu.cu->slice->isInterB() ? NUM_REF_PIC_LIST_01 : 1); ++iRefList)
@@ -21478,6 +21532,7 @@ void InterPrediction::deriveSubTmvpTMMv(PredictionUnit& pu)
 }
 void InterPrediction::deriveSubTmvpTMMv2Pel(PredictionUnit& pu, int step)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_TM );
   for (int iRefList = 0; iRefList < (pu.cu->slice->isInterB() ? NUM_REF_PIC_LIST_01 : 1); ++iRefList)
   {
     if (pu.interDir & (iRefList + 1))
@@ -21520,6 +21575,7 @@ void InterPrediction::deriveTemplateLIC(TplMatchingCtrl& tplCtrl, RefPicList eRe
 #endif
 Distortion InterPrediction::deriveTMMv(const PredictionUnit& pu, bool fillCurTpl, Distortion curBestCost, RefPicList eRefList, int refIdx, int maxSearchRounds, Mv& mv, const MvField* otherMvf)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_TM );
   CHECK(refIdx < 0, "Invalid reference index for TM");
   const CodingUnit& cu   = *pu.cu;
 #if JVET_Z0084_IBC_TM
@@ -21670,6 +21726,7 @@ void InterPrediction::deriveTMMv(PredictionUnit& pu, Distortion* tmCost)
 void InterPrediction::deriveTMMv(PredictionUnit& pu)
 #endif
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_TM );
   if( !pu.tmMergeFlag )
   {
     return;
@@ -23283,6 +23340,7 @@ void InterPrediction::clearAmvpTmvpBuffer()
 #if JVET_X0049_ADAPT_DMVR
 bool InterPrediction::processBDMVRPU2Dir(PredictionUnit& pu, bool subPURefine[2], Mv(&finalMvDir)[2])
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_DMVR );
   const int lumaArea = pu.lumaSize().area();
   bool       bUseMR = lumaArea > 64;
 #if JVET_Y0089_DMVR_BCW
@@ -23338,6 +23396,7 @@ static const int ACTIVITY_TH[MAX_QP + 1] =
 
 void InterPrediction::processBDMVRSubPU(PredictionUnit& pu, bool subPURefine)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_DMVR );
 
   if (!subPURefine)
   {
@@ -24641,6 +24700,7 @@ Distortion InterPrediction::xGetBilateralMatchingErrorAffineCheckMv(const Predic
 
 bool InterPrediction::processBDMVR4Affine(PredictionUnit& pu)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_DMVR );
   if (!pu.cs->slice->getSPS()->getUseDMVDMode() || !pu.cs->slice->isInterB())
   {
     return false;
@@ -24757,6 +24817,7 @@ bool InterPrediction::processBDMVR4Affine(PredictionUnit& pu)
 #if JVET_AF0163_TM_SUBBLOCK_REFINEMENT
 bool InterPrediction::processTM4Affine(PredictionUnit& pu, AffineMergeCtx &affineMergeCtx, int uiAffMergeCand, bool isEncoder)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_TM );
   if (!pu.cs->slice->getSPS()->getTMToolsEnableFlag())
   {
     return false;
@@ -24990,6 +25051,7 @@ bool InterPrediction::processTM4Affine(PredictionUnit& pu, AffineMergeCtx &affin
 #if JVET_AD0182_AFFINE_DMVR_PLUS_EXTENSIONS
 bool InterPrediction::processBDMVR4AdaptiveAffine(PredictionUnit& pu, Mv(&mvAffiL0)[2][3], Mv(&mvAffiL1)[2][3], EAffineModel& affTypeL0, EAffineModel& affTypeL1)
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_DMVR );
   if (!pu.cs->slice->getSPS()->getUseDMVDMode() || !pu.cs->slice->isInterB())
   {
     return false;
@@ -25277,6 +25339,7 @@ bool InterPrediction::processBDMVR(PredictionUnit& pu, int step, Distortion* tmC
 bool InterPrediction::processBDMVR(PredictionUnit& pu)
 #endif
 {
+  StageTimer stageTimer( m_stageTimes, STAGE_INTER_DMVR );
   if( !pu.cs->slice->getSPS()->getUseDMVDMode() || !pu.cs->slice->isInterB() )
   {
     return false;
@@ -34698,7 +34761,7 @@ std::vector<Mv> InterPrediction::deriveMVDFromMVSDIdxAffineSI(PredictionUnit& pu
 
     TplMatchingCtrl tplCtrl(pu, interRes, recPic, true, COMPONENT_Y, false, 0, m_pcCurTplAbove, m_pcCurTplLeft, m_pcRefTplAbove, m_pcRefTplLeft, Mv(0, 0), nullptr, 0, 1, true);
 #if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
-    static std::vector<std::pair<Mv, Distortion>> aMvCostVec;
+    static thread_local std::vector<std::pair<Mv, Distortion>> aMvCostVec;
     aMvCostVec.resize(patternsNum);
 #else
     std::vector<std::pair<Mv, Distortion>> aMvCostVec(patternsNum);
@@ -35072,7 +35135,7 @@ std::vector<Mv> InterPrediction::deriveMVDFromMVSDIdxAffineSI(PredictionUnit& pu
 
     //filter cMvdDerived to contain only elements with matching signs
 #if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
-    static std::vector<Mv> cMvdFiltered;
+    static thread_local std::vector<Mv> cMvdFiltered;
     cMvdFiltered.resize(0);
 #else
     std::vector<Mv> cMvdFiltered;
@@ -48,6 +48,7 @@
 #include "Picture.h"
 
 #include "RdCost.h"
+#include "StageTimer.h"
 #include "ContextModelling.h"
 #if JVET_Y0065_GPM_INTRA || JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
 #include "IntraPrediction.h"
@@ -500,6 +501,9 @@ protected:
                                  , bool fastOBMC = false
 #endif
                                  );
+#if ENABLE_FRAME_PARALLEL_DECODING
+  void xWaitForRefRows          ( const ComponentID compID, const PredictionUnit& pu, const Picture* refPic, const Mv& mv, const int width, const int height, const std::pair<int, int>& scalingRatio ) const;
+#endif
 #if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
   void xPredIBCBlkPadding       (const PredictionUnit& pu, ComponentID compID, const Picture* refPic, const ClpRng& clpRng
                                , CPelBuf& refBufBeforePadding, const Position& refOffsetByIntBv, int xFrac, int yFrac
@@ -628,6 +632,7 @@ protected:
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel      *m_cacheModel;
 #endif
+  StageTimes      *m_stageTimes;
   PelStorage       m_colorTransResiBuf[3];  // 0-org; 1-act; 2-tmp
 #if MULTI_HYP_PRED
   void xAddHypMC(PredictionUnit& pu, PelUnitBuf& predBuf, PelUnitBuf* predBufWOBIO, const bool lumaOnly = false);
@@ -997,6 +1002,7 @@ public:
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   void    cacheAssign( CacheModel *cache );
 #endif
+  void    setStageTimes( StageTimes *stageTimes ) { m_stageTimes = stageTimes; }
 #if !AFFINE_RM_CONSTRAINTS_AND_OPT
   static bool isSubblockVectorSpreadOverLimit( int a, int b, int c, int d, int predType );
 #endif
@@ -2584,7 +2584,8 @@ void InterpolationFilter::xWeightedSgpm(const PredictionUnit &pu, const uint32_t
   int16_t  hIdx   = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2_EX;
   int16_t  stepX  = 1 << scaleX;
   int16_t  stepY  = 0;
-  int16_t *weight = nullptr;
+  const int16_t *weight = nullptr;
+  const int blendShape = pu.cs->sps->getGeoMaskVariant() % GEO_NUM_BLEND_SHAPES;
 
 #if JVET_AC0189_SGPM_NO_BLENDING
   int blendWIdx = 0;
@@ -2600,7 +2601,7 @@ void InterpolationFilter::xWeightedSgpm(const PredictionUnit &pu, const uint32_t
   if (g_angle2mirror[angle] == 2)
   {
     stepY  = -(int) ((GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth());
-    weight = &g_geoWeights
+    weight = &g_geoWeights[blendShape]
 #if JVET_AC0189_SGPM_NO_BLENDING
                [blendWIdx]
 #else
@@ -2615,7 +2616,7 @@ void InterpolationFilter::xWeightedSgpm(const PredictionUnit &pu, const uint32_t
   {
     stepX  = -1 << scaleX;
     stepY  = (GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth();
-    weight = &g_geoWeights
+    weight = &g_geoWeights[blendShape]
 #if JVET_AC0189_SGPM_NO_BLENDING
                [blendWIdx]
 #else
@@ -2628,7 +2629,7 @@ void InterpolationFilter::xWeightedSgpm(const PredictionUnit &pu, const uint32_t
   else
   {
     stepY  = (GEO_WEIGHT_MASK_SIZE << scaleY) - pu.lwidth();
-    weight = &g_geoWeights
+    weight = &g_geoWeights[blendShape]
 #if JVET_AC0189_SGPM_NO_BLENDING
                [blendWIdx]
 #else
@@ -2668,29 +2669,22 @@ void InterpolationFilter::xWeightedGeoTpl(const PredictionUnit &pu, const uint8_
   const uint32_t scaleX = getComponentScaleX(compIdx, pu.chromaFormat);
   const uint32_t scaleY = getComponentScaleY(compIdx, pu.chromaFormat);
 
-  int16_t angle = g_geoParams[splitDir][0];
   int16_t wIdx  = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx  = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t stepX = 1 << scaleX;
-  int16_t stepY = 0;
-  Pel*   weight = &g_geoWeightsTpl[g_angle2mask[angle]][GEO_TM_ADDED_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE_EXT + GEO_TM_ADDED_WEIGHT_MASK_SIZE];
-  if (g_angle2mirror[angle] == 2)
+  const GeoMaskView& maskView = g_geoMaskView[pu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+  int16_t stepX = maskView.stepX << scaleX;
+  int16_t stepY = maskView.tplStride << scaleY;
+  const Pel* weight = maskView.tplMask;
+  if (maskView.stride < 0)
   {
-    stepY = -(int)(GEO_WEIGHT_MASK_SIZE_EXT << scaleY);
-    weight += ((GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE_EXT + g_weightOffset[splitDir][hIdx][wIdx][0]);
     weight += (trueTFalseL ? GEO_WEIGHT_MASK_SIZE_EXT * GEO_MODE_SEL_TM_SIZE : -GEO_MODE_SEL_TM_SIZE ); // Shift to template pos
   }
-  else if (g_angle2mirror[angle] == 1)
+  else if (maskView.stepX < 0)
   {
-    stepX = -1 << scaleX;
-    stepY = (GEO_WEIGHT_MASK_SIZE_EXT << scaleY);
-    weight += (g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE_EXT + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0]));
     weight -= (trueTFalseL ? GEO_WEIGHT_MASK_SIZE_EXT * GEO_MODE_SEL_TM_SIZE : -GEO_MODE_SEL_TM_SIZE ); // Shift to template pos
   }
   else
   {
-    stepY = (GEO_WEIGHT_MASK_SIZE_EXT << scaleY);
-    weight += (g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE_EXT + g_weightOffset[splitDir][hIdx][wIdx][0]);
     weight -= (trueTFalseL ? GEO_WEIGHT_MASK_SIZE_EXT * GEO_MODE_SEL_TM_SIZE : GEO_MODE_SEL_TM_SIZE ); // Shift to template pos
   }
 
@@ -2758,46 +2752,15 @@ void InterpolationFilter::xWeightedGeoBlk(const PredictionUnit &pu, const uint32
   const uint32_t scaleX = getComponentScaleX(compIdx, pu.chromaFormat);
   const uint32_t scaleY = getComponentScaleY(compIdx, pu.chromaFormat);
 
-  int16_t angle = g_geoParams[splitDir][0];
   int16_t wIdx = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t stepX = 1 << scaleX;
-  int16_t stepY = 0;
-  int16_t* weight = nullptr;
+  const GeoMaskView& maskView = g_geoMaskView[pu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+  int16_t stepX = maskView.stepX << scaleX;
+  int16_t stepY = (maskView.stride << scaleY) - maskView.stepX * (int)pu.lwidth();
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -(int)((GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth());
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepX = -1 << scaleX;
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth();
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-  }
-  else
-  {
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) - pu.lwidth();
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
+  const int16_t* weight = maskView.weight[bldIdx];
 #else
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -(int)((GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth());
-    weight = &g_geoWeights[g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepX = -1 << scaleX;
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth();
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-  }
-  else
-  {
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) - pu.lwidth();
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
+  const int16_t* weight = maskView.weight[0];
 #endif
   for( int y = 0; y < height; y++ )
   {
@@ -2844,46 +2807,15 @@ void InterpolationFilter::xWeightedGeoBlkRounded(const PredictionUnit &pu, const
   const uint32_t scaleX = getComponentScaleX(compIdx, pu.chromaFormat);
   const uint32_t scaleY = getComponentScaleY(compIdx, pu.chromaFormat);
 
-  int16_t angle = g_geoParams[splitDir][0];
   int16_t wIdx = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t stepX = 1 << scaleX;
-  int16_t stepY = 0;
-  int16_t* weight = nullptr;
+  const GeoMaskView& maskView = g_geoMaskView[pu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+  int16_t stepX = maskView.stepX << scaleX;
+  int16_t stepY = (maskView.stride << scaleY) - maskView.stepX * (int)pu.lwidth();
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -(int)((GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth());
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepX = -1 << scaleX;
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth();
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-  }
-  else
-  {
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) - pu.lwidth();
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
+  const int16_t* weight = maskView.weight[bldIdx];
 #else
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -(int)((GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth());
-    weight = &g_geoWeights[g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepX = -1 << scaleX;
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) + pu.lwidth();
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-  }
-  else
-  {
-    stepY = (GEO_WEIGHT_MASK_SIZE << scaleY) - pu.lwidth();
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
+  const int16_t* weight = maskView.weight[0];
 #endif
   for( int y = 0; y < height; y++ )
   {
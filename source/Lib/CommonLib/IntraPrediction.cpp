@@ -188,6 +188,9 @@ IntraPrediction::IntraPrediction()
     m_cflmBuf[i] = nullptr;
   }
 #endif
+#if CCP_LUMA_REF_CACHE
+  setCcpLumaRefCache( false );
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -561,9 +564,6 @@ void IntraPrediction::init(ChromaFormat chromaFormatIDC, const unsigned bitDepth
 #if JVET_AC0112_IBC_CIIP && INTRA_TRANS_ENC_OPT
   m_ibcCiipBlending = ibcCiipBlending;
 #endif
-#if JVET_AG0058_EIP && INTRA_TRANS_ENC_OPT
-  m_calcAeipGroupSum = calcAeipGroupSum;
-#endif
 #if JVET_V0130_INTRA_TMP
   unsigned int blkSize;
   if( m_pppTarPatch == NULL )
@@ -852,6 +852,8 @@ void IntraPrediction::xIntraPredTimdPlanarDcPdpc(const CPelBuf &pSrc, Pel* pDst,
   }
 }
 
+void ( *IntraPrediction::m_timdAngLuma )( Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset ) = IntraPrediction::xIntraPredTimdAngLuma;
+
 void IntraPrediction::xIntraPredTimdAngLuma(Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset)
 {
   for (int y = yOffset; y<height; y++ )
@@ -1005,7 +1007,7 @@ bool IntraPrediction::xFillIntraGPMRefTemplate(PredictionUnit& pu, TemplateType
   m_abFilledIntraGPMRefTpl[intraMode] = true;
 
   const uint32_t uiPredStride = MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE;
-  static Pel predLuma[uiPredStride * uiPredStride];
+  static thread_local Pel predLuma[uiPredStride * uiPredStride];
   
   int iTempWidth  = GEO_MODE_SEL_TM_SIZE;
   int iTempHeight = GEO_MODE_SEL_TM_SIZE;
@@ -4003,8 +4005,8 @@ void IntraPrediction::geneChromaFusionPred(const ComponentID compId, PelBuf &piP
 #endif
 
 #if JVET_AD0120_LBCCP
-  static int cclmSAD  = MAX_INT;
-  static int cccmSAD  = MAX_INT;
+  static thread_local int cclmSAD  = MAX_INT;
+  static thread_local int cccmSAD  = MAX_INT;
 #if JVET_AA0057_CCCM
 #if JVET_AE0174_NONINTER_TM_TOOLS_CONTROL
   if (pu.cs->slice->isIntra() && PU::cccmMultiModeAvail(pu, MMLM_CHROMA_IDX) && pu.cs->sps->getTMnoninterToolsEnableFlag())
@@ -4017,11 +4019,11 @@ void IntraPrediction::geneChromaFusionPred(const ComponentID compId, PelBuf &piP
     const int  bitDepth = pu.cu->slice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA);
     const CompArea                   &areaCb = pu2.blocks[COMPONENT_Cb];
     const CompArea                   &areaCr = pu2.blocks[COMPONENT_Cr];
-    static CclmModel                  cclmModelCb;
-    static CclmModel                  cclmModelCr;
-    static int                        modelThr       = 0;
-    static CccmModel cccmModelCb[2] = { CccmModel( CCCM_NUM_PARAMS, bitDepth), CccmModel( CCCM_NUM_PARAMS, bitDepth) };
-    static CccmModel cccmModelCr[2] = { CccmModel( CCCM_NUM_PARAMS, bitDepth), CccmModel( CCCM_NUM_PARAMS, bitDepth) };
+    static thread_local CclmModel                  cclmModelCb;
+    static thread_local CclmModel                  cclmModelCr;
+    static thread_local int                        modelThr       = 0;
+    static thread_local CccmModel cccmModelCb[2] = { CccmModel( CCCM_NUM_PARAMS, bitDepth), CccmModel( CCCM_NUM_PARAMS, bitDepth) };
+    static thread_local CccmModel cccmModelCr[2] = { CccmModel( CCCM_NUM_PARAMS, bitDepth), CccmModel( CCCM_NUM_PARAMS, bitDepth) };
 
     if (compId == COMPONENT_Cb)
     {
@@ -5459,7 +5461,7 @@ void IntraPrediction::predTimdIntraAng( const ComponentID compId, const Predicti
 
 void IntraPrediction::xPredTimdIntraPlanar( const CPelBuf &pSrc, Pel* rpDst, int iDstStride, int width, int height, TemplateType eTempType, int iTemplateWidth, int iTemplateHeight )
 {
-  static int leftColumn[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE+1] = {0}, topRow[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE+1] ={0}, bottomRow[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE] = {0}, rightColumn[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE]={0};
+  int leftColumn[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE+1] = {0}, topRow[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE+1] ={0}, bottomRow[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE] = {0}, rightColumn[MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE]={0};
   if(eTempType == LEFT_ABOVE_NEIGHBOR)
   {
     //predict above template
@@ -5766,8 +5768,8 @@ void IntraPrediction::xPredTimdIntraAng( const CPelBuf &pSrc, const ClpRng& clpR
   Pel * refAbove = tempRefAbove;
   Pel * refLeft  = tempRefLeft;
 #else
-  static Pel  refAbove[2 * MAX_CU_SIZE + 5 + 33 * MAX_REF_LINE_IDX];
-  static Pel  refLeft[2 * MAX_CU_SIZE + 5 + 33 * MAX_REF_LINE_IDX];
+  static thread_local Pel  refAbove[2 * MAX_CU_SIZE + 5 + 33 * MAX_REF_LINE_IDX];
+  static thread_local Pel  refLeft[2 * MAX_CU_SIZE + 5 + 33 * MAX_REF_LINE_IDX];
 #endif
 
   // Initialize the Main and Left reference array.
@@ -5815,7 +5817,7 @@ void IntraPrediction::xPredTimdIntraAng( const CPelBuf &pSrc, const ClpRng& clpR
   }
 
   // swap width/height if we are doing a horizontal mode:
-  static Pel tempArray[(MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE)*(MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE)];  ///< buffer size may not be big enough
+  static thread_local Pel tempArray[(MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE)*(MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE)];  ///< buffer size may not be big enough
   const int dstStride = bIsModeVer ? iDstStride : (MAX_CU_SIZE+DIMD_MAX_TEMP_SIZE);
   Pel *pDst = bIsModeVer ? pTrueDst : tempArray;
   if (!bIsModeVer)
@@ -5907,13 +5909,13 @@ void IntraPrediction::xPredTimdIntraAng( const CPelBuf &pSrc, const ClpRng& clpR
         if (isLuma(channelType))
         {
 #endif
-        xIntraPredTimdAngLuma(pDsty, dstStride, refMain, width, iTemplateHeight, deltaPos, intraPredAngle, clpRng, iTemplateWidth, 0);
+        m_timdAngLuma(pDsty, dstStride, refMain, width, iTemplateHeight, deltaPos, intraPredAngle, clpRng, iTemplateWidth, 0);
         // Left template
         for (int y = 0; y < iTemplateHeight; y++)
         {
           deltaPos += intraPredAngle;
         }
-        xIntraPredTimdAngLuma(pDsty, dstStride, refMain, iTemplateWidth, height, deltaPos, intraPredAngle, clpRng, 0, iTemplateHeight);
+        m_timdAngLuma(pDsty, dstStride, refMain, iTemplateWidth, height, deltaPos, intraPredAngle, clpRng, 0, iTemplateHeight);
 #if JVET_AC0119_LM_CHROMA_FUSION
         }
         else
@@ -5971,7 +5973,7 @@ void IntraPrediction::xPredTimdIntraAng( const CPelBuf &pSrc, const ClpRng& clpR
         if (isLuma(channelType))
         {
 #endif
-        xIntraPredTimdAngLuma(pDsty, dstStride, refMain, iRegionWidth, iRegionHeight, deltaPos, intraPredAngle, clpRng, 0, 0);
+        m_timdAngLuma(pDsty, dstStride, refMain, iRegionWidth, iRegionHeight, deltaPos, intraPredAngle, clpRng, 0, 0);
 #if JVET_AC0119_LM_CHROMA_FUSION
         }
         else
@@ -6765,7 +6767,7 @@ int IntraPrediction::getBestNonAnglularMode(const CPelBuf& recoBuf, const CompAr
   SizeType uiWidth = cu.lwidth();
   SizeType uiHeight = cu.lheight();
 
-  static Pel predLuma[(MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE)];
+  static thread_local Pel predLuma[(MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE)];
   memset(predLuma, 0, (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * sizeof(Pel));
   Pel* piPred = predLuma;
   uint32_t uiPredStride = MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE;
@@ -7294,8 +7296,23 @@ int IntraPrediction::deriveTimdMode(const CPelBuf &recoBuf, const CompArea &area
       {
         if (bFull && updateFull)
         {
+#if TIMD_TEMPLATE_COST_PRUNING
+          // the part along the mode direction goes first since the horizontal and vertical candidates need it, the
+          // other part is only added when the mode can still enter the best two
+          if (iMode > EXT_DIA_IDX)
+          {
+            tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
+            tmpCost1 = tmpCost0 < uiSecondaryCost ? distParamSad[1].distFunc(distParamSad[1]) : 0;
+          }
+          else
+          {
+            tmpCost1 = distParamSad[1].distFunc(distParamSad[1]);
+            tmpCost0 = tmpCost1 < uiSecondaryCost ? distParamSad[0].distFunc(distParamSad[0]) : 0;
+          }
+#else
           tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
           tmpCost1 = distParamSad[1].distFunc(distParamSad[1]);
+#endif
         }
         else
         {
@@ -7459,8 +7476,13 @@ int IntraPrediction::deriveTimdMode(const CPelBuf &recoBuf, const CompArea &area
 
         if (eTempType == LEFT_ABOVE_NEIGHBOR)
         {
+#if TIMD_TEMPLATE_COST_PRUNING
+          tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
+          tmpCost1 = tmpCost0 < uiSecondaryCost ? distParamSad[1].distFunc(distParamSad[1]) : 0;
+#else
           tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
           tmpCost1 = distParamSad[1].distFunc(distParamSad[1]);
+#endif
         }
         else if (eTempType == ABOVE_NEIGHBOR)
         {
@@ -7556,8 +7578,13 @@ int IntraPrediction::deriveTimdMode(const CPelBuf &recoBuf, const CompArea &area
           uint64_t tmpCost1 = 0;
           if (eTempType == LEFT_ABOVE_NEIGHBOR)
           {
+#if TIMD_TEMPLATE_COST_PRUNING
+            tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
+            tmpCost1 = tmpCost0 < uiBestCost ? distParamSad[1].distFunc(distParamSad[1]) : 0;
+#else
             tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
             tmpCost1 = distParamSad[1].distFunc(distParamSad[1]);
+#endif
           }
           else if (eTempType == ABOVE_NEIGHBOR)
           {
@@ -7636,8 +7663,13 @@ int IntraPrediction::deriveTimdMode(const CPelBuf &recoBuf, const CompArea &area
           uint64_t tmpCost1 = 0;
           if (eTempType == LEFT_ABOVE_NEIGHBOR)
           {
+#if TIMD_TEMPLATE_COST_PRUNING
+            tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
+            tmpCost1 = tmpCost0 < uiSecondaryCost ? distParamSad[1].distFunc(distParamSad[1]) : 0;
+#else
             tmpCost0 = distParamSad[0].distFunc(distParamSad[0]);
             tmpCost1 = distParamSad[1].distFunc(distParamSad[1]);
+#endif
           }
           else if (eTempType == ABOVE_NEIGHBOR)
           {
@@ -7805,7 +7837,7 @@ int IntraPrediction::deriveTimdMode( const CPelBuf &recoBuf, const CompArea &are
   SizeType uiWidth = cu.lwidth();
   SizeType uiHeight = cu.lheight();
 
-  static Pel predLuma[(MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE)];
+  static thread_local Pel predLuma[(MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE)];
   memset(predLuma, 0, (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * (MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE) * sizeof(Pel));
   Pel* piPred = predLuma;
   uint32_t uiPredStride = MAX_CU_SIZE + DIMD_MAX_TEMP_SIZE;
@@ -8268,6 +8300,7 @@ void IntraPrediction::ibcCiipBlending(Pel *pDst, int strideDst, const Pel *pSrc0
 #endif
 
 #if ENABLE_DIMD
+int ( *IntraPrediction::m_buildHistogram )( const Pel *pReco, int iStride, uint32_t uiHeight, uint32_t uiWidth, int* piHistogram, int direction, int bw, int bh ) = buildHistogram;
 
 #if JVET_AC0115_INTRA_TMP_DIMD_MTS_LFNST
 int IntraPrediction::deriveDimdIntraTmpModePred(const CodingUnit cu, CPelBuf predBuf)
@@ -8281,7 +8314,7 @@ int IntraPrediction::deriveDimdIntraTmpModePred(const CodingUnit cu, CPelBuf pre
   int piHistogramClean[NUM_LUMA_MODE] = { 0 };
 
   pPred = pPred + iStride + 1;
-  sigcnt += buildHistogram(pPred, iStride, height - 2, width - 2, piHistogramClean, 0, width - 2, height - 2);
+  sigcnt += m_buildHistogram(pPred, iStride, height - 2, width - 2, piHistogramClean, 0, width - 2, height - 2);
 
   int firstAmp = 0, curAmp = 0;
   int firstMode = 0, curMode = 0;
@@ -8368,9 +8401,9 @@ void IntraPrediction::deriveDimdMode(const CPelBuf &recoBuf, const CompArea &are
 #endif
     const Pel *pRecoLeft = pReco - 2 + iStride * (!numIntraAbove ? 1 : 0);
 #if JVET_AC0098_LOC_DEP_DIMD
-    buildHistogram(pRecoLeft, iStride, uiHeightLeft, 1, histogramLeft, 1, uiWidth, uiHeight);
+    m_buildHistogram(pRecoLeft, iStride, uiHeightLeft, 1, histogramLeft, 1, uiWidth, uiHeight);
 #else
-    buildHistogram(pRecoLeft, iStride, uiHeightLeft, 1, histogram, 1, uiWidth, uiHeight);
+    m_buildHistogram(pRecoLeft, iStride, uiHeightLeft, 1, histogram, 1, uiWidth, uiHeight);
 #endif
   }
 
@@ -8383,9 +8416,9 @@ void IntraPrediction::deriveDimdMode(const CPelBuf &recoBuf, const CompArea &are
 #endif
     const Pel *pRecoAbove = pReco - iStride * 2 + (!numIntraLeft ? 1 : 0);
 #if JVET_AC0098_LOC_DEP_DIMD
-    buildHistogram(pRecoAbove, iStride, 1, uiWidthAbove, histogramTop, 2, uiWidth, uiHeight);
+    m_buildHistogram(pRecoAbove, iStride, 1, uiWidthAbove, histogramTop, 2, uiWidth, uiHeight);
 #else
-    buildHistogram(pRecoAbove, iStride, 1, uiWidthAbove, histogram, 2, uiWidth, uiHeight);
+    m_buildHistogram(pRecoAbove, iStride, 1, uiWidthAbove, histogram, 2, uiWidth, uiHeight);
 #endif
   }
 
@@ -8393,9 +8426,9 @@ void IntraPrediction::deriveDimdMode(const CPelBuf &recoBuf, const CompArea &are
   {
     const Pel *pRecoAboveLeft = pReco - 2 - iStride * 2;
 #if JVET_AC0098_LOC_DEP_DIMD
-    buildHistogram(pRecoAboveLeft, iStride, 2, 2, histogramTopLeft, 3, uiWidth, uiHeight);
+    m_buildHistogram(pRecoAboveLeft, iStride, 2, 2, histogramTopLeft, 3, uiWidth, uiHeight);
 #else
-    buildHistogram(pRecoAboveLeft, iStride, 2, 2, histogram, 3, uiWidth, uiHeight);
+    m_buildHistogram(pRecoAboveLeft, iStride, 2, 2, histogram, 3, uiWidth, uiHeight);
 #endif
   }
 #if JVET_AC0098_LOC_DEP_DIMD
@@ -8862,7 +8895,7 @@ void IntraPrediction::deriveDimdChromaMode(const CPelBuf &recoBufY, const CPelBu
 #if JVET_AC0094_REF_SAMPLES_OPT
   const uint32_t uiHeightLeftY = (numLeftUnits*unitHeight << getChannelTypeScaleY(CHANNEL_TYPE_CHROMA, sps.getChromaFormatIdc())) - 2;
   const Pel* const pRecoLeftY = pRecoY + 1 + iStrideY;
-  buildHistogram(pRecoLeftY, iStrideY, uiHeightLeftY, 2, piHistogram, 1, uiWidthY, uiHeightY);
+  m_buildHistogram(pRecoLeftY, iStrideY, uiHeightLeftY, 2, piHistogram, 1, uiWidthY, uiHeightY);
 #endif
   if (numIntraLeft)
   {
@@ -8878,15 +8911,15 @@ void IntraPrediction::deriveDimdChromaMode(const CPelBuf &recoBufY, const CPelBu
     const Pel *pRecoLeftCb = pRecoCb - 2 + iStrideCb * (!numIntraAbove ? 1 : 0);
     const Pel *pRecoLeftCr = pRecoCr - 2 + iStrideCr * (!numIntraAbove ? 1 : 0);
 #if !JVET_AC0094_REF_SAMPLES_OPT
-    buildHistogram(pRecoLeftY, iStrideY, uiHeightLeftY, 1, piHistogram, 1, uiWidthY, uiHeightY);
+    m_buildHistogram(pRecoLeftY, iStrideY, uiHeightLeftY, 1, piHistogram, 1, uiWidthY, uiHeightY);
 #endif
-    buildHistogram(pRecoLeftCb, iStrideCb, uiHeightLeftC, 1, piHistogram, 1, uiWidthCb, uiHeightCb);
-    buildHistogram(pRecoLeftCr, iStrideCr, uiHeightLeftC, 1, piHistogram, 1, uiWidthCr, uiHeightCr);
+    m_buildHistogram(pRecoLeftCb, iStrideCb, uiHeightLeftC, 1, piHistogram, 1, uiWidthCb, uiHeightCb);
+    m_buildHistogram(pRecoLeftCr, iStrideCr, uiHeightLeftC, 1, piHistogram, 1, uiWidthCr, uiHeightCr);
   }
 #if JVET_AC0094_REF_SAMPLES_OPT
   const uint32_t uiWidthAboveY = (numAboveUnits*unitWidth << getChannelTypeScaleX(CHANNEL_TYPE_CHROMA, sps.getChromaFormatIdc())) - 4;
   const Pel* const pRecoAboveY = pRecoY + 3 + iStrideY;
-  buildHistogram(pRecoAboveY, iStrideY, 2, uiWidthAboveY, piHistogram, 2, uiWidthY, uiHeightY);
+  m_buildHistogram(pRecoAboveY, iStrideY, 2, uiWidthAboveY, piHistogram, 2, uiWidthY, uiHeightY);
 #endif
   if (numIntraAbove)
   {
@@ -8902,10 +8935,10 @@ void IntraPrediction::deriveDimdChromaMode(const CPelBuf &recoBufY, const CPelBu
     const Pel *pRecoAboveCb = pRecoCb - iStrideCb * 2 + (!numIntraLeft ? 1 : 0);
     const Pel *pRecoAboveCr = pRecoCr - iStrideCr * 2 + (!numIntraLeft ? 1 : 0);
 #if !JVET_AC0094_REF_SAMPLES_OPT
-    buildHistogram(pRecoAboveY, iStrideY, 1, uiWidthAboveY, piHistogram, 2, uiWidthY, uiHeightY);
+    m_buildHistogram(pRecoAboveY, iStrideY, 1, uiWidthAboveY, piHistogram, 2, uiWidthY, uiHeightY);
 #endif
-    buildHistogram(pRecoAboveCb, iStrideCb, 1, uiWidthAboveC, piHistogram, 2, uiWidthCb, uiHeightCb);
-    buildHistogram(pRecoAboveCr, iStrideCr, 1, uiWidthAboveC, piHistogram, 2, uiWidthCr, uiHeightCr);
+    m_buildHistogram(pRecoAboveCb, iStrideCb, 1, uiWidthAboveC, piHistogram, 2, uiWidthCb, uiHeightCb);
+    m_buildHistogram(pRecoAboveCr, iStrideCr, 1, uiWidthAboveC, piHistogram, 2, uiWidthCr, uiHeightCr);
   }
   if (numIntraLeft && numIntraAbove)
   {
@@ -8915,10 +8948,10 @@ void IntraPrediction::deriveDimdChromaMode(const CPelBuf &recoBufY, const CPelBu
     const Pel *pRecoAboveLeftCb = pRecoCb - 2 - iStrideCb * 2;
     const Pel *pRecoAboveLeftCr = pRecoCr - 2 - iStrideCr * 2;
 #if !JVET_AC0094_REF_SAMPLES_OPT
-    buildHistogram(pRecoAboveLeftY, iStrideY, 2, 2, piHistogram, 3, uiWidthY, uiHeightY);
+    m_buildHistogram(pRecoAboveLeftY, iStrideY, 2, 2, piHistogram, 3, uiWidthY, uiHeightY);
 #endif
-    buildHistogram(pRecoAboveLeftCb, iStrideCb, 2, 2, piHistogram, 3, uiWidthCb, uiHeightCb);
-    buildHistogram(pRecoAboveLeftCr, iStrideCr, 2, 2, piHistogram, 3, uiWidthCr, uiHeightCr);
+    m_buildHistogram(pRecoAboveLeftCb, iStrideCb, 2, 2, piHistogram, 3, uiWidthCb, uiHeightCb);
+    m_buildHistogram(pRecoAboveLeftCr, iStrideCr, 2, 2, piHistogram, 3, uiWidthCr, uiHeightCr);
   }
 
   int firstAmp = 0, secondAmp = 0, curAmp = 0;
@@ -8975,7 +9008,7 @@ int IntraPrediction::deriveDimdMipMode(PelBuf& reducedPred, int width, int heigh
   int histogram[NUM_LUMA_MODE] = { 0 };
 
   pPred = pPred + iStride + 1;
-  buildHistogram(pPred, iStride, height - 2, width - 2, histogram, 0, width - 2, height - 2);
+  m_buildHistogram(pPred, iStride, height - 2, width - 2, histogram, 0, width - 2, height - 2);
 
   int firstAmp = 0, curAmp = 0;
   int firstMode = 0, curMode = 0;
@@ -9865,6 +9898,9 @@ void IntraPrediction::xGetLumaRecPixelsGlmAll(const PredictionUnit &pu, CompArea
   for (int i = 0; i < NUM_GLM_IDC; i++)
   {
     refGrad[i] = xGlmGetGradRefBuf(pu, chromaArea, areaWidth, areaHeight, refSizeX, refSizeY, refPosPicX, refPosPicY, i);
+#if CCP_LUMA_REF_CACHE
+    m_glmGradRefCache[i].valid = false;
+#endif
   }
 
   int puBorderX = refSizeX + chromaArea.width;
@@ -11056,7 +11092,7 @@ void IntraPrediction::reorderPLT(CodingStructure& cs, Partitioner& partitioner,
     curPLTpred[idx] = false;
   }
 
-  for (int predidx = 0; predidx < cs.prevPLT.curPLTSize[compBegin]; predidx++)
+  for (int predidx = 0; predidx < cs.getPrevPLT().curPLTSize[compBegin]; predidx++)
   {
     bool match = false;
     int curidx = 0;
@@ -11070,7 +11106,7 @@ void IntraPrediction::reorderPLT(CodingStructure& cs, Partitioner& partitioner,
       bool matchTmp = true;
       for (int comp = compBegin; comp < (compBegin + numComp); comp++)
       {
-        matchTmp = matchTmp && (cu.curPLT[comp][curidx] == cs.prevPLT.curPLT[comp][predidx]);
+        matchTmp = matchTmp && (cu.curPLT[comp][curidx] == cs.getPrevPLT().curPLT[comp][predidx]);
       }
       if (matchTmp)
       {
@@ -11092,14 +11128,14 @@ void IntraPrediction::reorderPLT(CodingStructure& cs, Partitioner& partitioner,
         cu.reuseflag[COMPONENT_Y][predidx] = true;
         for( int comp = COMPONENT_Y; comp < MAX_NUM_COMPONENT; comp++ )
         {
-          curPLTtmp[comp][reusePLTSizetmp] = cs.prevPLT.curPLT[comp][predidx];
+          curPLTtmp[comp][reusePLTSizetmp] = cs.getPrevPLT().curPLT[comp][predidx];
         }
       }
       else
       {
         for (int comp = compBegin; comp < (compBegin + numComp); comp++)
         {
-          curPLTtmp[comp][reusePLTSizetmp] = cs.prevPLT.curPLT[comp][predidx];
+          curPLTtmp[comp][reusePLTSizetmp] = cs.getPrevPLT().curPLT[comp][predidx];
         }
       }
       reusePLTSizetmp++;
@@ -12123,6 +12159,35 @@ void IntraPrediction::candidateSearchIntra( CodingUnit* pcCU, unsigned int uiBlk
 #endif   
 }
 
+#if TMP_SEARCH_SUM_PRUNING
+void IntraPrediction::xBuildTmpIntegral( const Pel* ref, const int refStride, const int x0, const int y0, const int width, const int height )
+{
+  // sums wrap around for high bit depths, the differences of four entries are exact for the template sizes
+  m_tmpIntegralX      = x0;
+  m_tmpIntegralY      = y0;
+  m_tmpIntegralStride = width + 1;
+  m_tmpIntegral.resize( ( width + 1 ) * ( height + 1 ) );
+
+  uint32_t* line = m_tmpIntegral.data();
+  std::fill( line, line + width + 1, 0 );
+
+  const Pel* src = ref + y0 * refStride + x0;
+  for( int y = 0; y < height; y++, src += refStride )
+  {
+    const uint32_t* above = line;
+    line += m_tmpIntegralStride;
+
+    uint32_t rowSum = 0;
+    line[0] = 0;
+    for( int x = 0; x < width; x++ )
+    {
+      rowSum     += uint32_t( src[x] );
+      line[x + 1] = above[x + 1] + rowSum;
+    }
+  }
+}
+
+#endif
 #if JVET_W0069_TMP_BOUNDARY
 void IntraPrediction::searchCandidateFromOnePicIntra( CodingUnit* pcCU, Pel** tarPatch, unsigned int uiPatchWidth, unsigned int uiPatchHeight, RefTemplateType tempType
 #if JVET_AG0136_INTRA_TMP_LIC
@@ -12296,6 +12361,80 @@ void IntraPrediction::searchCandidateFromOnePicIntra( CodingUnit* pcCU, Pel** ta
                           TMP_TEMPLATE_SIZE, uiBlkWidth, uiBlkHeight, iCurrY, iCurrX, offsetLCUY, offsetLCUX, tempType);
   }
 
+#if TMP_SEARCH_SUM_PRUNING
+  // The absolute sum of the differences over a template part bounds its SAD from below, also with the mean removed.
+  // A position is skipped when the bounds reach the thresholds of all candidate lists, which keeps the result of the
+  // exhaustive scan.
+  const int tmpW = (int) uiBlkWidth;
+  const int tmpH = (int) uiBlkHeight;
+  int tarSumCorner = 0;
+  int tarSumTop    = 0;
+  int tarSumLeft   = 0;
+  for (int iY = 0; iY < TMP_TEMPLATE_SIZE; iY++)
+  {
+    const int topStart = tempType == ABOVE_TEMPLATE ? 0 : TMP_TEMPLATE_SIZE;
+    for (int iX = 0; iX < TMP_TEMPLATE_SIZE && tempType == L_SHAPE_TEMPLATE; iX++)
+    {
+      tarSumCorner += tarPatch[iY][iX];
+    }
+    for (int iX = topStart; iX < topStart + tmpW && tempType != LEFT_TEMPLATE; iX++)
+    {
+      tarSumTop += tarPatch[iY][iX];
+    }
+  }
+  for (int iY = TMP_TEMPLATE_SIZE; iY < (int) uiPatchHeight && tempType != ABOVE_TEMPLATE; iY++)
+  {
+    for (int iX = 0; iX < TMP_TEMPLATE_SIZE; iX++)
+    {
+      tarSumLeft += tarPatch[iY][iX];
+    }
+  }
+
+  const int tplX0 = tempType == ABOVE_TEMPLATE ? 0 : -TMP_TEMPLATE_SIZE;
+  const int tplY0 = tempType == LEFT_TEMPLATE ? 0 : -TMP_TEMPLATE_SIZE;
+  const int tplX1 = tempType == LEFT_TEMPLATE ? 0 : tmpW;
+  const int tplY1 = tempType == ABOVE_TEMPLATE ? 0 : tmpH;
+  int winX0 = MAX_INT, winY0 = MAX_INT, winX1 = -MAX_INT, winY1 = -MAX_INT;
+  for (regionId = 0; regionId < regionNum; regionId++)
+  {
+    if (mvYMaxs[regionId] >= mvYMins[regionId] && mvXMaxs[regionId] >= mvXMins[regionId])
+    {
+      winX0 = std::min(winX0, mvXMins[regionId] + tplX0);
+      winY0 = std::min(winY0, mvYMins[regionId] + tplY0);
+      winX1 = std::max(winX1, mvXMaxs[regionId] + tplX1);
+      winY1 = std::max(winY1, mvYMaxs[regionId] + tplY1);
+    }
+  }
+  if (winX1 > winX0)
+  {
+    xBuildTmpIntegral(ref, refStride, winX0, winY0, winX1 - winX0, winY1 - winY0);
+  }
+
+  auto templateCostBounds = [&](const int xOffset, const int yOffset, const bool isMrSad, const int requiredTemplate, int *bound)
+  {
+    const int refSumTop  = tempType != LEFT_TEMPLATE ? xTmpRefSum(xOffset, yOffset - TMP_TEMPLATE_SIZE, tmpW, TMP_TEMPLATE_SIZE) : 0;
+    const int refSumLeft = tempType != ABOVE_TEMPLATE ? xTmpRefSum(xOffset - TMP_TEMPLATE_SIZE, yOffset, TMP_TEMPLATE_SIZE, tmpH) : 0;
+    const int topMeanDiff  = isMrSad ? (refSumTop >> log2SizeTop) - topTargetMean : 0;
+    const int leftMeanDiff = isMrSad ? (refSumLeft >> log2SizeLeft) - leftTargetMean : 0;
+    const int boundTop     = abs(refSumTop - tarSumTop - TMP_TEMPLATE_SIZE * tmpW * topMeanDiff);
+    const int boundLeft    = abs(refSumLeft - tarSumLeft - TMP_TEMPLATE_SIZE * tmpH * leftMeanDiff);
+    if (tempType == L_SHAPE_TEMPLATE)
+    {
+      const int refSumCorner = xTmpRefSum(xOffset - TMP_TEMPLATE_SIZE, yOffset - TMP_TEMPLATE_SIZE, TMP_TEMPLATE_SIZE, TMP_TEMPLATE_SIZE);
+      bound[0] = abs(refSumCorner - tarSumCorner - TMP_TEMPLATE_SIZE * TMP_TEMPLATE_SIZE * topMeanDiff) + boundTop + boundLeft;
+      // only the top-left cost is computed otherwise, the top and left costs are returned as zero
+      bound[1] = requiredTemplate == 3 ? boundTop : 0;
+      bound[2] = requiredTemplate == 3 ? boundLeft : 0;
+    }
+    else
+    {
+      bound[0] = tempType == ABOVE_TEMPLATE ? boundTop : boundLeft;
+      bound[1] = MAX_INT;
+      bound[2] = MAX_INT;
+    }
+  };
+#endif
+
 #if JVET_AG0151_INTRA_TMP_MERGE_MODE
   if (!bJointCalc && pcCU->cs->pcv->isEncoder)
   {
@@ -12346,6 +12485,30 @@ void IntraPrediction::searchCandidateFromOnePicIntra( CodingUnit* pcCU, Pel** ta
     {
       for (iXOffset = mvXMax; iXOffset >= mvXMin; iXOffset--)
       {
+#endif
+#if TMP_SEARCH_SUM_PRUNING
+        {
+          int bound[3];
+          if (bJointCalc)
+          {
+            int boundSupp[3];
+            templateCostBounds(iXOffset, iYOffset, false, 3, bound);
+            templateCostBounds(iXOffset, iYOffset, true, 3, boundSupp);
+            if (bound[0] >= pDiff[0] && bound[1] >= pDiff[1] && bound[2] >= pDiff[2]
+                && boundSupp[0] >= pDiffSupp[0] && boundSupp[1] >= pDiffSupp[1] && boundSupp[2] >= pDiffSupp[2])
+            {
+              continue;
+            }
+          }
+          else
+          {
+            templateCostBounds(iXOffset, iYOffset, useMR, needTopLeft ? 3 : 0, bound);
+            if (bound[0] >= pDiff[0] && bound[1] >= pDiff[1] && bound[2] >= pDiff[2])
+            {
+              continue;
+            }
+          }
+        }
 #endif
         refCurr = ref + iYOffset * refStride + iXOffset;
 
@@ -13306,7 +13469,7 @@ void IntraPrediction::xTMPBuildFusionCandidate(CodingUnit &cu, RefTemplateType t
     }
     else
     {
-      static int iDiff[TMP_FUSION_NUM];
+      static thread_local int iDiff[TMP_FUSION_NUM];
 #if JVET_AG0136_INTRA_TMP_LIC
       const int  offset       = ptrTmpFusionInfo[i].tmpFusionIdx;
       const int  foundCandNum = ptrTmpFusionInfo[i].tmpFusionNumber;
@@ -16957,8 +17120,8 @@ void IntraPrediction::predCCPCandidate(PredictionUnit &pu, PelBuf &predCb, PelBu
       if (pu.ccpMergeFusionType == 0)
       {
         const int                         bitDepth = pu.cu->slice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA);
-        static CccmModel cccmModelCb[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
-        static CccmModel cccmModelCr[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
+        static thread_local CccmModel cccmModelCb[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
+        static thread_local CccmModel cccmModelCr[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
 
         pu2.cccmFlag = 1;
 #if JVET_AC0054_GLCCCM
@@ -16970,7 +17133,7 @@ void IntraPrediction::predCCPCandidate(PredictionUnit &pu, PelBuf &predCb, PelBu
 #if MMLM
         pu2.intraDir[1] = MMLM_CHROMA_IDX;
 
-        static int modelThr = 0;
+        static thread_local int modelThr = 0;
 
         modelThr = xCccmCalcRefAver(pu2);
         xCccmCalcModels(pu2, cccmModelCb[0], cccmModelCr[0], 1, modelThr);
@@ -17042,7 +17205,7 @@ void IntraPrediction::xInterCccmApplyModelOffset(const PredictionUnit& pu, const
   CHECK(!pu.cccmNoSubFlag, "cccmNoSubFlag shall be enabled");
 
   const ClpRng& clpRng(pu.cu->cs->slice->clpRng(compId));
-  static Pel    samples[INTER_CCCM_NUM_PARAMS];
+  static thread_local Pel    samples[INTER_CCCM_NUM_PARAMS];
 
   const PelBuf  refLumaBlk = xCccmGetLumaPuBuf(pu);
   const int chromaScaleX = getChannelTypeScaleX(CHANNEL_TYPE_CHROMA, pu.cu->slice->getSPS()->getChromaFormatIdc());
@@ -17078,7 +17241,7 @@ int IntraPrediction::xGetCostInterCccm(const PredictionUnit& pu, const Component
 {
   CHECK(!pu.cccmNoSubFlag, "cccmNoSubFlag shall be enabled");
   const ClpRng& clpRng(pu.cu->cs->slice->clpRng(compID));
-  static Pel samples[INTER_CCCM_NUM_PARAMS];
+  static thread_local Pel samples[INTER_CCCM_NUM_PARAMS];
 
   CPelBuf   refLumaBlk = xCccmGetLumaPuBuf(pu);
   const int chromaScaleX = getChannelTypeScaleX(CHANNEL_TYPE_CHROMA, pu.cu->slice->getSPS()->getChromaFormatIdc());
@@ -19525,7 +19688,7 @@ void IntraPrediction::xCccmCalcRefArea(const PredictionUnit& pu, CompArea chroma
   const int  numAboveRightUnits = totalAboveUnits - numAboveUnits;
   const int  numLeftBelowUnits  = totalLeftUnits - numLeftUnits;
 
-  static bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
+  static thread_local bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
 
   int avaiAboveRightUnits = isAboveRightAvailable( cu, chType, chromaArea.topRight(),   numAboveRightUnits, unitWidth,  (neighborFlags + totalLeftUnits + 1 + numAboveUnits) );
   int avaiLeftBelowUnits  = isBelowLeftAvailable ( cu, chType, chromaArea.bottomLeft(), numLeftBelowUnits,  unitHeight, (neighborFlags + totalLeftUnits - 1 - numLeftUnits) );
@@ -19760,6 +19923,38 @@ int IntraPrediction::xCccmCalcRefAver(const PredictionUnit& pu
 #endif
 }
 
+#if CCP_LUMA_REF_CACHE
+void IntraPrediction::setCcpLumaRefCache(bool enable)
+{
+  m_ccpLumaRefCacheEnabled = enable;
+
+  for (int i = 0; i < CCCM_NUM_PRED_FILTER + 1; i++)
+  {
+    m_cccmLumaRefCache[i].valid = false;
+  }
+  for (int i = 0; i < NUM_GLM_IDC; i++)
+  {
+    m_glmGradRefCache[i].valid = false;
+  }
+  m_cflmLumaRefCache.valid = false;
+}
+
+// Returns true when the buffer of the entry already holds the planes of the block and reference area, otherwise records them for the following fill
+bool IntraPrediction::xCcpLumaRefCacheHit(CcpLumaRefCacheEntry& entry, const Area& blkArea, const Area& refArea)
+{
+  if (entry.valid && entry.blkArea == blkArea && entry.refArea == refArea)
+  {
+    return true;
+  }
+
+  entry.valid   = m_ccpLumaRefCacheEnabled;
+  entry.blkArea = blkArea;
+  entry.refArea = refArea;
+
+  return false;
+}
+#endif
+
 void IntraPrediction::xCccmCreateLumaRef(const PredictionUnit& pu, CompArea chromaArea
 #if JVET_AD0202_CCCM_MDF
   , int downsFilterIdx
@@ -19790,6 +19985,20 @@ void IntraPrediction::xCccmCreateLumaRef(const PredictionUnit& pu, CompArea chro
   xCccmSetLumaRefValue( pu );
 #endif
 
+#if CCP_LUMA_REF_CACHE
+  // the sub-sampled planes of the downsampling filters are kept, the template and the non-subsampled fills overwrite them partially
+  CcpLumaRefCacheEntry& cacheEntry = m_cccmLumaRefCache[pu.cccmNoSubFlag ? 0 : downsFilterIdx + 1];
+
+  if( isTemplate || pu.cccmNoSubFlag )
+  {
+    cacheEntry.valid = false;
+  }
+  else if( xCcpLumaRefCacheHit( cacheEntry, m_cccmBlkArea, m_cccmRefArea ) )
+  {
+    return;
+  }
+#endif
+
 #if JVET_AF0073_INTER_CCP_MERGE
   if (!isTemplate)
   {
@@ -20130,7 +20339,7 @@ void IntraPrediction::xCflmCalcRefArea(const PredictionUnit& pu, const CompArea&
   const int  numAboveRightUnits = totalAboveUnits - numAboveUnits;
   const int  numLeftBelowUnits = totalLeftUnits - numLeftUnits;
 
-  static bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
+  static thread_local bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
 
   int avaiAboveRightUnits = isAboveRightAvailable(cu, chType, chromaArea.topRight(), numAboveRightUnits, unitWidth, (neighborFlags + totalLeftUnits + 1 + numAboveUnits));
   int avaiLeftBelowUnits = isBelowLeftAvailable(cu, chType, chromaArea.bottomLeft(), numLeftBelowUnits, unitHeight, (neighborFlags + totalLeftUnits - 1 - numLeftUnits));
@@ -20192,6 +20401,13 @@ void IntraPrediction::xCflmCreateLumaRef(const PredictionUnit& pu, const CompAre
   xCccmSetLumaRefValue(pu);
 #endif
 
+#if CCP_LUMA_REF_CACHE
+  if (xCcpLumaRefCacheHit(m_cflmLumaRefCache, chromaArea, m_cflmRefArea))
+  {
+    return;
+  }
+#endif
+
   // Generate down-sampled luma for the area covering both the PU and the top/left reference areas
   for (int y = 0; y < areaHeight; y++)
   {
@@ -20432,9 +20648,58 @@ int IntraPrediction::xCflmCalcRefAver(const PredictionUnit& pu, const CompArea&
 
 #if JVET_AA0057_CCCM || JVET_AB0092_GLM_WITH_LUMA || JVET_AC0119_LM_CHROMA_FUSION || JVET_AG0058_EIP || JVET_AG0154_DECODER_DERIVED_CCP_FUSION
     
+void (*CccmCovariance::m_calcCovariance)( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_MAX], const Pel* C0, const Pel* C1, const int numParams, const int sampleNum, TCccmCoeff ATA[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* ATC0, TCccmCoeff* ATC1 ) = CccmCovariance::calcCovariance;
+
+void CccmCovariance::calcCovariance( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_MAX], const Pel* C0, const Pel* C1, const int numParams, const int sampleNum, TCccmCoeff ATA[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* ATC0, TCccmCoeff* ATC1 )
+{
+  for( int i = 0; i < numParams; i++ )
+  {
+    memset( ATA[i], 0x00, sizeof( TCccmCoeff ) * numParams );
+  }
+  memset( ATC0, 0x00, sizeof( TCccmCoeff ) * numParams );
+  if( C1 )
+  {
+    memset( ATC1, 0x00, sizeof( TCccmCoeff ) * numParams );
+  }
+
+  for( int coli0 = 0; coli0 < numParams; coli0++ )
+  {
+    for( int coli1 = coli0; coli1 < numParams; coli1++ )
+    {
+      const Pel *col0 = A[coli0];
+      const Pel *col1 = A[coli1];
+
+      for( int rowi = 0; rowi < sampleNum; rowi++ )
+      {
+        ATA[coli0][coli1] += col0[rowi] * col1[rowi];
+      }
+    }
+  }
+
+  for( int coli = 0; coli < numParams; coli++ )
+  {
+    const Pel *col = A[coli];
+
+    for( int rowi = 0; rowi < sampleNum; rowi++ )
+    {
+      ATC0[coli] += col[rowi] * C0[rowi];
+    }
+    if( C1 )
+    {
+      for( int rowi = 0; rowi < sampleNum; rowi++ )
+      {
+        ATC1[coli] += col[rowi] * C1[rowi];
+      }
+    }
+  }
+}
+
 #if JVET_AC0053_GAUSSIAN_SOLVER
+template<int fixedNumEq>
 void CccmCovariance::gaussBacksubstitution( TCccmCoeff* x, int numEq, int col )
 {
+  numEq = fixedNumEq ? fixedNumEq : numEq;
+
   x[numEq-1] = C[numEq-1][col];
 
   for( int i = numEq-2; i >= 0; i-- )
@@ -20448,32 +20713,11 @@ void CccmCovariance::gaussBacksubstitution( TCccmCoeff* x, int numEq, int col )
   }
 }
 
-void CccmCovariance::gaussElimination( TCccmCoeff A[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* y0, TCccmCoeff* x0, TCccmCoeff* y1, TCccmCoeff* x1, int numEq, int numFilters, int bd
-#if JVET_AE0059_INTER_CCCM
-  ,const bool interCccmMode
-#endif
-)
-{ 
-  int colChr0 = numEq;
-  int colChr1 = numEq + 1;
-#if JVET_AE0059_INTER_CCCM
-  int reg = interCccmMode ? 1 : 2 << (bd - 8);
-#else
-  int reg = 2 << (bd - 8);
-#endif
-  
-  // Create an [M][M+2] matrix system (could have been done already when calculating auto/cross-correlations)
-  for( int i = 0; i < numEq; i++ )
-  {
-    for( int j = 0; j < numEq; j++ )
-    {
-      C[i][j] = j >= i ? A[i][j] : A[j][i];
-    }
-    
-    C[i][i]      += reg; // Regularization
-    C[i][colChr0] = y0[i];
-    C[i][colChr1] = numFilters == 2 ? y1[i] : 0; // Only applicable if solving for 2 filters at the same time
-  }
+// A non-zero fixedNumEq makes the number of equations a compile time constant, so that the loops can be unrolled
+template<int fixedNumEq>
+void CccmCovariance::gaussSolve( TCccmCoeff* x0, TCccmCoeff* x1, int numEq, int numFilters )
+{
+  numEq = fixedNumEq ? fixedNumEq : numEq;
 
   for( int i = 0; i < numEq; i++ )
   {
@@ -20509,14 +20753,50 @@ void CccmCovariance::gaussElimination( TCccmCoeff A[CCCM_NUM_PARAMS_MAX][CCCM_NU
   }
 
   // Solve with backsubstitution
+  gaussBacksubstitution<fixedNumEq>(x0, numEq, numEq);
   if ( numFilters == 2 )
   {
-    gaussBacksubstitution(x0, numEq, colChr0);
-    gaussBacksubstitution(x1, numEq, colChr1);
+    gaussBacksubstitution<fixedNumEq>(x1, numEq, numEq + 1);
   }
-  else
+}
+
+void CccmCovariance::gaussElimination( TCccmCoeff A[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* y0, TCccmCoeff* x0, TCccmCoeff* y1, TCccmCoeff* x1, int numEq, int numFilters, int bd
+#if JVET_AE0059_INTER_CCCM
+  ,const bool interCccmMode
+#endif
+)
+{ 
+  int colChr0 = numEq;
+  int colChr1 = numEq + 1;
+#if JVET_AE0059_INTER_CCCM
+  int reg = interCccmMode ? 1 : 2 << (bd - 8);
+#else
+  int reg = 2 << (bd - 8);
+#endif
+  
+  // Create an [M][M+2] matrix system (could have been done already when calculating auto/cross-correlations)
+  for( int i = 0; i < numEq; i++ )
   {
-    gaussBacksubstitution(x0, numEq, colChr0);
+    for( int j = 0; j < numEq; j++ )
+    {
+      C[i][j] = j >= i ? A[i][j] : A[j][i];
+    }
+    
+    C[i][i]      += reg; // Regularization
+    C[i][colChr0] = y0[i];
+    C[i][colChr1] = numFilters == 2 ? y1[i] : 0; // Only applicable if solving for 2 filters at the same time
+  }
+
+  // parameter counts of GLM/CFLM, CCCM, inter CCCM, multiple filter CCCM, CCCM without subsampling and EIP
+  switch( numEq )
+  {
+  case 3:  gaussSolve<3>( x0, x1, numEq, numFilters );  break;
+  case 7:  gaussSolve<7>( x0, x1, numEq, numFilters );  break;
+  case 8:  gaussSolve<8>( x0, x1, numEq, numFilters );  break;
+  case 10: gaussSolve<10>( x0, x1, numEq, numFilters ); break;
+  case 11: gaussSolve<11>( x0, x1, numEq, numFilters ); break;
+  case 15: gaussSolve<15>( x0, x1, numEq, numFilters ); break;
+  default: gaussSolve<0>( x0, x1, numEq, numFilters );  break;
   }
 }
 
@@ -20652,35 +20932,7 @@ void CccmCovariance::solve1( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_M
   CHECK( CCCM_REF_SAMPLES_MAX < sampleNum, "Insufficient buffer size" );
   CHECK( CCCM_NUM_PARAMS_MAX < numParams, "Insufficient buffer size" );
 
-  for( int i = 0; i < numParams; i++ )
-  {
-    memset( ATA[i], 0x00, sizeof( TCccmCoeff ) * numParams );
-  }
-  memset( ATCb, 0x00, sizeof( TCccmCoeff ) * numParams );
-
-  for( int coli0 = 0; coli0 < numParams; coli0++ )
-  {
-    for( int coli1 = coli0; coli1 < numParams; coli1++ )
-    {
-      const Pel *col0 = A[coli0];
-      const Pel *col1 = A[coli1];
-
-      for( int rowi = 0; rowi < sampleNum; rowi++ )
-      {
-        ATA[coli0][coli1] += col0[rowi] * col1[rowi];
-      }
-    }
-  }
-
-  for( int coli = 0; coli < numParams; coli++ )
-  {
-    const Pel *col = A[coli];
-
-    for( int rowi = 0; rowi < sampleNum; rowi++ )
-    {
-      ATCb[coli] += col[rowi] * C[rowi];
-    }
-  }
+  m_calcCovariance( A, C, nullptr, numParams, sampleNum, ATA, ATCb, nullptr );
 
 #if JVET_AB0174_CCCM_DIV_FREE
   // Remove chromaOffset from stats to update cross-correlation
@@ -20766,37 +21018,7 @@ void CccmCovariance::solve2( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_M
   CHECK( CCCM_NUM_PARAMS_MAX < numParams, "Insufficient buffer size" );
 
   // Calculate autocorrelation matrix and cross-correlation vector
-  for( int i = 0; i < numParams; i++ )
-  {
-    memset( ATA[i], 0x00, sizeof( TCccmCoeff ) * numParams );
-  }
-  memset( ATCb, 0x00, sizeof( TCccmCoeff ) * numParams );
-  memset( ATCr, 0x00, sizeof( TCccmCoeff ) * numParams );
-
-  for( int coli0 = 0; coli0 < numParams; coli0++ )
-  {
-    for( int coli1 = coli0; coli1 < numParams; coli1++ )
-    {
-      const Pel *col0 = A[coli0];
-      const Pel *col1 = A[coli1];
-
-      for( int rowi = 0; rowi < sampleNum; rowi++ )
-      {
-        ATA[coli0][coli1] += col0[rowi] * col1[rowi];
-      }
-    }
-  }
-
-  for( int coli = 0; coli < numParams; coli++ )
-  {
-    const Pel *col = A[coli];
-
-    for( int rowi = 0; rowi < sampleNum; rowi++ )
-    {
-      ATCb[coli] += col[rowi] * Cb[rowi];
-      ATCr[coli] += col[rowi] * Cr[rowi];
-    }
-  }
+  m_calcCovariance( A, Cb, Cr, numParams, sampleNum, ATA, ATCb, ATCr );
 
 #if JVET_AB0174_CCCM_DIV_FREE
   // Remove chromaOffset from stats to update cross-correlation
@@ -21074,7 +21296,7 @@ void IntraPrediction::xGlmCalcRefArea(const PredictionUnit& pu, CompArea chromaA
   const int  numAboveRightUnits = totalAboveUnits - numAboveUnits;
   const int  numLeftBelowUnits = totalLeftUnits - numLeftUnits;
 
-  static bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
+  static thread_local bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
 
   int avaiAboveRightUnits = isAboveRightAvailable(cu, chType, chromaArea.topRight(), numAboveRightUnits, unitWidth, (neighborFlags + totalLeftUnits + 1 + numAboveUnits));
   int avaiLeftBelowUnits = isBelowLeftAvailable(cu, chType, chromaArea.bottomLeft(), numLeftBelowUnits, unitHeight, (neighborFlags + totalLeftUnits - 1 - numLeftUnits));
@@ -21147,6 +21369,29 @@ void IntraPrediction::xGlmCreateGradRef(const PredictionUnit& pu, CompArea chrom
   xGlmSetLumaRefValue(pu, chromaArea);
 #endif
 
+#if CCP_LUMA_REF_CACHE
+  // the luma plane and the gradient plane are filled together, both have to be present for the block
+  const int glmIdx = pu.glmIdc.getIdc(chromaArea.compID, 0);
+  CcpLumaRefCacheEntry& lumaCacheEntry = m_glmGradRefCache[0];
+  CcpLumaRefCacheEntry& gradCacheEntry = m_glmGradRefCache[glmIdx > NUM_GLM_PATTERN ? glmIdx - NUM_GLM_PATTERN : glmIdx];
+
+  if (isTemplate)
+  {
+    lumaCacheEntry.valid = false;
+    gradCacheEntry.valid = false;
+  }
+  else
+  {
+    const bool lumaHit = xCcpLumaRefCacheHit(lumaCacheEntry, chromaArea, m_glmRefArea);
+    const bool gradHit = xCcpLumaRefCacheHit(gradCacheEntry, chromaArea, m_glmRefArea);
+
+    if (lumaHit && gradHit)
+    {
+      return;
+    }
+  }
+#endif
+
 #if JVET_AF0073_INTER_CCP_MERGE
   if (!isTemplate)
   {
@@ -22174,7 +22419,7 @@ void IntraPrediction::xPredTmrlIntraAng(const CPelBuf& pSrc, const ClpRng& clpRn
     std::swap(uiTemplateAbove, uiTemplateLeft);
   }
   const int iAreaSize = MAX_CU_SIZE + TMRL_TPL_SIZE;
-  static Pel tempArray[iAreaSize * iAreaSize];
+  static thread_local Pel tempArray[iAreaSize * iAreaSize];
   const int dstStride = iDstStride;
   Pel* pDstBuf = bIsModeVer ? pTrueDst : tempArray;
 
@@ -22679,17 +22924,6 @@ void IntraPrediction::getTmrlList(CodingUnit& cu)
 #endif
 
 #if JVET_AG0058_EIP
-int64_t IntraPrediction::calcAeipGroupSum(const Pel* src1, const Pel* src2, const int numSamples)
-{
-  int64_t sum = 0;
-  for (int i = 0; i < numSamples; i++)
-  {
-    sum += src1[i] * src2[i];
-  }
-
-  return sum;
-}
-
 #if JVET_AB0174_CCCM_DIV_FREE
 void CccmCovariance::solveEip(const TCccmCoeff* A, const TCccmCoeff* Y, const int sampleNum, const int lumaOffset, CccmModel& model)
 #else
@@ -22798,7 +23032,7 @@ void IntraPrediction::initEipParams(const PredictionUnit& pu, const ComponentID
   const int  numAboveRightUnits = totalAboveUnits - numAboveUnits;
   const int  numLeftBelowUnits = totalLeftUnits - numLeftUnits;
 
-  static bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
+  static thread_local bool neighborFlags[4 * MAX_NUM_PART_IDXS_IN_CTU_WIDTH + 1] = { false }; // Just a dummy array here, content not used
   int avaiAboveRightUnits = isAboveRightAvailable(cu, chType, area.topRight(), numAboveRightUnits, unitWidth, (neighborFlags + totalLeftUnits + 1 + numAboveUnits));
   int avaiLeftBelowUnits = isBelowLeftAvailable(cu, chType, area.bottomLeft(), numLeftBelowUnits, unitHeight, (neighborFlags + totalLeftUnits - 1 - numLeftUnits));
 
@@ -22848,8 +23082,6 @@ void IntraPrediction::getCurEipCands(const PredictionUnit& pu, static_vector<Eip
   const int refWidth = m_cccmBlkArea.width;
   PelBuf refBuf(m_eipBuffer, refWidth, refHeight);
   const int bd = pu.cu->slice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA);
-  const int log2BatchSize = 10;
-  const int batchSize = (1 << log2BatchSize);
   const int sizeAtaBuf = ((EIP_FILTER_TAP + 1) * EIP_FILTER_TAP) >> 1;
   const int numInputs = EIP_FILTER_TAP;
   static_vector<EIPInfo, NUM_DERIVED_EIP> eipInfoList;
@@ -22950,29 +23182,23 @@ void IntraPrediction::getCurEipCands(const PredictionUnit& pu, static_vector<Eip
           }
         }
 
-        const int samplesInBatches = (numSamples >> log2BatchSize) << log2BatchSize;
+        TCccmCoeff ata[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX];
+        TCccmCoeff aty[CCCM_NUM_PARAMS_MAX];
+        CccmCovariance::m_calcCovariance(m_a, m_eipYBuffer[refIdx], nullptr, numInputs, numSamples, ata, aty, nullptr);
+
         int i = 0;
         for (int coli0 = 0; coli0 < numInputs; coli0++)
         {
           for (int coli1 = coli0; coli1 < numInputs; coli1++)
           {
-            for (int offset = 0; offset < samplesInBatches; offset += batchSize)
-            {
-              ATABuf[srcBufIdx][i] += m_calcAeipGroupSum(&m_a[coli0][offset], &m_a[coli1][offset], batchSize);
-            }
-            ATABuf[srcBufIdx][i] +=
-              m_calcAeipGroupSum(&m_a[coli0][samplesInBatches], &m_a[coli1][samplesInBatches], numSamples - samplesInBatches);
+            ATABuf[srcBufIdx][i] += ata[coli0][coli1];
             i++;
           }
         }
 
         for (int coli = 0; coli < numInputs; coli++)
         {
-          for (int offset = 0; offset < samplesInBatches; offset += batchSize)
-          {
-            ATYBuf[srcBufIdx][coli] += m_calcAeipGroupSum(&m_a[coli][offset], &m_eipYBuffer[refIdx][offset], batchSize);
-          }
-          ATYBuf[srcBufIdx][coli] += m_calcAeipGroupSum(&m_a[coli][samplesInBatches], &m_eipYBuffer[refIdx][samplesInBatches], numSamples - samplesInBatches);
+          ATYBuf[srcBufIdx][coli] += aty[coli];
         }
       }
 
@@ -23466,14 +23692,14 @@ void IntraPrediction::getNeiEipCands(const PredictionUnit& pu, static_vector<Eip
 #if JVET_Z0118_GDR
   if (pu.cs->isGdrEnabled() && pu.cs->isClean(pu))
   {
-    tryHistEip(pu.cs->eipLut.lutEip1);  
+    tryHistEip(pu.cs->getEipLut().lutEip1);  
   }
   else
   {
-    tryHistEip(pu.cs->eipLut.lutEip0); 
+    tryHistEip(pu.cs->getEipLut().lutEip0); 
   }
 #else
-  tryHistEip(pu.cs->eipLut.lutEip); 
+  tryHistEip(pu.cs->getEipLut().lutEip); 
 #endif
 }
 
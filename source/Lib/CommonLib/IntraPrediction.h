@@ -188,6 +188,9 @@ struct CccmCovariance
 #endif
   );
 #endif
+  // auto-correlations of the parameter columns (upper triangle) and their cross-correlations with one or two targets
+  static void (*m_calcCovariance)  ( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_MAX], const Pel* C0, const Pel* C1, const int numParams, const int sampleNum, TCccmCoeff ATA[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* ATC0, TCccmCoeff* ATC1 );
+  static void calcCovariance       ( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_MAX], const Pel* C0, const Pel* C1, const int numParams, const int sampleNum, TCccmCoeff ATA[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* ATC0, TCccmCoeff* ATC1 );
 #if JVET_AG0058_EIP
 #if JVET_AB0174_CCCM_DIV_FREE
   void solveEip                    ( const TCccmCoeff* A, const TCccmCoeff* Y, const int sampleNum, const int lumaOffset, CccmModel& model );
@@ -202,7 +205,10 @@ private:
   TCccmCoeff C[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX + 2];
 
 #if JVET_AC0053_GAUSSIAN_SOLVER
+  template<int fixedNumEq>
   void gaussBacksubstitution       ( TCccmCoeff* x, int numEq, int col );
+  template<int fixedNumEq>
+  void gaussSolve                  ( TCccmCoeff* x0, TCccmCoeff* x1, int numEq, int numFilters );
 #if JVET_AE0059_INTER_CCCM
   void gaussElimination            ( TCccmCoeff A[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* y0, TCccmCoeff* x0, TCccmCoeff* y1, TCccmCoeff* x1, int numEq, int numFilters, int bd, const bool interCccmMode = false);
 #else
@@ -386,6 +392,18 @@ private:
 #if JVET_AC0119_LM_CHROMA_FUSION
   Area m_cflmRefArea;
   Pel* m_cflmBuf[3];
+#endif
+#if CCP_LUMA_REF_CACHE
+  struct CcpLumaRefCacheEntry
+  {
+    bool valid;
+    Area blkArea;
+    Area refArea;
+  };
+  bool                 m_ccpLumaRefCacheEnabled;
+  CcpLumaRefCacheEntry m_cccmLumaRefCache[CCCM_NUM_PRED_FILTER + 1];
+  CcpLumaRefCacheEntry m_glmGradRefCache[NUM_GLM_IDC];
+  CcpLumaRefCacheEntry m_cflmLumaRefCache;
 #endif
   MatrixIntraPrediction m_matrixIntraPred;
 #if JVET_AG0136_INTRA_TMP_LIC
@@ -427,6 +445,20 @@ protected:
   unsigned int m_uiPicStride;
   unsigned int m_uiVaildCandiNum;
   Pel***       m_pppTarPatch;
+#if TMP_SEARCH_SUM_PRUNING
+  std::vector<uint32_t> m_tmpIntegral;        // integral image of the reconstruction over the window of the current TMP search
+  int                   m_tmpIntegralX;       // window position relative to the current block
+  int                   m_tmpIntegralY;
+  int                   m_tmpIntegralStride;
+
+  void xBuildTmpIntegral( const Pel* ref, const int refStride, const int x0, const int y0, const int width, const int height );
+  int  xTmpRefSum       ( const int x, const int y, const int width, const int height ) const
+  {
+    const uint32_t* top    = m_tmpIntegral.data() + ( y - m_tmpIntegralY ) * m_tmpIntegralStride + ( x - m_tmpIntegralX );
+    const uint32_t* bottom = top + height * m_tmpIntegralStride;
+    return int( bottom[width] - bottom[0] - top[width] + top[0] );
+  }
+#endif
 #endif
 
 #if TMP_FAST_ENC
@@ -660,6 +692,10 @@ public:
   int    xCflmCalcRefAver         (const PredictionUnit& pu, const CompArea& chromaArea);
   void   xCflmCalcRefArea         (const PredictionUnit& pu, const CompArea& chromaArea);
 #endif
+#if CCP_LUMA_REF_CACHE
+  void   setCcpLumaRefCache       (bool enable);
+  bool   xCcpLumaRefCacheHit      (CcpLumaRefCacheEntry& entry, const Area& blkArea, const Area& refArea);
+#endif
 
 #if JVET_AD0188_CCP_MERGE || JVET_AG0154_DECODER_DERIVED_CCP_FUSION
 #if JVET_AG0154_DECODER_DERIVED_CCP_FUSION
@@ -737,6 +773,7 @@ public:
 #if !JVET_AG0061_INTER_LFNST_NSPT
   static int  buildHistogram      ( const Pel *pReco, int iStride, uint32_t uiHeight, uint32_t uiWidth, int* piHistogram, int direction, int bw, int bh );
 #endif
+  static int (*m_buildHistogram)  ( const Pel *pReco, int iStride, uint32_t uiHeight, uint32_t uiWidth, int* piHistogram, int direction, int bw, int bh );
 #endif
 #if JVET_W0123_TIMD_FUSION || JVET_AC0119_LM_CHROMA_FUSION
   void xIntraPredTimdHorVerPdpc   (Pel* pDsty,const int dstStride, Pel* refSide, const int width, const int height, int xOffset, int yOffset, int scale, const Pel* refMain, const ClpRng& clpRng);
@@ -751,7 +788,8 @@ public:
   void predTimdIbcItmp(const ComponentID compId, const PredictionUnit& pu, Mv Bv, Pel* pPred, uint32_t uiStride, uint32_t iWidth, uint32_t iHeight, TemplateType eTempType, int32_t iTemplateWidth, int32_t iTemplateHeight, Pel* piOrg, int orgStride);
   void predUsingBv(Pel* piPred, unsigned int uiStride, Mv Bv, CodingUnit cu);
 #endif
-  void xIntraPredTimdAngLuma(Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset);
+  static void xIntraPredTimdAngLuma(Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset);
+  static void (*m_timdAngLuma)     (Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset);
 #if JVET_AC0119_LM_CHROMA_FUSION
   void xIntraPredTimdAngChroma(Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset);
 #endif
@@ -840,8 +878,6 @@ public:
   void initEipParams(const PredictionUnit& pu, const ComponentID compId);
   void eipPred(const PredictionUnit& pu, PelBuf& piPred, const ComponentID compId = COMPONENT_Y);
   void getCurEipCands(const PredictionUnit& pu, static_vector<EipModelCandidate, NUM_DERIVED_EIP>& candList, const ComponentID compId = COMPONENT_Y, const bool fastTest = true); 
-  int64_t (*m_calcAeipGroupSum)(const Pel* src1, const Pel* src2, const int numSamples);
-  static int64_t calcAeipGroupSum(const Pel* src1, const Pel* src2, const int numSamples);
 
   void getNeiEipCands(const PredictionUnit &pu, static_vector<EipModelCandidate, MAX_MERGE_EIP> &candList, const ComponentID compId = COMPONENT_Y);
   void reorderEipCands(const PredictionUnit &pu, static_vector<EipModelCandidate, MAX_MERGE_EIP> &candList, const ComponentID compId = COMPONENT_Y);
@@ -1157,6 +1193,8 @@ public:
   void    initIntraX86();
   template <X86_VEXT vext>
   void    _initIntraX86();
+  template <X86_VEXT vext>
+  static void _initIntraStaticX86();
 #endif
 };
 //! \}
@@ -44,6 +44,13 @@
 #include "dtrace_codingstruct.h"
 #include "dtrace_buffer.h"
 
+#if ENABLE_PARALLEL_DEBLOCKING
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
 //! \ingroup CommonLib
 //! \{
 
@@ -106,6 +113,18 @@ LoopFilter::LoopFilter()
 {
 #if JVET_AB0171_ASYMMETRIC_DB_FOR_GDR
   m_asymmetricDB = false;
+  m_applyAsymmetricDB = false;
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  m_maxCUDepth = 0;
+  m_numThreads = 1;
+#endif
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+  m_deblockLumaSegment   = nullptr;
+  m_deblockChromaSegment = nullptr;
+#ifdef TARGET_SIMD_X86
+  initLoopFilterX86();
+#endif
 #endif
 }
 
@@ -126,6 +145,9 @@ void LoopFilter::create( const unsigned uiMaxCUDepth )
     m_aapbEdgeFilter[edgeDir].resize( numPartitions );
   }
   m_enc = false;
+#if ENABLE_PARALLEL_DEBLOCKING
+  m_maxCUDepth = uiMaxCUDepth;
+#endif
 }
 
 void LoopFilter::initEncPicYuvBuffer(ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize)
@@ -143,6 +165,9 @@ void LoopFilter::destroy()
     m_aapbEdgeFilter[edgeDir].clear();
   }
   m_encPicYuvBuffer.destroy();
+#if ENABLE_PARALLEL_DEBLOCKING
+  m_rowFilters.clear();
+#endif
 }
 
 /**
@@ -170,82 +195,210 @@ void LoopFilter::loopFilterPic( CodingStructure& cs
   }
 #endif
 
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+#if ENABLE_PARALLEL_DEBLOCKING
+  if( xUseParallelRows( cs ) )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    xLoopFilterRowsParallel( cs );
+  }
+  else
+#endif
+  {
+    for( int y = 0; y < pcv.heightInCtus; y++ )
     {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-      clearFilterLengthAndTransformEdge();
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        xDeblockCU( currCU, EDGE_VER );
+        xDeblockCtu( cs, x, y, EDGE_VER );
       }
+    }
 
-      if( CS::isDualITree( cs ) )
+    // Vertical filtering
+    for( int y = 0; y < pcv.heightInCtus; y++ )
+    {
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-        clearFilterLengthAndTransformEdge();
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
+        xDeblockCtu( cs, x, y, EDGE_HOR );
       }
     }
   }
 
-  // Vertical filtering
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
+
+  DTRACE    ( g_trace_ctx, D_CRC, "LoopFilter" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+}
+
+void LoopFilter::xDeblockCtu( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+  memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+  clearFilterLengthAndTransformEdge();
+  m_ctuXLumaSamples = ctuX << pcv.maxCUWidthLog2;
+  m_ctuYLumaSamples = ctuY << pcv.maxCUHeightLog2;
+
+  const UnitArea ctuArea( pcv.chrFormat, Area( ctuX << pcv.maxCUWidthLog2, ctuY << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+  CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
+  if( cs.slice != firstCU->slice )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    // only written when the slice changes, the threads deblocking a single-slice picture just read it
+    cs.slice = firstCU->slice;
+  }
+
+  // CU-based deblocking
+  for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+  {
+    xDeblockCU( currCU, edgeDir );
+  }
+
+  if( CS::isDualITree( cs ) )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+    clearFilterLengthAndTransformEdge();
+
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
     {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-      clearFilterLengthAndTransformEdge();
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
+      xDeblockCU( currCU, edgeDir );
+    }
+  }
+}
 
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
+#if ENABLE_PARALLEL_DEBLOCKING
+bool LoopFilter::xUseParallelRows( const CodingStructure& cs ) const
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  if( m_numThreads < 2 || pcv.heightInCtus < 2 || m_enc )
+  {
+    return false;
+  }
+
+  // the CU-level tools read the slice of the coding structure, which the threads share: it has to be the same for all CTUs
+  const Slice* slice = cs.getCU( Position( 0, 0 ), CH_L )->slice;
+  for( int ctuRsAddr = 1; ctuRsAddr < pcv.sizeInCtus; ctuRsAddr++ )
+  {
+    const Position ctuPos( ( ctuRsAddr % pcv.widthInCtus ) << pcv.maxCUWidthLog2, ( ctuRsAddr / pcv.widthInCtus ) << pcv.maxCUHeightLog2 );
+    if( cs.getCU( ctuPos, CH_L )->slice != slice )
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+/**
+ - deblock the CTU rows of a single-slice picture concurrently
+ .
+ A thread takes the next CTU row, filters its vertical edges and then its horizontal edges CTU by CTU. The vertical
+ edges only modify samples of the own row. The horizontal edges at the top of a CTU read and modify the bottom lines
+ of the CTU above, which are final once that CTU is filtered horizontally, so each CTU waits for the one above.
+ The result equals the one of the serial filter.
+ */
+void LoopFilter::xLoopFilterRowsParallel( CodingStructure& cs )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int numThreads = std::min<int>( m_numThreads, pcv.heightInCtus );
+
+  while( (int) m_rowFilters.size() < numThreads - 1 )
+  {
+    m_rowFilters.emplace_back( new LoopFilter );
+    m_rowFilters.back()->create( m_maxCUDepth );
+  }
+  for( auto& rowFilter : m_rowFilters )
+  {
+    rowFilter->m_shiftHor = m_shiftHor;
+    rowFilter->m_shiftVer = m_shiftVer;
+#if JVET_AB0171_ASYMMETRIC_DB_FOR_GDR
+    rowFilter->setAsymmetricDB( m_asymmetricDB );
+#endif
+  }
+  cs.slice = cs.getCU( Position( 0, 0 ), CH_L )->slice;
+
+  std::vector<int>        horFiltered( pcv.heightInCtus, 0 );   ///< number of CTUs of each row filtered horizontally
+  std::mutex              progressLock;
+  std::condition_variable progressChanged;
+  std::exception_ptr      failure;
+  bool                    failed  = false;
+  int                     nextRow = 0;
+
+  auto filterRows = [&]( LoopFilter& loopFilter )
+  {
+    while( true )
+    {
+      int y;
       {
-        xDeblockCU( currCU, EDGE_HOR );
+        std::lock_guard<std::mutex> lock( progressLock );
+        if( failed || nextRow == pcv.heightInCtus )
+        {
+          return;
+        }
+        y = nextRow++;
       }
 
-      if( CS::isDualITree( cs ) )
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-        clearFilterLengthAndTransformEdge();
+        loopFilter.xDeblockCtu( cs, x, y, EDGE_VER );
+      }
+
+      for( int x = 0; x < pcv.widthInCtus; x++ )
+      {
+        if( y > 0 )
+        {
+          std::unique_lock<std::mutex> lock( progressLock );
+          progressChanged.wait( lock, [&]() { return failed || horFiltered[y - 1] > x; } );
+          if( failed )
+          {
+            return;
+          }
+        }
+
+        loopFilter.xDeblockCtu( cs, x, y, EDGE_HOR );
 
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
         {
-          xDeblockCU( currCU, EDGE_HOR );
+          std::lock_guard<std::mutex> lock( progressLock );
+          horFiltered[y] = x + 1;
         }
+        progressChanged.notify_all();
       }
     }
-  }
+  };
 
-  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
+  auto runThread = [&]( LoopFilter& loopFilter )
+  {
+    try
+    {
+      filterRows( loopFilter );
+    }
+    catch( ... )
+    {
+      std::lock_guard<std::mutex> lock( progressLock );
+      if( !failed )
+      {
+        failure = std::current_exception();
+        failed  = true;
+      }
+      progressChanged.notify_all();
+    }
+  };
 
-  DTRACE    ( g_trace_ctx, D_CRC, "LoopFilter" );
-  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+  std::vector<std::thread> threads;
+  for( int tId = 1; tId < numThreads; tId++ )
+  {
+    threads.emplace_back( runThread, std::ref( *m_rowFilters[tId - 1] ) );
+  }
+  runThread( *this );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+  if( failure )
+  {
+    std::rethrow_exception( failure );
+  }
 }
+#endif
 
 void LoopFilter::resetFilterLengths()
 {
@@ -1097,7 +1250,7 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   unsigned     uiNumParts   = ( ( ( edgeDir == EDGE_VER ) ? lumaArea.height / pcv.minCUHeight : lumaArea.width / pcv.minCUWidth ) );
   int          pelsInPart   = pcv.minCUWidth;
   unsigned     uiBsAbsIdx   = 0, uiBs = 0;
-  int          iOffset, iSrcStep;
+  int          iSrcStep;
 
   bool  bPartPNoFilter  = false;
   bool  bPartQNoFilter  = false;
@@ -1111,7 +1264,6 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   {
     xoffset   = 0;
     yoffset   = pelsInPart;
-    iOffset   = 1;
     iSrcStep  = iStride;
     piTmpSrc += iEdge * pelsInPart;
     pos       = Position{ lumaArea.x + iEdge * pelsInPart, lumaArea.y - yoffset };
@@ -1120,7 +1272,6 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
   {
     xoffset   = pelsInPart;
     yoffset   = 0;
-    iOffset   = iStride;
     iSrcStep  = 1;
     piTmpSrc += iEdge*pelsInPart*iStride;
     pos       = Position{ lumaArea.x - xoffset, lumaArea.y + iEdge * pelsInPart };
@@ -1230,114 +1381,21 @@ void LoopFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edg
 
       const int iTc = bitDepthLuma < 10 ? ((sm_tcTable[iIndexTC] + (1 << (9 - bitDepthLuma))) >> (10 - bitDepthLuma)) : ((sm_tcTable[iIndexTC]) << (bitDepthLuma - 10));
       const int iBeta     = sm_betaTable[iIndexB ] * iBitdepthScale;
-      const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
-      const int iThrCut   = iTc * 10;
 
       const unsigned uiBlocksInPart = pelsInPart / 4 ? pelsInPart / 4 : 1;
 
-      for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+      bPartPNoFilter = bPartQNoFilter = false;
+      if (spsPaletteEnabledFlag)
       {
-        const int dp0 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dq0 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0), iOffset);
-        const int dp3 = xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        const int dq3 = xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3), iOffset);
-        int dp0L = dp0;
-        int dq0L = dq0;
-        int dp3L = dp3;
-        int dq3L = dq3;
-
-        if (sidePisLarge)
-        {
-          dp0L = (dp0L + xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0) - 3 * iOffset, iOffset) + 1) >> 1;
-          dp3L = (dp3L + xCalcDP(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3) - 3 * iOffset, iOffset) + 1) >> 1;
-        }
-        if (sideQisLarge)
-        {
-          dq0L = (dq0L + xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 0) + 3 * iOffset, iOffset) + 1) >> 1;
-          dq3L = (dq3L + xCalcDQ(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + 3) + 3 * iOffset, iOffset) + 1) >> 1;
-        }
-        bool useLongtapFilter = false;
-        if (sidePisLarge || sideQisLarge)
-        {
-          int d0L = dp0L + dq0L;
-          int d3L = dp3L + dq3L;
-
-          int dpL = dp0L + dp3L;
-          int dqL = dq0L + dq3L;
-
-          int dL = d0L + d3L;
-
-          bPartPNoFilter = bPartQNoFilter = false;
-          if (spsPaletteEnabledFlag)
-          {
-            // check if each of PUs is palette coded
-            bPartPNoFilter = bPartPNoFilter || CU::isPLT(cuP);
-            bPartQNoFilter = bPartQNoFilter || CU::isPLT(cuQ);
-          }
-
-          if (dL < iBeta)
-          {
-            const bool filterP = (dpL < iSideThreshold);
-            const bool filterQ = (dqL < iSideThreshold);
-
-            Pel* src0 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 0);
-            Pel* src3 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 3);
-
-            // adjust decision so that it is not read beyond p5 is maxFilterLengthP is 5 and q5 if maxFilterLengthQ is 5
-            const bool swL = xUseStrongFiltering(src0, iOffset, 2 * d0L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ)
-              && xUseStrongFiltering(src3, iOffset, 2 * d3L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-            if (swL)
-            {
-              useLongtapFilter = true;
-              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-              {
-                xPelFilterLuma(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-              }
-            }
-
-          }
-        }
-        if (!useLongtapFilter)
-        {
-          const int d0 = dp0 + dq0;
-          const int d3 = dp3 + dq3;
-
-          const int dp = dp0 + dp3;
-          const int dq = dq0 + dq3;
-          const int d  = d0 + d3;
-
-          bPartPNoFilter = bPartQNoFilter = false;
-          if (spsPaletteEnabledFlag)
-          {
-            // check if each of PUs is palette coded
-            bPartPNoFilter = bPartPNoFilter || CU::isPLT(cuP);
-            bPartQNoFilter = bPartQNoFilter || CU::isPLT(cuQ);
-          }
+        // check if each of PUs is palette coded
+        bPartPNoFilter = bPartPNoFilter || CU::isPLT(cuP);
+        bPartQNoFilter = bPartQNoFilter || CU::isPLT(cuQ);
+      }
 
-          if (d < iBeta)
-          {
-            bool bFilterP = false;
-            bool bFilterQ = false;
-            if (maxFilterLengthP > 1 && maxFilterLengthQ > 1)
-            {
-              bFilterP = (dp < iSideThreshold);
-              bFilterQ = (dq < iSideThreshold);
-            }
-            bool sw = false;
-            if (maxFilterLengthP > 2 && maxFilterLengthQ > 2)
-            {
-              sw = xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + 0), iOffset, 2 * d0,
-                                       iBeta, iTc)
-                   && xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + 3), iOffset, 2 * d3,
-                                          iBeta, iTc);
-            }
-            for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-            {
-              xPelFilterLuma(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, sw,
-                             bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
-            }
-          }
-        }
+      for( int iBlkIdx = 0; iBlkIdx < uiBlocksInPart; iBlkIdx++ )
+      {
+        deblockLumaSegment( piTmpSrc + iSrcStep * ( iIdx * pelsInPart + iBlkIdx * 4 ), iStride, edgeDir == EDGE_VER, iTc, iBeta,
+                            maxFilterLengthP, maxFilterLengthQ, sidePisLarge, sideQisLarge, bPartPNoFilter, bPartQNoFilter, clpRng );
       }
     }
   }
@@ -1363,7 +1421,7 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   const unsigned uiPelsInPartChromaH = pcv.minCUWidth  >> ::getComponentScaleX(COMPONENT_Cb, nChromaFormat);
   const unsigned uiPelsInPartChromaV = pcv.minCUHeight >> ::getComponentScaleY(COMPONENT_Cb, nChromaFormat);
 
-  int       iOffset, iSrcStep;
+  int       iSrcStep;
   unsigned  uiLoopLength;
 
   bool      bPartPNoFilter  = false;
@@ -1399,7 +1457,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   {
     xoffset      = 0;
     yoffset      = uiNumPelsLuma;
-    iOffset      = 1;
     iSrcStep     = iStride;
     piTmpSrcCb  += iEdge*uiPelsInPartChromaH;
     piTmpSrcCr  += iEdge*uiPelsInPartChromaH;
@@ -1410,7 +1467,6 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
   {
     xoffset      = uiNumPelsLuma;
     yoffset      = 0;
-    iOffset      = iStride;
     iSrcStep     = 1;
     piTmpSrcCb  += iEdge*iStride*uiPelsInPartChromaV;
     piTmpSrcCr  += iEdge*iStride*uiPelsInPartChromaV;
@@ -1523,56 +1579,193 @@ void LoopFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir ed
           const int iTc = bitDepthChroma < 10
             ? ( ( sm_tcTable[iIndexTC] + ( 1 << ( 9 - bitDepthChroma ) ) ) >> ( 10 - bitDepthChroma ) )
             : ( ( sm_tcTable[iIndexTC] ) << ( bitDepthChroma - 10 ) );
-          bool useLongFilter = false;
-          if( largeBoundary )
-          {
-            const int indexB = Clip3<int>( 0, MAX_QP, iQP + ( betaOffsetDiv2[chromaIdx] << 1 ) );
-            const int beta = sm_betaTable[indexB] * iBitdepthScale;
+          const int indexB = Clip3<int>( 0, MAX_QP, iQP + ( betaOffsetDiv2[chromaIdx] << 1 ) );
+          const int beta   = sm_betaTable[indexB] * iBitdepthScale;
+          const int subSamplingShift = ( edgeDir == EDGE_VER ) ? m_shiftVer : m_shiftHor;
+
+          deblockChromaSegment( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength ), iStride, edgeDir == EDGE_VER, uiLoopLength,
+                                ( subSamplingShift == 1 ) ? 1 : 3, iTc, beta, largeBoundary, isChromaHorCTBBoundary, bPartPNoFilter, bPartQNoFilter, clpRng );
+        }
+      }
+    }
+  }
+}
+
+void LoopFilter::deblockLumaSegment( Pel* src, const int stride, const bool verEdge, const int tc, const int beta, const int maxFilterLengthP, const int maxFilterLengthQ, const bool sidePisLarge, const bool sideQisLarge, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng )
+{
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+  if( m_deblockLumaSegment
+#if JVET_AB0171_ASYMMETRIC_DB_FOR_GDR
+      && !m_applyAsymmetricDB
+#endif
+    )
+  {
+    m_deblockLumaSegment( src, stride, verEdge, tc, beta, maxFilterLengthP, maxFilterLengthQ, sidePisLarge, sideQisLarge, partPNoFilter, partQNoFilter, clpRng );
+    return;
+  }
+#endif
+  xDeblockLumaSegment( src, stride, verEdge, tc, beta, maxFilterLengthP, maxFilterLengthQ, sidePisLarge, sideQisLarge, partPNoFilter, partQNoFilter, clpRng );
+}
+
+void LoopFilter::deblockChromaSegment( Pel* src, const int stride, const bool verEdge, const int numLines, const int decisionLine, const int tc, const int beta, const bool largeBoundary, const bool isChromaHorCTBBoundary, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng )
+{
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+  if( m_deblockChromaSegment
+#if JVET_AB0171_ASYMMETRIC_DB_FOR_GDR
+      && !m_applyAsymmetricDB
+#endif
+    )
+  {
+    m_deblockChromaSegment( src, stride, verEdge, numLines, decisionLine, tc, beta, largeBoundary, isChromaHorCTBBoundary, partPNoFilter, partQNoFilter, clpRng );
+    return;
+  }
+#endif
+  xDeblockChromaSegment( src, stride, verEdge, numLines, decisionLine, tc, beta, largeBoundary, isChromaHorCTBBoundary, partPNoFilter, partQNoFilter, clpRng );
+}
 
-            const int dp0 =
-              xCalcDP( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 0 ), iOffset, isChromaHorCTBBoundary );
-            const int dq0 = xCalcDQ( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 0 ), iOffset );
+/**
+ - Decisions and deblocking of the 4 lines of a luma edge segment
+ .
+ \param src              pointer to the first line of the segment at the edge
+ \param stride           picture stride
+ \param verEdge          vertical edge, the lines are rows
+ */
+void LoopFilter::xDeblockLumaSegment( Pel* src, const int stride, const bool verEdge, const int iTc, const int iBeta, const int maxFilterLengthP, const int maxFilterLengthQ, const bool sidePisLarge, const bool sideQisLarge, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const
+{
+  const int iOffset        = verEdge ? 1 : stride;
+  const int srcStep        = verEdge ? stride : 1;
+  const int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
+  const int iThrCut        = iTc * 10;
+
+  const int dp0 = xCalcDP(src, iOffset);
+  const int dq0 = xCalcDQ(src, iOffset);
+  const int dp3 = xCalcDP(src + srcStep * 3, iOffset);
+  const int dq3 = xCalcDQ(src + srcStep * 3, iOffset);
+  int dp0L = dp0;
+  int dq0L = dq0;
+  int dp3L = dp3;
+  int dq3L = dq3;
+
+  if (sidePisLarge)
+  {
+    dp0L = (dp0L + xCalcDP(src - 3 * iOffset, iOffset) + 1) >> 1;
+    dp3L = (dp3L + xCalcDP(src + srcStep * 3 - 3 * iOffset, iOffset) + 1) >> 1;
+  }
+  if (sideQisLarge)
+  {
+    dq0L = (dq0L + xCalcDQ(src + 3 * iOffset, iOffset) + 1) >> 1;
+    dq3L = (dq3L + xCalcDQ(src + srcStep * 3 + 3 * iOffset, iOffset) + 1) >> 1;
+  }
+  bool useLongtapFilter = false;
+  if (sidePisLarge || sideQisLarge)
+  {
+    int d0L = dp0L + dq0L;
+    int d3L = dp3L + dq3L;
 
-            const int subSamplingShift = ( edgeDir == EDGE_VER ) ? m_shiftVer : m_shiftHor;
+    int dpL = dp0L + dp3L;
+    int dqL = dq0L + dq3L;
 
-            const int dp3 =
-              ( subSamplingShift == 1 )
-              ? xCalcDP( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 1 ), iOffset, isChromaHorCTBBoundary )
-              : xCalcDP( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 3 ), iOffset, isChromaHorCTBBoundary );
-            const int dq3 = ( subSamplingShift == 1 )
-              ? xCalcDQ( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 1 ), iOffset )
-              : xCalcDQ( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 3 ), iOffset );
+    int dL = d0L + d3L;
 
-            const int d0 = dp0 + dq0;
-            const int d3 = dp3 + dq3;
-            const int d = d0 + d3;
+    if (dL < iBeta)
+    {
+      const bool filterP = (dpL < iSideThreshold);
+      const bool filterQ = (dqL < iSideThreshold);
 
-            if( d < beta )
-            {
-              useLongFilter = true;
-              const bool sw = xUseStrongFiltering( piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + 0 ), iOffset,
-                                                   2 * d0, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary )
-                && xUseStrongFiltering(
-                  piTmpSrcChroma + iSrcStep * ( iIdx * uiLoopLength + ( ( subSamplingShift == 1 ) ? 1 : 3 ) ),
-                  iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary );
-
-              for( unsigned step = 0; step < uiLoopLength; step++ )
-              {
-                xPelFilterChroma( piTmpSrcChroma + iSrcStep * ( step + iIdx * uiLoopLength ), iOffset, iTc, sw,
-                                  bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary );
-              }
-            }
-          }
-          if( !useLongFilter )
-          {
-            for( unsigned step = 0; step < uiLoopLength; step++ )
-            {
-              xPelFilterChroma( piTmpSrcChroma + iSrcStep * ( step + iIdx * uiLoopLength ), iOffset, iTc, false,
-                                bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary );
-            }
-          }
+      // adjust decision so that it is not read beyond p5 is maxFilterLengthP is 5 and q5 if maxFilterLengthQ is 5
+      const bool swL = xUseStrongFiltering(src, iOffset, 2 * d0L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ)
+        && xUseStrongFiltering(src + srcStep * 3, iOffset, 2 * d3L, iBeta, iTc, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
+      if (swL)
+      {
+        useLongtapFilter = true;
+        for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
+        {
+          xPelFilterLuma(src + srcStep * i, iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
         }
       }
+
+    }
+  }
+  if (!useLongtapFilter)
+  {
+    const int d0 = dp0 + dq0;
+    const int d3 = dp3 + dq3;
+
+    const int dp = dp0 + dp3;
+    const int dq = dq0 + dq3;
+    const int d  = d0 + d3;
+
+    if (d < iBeta)
+    {
+      bool bFilterP = false;
+      bool bFilterQ = false;
+      if (maxFilterLengthP > 1 && maxFilterLengthQ > 1)
+      {
+        bFilterP = (dp < iSideThreshold);
+        bFilterQ = (dq < iSideThreshold);
+      }
+      bool sw = false;
+      if (maxFilterLengthP > 2 && maxFilterLengthQ > 2)
+      {
+        sw = xUseStrongFiltering(src, iOffset, 2 * d0,
+                                 iBeta, iTc)
+             && xUseStrongFiltering(src + srcStep * 3, iOffset, 2 * d3,
+                                    iBeta, iTc);
+      }
+      for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
+      {
+        xPelFilterLuma(src + srcStep * i, iOffset, iTc, sw,
+                       bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
+      }
+    }
+  }
+}
+
+/**
+ - Decisions and deblocking of the 2 or 4 lines of a chroma edge segment
+ .
+ \param src              pointer to the first line of the segment at the edge
+ \param stride           picture stride
+ \param verEdge          vertical edge, the lines are rows
+ \param numLines         number of lines of the segment
+ \param decisionLine     second line the strong filter decision is taken on (1 or 3)
+ */
+void LoopFilter::xDeblockChromaSegment( Pel* src, const int stride, const bool verEdge, const int numLines, const int decisionLine, const int iTc, const int beta, const bool largeBoundary, const bool isChromaHorCTBBoundary, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const
+{
+  const int iOffset = verEdge ? 1 : stride;
+  const int srcStep = verEdge ? stride : 1;
+
+  bool useLongFilter = false;
+  if( largeBoundary )
+  {
+    const int dp0 = xCalcDP( src, iOffset, isChromaHorCTBBoundary );
+    const int dq0 = xCalcDQ( src, iOffset );
+    const int dp3 = xCalcDP( src + srcStep * decisionLine, iOffset, isChromaHorCTBBoundary );
+    const int dq3 = xCalcDQ( src + srcStep * decisionLine, iOffset );
+
+    const int d0 = dp0 + dq0;
+    const int d3 = dp3 + dq3;
+    const int d = d0 + d3;
+
+    if( d < beta )
+    {
+      useLongFilter = true;
+      const bool sw = xUseStrongFiltering( src, iOffset, 2 * d0, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary )
+        && xUseStrongFiltering( src + srcStep * decisionLine, iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary );
+
+      for( int step = 0; step < numLines; step++ )
+      {
+        xPelFilterChroma( src + srcStep * step, iOffset, iTc, sw,
+                          bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary );
+      }
+    }
+  }
+  if( !useLongFilter )
+  {
+    for( int step = 0; step < numLines; step++ )
+    {
+      xPelFilterChroma( src + srcStep * step, iOffset, iTc, false,
+                        bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary );
     }
   }
 }
@@ -42,6 +42,11 @@
 #include "Unit.h"
 #include "Picture.h"
 
+#if ENABLE_PARALLEL_DEBLOCKING
+#include <memory>
+#include <vector>
+#endif
+
 //! \ingroup CommonLib
 //! \{
 
@@ -77,8 +82,23 @@ private:
                                                 // left edge of CTU][luma/chroma sample distance from top edge of CTU]
   PelStorage                   m_encPicYuvBuffer;
   bool                         m_enc;
+#if ENABLE_PARALLEL_DEBLOCKING
+  unsigned                     m_maxCUDepth;
+  int                          m_numThreads;                               ///< number of threads deblocking a picture
+  std::vector<std::unique_ptr<LoopFilter>> m_rowFilters;                   ///< deblocking contexts of the additional threads
+#endif
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+  // decide on and filter the lines of an edge segment, null when no SIMD implementation is available
+  void ( *m_deblockLumaSegment )  ( Pel* src, const int stride, const bool verEdge, const int tc, const int beta, const int maxFilterLengthP, const int maxFilterLengthQ, const bool sidePisLarge, const bool sideQisLarge, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng );
+  void ( *m_deblockChromaSegment )( Pel* src, const int stride, const bool verEdge, const int numLines, const int decisionLine, const int tc, const int beta, const bool largeBoundary, const bool isChromaHorCTBBoundary, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng );
+#endif
 private:
   void clearFilterLengthAndTransformEdge();
+  void xDeblockCtu                ( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir );
+#if ENABLE_PARALLEL_DEBLOCKING
+  bool xUseParallelRows           ( const CodingStructure& cs ) const;
+  void xLoopFilterRowsParallel    ( CodingStructure& cs );
+#endif
 
   // set / get functions
   void xSetLoopfilterParam        ( const CodingUnit& cu );
@@ -94,6 +114,8 @@ private:
                                     const bool            EdgeIdx = false );
   void xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge );
   void xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdgeDir edgeDir, const int iEdge);
+  void xDeblockLumaSegment        ( Pel* src, const int stride, const bool verEdge, const int iTc, const int iBeta, const int maxFilterLengthP, const int maxFilterLengthQ, const bool sidePisLarge, const bool sideQisLarge, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const;
+  void xDeblockChromaSegment      ( Pel* src, const int stride, const bool verEdge, const int numLines, const int decisionLine, const int iTc, const int beta, const bool largeBoundary, const bool isChromaHorCTBBoundary, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng ) const;
 
 #if LUMA_ADAPTIVE_DEBLOCKING_FILTER_QP_OFFSET
   void deriveLADFShift( const Pel* src, const int stride, int& shift, const DeblockEdgeDir edgeDir, const SPS sps );
@@ -136,6 +158,9 @@ public:
 
   void  create                    ( const unsigned uiMaxCUDepth );
   void  destroy                   ();
+#if ENABLE_PARALLEL_DEBLOCKING
+  void  setNumThreads             ( int numThreads ) { m_numThreads = numThreads; }
+#endif
 
   /// picture-level deblocking filter
   void loopFilterPic              ( CodingStructure& cs
@@ -149,6 +174,18 @@ public:
 
   void resetFilterLengths();
 
+  /// decisions and deblocking of one edge segment, through the SIMD kernel when one is available
+  void deblockLumaSegment         ( Pel* src, const int stride, const bool verEdge, const int tc, const int beta, const int maxFilterLengthP, const int maxFilterLengthQ, const bool sidePisLarge, const bool sideQisLarge, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng );
+  void deblockChromaSegment       ( Pel* src, const int stride, const bool verEdge, const int numLines, const int decisionLine, const int tc, const int beta, const bool largeBoundary, const bool isChromaHorCTBBoundary, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng );
+
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+#ifdef TARGET_SIMD_X86
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
+#endif
+
 #if JVET_AB0171_ASYMMETRIC_DB_FOR_GDR
 private:
   bool m_applyAsymmetricDB;
@@ -57,6 +57,13 @@ MatrixIntraPrediction::MatrixIntraPrediction():
   m_upsmpFactorHor( 0 ),
   m_upsmpFactorVer( 0 )
 {
+  m_reducedPredMul = reducedPredMul;
+  m_predUpsampling = predictionUpsampling;
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_MIP
+  initMatrixIntraPredictionX86();
+#endif
+#endif
 }
 
 void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth,
@@ -146,7 +153,8 @@ void MatrixIntraPrediction::predBlock(int *const result, const int modeIdx, cons
 #endif
   if( needUpsampling )
   {
-    predictionUpsampling( result, reducedPred );
+    m_predUpsampling( result, reducedPred, m_refSamplesTop.data(), m_refSamplesLeft.data(), m_blockSize.width,
+                      m_blockSize.height, m_reducedPredSize, m_upsmpFactorHor, m_upsmpFactorVer );
   }
 }
 
@@ -254,29 +262,31 @@ void MatrixIntraPrediction::predictionUpsampling1D(int* const dst, const int* co
 }
 
 
-void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* const src ) const
+void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* const src, const int* const refTop, const int* const refLeft,
+                                                  const SizeType width, const SizeType height, const SizeType reducedPredSize,
+                                                  const unsigned int upsmpFactorHor, const unsigned int upsmpFactorVer )
 {
   const int* verSrc     = src;
-  SizeType   verSrcStep = m_blockSize.width;
+  SizeType   verSrcStep = width;
 
-  if( m_upsmpFactorHor > 1 )
+  if( upsmpFactorHor > 1 )
   {
-    int* const horDst = dst + (m_upsmpFactorVer - 1) * m_blockSize.width;
+    int* const horDst = dst + (upsmpFactorVer - 1) * width;
     verSrc = horDst;
-    verSrcStep *= m_upsmpFactorVer;
+    verSrcStep *= upsmpFactorVer;
 
-    predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
-                            m_reducedPredSize, m_reducedPredSize,
-                            1, m_reducedPredSize, 1, verSrcStep,
-                            m_upsmpFactorVer, m_upsmpFactorHor );
+    predictionUpsampling1D( horDst, src, refLeft,
+                            reducedPredSize, reducedPredSize,
+                            1, reducedPredSize, 1, verSrcStep,
+                            upsmpFactorVer, upsmpFactorHor );
   }
 
-  if( m_upsmpFactorVer > 1 )
+  if( upsmpFactorVer > 1 )
   {
-    predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
-                            m_reducedPredSize, m_blockSize.width,
-                            verSrcStep, 1, m_blockSize.width, 1,
-                            1, m_upsmpFactorVer );
+    predictionUpsampling1D( dst, verSrc, refTop,
+                            reducedPredSize, width,
+                            verSrcStep, 1, width, 1,
+                            1, upsmpFactorVer );
   }
 }
 
@@ -309,14 +319,35 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
   const int offset = (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
   CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
 
-  const uint8_t *weight = matrix;
   const int   inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
 
-  const bool redSize = (m_sizeId == 2);
+  m_reducedPredMul( resPtr, input, matrix, m_sizeId, offset, inputOffset, bitDepth );
+
+  if( transpose )
+  {
+    for( int y = 0; y < m_reducedPredSize; y++ )
+    {
+      for( int x = 0; x < m_reducedPredSize; x++ )
+      {
+        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
+      }
+    }
+  }
+}
+
+void MatrixIntraPrediction::reducedPredMul( int* const result, const int* const input, const uint8_t* matrix, const int sizeId,
+                                            const int offset, const int inputOffset, const int bitDepth )
+{
+  const int inputSize       = ( sizeId == 0 ) ? 4 : 8;
+  const int reducedPredSize = ( sizeId < 2 ) ? 4 : 8;
+
+  const uint8_t *weight = matrix;
+
+  const bool redSize = (sizeId == 2);
   int posRes = 0;
-  for( int y = 0; y < m_reducedPredSize; y++ )
+  for( int y = 0; y < reducedPredSize; y++ )
   {
-    for( int x = 0; x < m_reducedPredSize; x++ )
+    for( int x = 0; x < reducedPredSize; x++ )
     {
       if( redSize ) weight -= 1;
       int tmp0 = redSize ? 0 : (input[0] * weight[0]);
@@ -330,20 +361,9 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
         tmp2 += input[i + 2] * weight[i + 2];
         tmp3 += input[i + 3] * weight[i + 3];
       }
-      resPtr[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
+      result[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
 
       weight += inputSize;
     }
   }
-
-  if( transpose )
-  {
-    for( int y = 0; y < m_reducedPredSize; y++ )
-    {
-      for( int x = 0; x < m_reducedPredSize; x++ )
-      {
-        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
-      }
-    }
-  }
 }
@@ -59,6 +59,29 @@ public:
                  const ComponentID compId);
 #endif
 
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_MIP
+  void initMatrixIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initMatrixIntraPredictionX86();
+#endif
+#endif
+
+  protected:
+    // reduced prediction of the (non-transposed) reduced boundary, clipped to the bit depth
+    void ( *m_reducedPredMul )( int* const result, const int* const input, const uint8_t* matrix, const int sizeId,
+                                const int offset, const int inputOffset, const int bitDepth );
+    // bilinear upsampling of the reduced prediction to the block size, horizontally first
+    void ( *m_predUpsampling )( int* const dst, const int* const src, const int* const refTop, const int* const refLeft,
+                                const SizeType width, const SizeType height, const SizeType reducedPredSize,
+                                const unsigned int upsmpFactorHor, const unsigned int upsmpFactorVer );
+
+    static void reducedPredMul( int* const result, const int* const input, const uint8_t* matrix, const int sizeId,
+                                const int offset, const int inputOffset, const int bitDepth );
+    static void predictionUpsampling( int* const dst, const int* const src, const int* const refTop, const int* const refLeft,
+                                      const SizeType width, const SizeType height, const SizeType reducedPredSize,
+                                      const unsigned int upsmpFactorHor, const unsigned int upsmpFactorVer );
+
   private:
     ComponentID m_component;
 
@@ -80,7 +103,6 @@ public:
 
     static void boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen);
 
-    void predictionUpsampling( int* const dst, const int* const src ) const;
     static void predictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
                                         const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
                                         const SizeType srcStep, const SizeType srcStride,
@@ -204,8 +204,32 @@ Picture::Picture()
 #if JVET_Z0118_GDR
   m_cleanDirtyFlag = false;
 #endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  m_reconstructedRows = std::numeric_limits<int>::max();
+#endif
 }
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+void Picture::setReconstructedRows( int numRows )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_progressMutex );
+    m_reconstructedRows.store( numRows, std::memory_order_release );
+  }
+  m_progressCond.notify_all();
+}
+
+void Picture::waitForReconstructedRows( int lumaRow ) const
+{
+  if( getReconstructedRows() >= lumaRow )
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock( m_progressMutex );
+  m_progressCond.wait( lock, [&]() { return getReconstructedRows() >= lumaRow; } );
+}
+#endif
+
 void Picture::create(
   const bool rprEnabled,
 #if JVET_Z0118_GDR
@@ -49,6 +49,12 @@
 #include "Hash.h"
 #include "MCTS.h"
 #include <deque>
+#if ENABLE_FRAME_PARALLEL_DECODING
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#endif
 
 #if ENABLE_SPLIT_PARALLELISM
 
@@ -213,7 +219,25 @@ void create(
   bool getCleanDirty() const    { return m_cleanDirtyFlag; }  
 #endif
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+  /// luma rows at the top of the picture that are reconstructed and in-loop filtered, other pictures may reference them
+  /// (all rows, unless the picture is finished by a worker thread); the margins are padded only when it is finished
+  int  getReconstructedRows()                 const { return m_reconstructedRows.load( std::memory_order_acquire ); }
+  void setReconstructedRows( int numRows );
+  /// blocks until the luma rows above lumaRow (exclusive) are reconstructed and in-loop filtered
+  void waitForReconstructedRows( int lumaRow ) const;
+  /// the picture is finished as a whole, including the padded margins
+  bool isFinished()                           const { return getReconstructedRows() == std::numeric_limits<int>::max(); }
+  void setFinished( bool finished )                 { setReconstructedRows( finished ? std::numeric_limits<int>::max() : 0 ); }
+  void waitUntilFinished()                    const { waitForReconstructedRows( std::numeric_limits<int>::max() ); }
+#endif
+
 private:
+#if ENABLE_FRAME_PARALLEL_DECODING
+  std::atomic<int>                m_reconstructedRows;
+  mutable std::mutex              m_progressMutex;
+  mutable std::condition_variable m_progressCond;
+#endif
   Window        m_conformanceWindow;
   Window        m_scalingWindow;
   int           m_decodingOrderNumber;
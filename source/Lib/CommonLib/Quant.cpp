@@ -505,7 +505,7 @@ void Quant::init( uint32_t uiMaxTrSize,
   m_resetStore = true;
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void Quant::copyState( const Quant& other )
 {
   m_dLambda = other.m_dLambda;
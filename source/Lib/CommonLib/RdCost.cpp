@@ -49,6 +49,7 @@
 
 
 FpDistFunc RdCost::m_afpDistortFunc[DF_TOTAL_FUNCTIONS] = { nullptr, };
+FpGeoSADFunc RdCost::m_fpGeoSADAllSplits = nullptr;
 
 RdCost::RdCost()
 {
@@ -232,6 +233,7 @@ void RdCost::init()
   m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD;
 
   m_afpDistortFunc[DF_SAD_WITH_MASK] = RdCost::xGetSADwMask;
+  m_fpGeoSADAllSplits                = RdCost::xGetGeoSADAllSplits;
 #if TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM
   m_afpDistortFunc[DF_TM_A_WSAD_FULL_NBIT  ] = RdCost::xGetTMErrorFull<TM_TPL_SIZE, true,  false>;
   m_afpDistortFunc[DF_TM_L_WSAD_FULL_NBIT  ] = RdCost::xGetTMErrorFull<TM_TPL_SIZE, false, false>;
@@ -254,7 +256,7 @@ void RdCost::init()
 }
 
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 
 void RdCost::copyState( const RdCost& other )
 {
@@ -3686,6 +3688,72 @@ Distortion RdCost::xGetSADwMask( const DistParam& rcDtParam )
   return (sum >> distortionShift );
 }
 
+void RdCost::xGetGeoSADAllSplits( const DistParam& rcDtParam, const int maskVariant, Distortion* sadPart0 )
+{
+  const int  cols   = rcDtParam.org.width;
+  const int  rows   = rcDtParam.org.height;
+  const int  wIdx   = floorLog2( cols ) - GEO_MIN_CU_LOG2;
+  const int  hIdx   = floorLog2( rows ) - GEO_MIN_CU_LOG2;
+
+  if( rcDtParam.applyWeight )
+  {
+    DistParam distParam = rcDtParam;
+    for( int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++ )
+    {
+      const GeoMaskView& maskView = g_geoMaskView[maskVariant][splitDir][hIdx][wIdx];
+      distParam.mask        = maskView.sadMask;
+      distParam.maskStride  = maskView.stride;
+      distParam.stepX       = maskView.stepX;
+      distParam.maskStride2 = -maskView.stepX * cols;
+      sadPart0[splitDir]    = xGetSADwMask( distParam );
+    }
+    return;
+  }
+
+  const int  subShift   = rcDtParam.subShift;
+  const int  subStep    = 1 << subShift;
+  const int  strideOrg  = rcDtParam.org.stride * subStep;
+  const int  strideCur  = rcDtParam.cur.stride * subStep;
+  const uint32_t distortionShift = DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+
+  // the absolute differences are shared by all split directions, only the masks differ
+  Pel        absDiff[GEO_MAX_CU_SIZE * GEO_MAX_CU_SIZE];
+  const Pel* org    = rcDtParam.org.buf;
+  const Pel* cur    = rcDtParam.cur.buf;
+  int        numRow = 0;
+  for( int y = 0; y < rows; y += subStep, numRow++ )
+  {
+    for( int x = 0; x < cols; x++ )
+    {
+      absDiff[numRow * cols + x] = abs( org[x] - cur[x] );
+    }
+    org += strideOrg;
+    cur += strideCur;
+  }
+
+  for( int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++ )
+  {
+    const GeoMaskView& maskView   = g_geoMaskView[maskVariant][splitDir][hIdx][wIdx];
+    const Pel*         mask       = maskView.sadMask;
+    const int          strideMask = maskView.stride * subStep;
+    const int          stepX      = maskView.stepX;
+    const Pel*         diff       = absDiff;
+
+    Distortion sum = 0;
+    for( int row = 0; row < numRow; row++ )
+    {
+      for( int x = 0; x < cols; x++ )
+      {
+        sum += diff[x] * mask[x * stepX];
+      }
+      diff += cols;
+      mask += strideMask;
+    }
+    sum <<= subShift;
+    sadPart0[splitDir] = sum >> distortionShift;
+  }
+}
+
 #if TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM
 template <int tplSize, bool trueAfalseL, bool mr>
 Distortion RdCost::xGetTMErrorFull( const DistParam& rcDtParam )
@@ -89,6 +89,7 @@ class EncCfg;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
+typedef void       (*FpGeoSADFunc) (const DistParam&, int, Distortion*);
 
 // ====================================================================================================================
 // Class definition
@@ -148,6 +149,7 @@ private:
   // for distortion
 
   static FpDistFunc       m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  static FpGeoSADFunc     m_fpGeoSADAllSplits;
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -230,6 +232,8 @@ public:
   void           setTimdDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY, int iOrgStride, int iRefStride, int bitDepth, ComponentID compID, int width, int height, int subShiftMode = 0, int step = 1, bool useHadamard = false );
 #endif
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRefY, int iRefStride, const Pel* mask01, int iMaskStride, int stepX, int iMaskStride2, int bitDepth, ComponentID compID);
+  // SADs of the first GPM partition (g_geoMaskView SAD masks of the mask variant) for all split directions of one prediction, same values as the DF_SAD_WITH_MASK function
+  void           getGeoSADAllSplits( const DistParam &rcDP, int maskVariant, Distortion sadPart0[GEO_NUM_PARTITION_MODE] ) const { m_fpGeoSADAllSplits( rcDP, maskVariant, sadPart0 ); }
 #if TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &cur, int bitDepth, bool trueAfalseL, int wIdx, int subShift, ComponentID compID);
 #endif
@@ -907,7 +911,7 @@ public:
 #endif
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void copyState( const RdCost& other );
 #endif
 
@@ -1081,6 +1085,7 @@ private:
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
   static Distortion xGetSADwMask      ( const DistParam& pcDtParam );
+  static void       xGetGeoSADAllSplits( const DistParam& pcDtParam, int maskVariant, Distortion* sadPart0 );
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
@@ -1140,6 +1145,8 @@ private:
 
   template< X86_VEXT vext >
   static Distortion xGetSADwMask_SIMD( const DistParam& pcDtParam );
+  template< X86_VEXT vext >
+  static void       xGetGeoSADAllSplits_SIMD( const DistParam& pcDtParam, int maskVariant, Distortion* sadPart0 );
 #endif
 
 public:
@@ -64,11 +64,11 @@ MsgLevel g_verbosity = VERBOSE;
 #if SIGN_PREDICTION
 #if JVET_Y0141_SIGN_PRED_IMPROVE
 #if JVET_W0119_LFNST_EXTENSION || EXTENDED_LFNST
-int8_t * g_resiBorderTemplateLFNST[6][6][210];
+std::atomic<int8_t*> g_resiBorderTemplateLFNST[6][6][210];
 #else
-int8_t * g_resiBorderTemplateLFNST[6][6][16];
+std::atomic<int8_t*> g_resiBorderTemplateLFNST[6][6][16];
 #endif
-int8_t * g_resiBorderTemplate[6][6][NUM_TRANS_TYPE*NUM_TRANS_TYPE];
+std::atomic<int8_t*> g_resiBorderTemplate[SIGN_PRED_NUM_AREAS][6][6][NUM_TRANS_TYPE*NUM_TRANS_TYPE];
 #else
 const int8_t * g_resiBorderTemplate[6][6][NUM_TRANS_TYPE*NUM_TRANS_TYPE];
 #endif
@@ -4499,9 +4499,16 @@ void initROM()
 
   initGeoTemplate();
 
+#if ENABLE_WPP_PARALLELISM
+  ::memset(g_isReusedUniMVsFilled, 0, sizeof(ReusedUniMvsFilled) * REUSED_UNI_MVS_SIZE);
+#if INTER_LIC
+  ::memset(g_isReusedUniMVsFilledLIC, 0, sizeof(ReusedUniMvsFilledLIC) * REUSED_UNI_MVS_LIC_SIZE);
+#endif
+#else
   ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
 #if INTER_LIC
   ::memset(g_isReusedUniMVsFilledLIC, 0, sizeof(g_isReusedUniMVsFilledLIC));
+#endif
 #endif
 
   for (int qp = 0; qp < 57; qp++)
@@ -4560,8 +4567,8 @@ void initROM()
 #endif
   
 #if JVET_Y0141_SIGN_PRED_IMPROVE
-  memset(&g_resiBorderTemplate[0][0][0], 0, sizeof(g_resiBorderTemplate));
-  memset(&g_resiBorderTemplateLFNST[0][0][0], 0, sizeof(g_resiBorderTemplateLFNST));
+  std::fill( &g_resiBorderTemplate[0][0][0][0], &g_resiBorderTemplate[0][0][0][0] + sizeof( g_resiBorderTemplate ) / sizeof( g_resiBorderTemplate[0][0][0][0] ), nullptr );
+  std::fill( &g_resiBorderTemplateLFNST[0][0][0], &g_resiBorderTemplateLFNST[0][0][0] + sizeof( g_resiBorderTemplateLFNST ) / sizeof( g_resiBorderTemplateLFNST[0][0][0] ), nullptr );
 #endif
 #if TU_256
   c = 256;
@@ -4828,31 +4835,10 @@ void destroyROM()
   }
   delete[] g_geoParams;
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
-#if JVET_AB0155_SGPM
-  for( int bldIdx = 0; bldIdx < TOTAL_GEO_BLENDING_NUM; bldIdx++ )
-#else
-  for( int bldIdx = 0; bldIdx < GEO_BLENDING_NUM; bldIdx++ )
-#endif
-  {
-    for (int i = 0; i < GEO_NUM_PRESTORED_MASK; i++)
-    {
-      delete[] g_geoWeights[bldIdx][i];
-      g_geoWeights[bldIdx][i] = nullptr;
-#if GPM_CURVE
-      delete[] g_geoCurveWeights[bldIdx][i];
-      g_geoCurveWeights[bldIdx][i] = nullptr;
-#endif
-    }
-  }
-
   for (int i = 0; i < GEO_NUM_PRESTORED_MASK; i++)
   {
     delete[] g_geoEncSadMask[i];
     g_geoEncSadMask[i] = nullptr;
-#if GPM_CURVE
-    delete[] g_geoCurveEncSadMask[i];
-    g_geoCurveEncSadMask[i] = nullptr;
-#endif
 #if JVET_Z0056_GPM_SPLIT_MODE_REORDERING
     delete[] g_geoWeightsTpl[i];
     g_geoWeightsTpl[i] = nullptr;
@@ -4876,12 +4862,15 @@ void destroyROM()
   {
     for (int log2Height = 0; log2Height < 6; log2Height++)
     {
-      for (int idx = 0; idx < NUM_TRANS_TYPE*NUM_TRANS_TYPE; idx++)
+      for (int areaIdx = 0; areaIdx < SIGN_PRED_NUM_AREAS; areaIdx++)
       {
-        if (g_resiBorderTemplate[log2Width][log2Height][idx])
+        for (int idx = 0; idx < NUM_TRANS_TYPE*NUM_TRANS_TYPE; idx++)
         {
-          xFree(g_resiBorderTemplate[log2Width][log2Height][idx]);
-          g_resiBorderTemplate[log2Width][log2Height][idx] = nullptr;
+          if (g_resiBorderTemplate[areaIdx][log2Width][log2Height][idx])
+          {
+            xFree(g_resiBorderTemplate[areaIdx][log2Width][log2Height][idx]);
+            g_resiBorderTemplate[areaIdx][log2Width][log2Height][idx] = nullptr;
+          }
         }
       }
 #if JVET_W0119_LFNST_EXTENSION || EXTENDED_LFNST
@@ -5215,6 +5204,18 @@ const uint32_t g_scalingListId[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM] =
   {  0,  0,  0,  0,  0,  0},  // SCALING_LIST_128x128
 };
 
+#if ENABLE_WPP_PARALLELISM
+static ReusedUniMvs       s_reusedUniMVs        [REUSED_UNI_MVS_SIZE];
+static ReusedUniMvsFilled s_isReusedUniMVsFilled[REUSED_UNI_MVS_SIZE];
+thread_local ReusedUniMvs*       g_reusedUniMVs         = s_reusedUniMVs;
+thread_local ReusedUniMvsFilled* g_isReusedUniMVsFilled = s_isReusedUniMVsFilled;
+#if INTER_LIC
+static ReusedUniMvsLIC       s_reusedUniMVsLIC        [REUSED_UNI_MVS_LIC_SIZE];
+static ReusedUniMvsFilledLIC s_isReusedUniMVsFilledLIC[REUSED_UNI_MVS_LIC_SIZE];
+thread_local ReusedUniMvsLIC*       g_reusedUniMVsLIC         = s_reusedUniMVsLIC;
+thread_local ReusedUniMvsFilledLIC* g_isReusedUniMVsFilledLIC = s_isReusedUniMVsFilledLIC;
+#endif
+#else
 #if CTU_256
 Mv   g_reusedUniMVs        [MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2][33];
 bool g_isReusedUniMVsFilled[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
@@ -5226,22 +5227,12 @@ bool g_isReusedUniMVsFilled[32][32][8][8];
 Mv   g_reusedUniMVsLIC        [MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2][33];
 bool g_isReusedUniMVsFilledLIC[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
 #endif
+#endif
 
 uint16_t g_paletteQuant[57];
 uint8_t g_paletteRunTopLut [5] = { 0, 1, 1, 2, 2 };
 uint8_t g_paletteRunLeftLut[5] = { 0, 1, 2, 3, 4 };
 
-#if GPM_CURVE
-const int circleCenter[6][3]={
-  {-153,56,46656},
-  {-153,4,49729},
-  {-153,-49,58564},
-  {-153,-153,93636},
-  {-49,-153,58564},
-  {56,-153,46656},
-};
-#endif
-
 void initGeoTemplate()
 {
   g_geoParams = new int16_t*[GEO_NUM_PARTITION_MODE];
@@ -5263,88 +5254,7 @@ void initGeoTemplate()
     }
   }
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM
-  // initialization of blending weights
-  for (int angleIdx = 0; angleIdx < (GEO_NUM_ANGLES >> 2) + 1; angleIdx++)
-  {
-    if (g_angle2mask[angleIdx] == -1)
-    {
-      continue;
-    }
-#if JVET_AB0155_SGPM
-    for (int bldIdx = 0; bldIdx < TOTAL_GEO_BLENDING_NUM; bldIdx++)
-#else
-    for (int bldIdx = 0; bldIdx < GEO_BLENDING_NUM; bldIdx++)
-#endif
-    {
-#if GPM_CURVE
-      g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]] = new int16_t[GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE];
-      int indexCurve=0;
-      int circleCenterx=circleCenter[g_angle2mask[angleIdx]][0];
-      int circleCentery=circleCenter[g_angle2mask[angleIdx]][1];
-      for (int y=0;y<GEO_WEIGHT_MASK_SIZE;y++)
-      {
-         for(int x=0;x<GEO_WEIGHT_MASK_SIZE;x++,indexCurve++)
-         {
-          int     indexGeoWeight2x, indexGeoWeight2y;
-          indexGeoWeight2x = indexCurve % GEO_WEIGHT_MASK_SIZE;
-          indexGeoWeight2y = 112 - indexCurve / GEO_WEIGHT_MASK_SIZE;
-          int radiusSquare       = (indexGeoWeight2x - circleCenterx) * (indexGeoWeight2x - circleCenterx)
-                         + (indexGeoWeight2y - circleCentery) * (indexGeoWeight2y - circleCentery);
-          int blendweight;
-          blendweight = (int)floor(sqrt(radiusSquare) - sqrt(circleCenter[g_angle2mask[angleIdx]][2]));
-          int bldWidth = g_bld2Width[bldIdx];
-          if(blendweight < -(bldWidth >> 1))
-          {
-            g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]][indexCurve] = 0;
-          }
-          else if (blendweight > (bldWidth >> 1))
-          {
-            g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]][indexCurve] = 32;
-          }
-          else
-          {
-            g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]][indexCurve] = blendweight * 32 / bldWidth + 16;
-          }
-          g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]][indexCurve] = Clip3<int>(0,32,g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]][indexCurve]);
-          // g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]][indexCurve]*=100;
-         }
-      }
-#endif
-      g_geoWeights[bldIdx][g_angle2mask[angleIdx]] = new int16_t[GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE];
-
-      int distanceX = angleIdx;
-      int distanceY = (distanceX + (GEO_NUM_ANGLES >> 2)) % GEO_NUM_ANGLES;
-      int16_t rho = (g_dis[distanceX] << (GEO_MAX_CU_LOG2 + 1)) + (g_dis[distanceY] << (GEO_MAX_CU_LOG2 + 1));
-      static const int16_t maskOffset = (2 * GEO_MAX_CU_SIZE - GEO_WEIGHT_MASK_SIZE) >> 1;
-      int index = 0;
-
-      for (int y = 0; y < GEO_WEIGHT_MASK_SIZE; y++)
-      {
-        int16_t lookUpY = (((y + maskOffset) << 1) + 1) * g_dis[distanceY];
-        for (int x = 0; x < GEO_WEIGHT_MASK_SIZE; x++, index++)
-        {
-          int16_t sxi = ((x + maskOffset) << 1) + 1;
-          int16_t weightIdx = sxi * g_dis[distanceX] + lookUpY - rho;
-          if (g_bld2Width[bldIdx] > 1)
-          {
-            int weightLinearIdx = 8 * g_bld2Width[bldIdx] + weightIdx;
-            g_geoWeights[bldIdx][g_angle2mask[angleIdx]][index] = Clip3(0, 32, (weightLinearIdx + (g_bld2Width[bldIdx] >> 2)) >> floorLog2(g_bld2Width[bldIdx] >> 1));
-          }
-          else
-          {
-            int weightLinearIdx = 8 + weightIdx;
-            g_geoWeights[bldIdx][g_angle2mask[angleIdx]][index] = Clip3(0, 32, weightLinearIdx << 1);
-          }
-#if GPM_BLEND
-          double width = (double)g_bld2Width[bldIdx];
-          double preWeight = (double)g_geoWeights[bldIdx][g_angle2mask[angleIdx]][index];
-          g_geoWeights[bldIdx][g_angle2mask[angleIdx]][index] = (int16_t)round((tanh(preWeight/width * 5.0 - 2.5) + 1.0) * 16.0);
-          g_geoWeights[bldIdx][g_angle2mask[angleIdx]][index] = Clip3<int16_t>(0, 32, g_geoWeights[bldIdx][g_angle2mask[angleIdx]][index]);
-#endif
-        }
-      }
-    }
-  }
+  // blending weights (g_geoWeights, g_geoCurveWeights) are compile-time tables, see xBuildGeoBlendMask()
 
   // initialization of mask weights
   for (int angleIdx = 0; angleIdx < (GEO_NUM_ANGLES >> 2) + 1; angleIdx++)
@@ -5353,26 +5263,6 @@ void initGeoTemplate()
     {
       continue;
     }
-#if GPM_CURVE
-      g_geoCurveEncSadMask[g_angle2mask[angleIdx]] = new int16_t[GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE];
-      int indexCurve=0;
-      int circleCenterx=circleCenter[g_angle2mask[angleIdx]][0];
-      int circleCentery=circleCenter[g_angle2mask[angleIdx]][1];
-      for (int y=0;y<GEO_WEIGHT_MASK_SIZE;y++)
-      {
-         for(int x=0;x<GEO_WEIGHT_MASK_SIZE;x++,indexCurve++)
-         {
-          int     indexGeoWeight2x, indexGeoWeight2y;
-          indexGeoWeight2x = indexCurve % GEO_WEIGHT_MASK_SIZE;
-          indexGeoWeight2y = 112 - indexCurve / GEO_WEIGHT_MASK_SIZE;
-          int radiusSquare       = (indexGeoWeight2x - circleCenterx) * (indexGeoWeight2x - circleCenterx)
-                         + (indexGeoWeight2y - circleCentery) * (indexGeoWeight2y - circleCentery);
-          int blendweight;
-          blendweight = (int)floor(sqrt(radiusSquare) - sqrt(circleCenter[g_angle2mask[angleIdx]][2]));
-          g_geoCurveEncSadMask[g_angle2mask[angleIdx]][indexCurve] = blendweight > 0 ? 1:0;
-         }
-      }
-#endif
 #if JVET_Z0056_GPM_SPLIT_MODE_REORDERING || JVET_AB0155_SGPM
     g_geoWeightsTpl[g_angle2mask[angleIdx]] = new Pel[GEO_WEIGHT_MASK_SIZE_EXT * GEO_WEIGHT_MASK_SIZE_EXT];
 #endif
@@ -5503,6 +5393,76 @@ void initGeoTemplate()
       }
     }
   }
+
+  for( int hIdx = 0; hIdx < GEO_NUM_CU_SIZE; hIdx++ )
+  {
+    for( int wIdx = 0; wIdx < GEO_NUM_CU_SIZE; wIdx++ )
+    {
+      for( int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++ )
+      {
+        const int16_t angle   = g_geoParams[splitDir][0];
+        const int     maskIdx = g_angle2mask[angle];
+        const int     offsetX = g_weightOffset[splitDir][hIdx][wIdx][0];
+        const int     offsetY = g_weightOffset[splitDir][hIdx][wIdx][1];
+        int           posX    = offsetX;
+        int           posY    = offsetY;
+        int           stepX   = 1;
+        int           stride  = GEO_WEIGHT_MASK_SIZE;
+
+        if( g_angle2mirror[angle] == 2 )
+        {
+          posY   = GEO_WEIGHT_MASK_SIZE - 1 - offsetY;
+          stride = -GEO_WEIGHT_MASK_SIZE;
+        }
+        else if( g_angle2mirror[angle] == 1 )
+        {
+          posX  = GEO_WEIGHT_MASK_SIZE - 1 - offsetX;
+          stepX = -1;
+        }
+        const int pos = posY * GEO_WEIGHT_MASK_SIZE + posX;
+#if GPM_CURVE
+        const bool curveSplit = g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX
+                                && CU::isGeoCURVEAvailable( splitDir, 1 << ( wIdx + GEO_MIN_CU_LOG2 ) );
+#endif
+
+        for( int variant = 0; variant < GEO_NUM_MASK_VARIANTS; variant++ )
+        {
+          GeoMaskView& view       = g_geoMaskView[variant][splitDir][hIdx][wIdx];
+          const int    blendShape = variant % GEO_NUM_BLEND_SHAPES;
+
+          view.stepX   = stepX;
+          view.stride  = stride;
+#if GPM_CURVE
+          view.isCurve = curveSplit && variant >= GEO_NUM_BLEND_SHAPES;
+#else
+          view.isCurve = false;
+#endif
+#if JVET_AA0058_GPM_ADAPTIVE_BLENDING
+          for( int bldIdx = 0; bldIdx < (int) ( sizeof( view.weight ) / sizeof( view.weight[0] ) ); bldIdx++ )
+          {
+#if GPM_CURVE
+            view.weight[bldIdx] = view.isCurve ? &g_geoCurveWeights[bldIdx][maskIdx][pos] : &g_geoWeights[blendShape][bldIdx][maskIdx][pos];
+#else
+            view.weight[bldIdx] = &g_geoWeights[blendShape][bldIdx][maskIdx][pos];
+#endif
+          }
+#else
+          view.weight[0] = &g_geoWeights[maskIdx][pos];
+          (void) blendShape;
+#endif
+#if GPM_CURVE && JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+          view.sadMask = &( view.isCurve ? g_geoCurveEncSadMask : g_geoEncSadMask )[maskIdx][pos];
+#else
+          view.sadMask = &g_geoEncSadMask[maskIdx][pos];
+#endif
+#if JVET_Z0056_GPM_SPLIT_MODE_REORDERING
+          view.tplMask   = &g_geoWeightsTpl[maskIdx][( posY + GEO_TM_ADDED_WEIGHT_MASK_SIZE ) * GEO_WEIGHT_MASK_SIZE_EXT + posX + GEO_TM_ADDED_WEIGHT_MASK_SIZE];
+          view.tplStride = stride < 0 ? -GEO_WEIGHT_MASK_SIZE_EXT : GEO_WEIGHT_MASK_SIZE_EXT;
+#endif
+        }
+      }
+    }
+  }
 #if JVET_AB0155_SGPM
   for (int hIdx = 0; hIdx < GEO_NUM_CU_SIZE_EX; hIdx++)
   {
@@ -5533,52 +5493,10 @@ void initGeoTemplate()
     }
   }
 #endif
-#if GPM_CURVE || GPM_BLEND
-  FILE *file0 = fopen("g_geoWeights.txt", "wb");
-  for (int angleIdx = 0; angleIdx < (GEO_NUM_ANGLES >> 2) + 1; angleIdx++)
-  {
-    if (g_angle2mask[angleIdx] == -1)
-    {
-      continue;
-    }
-    for (int bldIdx = 0; bldIdx < TOTAL_GEO_BLENDING_NUM; bldIdx++)
-    {
-      int index = 0;
-      fwrite(g_geoWeights[bldIdx][g_angle2mask[angleIdx]],sizeof(int16_t),GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE,file0);
-    }
-  }
-  fclose(file0);
-#endif
-#if GPM_CURVE
-  FILE *file1 = fopen("g_geoCurveWeights.txt", "wb");
-  for (int angleIdx = 0; angleIdx < (GEO_NUM_ANGLES >> 2) + 1; angleIdx++)
-  {
-    if (g_angle2mask[angleIdx] == -1)
-    {
-      continue;
-    }
-    for (int bldIdx = 0; bldIdx < TOTAL_GEO_BLENDING_NUM; bldIdx++)
-    {
-      int index = 0;
-      fwrite(g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]],sizeof(int16_t),GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE,file1);
-    }
-  }
-  fclose(file1);
-#endif
-
 }
 
 int16_t** g_geoParams;
-#if JVET_AB0155_SGPM
-int16_t *g_geoWeights[TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
-#if GPM_CURVE
-int16_t *g_geoCurveWeights[TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
-#endif
-int      g_bld2Width[TOTAL_GEO_BLENDING_NUM] = { 1, 2, 4, 8, 16, 32 };
-#elif JVET_AA0058_GPM_ADAPTIVE_BLENDING
-int16_t*  g_geoWeights[GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
-int       g_bld2Width[GEO_BLENDING_NUM] = { 1, 2, 4, 8, 16 };
-#else
+#if !JVET_AA0058_GPM_ADAPTIVE_BLENDING && !JVET_AB0155_SGPM
 int16_t*  g_geoWeights   [GEO_NUM_PRESTORED_MASK];
 #endif
 #if JVET_Z0056_GPM_SPLIT_MODE_REORDERING || JVET_AB0155_SGPM
@@ -5586,9 +5504,6 @@ Pel*      g_geoWeightsTpl[GEO_NUM_PRESTORED_MASK];
 #endif
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
 Pel*      g_geoEncSadMask[GEO_NUM_PRESTORED_MASK];
-#if GPM_CURVE
-Pel*      g_geoCurveEncSadMask[GEO_NUM_PRESTORED_MASK];
-#endif
 #else
 int16_t*  g_geoEncSadMask[GEO_NUM_PRESTORED_MASK];
 #endif
@@ -5607,9 +5522,236 @@ int8_t g_sgpmSplitDir[GEO_NUM_PARTITION_MODE] = {
 #endif
 
 int16_t   g_weightOffset       [GEO_NUM_PARTITION_MODE][GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE][2];
-int8_t    g_angle2mask[GEO_NUM_ANGLES] = { 0, -1, 1, 2, 3, 4, -1, -1, 5, -1, -1, 4, 3, 2, 1, -1, 0, -1, 1, 2, 3, 4, -1, -1, 5, -1, -1, 4, 3, 2, 1, -1 };
-int8_t    g_dis[GEO_NUM_ANGLES] = { 8, 8, 8, 8, 4, 4, 2, 1, 0, -1, -2, -4, -4, -8, -8, -8, -8, -8, -8, -8, -4, -4, -2, -1, 0, 1, 2, 4, 4, 8, 8, 8 };
+GeoMaskView g_geoMaskView      [GEO_NUM_MASK_VARIANTS][GEO_NUM_PARTITION_MODE][GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE];
+constexpr int8_t g_angle2mask[GEO_NUM_ANGLES] = { 0, -1, 1, 2, 3, 4, -1, -1, 5, -1, -1, 4, 3, 2, 1, -1, 0, -1, 1, 2, 3, 4, -1, -1, 5, -1, -1, 4, 3, 2, 1, -1 };
+constexpr int8_t g_dis[GEO_NUM_ANGLES] = { 8, 8, 8, 8, 4, 4, 2, 1, 0, -1, -2, -4, -4, -8, -8, -8, -8, -8, -8, -8, -4, -4, -2, -1, 0, 1, 2, 4, 4, 8, 8, 8 };
 int8_t    g_angle2mirror[GEO_NUM_ANGLES] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 2 };
+
+#if JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM
+#if JVET_AB0155_SGPM
+constexpr int g_bld2Width[TOTAL_GEO_BLENDING_NUM] = { 1, 2, 4, 8, 16, 32 };
+#else
+constexpr int g_bld2Width[GEO_BLENDING_NUM] = { 1, 2, 4, 8, 16 };
+#endif
+
+// The GPM blending masks are evaluated at compile time and stored read-only, so that neither the encoder nor the
+// decoder spends start-up time on them. Each mask is a separate constant expression to keep the evaluations small.
+template<typename T>
+struct GeoMaskTable
+{
+  T mask[GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE];
+};
+
+static constexpr int xGeoMaskAngle( const int maskIdx )
+{
+  int angleIdx = 0;
+  while( g_angle2mask[angleIdx] != maskIdx )
+  {
+    angleIdx++;
+  }
+  return angleIdx;
+}
+
+#if GPM_BLEND
+// round( ( tanh( w / bldWidth * 5 - 2.5 ) + 1 ) * 16 ) for the linear blending weights w = 0..32, per blending width
+static constexpr int16_t g_geoTanhBlendWeight[TOTAL_GEO_BLENDING_NUM][33] =
+{
+  { 0, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32 },
+  { 0, 16, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32 },
+  { 0,  2, 16, 30, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32 },
+  { 0,  1,  2,  7, 16, 25, 30, 31, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32 },
+  { 0,  0,  1,  1,  2,  4,  7, 11, 16, 21, 25, 28, 30, 31, 31, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32 },
+  { 0,  0,  0,  1,  1,  1,  1,  2,  2,  3,  4,  6,  7,  9, 11, 14, 16, 18, 21, 23, 25, 26, 28, 29, 30, 30, 31, 31, 31, 31, 32, 32, 32 },
+};
+#endif
+
+// blending weights of one prestored mask, with the linear (blendShape 0) or tanh (blendShape 1) ramp
+static constexpr GeoMaskTable<int16_t> xBuildGeoBlendMask( const int blendShape, const int bldIdx, const int maskIdx )
+{
+  GeoMaskTable<int16_t> table = {};
+  const int bldWidth   = g_bld2Width[bldIdx];
+  int       bldShift   = 0;
+  while( ( 2 << bldShift ) < bldWidth )
+  {
+    bldShift++;
+  }
+  const int distanceX  = xGeoMaskAngle( maskIdx );
+  const int distanceY  = ( distanceX + ( GEO_NUM_ANGLES >> 2 ) ) % GEO_NUM_ANGLES;
+  // multiplications instead of left shifts, which are not constant expressions for negative operands
+  const int rho        = g_dis[distanceX] * ( 2 * GEO_MAX_CU_SIZE ) + g_dis[distanceY] * ( 2 * GEO_MAX_CU_SIZE );
+  const int maskOffset = ( 2 * GEO_MAX_CU_SIZE - GEO_WEIGHT_MASK_SIZE ) >> 1;
+  int       index      = 0;
+
+  for( int y = 0; y < GEO_WEIGHT_MASK_SIZE; y++ )
+  {
+    const int lookUpY = ( ( ( y + maskOffset ) << 1 ) + 1 ) * g_dis[distanceY];
+    for( int x = 0; x < GEO_WEIGHT_MASK_SIZE; x++, index++ )
+    {
+      const int sxi       = ( ( x + maskOffset ) << 1 ) + 1;
+      const int weightIdx = sxi * g_dis[distanceX] + lookUpY - rho;
+      const int weight    = bldWidth > 1 ? ( 8 * bldWidth + weightIdx + ( bldWidth >> 2 ) ) >> bldShift : 2 * ( 8 + weightIdx );
+      table.mask[index] = std::min( 32, std::max( 0, weight ) );
+#if GPM_BLEND
+      if( blendShape == 1 )
+      {
+        table.mask[index] = g_geoTanhBlendWeight[bldIdx][table.mask[index]];
+      }
+#endif
+    }
+  }
+  return table;
+}
+
+template<int blendShape, int bldIdx, int maskIdx>
+static constexpr GeoMaskTable<int16_t> g_geoBlendMask = xBuildGeoBlendMask( blendShape, bldIdx, maskIdx );
+
+#if GPM_CURVE
+// circle centre (x, y) and radius of the curved partition for each prestored mask
+static constexpr int g_geoCurveCircle[GEO_NUM_PRESTORED_MASK][3] =
+{
+  { -153,   56, 216 },
+  { -153,    4, 223 },
+  { -153,  -49, 242 },
+  { -153, -153, 306 },
+  {  -49, -153, 242 },
+  {   56, -153, 216 },
+};
+
+// curve weights for bldIdx >= 0, otherwise the binary encoder SAD mask, both derived from the integer distance
+// floor( sqrt( dx * dx + dy * dy ) ) - radius of the mask position to the circle
+template<typename T>
+static constexpr GeoMaskTable<T> xBuildGeoCurveMask( const int bldIdx, const int maskIdx )
+{
+  GeoMaskTable<T> table    = {};
+  const int       bldWidth = bldIdx < 0 ? 0 : g_bld2Width[bldIdx];
+  int             index    = 0;
+
+  for( int y = 0; y < GEO_WEIGHT_MASK_SIZE; y++ )
+  {
+    const int dy     = GEO_WEIGHT_MASK_SIZE - y - g_geoCurveCircle[maskIdx][1];
+    int       radius = 0;
+    for( int x = 0; x < GEO_WEIGHT_MASK_SIZE; x++, index++ )
+    {
+      const int dx           = x - g_geoCurveCircle[maskIdx][0];
+      const int radiusSquare = dx * dx + dy * dy;
+      // integer square root, tracked along the row
+      while( radius * radius > radiusSquare )
+      {
+        radius--;
+      }
+      while( ( radius + 1 ) * ( radius + 1 ) <= radiusSquare )
+      {
+        radius++;
+      }
+      const int dist = radius - g_geoCurveCircle[maskIdx][2];
+      if( bldIdx < 0 )
+      {
+        table.mask[index] = dist > 0 ? 1 : 0;
+      }
+      else
+      {
+        table.mask[index] = dist < -( bldWidth >> 1 ) ? 0 : dist > ( bldWidth >> 1 ) ? 32 : std::min( 32, std::max( 0, dist * 32 / bldWidth + 16 ) );
+      }
+    }
+  }
+  return table;
+}
+
+template<int bldIdx, int maskIdx>
+static constexpr GeoMaskTable<int16_t> g_geoCurveMask = xBuildGeoCurveMask<int16_t>( bldIdx, maskIdx );
+
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+template<int maskIdx>
+static constexpr GeoMaskTable<Pel> g_geoCurveSadMask = xBuildGeoCurveMask<Pel>( -1, maskIdx );
+#endif
+#endif
+
+static_assert( GEO_NUM_PRESTORED_MASK == 6, "the GPM mask tables below list 6 prestored masks" );
+#define GEO_MASKS( table, ... ) { table<__VA_ARGS__ 0>.mask, table<__VA_ARGS__ 1>.mask, table<__VA_ARGS__ 2>.mask, table<__VA_ARGS__ 3>.mask, table<__VA_ARGS__ 4>.mask, table<__VA_ARGS__ 5>.mask }
+
+#if JVET_AB0155_SGPM
+#define GEO_BLEND_MASKS( blendShape )                                                                                 \
+  {                                                                                                                    \
+    GEO_MASKS( g_geoBlendMask, blendShape, 0, ), GEO_MASKS( g_geoBlendMask, blendShape, 1, ),                          \
+    GEO_MASKS( g_geoBlendMask, blendShape, 2, ), GEO_MASKS( g_geoBlendMask, blendShape, 3, ),                          \
+    GEO_MASKS( g_geoBlendMask, blendShape, 4, ), GEO_MASKS( g_geoBlendMask, blendShape, 5, ),                          \
+  }
+const int16_t* const g_geoWeights[GEO_NUM_BLEND_SHAPES][TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK] =
+{
+  GEO_BLEND_MASKS( 0 ),
+#if GPM_BLEND
+  GEO_BLEND_MASKS( 1 ),
+#endif
+};
+#if GPM_CURVE
+const int16_t* const g_geoCurveWeights[TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK] =
+{
+  GEO_MASKS( g_geoCurveMask, 0, ), GEO_MASKS( g_geoCurveMask, 1, ), GEO_MASKS( g_geoCurveMask, 2, ),
+  GEO_MASKS( g_geoCurveMask, 3, ), GEO_MASKS( g_geoCurveMask, 4, ), GEO_MASKS( g_geoCurveMask, 5, ),
+};
+#endif
+#else
+#define GEO_BLEND_MASKS( blendShape )                                                                                 \
+  {                                                                                                                    \
+    GEO_MASKS( g_geoBlendMask, blendShape, 0, ), GEO_MASKS( g_geoBlendMask, blendShape, 1, ),                          \
+    GEO_MASKS( g_geoBlendMask, blendShape, 2, ), GEO_MASKS( g_geoBlendMask, blendShape, 3, ),                          \
+    GEO_MASKS( g_geoBlendMask, blendShape, 4, ),                                                                       \
+  }
+const int16_t* const g_geoWeights[GEO_NUM_BLEND_SHAPES][GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK] =
+{
+  GEO_BLEND_MASKS( 0 ),
+#if GPM_BLEND
+  GEO_BLEND_MASKS( 1 ),
+#endif
+};
+#endif
+#if GPM_CURVE && JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+const Pel* const g_geoCurveEncSadMask[GEO_NUM_PRESTORED_MASK] = GEO_MASKS( g_geoCurveSadMask, );
+#endif
+#undef GEO_BLEND_MASKS
+#undef GEO_MASKS
+
+#if GPM_CURVE || GPM_BLEND
+void dumpGeoTemplate( const std::string& fileNamePrefix )
+{
+  const int numBld = sizeof( g_bld2Width ) / sizeof( g_bld2Width[0] );
+
+  for( int blendShape = 0; blendShape < GEO_NUM_BLEND_SHAPES; blendShape++ )
+  {
+    FILE* file = fopen( ( fileNamePrefix + ( blendShape ? "g_geoTanhWeights.txt" : "g_geoWeights.txt" ) ).c_str(), "wb" );
+    CHECK( file == nullptr, "Failed to open GPM weight dump file" );
+    for( int angleIdx = 0; angleIdx < ( GEO_NUM_ANGLES >> 2 ) + 1; angleIdx++ )
+    {
+      if( g_angle2mask[angleIdx] == -1 )
+      {
+        continue;
+      }
+      for( int bldIdx = 0; bldIdx < numBld; bldIdx++ )
+      {
+        fwrite( g_geoWeights[blendShape][bldIdx][g_angle2mask[angleIdx]], sizeof( int16_t ), GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE, file );
+      }
+    }
+    fclose( file );
+  }
+#if GPM_CURVE
+  FILE* file = fopen( ( fileNamePrefix + "g_geoCurveWeights.txt" ).c_str(), "wb" );
+  CHECK( file == nullptr, "Failed to open GPM curve weight dump file" );
+  for( int angleIdx = 0; angleIdx < ( GEO_NUM_ANGLES >> 2 ) + 1; angleIdx++ )
+  {
+    if( g_angle2mask[angleIdx] == -1 )
+    {
+      continue;
+    }
+    for( int bldIdx = 0; bldIdx < numBld; bldIdx++ )
+    {
+      fwrite( g_geoCurveWeights[bldIdx][g_angle2mask[angleIdx]], sizeof( int16_t ), GEO_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE, file );
+    }
+  }
+  fclose( file );
+#endif
+}
+#endif
+#endif
 #if JVET_Y0065_GPM_INTRA
 int8_t    g_geoAngle2IntraAng[GEO_NUM_ANGLES] = {50, 0, 44, 41, 34, 27, 0, 0, 18, 0, 0, 9, 66, 59, 56, 0, 50, 0, 44, 41, 34, 27, 0, 0, 18, 0, 0, 9, 66, 59, 56, 0};
 #endif
@@ -43,6 +43,7 @@
 
 #include <stdio.h>
 #include <iostream>
+#include <atomic>
 
 
 //! \ingroup CommonLib
@@ -63,11 +64,11 @@ void         destroyROM();
 #if SIGN_PREDICTION
 #if JVET_Y0141_SIGN_PRED_IMPROVE
 #if JVET_W0119_LFNST_EXTENSION || EXTENDED_LFNST
-extern       int8_t * g_resiBorderTemplateLFNST[6][6][210];
+extern std::atomic<int8_t*> g_resiBorderTemplateLFNST[6][6][210];
 #else
-extern       int8_t * g_resiBorderTemplateLFNST[6][6][16];
+extern std::atomic<int8_t*> g_resiBorderTemplateLFNST[6][6][16];
 #endif
-extern       int8_t * g_resiBorderTemplate[6][6][NUM_TRANS_TYPE*NUM_TRANS_TYPE];
+extern std::atomic<int8_t*> g_resiBorderTemplate[SIGN_PRED_NUM_AREAS][6][6][NUM_TRANS_TYPE*NUM_TRANS_TYPE];
 #else
 extern const int8_t * g_resiBorderTemplate[6][6][NUM_TRANS_TYPE*NUM_TRANS_TYPE];
 #endif
@@ -343,6 +344,27 @@ extern const int32_t   g_aucNumTrCombo[5][5];
 extern bool g_mctsDecCheckEnabled;
 
 class  Mv;
+#if ENABLE_WPP_PARALLELISM
+// one row of the reused uni-prediction MV tables, the tables are bound per thread to the storage of its CU encoder stack
+#if CTU_256
+typedef Mv   ReusedUniMvs      [MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2][33];
+typedef bool ReusedUniMvsFilled[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
+static const int REUSED_UNI_MVS_SIZE = MAX_CU_SIZE >> MIN_CU_LOG2;
+#else
+typedef Mv   ReusedUniMvs      [32][8][8][2][33];
+typedef bool ReusedUniMvsFilled[32][8][8];
+static const int REUSED_UNI_MVS_SIZE = 32;
+#endif
+extern thread_local ReusedUniMvs*       g_reusedUniMVs;
+extern thread_local ReusedUniMvsFilled* g_isReusedUniMVsFilled;
+#if INTER_LIC
+typedef Mv   ReusedUniMvsLIC      [MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2][33];
+typedef bool ReusedUniMvsFilledLIC[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
+static const int REUSED_UNI_MVS_LIC_SIZE = MAX_CU_SIZE >> MIN_CU_LOG2;
+extern thread_local ReusedUniMvsLIC*       g_reusedUniMVsLIC;
+extern thread_local ReusedUniMvsFilledLIC* g_isReusedUniMVsFilledLIC;
+#endif
+#else
 #if CTU_256
 extern Mv   g_reusedUniMVs        [MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2][33];
 extern bool g_isReusedUniMVsFilled[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
@@ -354,6 +376,7 @@ extern bool g_isReusedUniMVsFilled[32][32][8][8];
 extern Mv   g_reusedUniMVsLIC        [MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1][2][33];
 extern bool g_isReusedUniMVsFilledLIC[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
 #endif
+#endif
 
 extern uint16_t g_paletteQuant[57];
 extern uint8_t g_paletteRunTopLut[5];
@@ -368,31 +391,61 @@ const int g_IBCBufferSize = 256 * 128;
 void initGeoTemplate();
 extern int16_t** g_geoParams;
 #if JVET_AB0155_SGPM
-extern int16_t *g_geoWeights[TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
-extern int      g_bld2Width[TOTAL_GEO_BLENDING_NUM];
+extern const int16_t* const g_geoWeights[GEO_NUM_BLEND_SHAPES][TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
+extern const int      g_bld2Width[TOTAL_GEO_BLENDING_NUM];
 #if GPM_CURVE
-extern int16_t *g_geoCurveWeights[TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
+extern const int16_t* const g_geoCurveWeights[TOTAL_GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
 #endif
 #elif JVET_AA0058_GPM_ADAPTIVE_BLENDING
-extern int16_t*  g_geoWeights   [GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
-extern int       g_bld2Width          [GEO_BLENDING_NUM];
+extern const int16_t* const g_geoWeights[GEO_NUM_BLEND_SHAPES][GEO_BLENDING_NUM][GEO_NUM_PRESTORED_MASK];
+extern const int       g_bld2Width          [GEO_BLENDING_NUM];
 #else
 extern int16_t*  g_geoWeights   [GEO_NUM_PRESTORED_MASK];
 #endif
+#if (JVET_AA0058_GPM_ADAPTIVE_BLENDING || JVET_AB0155_SGPM) && (GPM_CURVE || GPM_BLEND)
+void dumpGeoTemplate( const std::string& fileNamePrefix );
+#endif
 #if JVET_Z0056_GPM_SPLIT_MODE_REORDERING || JVET_AB0155_SGPM
 extern Pel*      g_geoWeightsTpl[GEO_NUM_PRESTORED_MASK];
 #endif
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
 extern Pel*      g_geoEncSadMask[GEO_NUM_PRESTORED_MASK];
 #if GPM_CURVE
-extern Pel*      g_geoCurveEncSadMask[GEO_NUM_PRESTORED_MASK];
+extern const Pel* const g_geoCurveEncSadMask[GEO_NUM_PRESTORED_MASK];
 #endif
 #else
 extern int16_t*  g_geoEncSadMask[GEO_NUM_PRESTORED_MASK];
 #endif
 extern int16_t   g_weightOffset       [GEO_NUM_PARTITION_MODE][GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE][2];
-extern int8_t    g_angle2mask         [GEO_NUM_ANGLES];
-extern int8_t    g_dis[GEO_NUM_ANGLES];
+
+// GPM mask addressing of one split direction and CU size, resolved once in initGeoTemplate(). The pointers refer to
+// the mask sample of the top-left CU sample, the curve partition and the blending ramp of the mask variant
+// (SPS::getGeoMaskVariant()) being already taken into account.
+struct GeoMaskView
+{
+#if JVET_AB0155_SGPM
+  const int16_t* weight[TOTAL_GEO_BLENDING_NUM];  ///< blending weights, per blending width
+#elif JVET_AA0058_GPM_ADAPTIVE_BLENDING
+  const int16_t* weight[GEO_BLENDING_NUM];        ///< blending weights, per blending width
+#else
+  const int16_t* weight[1];                       ///< blending weights
+#endif
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  const Pel*     sadMask;                         ///< binary encoder SAD mask
+#else
+  const int16_t* sadMask;                         ///< binary encoder SAD mask
+#endif
+#if JVET_Z0056_GPM_SPLIT_MODE_REORDERING
+  const Pel*     tplMask;                         ///< binary mask in the template extended mask (GEO_WEIGHT_MASK_SIZE_EXT)
+  int            tplStride;                       ///< step to the sample below in the template mask
+#endif
+  int            stepX;                           ///< step to the sample on the right, -1 for horizontally mirrored angles
+  int            stride;                          ///< step to the sample below, negative for vertically mirrored angles
+  bool           isCurve;                         ///< curve partition
+};
+extern GeoMaskView g_geoMaskView      [GEO_NUM_MASK_VARIANTS][GEO_NUM_PARTITION_MODE][GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE];
+extern const int8_t g_angle2mask      [GEO_NUM_ANGLES];
+extern const int8_t g_dis[GEO_NUM_ANGLES];
 extern int8_t    g_angle2mirror[GEO_NUM_ANGLES];
 
 #if JVET_AB0155_SGPM
@@ -116,6 +116,16 @@ SampleAdaptiveOffset::SampleAdaptiveOffset()
 #if JVET_W0066_CCSAO
   m_ccSaoControl[0] = m_ccSaoControl[1] = m_ccSaoControl[2] = nullptr;
 #endif
+#if ENABLE_SIMD_SAO
+  m_offsetBandBlk  = nullptr;
+  m_offsetEdgeLine = nullptr;
+#if JVET_W0066_CCSAO
+  m_offsetCcSaoBandBlk = nullptr;
+#endif
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
@@ -352,6 +362,15 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
                                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
   )
 {
+#if ENABLE_SIMD_SAO
+  if( m_offsetEdgeLine && !isCtuCrossedByVirtualBoundaries )
+  {
+    xOffsetBlockSimd( channelBitDepth, clpRng, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+                    , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail, true );
+    return;
+  }
+#endif
+
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
@@ -602,6 +621,73 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   }
 }
 
+#if ENABLE_SIMD_SAO
+/** SAO of a block not crossed by virtual boundaries through the SIMD kernels, the edge offset
+    is applied to the rows over the same sample ranges as in offsetBlock()
+ */
+void SampleAdaptiveOffset::xOffsetBlockSimd(const int channelBitDepth, const ClpRng& clpRng, const int typeIdx, const int* offset, const Pel* srcBlk, Pel* resBlk, const int srcStride, const int resStride, const int width, const int height
+                                           , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail, const bool clip)
+{
+  if (typeIdx == SAO_TYPE_BO)
+  {
+    m_offsetBandBlk(srcBlk, srcStride, resBlk, resStride, width, height, offset, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, clpRng, clip);
+    return;
+  }
+
+  const int startX = isLeftAvail ? 0 : 1;
+  const int endX   = isRightAvail ? width : (width - 1);
+  // sample ranges of the first, the middle and the last rows
+  int firstLineStartX = startX, firstLineEndX = endX;
+  int midLineStartX   = startX, midLineEndX   = endX;
+  int lastLineStartX  = startX, lastLineEndX  = endX;
+  ptrdiff_t posA, posB;
+
+  switch (typeIdx)
+  {
+  case SAO_TYPE_EO_0:
+    posA = -1;
+    posB = 1;
+    break;
+  case SAO_TYPE_EO_90:
+    posA            = -srcStride;
+    posB            = srcStride;
+    firstLineStartX = midLineStartX = lastLineStartX = 0;
+    midLineEndX     = width;
+    firstLineEndX   = isAboveAvail ? width : 0;
+    lastLineEndX    = isBelowAvail ? width : 0;
+    break;
+  case SAO_TYPE_EO_135:
+    posA            = -srcStride - 1;
+    posB            = srcStride + 1;
+    firstLineStartX = isAboveLeftAvail ? 0 : 1;
+    firstLineEndX   = isAboveAvail ? endX : 1;
+    lastLineStartX  = isBelowAvail ? startX : (width - 1);
+    lastLineEndX    = isBelowRightAvail ? width : (width - 1);
+    break;
+  case SAO_TYPE_EO_45:
+    posA            = -srcStride + 1;
+    posB            = srcStride - 1;
+    firstLineStartX = isAboveAvail ? startX : (width - 1);
+    firstLineEndX   = isAboveRightAvail ? width : (width - 1);
+    lastLineStartX  = isBelowLeftAvail ? 0 : 1;
+    lastLineEndX    = isBelowAvail ? endX : 1;
+    break;
+  default:
+    THROW("Not a supported SAO types\n");
+  }
+
+  for (int y = 0; y < height; y++)
+  {
+    const int lineStartX = y == 0 ? firstLineStartX : y == height - 1 ? lastLineStartX : midLineStartX;
+    const int lineEndX   = y == 0 ? firstLineEndX   : y == height - 1 ? lastLineEndX   : midLineEndX;
+    if (lineEndX > lineStartX)
+    {
+      m_offsetEdgeLine(srcBlk + y * srcStride + lineStartX, resBlk + y * resStride + lineStartX, lineEndX - lineStartX, posA, posB, offset, clpRng, clip);
+    }
+  }
+}
+#endif
+
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER || JVET_W0066_CCSAO
 void SampleAdaptiveOffset::offsetBlockNoClip(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset
                                              , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
@@ -611,6 +697,19 @@ void SampleAdaptiveOffset::offsetBlockNoClip(const int channelBitDepth, const Cl
 #endif
 )
 {
+#if ENABLE_SIMD_SAO
+  if( m_offsetEdgeLine
+#if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
+      && !isCtuCrossedByVirtualBoundaries
+#endif
+    )
+  {
+    xOffsetBlockSimd( channelBitDepth, clpRng, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+                    , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail, false );
+    return;
+  }
+#endif
+
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
@@ -3501,6 +3600,42 @@ void SampleAdaptiveOffset::offsetBlockCcSaoNoClip(const ComponentID compID, cons
   const int chromaScaleY = getChannelTypeScaleY( CHANNEL_TYPE_CHROMA, chromaFormat );
   const int chromaScaleYM1 = 1 - chromaScaleY;
 
+#if ENABLE_SIMD_SAO
+  // the candidate positions whose processed samples form a rectangle, the others and the blocks
+  // crossed by virtual boundaries are classified by the code below
+  if (m_offsetCcSaoBandBlk && chromaFormat != CHROMA_400 && bitDepth + MAX_CCSAO_BAND_NUM_Y_BITS <= 16
+#if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
+      && !isCtuCrossedByVirtualBoundaries
+#endif
+     )
+  {
+    int  rectStartX = 0, rectEndX = width, rectEndY = height;
+#if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
+    bool isRect     = true;
+    switch (candPosY)
+    {
+    case 1: isRect     = isAboveAvail;                        break;
+    case 3: rectStartX = isLeftAvail ? 0 : 1;                 break;
+    case 4:                                                   break;
+    case 5: rectEndX   = isRightAvail ? width : (width - 1);   break;
+    case 7: rectEndY   = isBelowAvail ? height : (height - 1); break;
+    default: isRect    = false;                               break;
+    }
+#else
+    const bool isRect = true;
+#endif
+    if (isRect)
+    {
+      const bool isLumaComp = compID == COMPONENT_Y;
+      m_offsetCcSaoBandBlk(srcY + srcStrideY * candPosYY + candPosYX, srcU, srcV, dst, srcStrideY, srcStrideU, srcStrideV, dstStride
+                         , rectStartX, rectEndX, rectEndY
+                         , isLumaComp ? 0 : chromaScaleX, isLumaComp ? 0 : chromaScaleY, isLumaComp ? chromaScaleX : 0, isLumaComp ? chromaScaleY : 0
+                         , bandNumY, bandNumU, bandNumV, offset, bitDepth);
+      return;
+    }
+  }
+#endif
+
 #if JVET_Z0105_LOOP_FILTER_VIRTUAL_BOUNDARY
   int x, y, startX, startY, endX, endY;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
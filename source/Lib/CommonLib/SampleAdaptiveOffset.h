@@ -121,6 +121,15 @@ protected:
                          , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
 #endif
   );
+#endif
+#if ENABLE_SIMD_SAO
+  void xOffsetBlockSimd(const int channelBitDepth, const ClpRng& clpRng, const int typeIdx, const int* offset, const Pel* srcBlk, Pel* resBlk, const int srcStride, const int resStride, const int width, const int height
+                       , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail, const bool clip);
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
 #endif
   void invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets);
   void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
@@ -213,6 +222,16 @@ protected:
 
   std::vector<int8_t> m_signLineBuf1;
   std::vector<int8_t> m_signLineBuf2;
+#if ENABLE_SIMD_SAO
+  // offset kernels of the blocks not crossed by virtual boundaries, null when no SIMD implementation is available
+  void ( *m_offsetBandBlk )     ( const Pel* src, const int srcStride, Pel* res, const int resStride, const int width, const int height, const int* offset, const int shiftBits, const ClpRng& clpRng, const bool clip );
+  void ( *m_offsetEdgeLine )    ( const Pel* src, Pel* res, const int width, const ptrdiff_t posA, const ptrdiff_t posB, const int* offset, const ClpRng& clpRng, const bool clip );
+#if JVET_W0066_CCSAO
+  void ( *m_offsetCcSaoBandBlk )( const Pel* srcY, const Pel* srcU, const Pel* srcV, Pel* dst, const int srcStrideY, const int srcStrideU, const int srcStrideV, const int dstStride,
+                                  const int startX, const int endX, const int height, const int lumaScaleX, const int lumaScaleY, const int chromaScaleX, const int chromaScaleY,
+                                  const int bandNumY, const int bandNumU, const int bandNumV, const short* offset, const int bitDepth );
+#endif
+#endif
 #if JVET_W0066_CCSAO
   bool                m_created = false;
   PelStorage          m_ccSaoBuf;
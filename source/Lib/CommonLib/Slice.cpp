@@ -3769,6 +3769,12 @@ SPS::SPS()
   , m_useGeoBlend(true)
 #endif
 #endif
+#if GPM_CURVE
+, m_useGeoCurve               ( false )
+#endif
+#if GPM_BLEND
+, m_useGeoTanhBlend           ( true )
+#endif
 , m_SBT                       ( false )
 , m_ISP                       ( false )
 , m_chromaFormatIdc           (CHROMA_420)
@@ -5499,6 +5505,9 @@ void Slice::scaleRefPicList( Picture *scaledRefPic[ ], PicHeader *picHeader, APS
           scaledRefPic[j]->longTerm = m_apcRefPicList[refList][rIdx]->longTerm;
 
           // rescale the reference picture
+#if ENABLE_FRAME_PARALLEL_DECODING
+          m_apcRefPicList[refList][rIdx]->waitUntilFinished();
+#endif
           const bool downsampling = m_apcRefPicList[refList][rIdx]->getRecoBuf().Y().width >= scaledRefPic[j]->getRecoBuf().Y().width && m_apcRefPicList[refList][rIdx]->getRecoBuf().Y().height >= scaledRefPic[j]->getRecoBuf().Y().height;
           Picture::rescalePicture( m_scalingRatio[refList][rIdx],
                                    m_apcRefPicList[refList][rIdx]->getRecoBuf(), m_apcRefPicList[refList][rIdx]->slices[0]->getPPS()->getScalingWindow(),
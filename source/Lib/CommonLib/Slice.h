@@ -1615,6 +1615,12 @@ private:
 #endif
 #if JVET_AG0112_REGRESSION_BASED_GPM_BLENDING
   bool              m_useGeoBlend;
+#endif
+#if GPM_CURVE
+  bool              m_useGeoCurve;
+#endif
+#if GPM_BLEND
+  bool              m_useGeoTanhBlend;
 #endif
   bool              m_SBT;
   bool              m_ISP;
@@ -2537,6 +2543,27 @@ void                    setCCALFEnabledFlag( bool b )
   bool      getUseGeoBlend     ()                                      const     { return m_useGeoBlend; }
   void      setUseGeoBlend     ( bool b )                                        { m_useGeoBlend = b; }
 #endif
+#if GPM_CURVE
+  bool      getUseGeoCurve     ()                                      const     { return m_useGeoCurve; }
+  void      setUseGeoCurve     ( bool b )                                        { m_useGeoCurve = b; }
+#endif
+#if GPM_BLEND
+  bool      getUseGeoTanhBlend ()                                      const     { return m_useGeoTanhBlend; }
+  void      setUseGeoTanhBlend ( bool b )                                        { m_useGeoTanhBlend = b; }
+#endif
+  // index of the GPM mask variant (g_geoMaskView) selected by the curve partition and tanh blending flags
+  int       getGeoMaskVariant  ()                                      const
+  {
+#if GPM_CURVE && GPM_BLEND
+    return ( m_useGeoCurve ? GEO_NUM_BLEND_SHAPES : 0 ) + ( m_useGeoTanhBlend ? 1 : 0 );
+#elif GPM_CURVE
+    return m_useGeoCurve ? 1 : 0;
+#elif GPM_BLEND
+    return m_useGeoTanhBlend ? 1 : 0;
+#else
+    return 0;
+#endif
+  }
   void      setUseCiip         ( bool b )                                        { m_ciip = b; }
   bool      getUseCiip         ()                                      const     { return m_ciip; }
 #if JVET_X0141_CIIP_TIMD_TM && JVET_W0123_TIMD_FUSION
@@ -4221,9 +4248,6 @@ public:
 protected:
   Picture*              xGetRefPic( PicList& rcListPic, int poc, const int layerId );
   Picture*              xGetLongTermRefPic( PicList& rcListPic, int poc, bool pocHasMsb, const int layerId );
-public:
-  std::unordered_map< Position, std::unordered_map< Size, double> > m_mapPltCost[2];
-private:
 };// END CLASS DEFINITION Slice
 
 
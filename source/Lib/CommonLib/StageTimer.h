@@ -0,0 +1,135 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageTimer.h
+    \brief    per-picture processing time of the decoding stages
+*/
+
+#ifndef __STAGETIMER__
+#define __STAGETIMER__
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+//! \ingroup CommonLib
+//! \{
+
+enum ProcessingStage
+{
+  STAGE_PARSE = 0,
+  STAGE_INTRA,              ///< intra and palette CU reconstruction
+  STAGE_INTER,              ///< inter and IBC CU motion derivation and reconstruction
+  STAGE_INTER_DMVR,         ///< part of STAGE_INTER
+  STAGE_INTER_BDOF,         ///< part of STAGE_INTER
+  STAGE_INTER_OBMC,         ///< part of STAGE_INTER
+  STAGE_INTER_TM,           ///< part of STAGE_INTER
+  STAGE_INTER_AFFINE,       ///< part of STAGE_INTER
+  STAGE_LMCS,
+  STAGE_DEBLOCKING,
+  STAGE_SAO,                ///< SAO and bilateral filter
+  STAGE_CCSAO,
+  STAGE_ALF,                ///< ALF and CC-ALF
+  NUM_PROCESSING_STAGES
+};
+
+/// accumulated time of each stage; a stage entered again while running (recursion or overloads calling
+/// each other) is counted once, distinct stages may overlap (e.g. TM inside DMVR)
+class StageTimes
+{
+public:
+  StageTimes()                                    { reset(); }
+
+  void   reset()
+  {
+    std::fill( m_time, m_time + NUM_PROCESSING_STAGES, std::chrono::steady_clock::duration::zero() );
+    std::memset( m_depth, 0, sizeof( m_depth ) );
+  }
+  bool   enter( ProcessingStage stage )           { return m_depth[stage]++ == 0; }
+  void   leave( ProcessingStage stage, std::chrono::steady_clock::duration time )
+  {
+    if( --m_depth[stage] == 0 )
+    {
+      m_time[stage] += time;
+    }
+  }
+  double getSeconds( ProcessingStage stage ) const { return std::chrono::duration<double>( m_time[stage] ).count(); }
+  /// accumulates the times of another set, e.g. of a thread that processed a part of the picture
+  void   add( const StageTimes& other )
+  {
+    for( int stage = 0; stage < NUM_PROCESSING_STAGES; stage++ )
+    {
+      m_time[stage] += other.m_time[stage];
+    }
+  }
+
+  static const char* getStageName( ProcessingStage stage )
+  {
+    static const char* names[NUM_PROCESSING_STAGES] = { "parse", "intra", "inter", "dmvr", "bdof", "obmc", "tm", "affine",
+                                                        "lmcs", "dbf", "sao", "ccsao", "alf" };
+    return names[stage];
+  }
+
+private:
+  std::chrono::steady_clock::duration m_time[NUM_PROCESSING_STAGES];
+  int                                 m_depth[NUM_PROCESSING_STAGES];
+};
+
+/// adds its lifetime to a stage, does nothing when the stage times are not collected
+class StageTimer
+{
+public:
+  StageTimer( StageTimes* times, ProcessingStage stage ) : m_times( times ), m_stage( stage )
+  {
+    if( m_times && m_times->enter( m_stage ) )
+    {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+  ~StageTimer()
+  {
+    if( m_times )
+    {
+      m_times->leave( m_stage, std::chrono::steady_clock::now() - m_start );
+    }
+  }
+
+private:
+  StageTimes*                           m_times;
+  ProcessingStage                       m_stage;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+//! \}
+
+#endif // __STAGETIMER__
@@ -48,6 +48,7 @@
 #include <stdlib.h>
 #include <limits>
 #include <memory.h>
+#include <mutex>
 
 #include "QuantRDOQ.h"
 #include "DepQuant.h"
@@ -200,7 +201,7 @@ TrQuant::~TrQuant()
   }
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void TrQuant::copyState( const TrQuant& other )
 {
   m_quant->copyState( *other.m_quant );
@@ -305,6 +306,9 @@ void TrQuant::init( const Quant* otherQuant,
   m_computeFwdNspt = computeFwdNspt;
   m_computeInvNspt = computeInvNspt;
 #endif
+#if SIGN_PREDICTION
+  m_signPredCosts = signPredCosts;
+#endif
 #if TRANSFORM_SIMD_OPT
 #ifdef TARGET_SIMD_X86
   initTrQuantX86();
@@ -2161,6 +2165,38 @@ void TrQuant::xTransformSkip(const TransformUnit &tu, const ComponentID &compID,
 }
 
 #if SIGN_PREDICTION
+#if JVET_Y0141_SIGN_PRED_IMPROVE
+static std::mutex s_signPredTemplateMutex;
+#endif
+
+void TrQuant::signPredCosts( const Pel* predResiBorder, Pel* resiTemplate, const Pel* signTemplates, const int stride, const int first, const int last, const int numPredSigns, uint32_t* costs )
+{
+  uint32_t cost = 0;
+  for( int i = first; i < last; i++ )
+  {
+    cost += abs( predResiBorder[i] - resiTemplate[i] );
+  }
+
+  costs[0] = cost << SIGN_PRED_MAX_NUM;
+
+  for( uint32_t idx = 1; idx < ( 1 << numPredSigns ); idx++ )
+  {
+    const uint32_t signXor  = idx & ~( idx - 1 );
+    const uint32_t curSigns = idx ^ ( idx >> 1 );
+    const int16_t  scale    = ( curSigns & signXor ) != 0 ? -2 : 2;
+    const Pel*     templ    = signTemplates + ( numPredSigns - 1 - floorLog2( signXor ) ) * stride;
+
+    cost = 0;
+    for( int i = first; i < last; i++ )
+    {
+      resiTemplate[i] += templ[i] * scale;
+      cost += abs( predResiBorder[i] - resiTemplate[i] );
+    }
+
+    costs[curSigns] = ( cost << SIGN_PRED_MAX_NUM ) | curSigns;
+  }
+}
+
 void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const bool reshapeChroma)
 {
   bool bIsJCCR = tu.jointCbCr && isChroma(compID);
@@ -2239,13 +2275,12 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
   };
 #endif
 
-  auto createTemplate = [this,tu](ComponentID comp, uint32_t width, uint32_t height, uint32_t mtsIdx) -> void
+  auto createTemplate = [this, &tu](ComponentID comp, uint32_t width, uint32_t height, uint32_t mtsIdx) -> void
   {
     // This is the function used to generate template values stored in g_initRomSignPred[]
-    TCoeff *memCoeff = (TCoeff *)xMalloc(TCoeff, width*height);
-    Pel      *memTmpResid = (Pel *)xMalloc(Pel,    width*height);
-    CoeffBuf coeff(memCoeff, width, height);
-    PelBuf   resi(memTmpResid, width, height);
+    // The coefficient and residual buffers of the sign prediction are free until the templates exist
+    CoeffBuf coeff(m_tempCoeff, width, height);
+    PelBuf   resi(m_tempSignPredResid, width, height);
     coeff.fill(0);
 
     const uint32_t stride = width + height;
@@ -2306,21 +2341,21 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
 
     int log2Width = floorLog2(width);
     int log2Height = floorLog2(height);
+#if JVET_Y0141_SIGN_PRED_IMPROVE
+    g_resiBorderTemplate[tu.cs->sps->getLog2SignPredArea() - 2][log2Width-2][log2Height-2][mtsIdx].store( templateBuf.buf, std::memory_order_release );
+#else
     g_resiBorderTemplate[log2Width-2][log2Height-2][mtsIdx] = templateBuf.buf;
-
-    xFree(memCoeff);
-    xFree(memTmpResid);
+#endif
   };
 
 #if JVET_Y0141_SIGN_PRED_IMPROVE
-  auto createTemplateLFNST = [this, tu](ComponentID comp, uint32_t width, uint32_t height, uint32_t lfnstIdx) -> void
+  auto createTemplateLFNST = [this, &tu](ComponentID comp, uint32_t width, uint32_t height, uint32_t lfnstIdx) -> void
   {
     const uint32_t stride = width + height;
     const uint32_t length = width + height;
 
-    Pel      *memTmpResid = (Pel *)xMalloc(Pel, width*height);
     CoeffBuf coeff(m_tempCoeff, width, height);
-    PelBuf   resi(memTmpResid, width, height);
+    PelBuf   resi(m_tempSignPredResid, width, height);
     int signPredHeight = 4;
     int signPredWidth = 4;
     int8_t         *pTemplate      = (int8_t *) xMalloc(int8_t, stride * signPredHeight * signPredWidth);
@@ -2356,9 +2391,7 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
 
     int log2Width = floorLog2(width);
     int log2Height = floorLog2(height);
-    g_resiBorderTemplateLFNST[log2Width - 2][log2Height - 2][lfnstIdx] = templateBuf.buf;
-
-    xFree(memTmpResid);
+    g_resiBorderTemplateLFNST[log2Width - 2][log2Height - 2][lfnstIdx].store( templateBuf.buf, std::memory_order_release );
   };
 #endif
 
@@ -2377,15 +2410,13 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
 #if JVET_Y0141_SIGN_PRED_IMPROVE
   int log2Width = floorLog2(uiWidth);
   int log2Height = floorLog2(uiHeight);
+  int areaIdx = tu.cs->sps->getLog2SignPredArea() - 2;
   int actualTrIdx = 0, actualLfnstIdx = 0;
   bool lfnstEnabled = tu.checkLFNSTApplied(residCompID);
+  const int8_t *templateData = nullptr;
   if (lfnstEnabled)
   {
     actualLfnstIdx = getLfnstIdx(tu, residCompID);
-    if (!g_resiBorderTemplateLFNST[log2Width - 2][log2Height - 2][actualLfnstIdx])
-    {
-      createTemplateLFNST(residCompID, uiWidth, uiHeight, actualLfnstIdx);
-    }
   }
   else
   {
@@ -2396,9 +2427,28 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
 #else
     actualTrIdx = trHor * 3 + trVer;
 #endif
-    if (!g_resiBorderTemplate[log2Width - 2][log2Height - 2][actualTrIdx])
+  }
+  {
+    // templates are built once per block size, transform and sign prediction area and shared by all threads,
+    // only building a missing template takes the lock
+    std::atomic<int8_t*> &templ = lfnstEnabled ? g_resiBorderTemplateLFNST[log2Width - 2][log2Height - 2][actualLfnstIdx]
+                                               : g_resiBorderTemplate[areaIdx][log2Width - 2][log2Height - 2][actualTrIdx];
+    templateData = templ.load( std::memory_order_acquire );
+    if (!templateData)
     {
-      createTemplate(residCompID, uiWidth, uiHeight, actualTrIdx);
+      std::lock_guard<std::mutex> lock( s_signPredTemplateMutex );
+      if (!templ.load( std::memory_order_relaxed ))
+      {
+        if (lfnstEnabled)
+        {
+          createTemplateLFNST(residCompID, uiWidth, uiHeight, actualLfnstIdx);
+        }
+        else
+        {
+          createTemplate(residCompID, uiWidth, uiHeight, actualTrIdx);
+        }
+      }
+      templateData = templ.load( std::memory_order_relaxed );
     }
   }
 #else
@@ -2425,11 +2475,9 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
 
   AreaBuf<const int8_t> templateNormalizedBuf =
     (lfnstEnabled ? AreaBuf<const int8_t>()
-                  : AreaBuf<const int8_t>(g_resiBorderTemplate[log2Width - 2][log2Height - 2][actualTrIdx], stride,
-                                          length, w * h));
+                  : AreaBuf<const int8_t>(templateData, stride, length, w * h));
   AreaBuf<const int8_t> templateLfnstNormalizedBuf =
-    (lfnstEnabled ? AreaBuf<const int8_t>(g_resiBorderTemplateLFNST[log2Width - 2][log2Height - 2][actualLfnstIdx],
-                                          stride, length, signPredWidth * signPredHeight)
+    (lfnstEnabled ? AreaBuf<const int8_t>(templateData, stride, length, signPredWidth * signPredHeight)
                   : AreaBuf<const int8_t>());
 #else
   AreaBuf<const int8_t> templateNormalizedBuf(g_resiBorderTemplate[log2Width - 2][log2Height - 2][actualTrIdx], stride,
@@ -2574,58 +2622,42 @@ void TrQuant::predCoeffSigns(TransformUnit &tu, const ComponentID compID, const
   }
 
   // Compute SADs for all possible combinations of sign changes
-  uint32_t cost = 0;
+  uint32_t costs[1 << SIGN_PRED_MAX_NUM];
 
   if (reshapeChroma)
   {
+    uint32_t cost = 0;
     for (uint32_t i = first; i < last; i++)
     {
       cost += abs(predResiBorder[i] - Reshape::scalePel(predResiTemplate[i], chromaScale, maxVal));
     }
-  }
-  else
-  {
-    for (uint32_t i = first; i < last; i++)
-    {
-      cost += abs(predResiBorder[i] - predResiTemplate[i]);
-    }
-  }
 
-  uint32_t costs[1 << SIGN_PRED_MAX_NUM];
-
-  costs[0] = cost << SIGN_PRED_MAX_NUM;
+    costs[0] = cost << SIGN_PRED_MAX_NUM;
 
-  for (uint32_t idx = 1; idx < (1 << numPredSigns); idx++)
-  {
-    const uint32_t signXor  = idx & ~(idx - 1);
-    const uint32_t curSigns = idx ^ (idx >> 1);
-
-    const int16_t scale        = (curSigns & signXor) != 0 ? -2 : 2;
-    const int  predSignIdx  = numPredSigns - 1 - floorLog2(signXor);
+    for (uint32_t idx = 1; idx < (1 << numPredSigns); idx++)
+    {
+      const uint32_t signXor  = idx & ~(idx - 1);
+      const uint32_t curSigns = idx ^ (idx >> 1);
 
-    const Pel *templ = m_signPredTemplate + predSignIdx * stride;
+      const int16_t scale        = (curSigns & signXor) != 0 ? -2 : 2;
+      const int  predSignIdx  = numPredSigns - 1 - floorLog2(signXor);
 
-    // Compute cost of modification
-    uint32_t cost = 0;
+      const Pel *templ = m_signPredTemplate + predSignIdx * stride;
 
-    if (reshapeChroma)
-    {
+      // Compute cost of modification
+      cost = 0;
       for (uint32_t i = first; i < last; i++)
       {
         predResiTemplate[i] += templ[i] * scale;
         cost += abs(predResiBorder[i] - Reshape::scalePel(predResiTemplate[i], chromaScale, maxVal));
       }
-    }
-    else
-    {
-      for (uint32_t i = first; i < last; i++)
-      {
-        predResiTemplate[i] += templ[i] * scale;
-        cost += abs(predResiBorder[i] - predResiTemplate[i]);
-      }
-    }
 
-    costs[curSigns] = (cost << SIGN_PRED_MAX_NUM) | curSigns;
+      costs[curSigns] = (cost << SIGN_PRED_MAX_NUM) | curSigns;
+    }
+  }
+  else
+  {
+    m_signPredCosts(predResiBorder, predResiTemplate, m_signPredTemplate, stride, first, last, numPredSigns, costs);
   }
 
   uint32_t  minIdx            = 0;
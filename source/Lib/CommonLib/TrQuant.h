@@ -158,7 +158,7 @@ public:
   void predCoeffSigns( TransformUnit &tu, const ComponentID compID, const bool reshapeChroma );
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void    copyState( const TrQuant& other );
 #endif
 
@@ -169,6 +169,10 @@ protected:
 #if JVET_Y0141_SIGN_PRED_IMPROVE
   uint8_t  m_signsBuf[SIGN_PRED_FREQ_RANGE*SIGN_PRED_FREQ_RANGE];
 #endif
+
+  // border costs of all sign hypotheses in Gray code order, resiTemplate holds the border with all predicted signs positive and is updated in place
+  void(*m_signPredCosts)( const Pel* predResiBorder, Pel* resiTemplate, const Pel* signTemplates, const int stride, const int first, const int last, const int numPredSigns, uint32_t* costs );
+  static void signPredCosts( const Pel* predResiBorder, Pel* resiTemplate, const Pel* signTemplates, const int stride, const int first, const int last, const int numPredSigns, uint32_t* costs );
 #endif
 
 private:
@@ -256,6 +260,7 @@ private:
   static void fastInverseTransform_SIMD( const TCoeff *coeff, TCoeff *block, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum );
 #endif
 
+public:
 #if TRANSFORM_SIMD_OPT
 #ifdef TARGET_SIMD_X86
   void    initTrQuantX86();
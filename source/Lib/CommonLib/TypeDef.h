@@ -295,8 +295,8 @@
 #define JVET_Z0139_HIST_AFF                               1 // JVET-Z0139: Affine HMVP 
 #define JVET_Z0139_NA_AFF                                 1 // JVET-Z0139: Constructed non-adjacent spatial neighbors for affine mode
 #define JVET_AA0058_GPM_ADAPTIVE_BLENDING                 1 // JVET-AA0058: GPM adaptive blending
-#define GPM_CURVE                                         0 // GPM curve split mode
-#define GPM_BLEND                                         1 // GPM advanced blending
+#define GPM_CURVE                                         1 // GPM curve split mode support, enabled by sps_gpm_curve_flag
+#define GPM_BLEND                                         1 // GPM advanced (tanh) blending support, enabled by sps_gpm_tanh_blend_flag
 #define JVET_AA0146_WRAP_AROUND_FIX                       1 // JVET-AA0146: bugfix&cleanup for wrap around motion compensation
 #define JVET_AA0107_RMVF_AFFINE_MERGE_DERIVATION          1 // JVET-AA0107 Regression based affine merge candidate derivation
 #if JVET_AA0107_RMVF_AFFINE_MERGE_DERIVATION
@@ -441,6 +441,13 @@
 #endif
 #if JVET_V0130_INTRA_TMP
 #define ENABLE_SIMD_TMP                                   1
+#define TMP_SEARCH_SUM_PRUNING                          ( JVET_AD0086_ENHANCED_INTRA_TMP && JVET_W0069_TMP_BOUNDARY && JVET_AG0136_INTRA_TMP_LIC ) // skip TMP search positions whose template cost bounds from sums cannot enter the candidate lists, no impact on RD performance
+#endif
+#if JVET_AA0057_CCCM
+#define CCP_LUMA_REF_CACHE                              ( JVET_AC0147_CCCM_NO_SUBSAMPLING && JVET_AD0202_CCCM_MDF && JVET_AB0092_GLM_WITH_LUMA && JVET_AC0119_LM_CHROMA_FUSION && JVET_AF0073_INTER_CCP_MERGE ) // reuse the downsampled luma and gradient planes of a chroma block across the CCCM, GLM and CFLM candidates of the encoder chroma search, no impact on RD performance
+#endif
+#if JVET_W0123_TIMD_FUSION
+#define TIMD_TEMPLATE_COST_PRUNING                        1 // skip the second template part of a TIMD candidate whose first part already cannot enter the best two modes, no impact on RD performance
 #endif
 #if JVET_V0094_BILATERAL_FILTER
 #define ENABLE_SIMD_BILATERAL_FILTER                      1
@@ -656,6 +663,36 @@ typedef std::pair<int, int>  TrCost;
 #define PARL_SPLIT_MAX_NUM_THREADS                        PARL_SPLIT_MAX_NUM_JOBS
 #define NUM_SPLIT_THREADS_IF_MSVC                         4
 
+#endif
+#ifndef ENABLE_WPP_PARALLELISM
+#define ENABLE_WPP_PARALLELISM                            1 // encode the CTU rows of a slice wavefront-parallel (NumWppThreads), one CU encoder stack per thread
+#endif
+#ifndef ENABLE_FRAME_PARALLELISM
+#define ENABLE_FRAME_PARALLELISM                          1 // compress the pictures of a GOP that do not depend on each other concurrently (NumFrameThreads)
+#endif
+#if ENABLE_FRAME_PARALLELISM && !ENABLE_WPP_PARALLELISM
+#error ENABLE_FRAME_PARALLELISM requires the CU encoder stacks of ENABLE_WPP_PARALLELISM
+#endif
+#ifndef ENABLE_PARALLEL_SUBSTREAM_DECODING
+#define ENABLE_PARALLEL_SUBSTREAM_DECODING                1 // decode the tiles and WPP CTU rows of a slice concurrently (NumSubstreamThreads), one CU decoder per thread
+#endif
+#ifndef ENABLE_FRAME_PARALLEL_DECODING
+#define ENABLE_FRAME_PARALLEL_DECODING                    1 // in-loop filter and finish a picture in a worker thread while the next picture is decoded (NumFrameThreads)
+#endif
+#ifndef ENABLE_PIPELINED_CTU_DECODING
+#define ENABLE_PIPELINED_CTU_DECODING                     1 // parse the CTUs of a slice in a separate thread ahead of their reconstruction (ParseAheadCtus)
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING && !ENABLE_PARALLEL_SUBSTREAM_DECODING
+#error ENABLE_PIPELINED_CTU_DECODING requires the CU chain handling of ENABLE_PARALLEL_SUBSTREAM_DECODING
+#endif
+#ifndef ENABLE_PARALLEL_DEBLOCKING
+#define ENABLE_PARALLEL_DEBLOCKING                        1 // deblock the CTU rows of a picture concurrently in encoder and decoder (NumLoopFilterThreads)
+#endif
+#ifndef ENABLE_PARALLEL_ALF
+#define ENABLE_PARALLEL_ALF                               1 // filter the CTUs of a picture with ALF/CCALF in a wavefront of CTU rows in the decoder (NumLoopFilterThreads)
+#endif
+#if ENABLE_PARALLEL_ALF && !( ENABLE_PARALLEL_DEBLOCKING && ALF_IMPROVEMENT && JVET_X0071_ALF_BAND_CLASSIFIER && JVET_AB0184_ALF_MORE_FIXED_FILTER_OUTPUT_TAPS )
+#error ENABLE_PARALLEL_ALF requires the NumLoopFilterThreads option of ENABLE_PARALLEL_DEBLOCKING and the picture-level fixed filter buffers of ALF_IMPROVEMENT
 #endif
 
 // clang-format on
@@ -744,6 +781,12 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_DEBLOCKING_FILTER                   ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_SAO                                 ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the SAO and CCSAO offsets, no impact on RD performance
+#define ENABLE_SIMD_MIP                                 ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the matrix multiplication and upsampling of MIP, no impact on RD performance
+#define ENABLE_SIMD_DIMD                                ( 1 && ENABLE_SIMD_OPT && ENABLE_DIMD && JVET_X0149_TIMD_DIMD_LUT ) ///< SIMD optimization for the gradient histogram of DIMD, no impact on RD performance
+#define ENABLE_SIMD_CCCM                                ( 1 && ENABLE_SIMD_OPT && JVET_AA0057_CCCM )        ///< SIMD optimization for the auto- and cross-correlations of the CCCM, GLM, CFLM and EIP models, no impact on RD performance
+#define ENABLE_SIMD_TIMD                                ( 1 && ENABLE_SIMD_OPT && JVET_W0123_TIMD_FUSION )  ///< SIMD optimization for the 4-tap interpolation of the TIMD template prediction, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
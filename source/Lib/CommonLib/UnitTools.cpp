@@ -59,6 +59,45 @@ bool CS::isDualITree( const CodingStructure &cs )
   return cs.slice->isIntra() && !cs.pcv->ISingleTree;
 }
 
+// number of CTUs a CTU row has to be ahead before the row below can process a CTU, derived from how far right of the
+// left edge of a CTU its CUs look up units or samples in the row above
+uint32_t CS::getWavefrontLag( const SPS &sps )
+{
+  const int ctuSize = sps.getMaxCUWidth();
+
+  // the above-right intra reference samples of a CU of width w end 2 * w right of its left edge
+  int reach = 2 * ctuSize;
+#if NON_ADJACENT_MRG_CAND || TM_AMVP
+  // the non-adjacent spatial candidates of a CU of width w are looked up up to w * ( NADISTANCE_LEVEL_MAX + 1 ) right
+  // of its left edge, which is at most ctuSize - w right of the left edge of the CTU; the lookup reads the unit maps
+  // of the row above also where the wavefront restriction then drops the candidate
+  reach = std::max( reach, ( NADISTANCE_LEVEL_MAX + 1 ) * ctuSize );
+#endif
+#if JVET_V0130_INTRA_TMP
+  if( sps.getUseIntraTMP() )
+  {
+    // the candidate blocks of intra template matching end up to the search range right of the current block
+    const int tmpSize = 1 << TMP_MAXSIZE_DEPTH;
+    reach = std::max( reach, ctuSize + std::max( TMP_SEARCH_RANGE_MULT_FACTOR * tmpSize, TMP_MINSR ) + tmpSize );
+  }
+#endif
+  return 1 + ( ( reach - 1 ) >> floorLog2( ctuSize ) );
+}
+
+// the unit vectors must not be reallocated while other threads look up units, at most one unit of each kind starts in
+// each position of the unit maps
+void CS::reserveUnitsOfPicture( CodingStructure &cs )
+{
+  size_t maxNumUnits = 0;
+  for( int ch = 0; ch < ::getNumberValidChannels( cs.area.chromaFormat ); ch++ )
+  {
+    maxNumUnits += cs.unitScale[ch].scaleArea( cs.area.blocks[ch].area() );
+  }
+  cs.cus.reserve( maxNumUnits );
+  cs.pus.reserve( maxNumUnits );
+  cs.tus.reserve( maxNumUnits );
+}
+
 UnitArea CS::getArea( const CodingStructure &cs, const UnitArea &area, const ChannelType chType )
 {
 #if INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
@@ -670,9 +709,9 @@ void CU::saveMotionInHMVP( const CodingUnit& cu, const bool isToBeDone )
     pu.getAffineMotionInfo(addMi, addRefIdx);
 #endif
 #if JVET_Z0118_GDR 
-    cu.cs->addAffMiToLut((isClean) ? cu.cs->motionLut.lutAff1 : cu.cs->motionLut.lutAff0, addMi, addRefIdx);
+    cu.cs->addAffMiToLut((isClean) ? cu.cs->getMotionLut().lutAff1 : cu.cs->getMotionLut().lutAff0, addMi, addRefIdx);
 #else
-    cu.cs->addAffMiToLut(cu.cs->motionLut.lutAff, addMi, addRefIdx);
+    cu.cs->addAffMiToLut(cu.cs->getMotionLut().lutAff, addMi, addRefIdx);
 #endif
 
 #if !JVET_AG0164_AFFINE_GPM
@@ -694,9 +733,9 @@ void CU::saveMotionInHMVP( const CodingUnit& cu, const bool isToBeDone )
     if (addAffInherit.baseMV[0].refIdx != -1 || addAffInherit.baseMV[1].refIdx != -1)
     {
 #if JVET_Z0118_GDR
-      cu.cs->addAffInheritToLut((isClean) ? cu.cs->motionLut.lutAffInherit1 : cu.cs->motionLut.lutAffInherit0, addAffInherit);
+      cu.cs->addAffInheritToLut((isClean) ? cu.cs->getMotionLut().lutAffInherit1 : cu.cs->getMotionLut().lutAffInherit0, addAffInherit);
 #else
-      cu.cs->addAffInheritToLut(cu.cs->motionLut.lutAffInherit, addAffInherit);
+      cu.cs->addAffInheritToLut(cu.cs->getMotionLut().lutAffInherit, addAffInherit);
 #endif
     }
     return;
@@ -751,11 +790,11 @@ void CU::saveMotionInHMVP( const CodingUnit& cu, const bool isToBeDone )
         if (CU::isIBC(cu))
 #endif
         {
-          cu.cs->addMiToLutIBC(cu.cs->motionLut.lutIbc1, mi);
+          cu.cs->addMiToLutIBC(cu.cs->getMotionLut().lutIbc1, mi);
         }
         else
         {
-          cu.cs->addMiToLut(cu.cs->motionLut.lut1, mi);
+          cu.cs->addMiToLut(cu.cs->getMotionLut().lut1, mi);
         }
       }
 
@@ -765,31 +804,31 @@ void CU::saveMotionInHMVP( const CodingUnit& cu, const bool isToBeDone )
       if (CU::isIBC(cu))
 #endif
       {
-        cu.cs->addMiToLutIBC(cu.cs->motionLut.lutIbc0, mi);
+        cu.cs->addMiToLutIBC(cu.cs->getMotionLut().lutIbc0, mi);
       }
       else
       {
-        cu.cs->addMiToLut(cu.cs->motionLut.lut0, mi);
+        cu.cs->addMiToLut(cu.cs->getMotionLut().lut0, mi);
       }
 #else 
       if (CU::isIBC(cu))
       {
-        cu.cs->addMiToLutIBC(cu.cs->motionLut.lutIbc, mi);
+        cu.cs->addMiToLutIBC(cu.cs->getMotionLut().lutIbc, mi);
       }
       else
       {
-        cu.cs->addMiToLut(cu.cs->motionLut.lut, mi);
+        cu.cs->addMiToLut(cu.cs->getMotionLut().lut, mi);
       }
 #endif
 #else
 #if JVET_Z0118_GDR
       if (isClean)
       {
-        cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc1 : cu.cs->motionLut.lut1, mi);
+        cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut().lutIbc1 : cu.cs->getMotionLut().lut1, mi);
       }
-      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc0 : cu.cs->motionLut.lut0, mi);      
+      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut().lutIbc0 : cu.cs->getMotionLut().lut0, mi);      
 #else
-      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc : cu.cs->motionLut.lut, mi);
+      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut().lutIbc : cu.cs->getMotionLut().lut, mi);
 #endif
 #endif
     }
@@ -2087,7 +2126,7 @@ int PU::getIntraMPMs(const PredictionUnit &pu, unsigned* mpm, const ChannelType
 #if JVET_Z0056_GPM_SPLIT_MODE_REORDERING
 void PU::getGeoIntraMPMs(const PredictionUnit &pu, uint8_t* mpm, uint8_t splitDir, uint8_t shape, bool doInit, bool doInitAL, bool doInitA, bool doInitL)
 {
-  static uint8_t  partialMPMsAll[GEO_NUM_TM_MV_CAND - 1][GEO_MAX_NUM_INTRA_CANDS]; // [0] for above-left, [1] for above [1] for left
+  static thread_local uint8_t  partialMPMsAll[GEO_NUM_TM_MV_CAND - 1][GEO_MAX_NUM_INTRA_CANDS]; // [0] for above-left, [1] for above [1] for left
   if (doInit)
   {
     if (doInitAL)
@@ -4092,14 +4131,14 @@ int PU::getCCPModelCandidateList(const PredictionUnit &pu, CCPModelCandidate can
 
   if (pu.cs->isGdrEnabled() && pu.cs->isClean(pu))
   {
-    ret = tryHistCCP(pu.cs->ccpLut.lutCCP1);  
+    ret = tryHistCCP(pu.cs->getCcpLut().lutCCP1);  
   }
   else
   {
-    ret = tryHistCCP(pu.cs->ccpLut.lutCCP0);
+    ret = tryHistCCP(pu.cs->getCcpLut().lutCCP0);
   }
 #else
-  int ret = tryHistCCP(pu.cs->ccpLut);
+  int ret = tryHistCCP(pu.cs->getCcpLut());
 #endif
 
   if (ret != -1)
@@ -4389,12 +4428,12 @@ void CU::saveModelsInHCCP(const CodingUnit &cu)
 #if JVET_Z0118_GDR   
     if (pu.cs->isGdrEnabled() && pu.cs->isClean(pu))
     {      
-      cs.addCCPToLut(cs.ccpLut.lutCCP1, pu.curCand, -1);     
+      cs.addCCPToLut(cs.getCcpLut().lutCCP1, pu.curCand, -1);     
     }
 
-    cs.addCCPToLut(cs.ccpLut.lutCCP0, pu.curCand, -1);
+    cs.addCCPToLut(cs.getCcpLut().lutCCP0, pu.curCand, -1);
 #else
-    cs.addCCPToLut(cs.ccpLut.lutCCP, pu.curCand, -1);
+    cs.addCCPToLut(cs.getCcpLut().lutCCP, pu.curCand, -1);
 #endif
   }
 #if JVET_AF0073_INTER_CCP_MERGE
@@ -4408,12 +4447,12 @@ void CU::saveModelsInHCCP(const CodingUnit &cu)
 #if JVET_Z0118_GDR   
         if (tu.cs->isGdrEnabled() && tu.cs->isClean(tu))
         {
-          cs.addCCPToLut(cs.ccpLut.lutCCP1, tu.curCand, -1);
+          cs.addCCPToLut(cs.getCcpLut().lutCCP1, tu.curCand, -1);
         }
 
-        cs.addCCPToLut(cs.ccpLut.lutCCP0, tu.curCand, -1);
+        cs.addCCPToLut(cs.getCcpLut().lutCCP0, tu.curCand, -1);
 #else
-        cs.addCCPToLut(cs.ccpLut.lutCCP, tu.curCand, -1);
+        cs.addCCPToLut(cs.getCcpLut().lutCCP, tu.curCand, -1);
 #endif
       }
     }
@@ -5202,16 +5241,16 @@ void PU::addMergeHMVPCandSubTMVP(const CodingStructure &cs, MergeCtx &mrgCtx, co
 #if JVET_Z0075_IBC_HMVP_ENLARGE
 #if JVET_Z0118_GDR  
   bool isClean = cs.isClean(pu.cu->Y().bottomRight(), CHANNEL_TYPE_LUMA);
-  auto &lut = (isClean) ? cs.motionLut.lut1 : cs.motionLut.lut0;
+  auto &lut = (isClean) ? cs.getMotionLut().lut1 : cs.getMotionLut().lut0;
 #else
-  auto &lut = cs.motionLut.lut;
+  auto &lut = cs.getMotionLut().lut;
 #endif
 #else
 
 #if JVET_Z0118_GDR  
-  auto &lut = ibcFlag ? (isClean ? cs.motionLut.lutIbc1 : cs.motionLut.lutIbc0) : (isClean ? cs.motionLut.lut1 : cs.motionLut.lut0);
+  auto &lut = ibcFlag ? (isClean ? cs.getMotionLut().lutIbc1 : cs.getMotionLut().lutIbc0) : (isClean ? cs.getMotionLut().lut1 : cs.getMotionLut().lut0);
 #else
-  auto &lut = ibcFlag ? cs.motionLut.lutIbc : cs.motionLut.lut;
+  auto &lut = ibcFlag ? cs.getMotionLut().lutIbc : cs.getMotionLut().lut;
 #endif
 
 #endif // JVET_Z0075_IBC_HMVP_ENLARGE
@@ -5319,15 +5358,15 @@ bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx &mrgCtx, const int
 #endif
 #if JVET_Z0075_IBC_HMVP_ENLARGE
 #if JVET_Z0118_GDR
-  auto &lut = (isClean) ? cs.motionLut.lut1 : cs.motionLut.lut0;
+  auto &lut = (isClean) ? cs.getMotionLut().lut1 : cs.getMotionLut().lut0;
 #else
-  auto &lut = cs.motionLut.lut;
+  auto &lut = cs.getMotionLut().lut;
 #endif
 #else
 #if JVET_Z0118_GDR
-  auto &lut = ibcFlag ? (isClean ? cs.motionLut.lutIbc1 : cs.motionLut.lutIbc0) : (isClean ? cs.motionLut.lut1 : cs.motionLut.lut0);
+  auto &lut = ibcFlag ? (isClean ? cs.getMotionLut().lutIbc1 : cs.getMotionLut().lutIbc0) : (isClean ? cs.getMotionLut().lut1 : cs.getMotionLut().lut0);
 #else
-  auto &lut = ibcFlag ? cs.motionLut.lutIbc : cs.motionLut.lut;
+  auto &lut = ibcFlag ? cs.getMotionLut().lutIbc : cs.getMotionLut().lut;
 #endif
 #endif
 
@@ -5670,9 +5709,9 @@ bool PU::addIBCMergeHMVPCand(const CodingStructure &cs, MergeCtx &mrgCtx, const
 #endif
 
 #if JVET_Z0118_GDR
-  auto &lut = (isClean) ? cs.motionLut.lutIbc1 : cs.motionLut.lutIbc0;
+  auto &lut = (isClean) ? cs.getMotionLut().lutIbc1 : cs.getMotionLut().lutIbc0;
 #else
-  auto &lut = cs.motionLut.lutIbc;
+  auto &lut = cs.getMotionLut().lutIbc;
 #endif
   int num_avai_candInLUT = (int)lut.size();
   int compareNum = cnt;
@@ -10202,15 +10241,15 @@ bool PU::addBMMergeHMVPCand(const CodingStructure &cs, MergeCtx &mrgCtx, const i
 
 #if JVET_Z0075_IBC_HMVP_ENLARGE
 #if JVET_Z0118_GDR
-  auto &lut = (isClean) ? cs.motionLut.lut1 : cs.motionLut.lut0;
+  auto &lut = (isClean) ? cs.getMotionLut().lut1 : cs.getMotionLut().lut0;
 #else
-  auto &lut = cs.motionLut.lut;
+  auto &lut = cs.getMotionLut().lut;
 #endif
 #else
 #if JVET_Z0118_GDR
-  auto &lut = ibcFlag ? (isClean ? cs.motionLut.lutIbc1 : cs.motionLut.lutIbc0) : (isClean ? cs.motionLut.lut1 : cs.motionLut.lut0);
+  auto &lut = ibcFlag ? (isClean ? cs.getMotionLut().lutIbc1 : cs.getMotionLut().lutIbc0) : (isClean ? cs.getMotionLut().lut1 : cs.getMotionLut().lut0);
 #else
-  auto &lut = ibcFlag ? cs.motionLut.lutIbc : cs.motionLut.lut;
+  auto &lut = ibcFlag ? cs.getMotionLut().lutIbc : cs.getMotionLut().lut;
 #endif
 #endif
 
@@ -15848,17 +15887,17 @@ void PU::getIbcMVPsEncOnly(PredictionUnit &pu, Mv* mvPred, int& nbPred)
   }
 
 #if JVET_Z0118_GDR
-  size_t numAvaiCandInLUT = isClean ? pu.cs->motionLut.lutIbc1.size() : pu.cs->motionLut.lutIbc0.size();
+  size_t numAvaiCandInLUT = isClean ? pu.cs->getMotionLut().lutIbc1.size() : pu.cs->getMotionLut().lutIbc0.size();
 #else
-  size_t numAvaiCandInLUT = pu.cs->motionLut.lutIbc.size();
+  size_t numAvaiCandInLUT = pu.cs->getMotionLut().lutIbc.size();
 #endif
 
   for (uint32_t cand = 0; cand < numAvaiCandInLUT && nbPred < IBC_NUM_CANDIDATES; cand++)
   {
 #if JVET_Z0118_GDR
-    MotionInfo neibMi = isClean ? pu.cs->motionLut.lutIbc1[cand] : pu.cs->motionLut.lutIbc0[cand];
+    MotionInfo neibMi = isClean ? pu.cs->getMotionLut().lutIbc1[cand] : pu.cs->getMotionLut().lutIbc0[cand];
 #else
-    MotionInfo neibMi = pu.cs->motionLut.lutIbc[cand];
+    MotionInfo neibMi = pu.cs->getMotionLut().lutIbc[cand];
 #endif
     if (isAddNeighborMv(neibMi.bv, mvPred, nbPred))
     {
@@ -17513,9 +17552,9 @@ bool PU::addMergeHMVPCandFromAffModel(const PredictionUnit& pu, MergeCtx& mrgCtx
       MotionInfo mvInfo = puNei->getMotionInfo(posGroup1[i]);
 
 #if JVET_Z0118_GDR
-      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, iAffListIdx, mvInfo, posGroup1[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
+      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, iAffListIdx, mvInfo, posGroup1[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
 #else
-      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, pu.cs->motionLut.lutAff, iAffListIdx, mvInfo, posGroup1[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
+      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, pu.cs->getMotionLut().lutAff, iAffListIdx, mvInfo, posGroup1[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
 #endif
 #if INTER_LIC
 #if JVET_AD0213_LIC_IMP
@@ -17589,9 +17628,9 @@ bool PU::addMergeHMVPCandFromAffModel(const PredictionUnit& pu, MergeCtx& mrgCtx
       MotionInfo mvInfo = puNei->getMotionInfo(posGroup2[i]);
 
 #if JVET_Z0118_GDR
-      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, iAffListIdx, mvInfo, posGroup2[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
+      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, iAffListIdx, mvInfo, posGroup2[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
 #else
-      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, pu.cs->motionLut.lutAff, iAffListIdx, mvInfo, posGroup2[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
+      if (addOneMergeHMVPCandFromAffModel(pu, mrgCtx, cnt, pu.cs->getMotionLut().lutAff, iAffListIdx, mvInfo, posGroup2[i], mvInfo.interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
 #endif
 #if INTER_LIC
 #if JVET_AD0213_LIC_IMP
@@ -18234,17 +18273,17 @@ void PU::fillAffineMvpCand(PredictionUnit &pu, const RefPicList &eRefPicList, co
     if (affiAMVPInfo.numCand < AMVP_MAX_NUM_CANDS && leftAffNeiNum > 0)
     {
 #if JVET_Z0118_GDR
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
 #else
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->motionLut.lutAff, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->getMotionLut().lutAff, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
 #endif
     }
     if (affiAMVPInfo.numCand < AMVP_MAX_NUM_CANDS && aboveAffNeiNum > 0)
     {
 #if JVET_Z0118_GDR
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
 #else
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->motionLut.lutAff, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->getMotionLut().lutAff, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
 #endif
     }
   }
@@ -18345,17 +18384,17 @@ void PU::fillAffineMvpCand(PredictionUnit &pu, const RefPicList &eRefPicList, co
     if (affiAMVPInfo.numCand < AMVP_MAX_NUM_CANDS && leftAffNeiNum > 0)
     {
 #if JVET_Z0118_GDR
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
 #else
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->motionLut.lutAff, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->getMotionLut().lutAff, 0, leftNeiIdx, leftAffNeiNum, aiNeibeInherited, true);
 #endif
     }
     if (affiAMVPInfo.numCand < AMVP_MAX_NUM_CANDS && aboveAffNeiNum > 0)
     {
 #if JVET_Z0118_GDR
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
 #else
-      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->motionLut.lutAff, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
+      addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->getMotionLut().lutAff, 0, aboveNeiIdx, aboveAffNeiNum, aiNeibeInherited, true);
 #endif
     }
   }
@@ -18433,9 +18472,9 @@ void PU::fillAffineMvpCand(PredictionUnit &pu, const RefPicList &eRefPicList, co
       for (int affHMVPIdx = 0; affHMVPIdx < MAX_NUM_AFF_HMVP_CANDS; affHMVPIdx++)
       {
 #if JVET_Z0118_GDR
-        addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, affHMVPIdx, neiIdx, 5, aiNeibeInherited, false);
+        addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, affHMVPIdx, neiIdx, 5, aiNeibeInherited, false);
 #else
-        addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->motionLut.lutAff, affHMVPIdx, neiIdx, 5, aiNeibeInherited, false);
+        addSpatialAffineAMVPHMVPCand(pu, eRefPicList, refIdx, affiAMVPInfo, pu.cs->getMotionLut().lutAff, affHMVPIdx, neiIdx, 5, aiNeibeInherited, false);
 #endif
       }
     }
@@ -18544,15 +18583,15 @@ void PU::addAMVPHMVPCand(const PredictionUnit &pu, const RefPicList eRefPicList,
 
 #if JVET_Z0075_IBC_HMVP_ENLARGE
 #if JVET_Z0118_GDR
-  auto &lut = (isClean) ? pu.cs->motionLut.lut1 : pu.cs->motionLut.lut0;
+  auto &lut = (isClean) ? pu.cs->getMotionLut().lut1 : pu.cs->getMotionLut().lut0;
 #else
-  auto &lut = pu.cs->motionLut.lut;
+  auto &lut = pu.cs->getMotionLut().lut;
 #endif
 #else
 #if JVET_Z0118_GDR
-  auto &lut = CU::isIBC(*pu.cu) ? (isClean ? pu.cs->motionLut.lutIbc1 : pu.cs->motionLut.lutIbc0) : (isClean ? pu.cs->motionLut.lut1 : pu.cs->motionLut.lut0);
+  auto &lut = CU::isIBC(*pu.cu) ? (isClean ? pu.cs->getMotionLut().lutIbc1 : pu.cs->getMotionLut().lutIbc0) : (isClean ? pu.cs->getMotionLut().lut1 : pu.cs->getMotionLut().lut0);
 #else
-  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->motionLut.lutIbc : pu.cs->motionLut.lut;
+  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->getMotionLut().lutIbc : pu.cs->getMotionLut().lut;
 #endif
 #endif
 
@@ -18948,16 +18987,16 @@ const int getNonAdjAvailableAffineNeighboursByDistance(const PredictionUnit &pu,
     }
   }
 #if JVET_Z0118_GDR
-  int lutSize = (isClean) ? (int)pu.cs->motionLut.lutAffInherit1.size() : (int)pu.cs->motionLut.lutAffInherit0.size();
+  int lutSize = (isClean) ? (int)pu.cs->getMotionLut().lutAffInherit1.size() : (int)pu.cs->getMotionLut().lutAffInherit0.size();
 #else
-  int lutSize = (int)pu.cs->motionLut.lutAffInherit.size();
+  int lutSize = (int)pu.cs->getMotionLut().lutAffInherit.size();
 #endif
   for (int listIdx = 0; listIdx < lutSize; listIdx++)
   {
 #if JVET_Z0118_GDR
-    AffineInheritInfo& affHistInfo = (isClean) ? pu.cs->motionLut.lutAffInherit1[lutSize - 1 - listIdx] : pu.cs->motionLut.lutAffInherit0[lutSize - 1 - listIdx];
+    AffineInheritInfo& affHistInfo = (isClean) ? pu.cs->getMotionLut().lutAffInherit1[lutSize - 1 - listIdx] : pu.cs->getMotionLut().lutAffInherit0[lutSize - 1 - listIdx];
 #else
-    AffineInheritInfo& affHistInfo = pu.cs->motionLut.lutAffInherit[lutSize - 1 - listIdx];
+    AffineInheritInfo& affHistInfo = pu.cs->getMotionLut().lutAffInherit[lutSize - 1 - listIdx];
 #endif
     const Position posTemp = affHistInfo.basePos;
     const PredictionUnit *puTemp = pu.cs->getPURestricted(posTemp, pu, pu.chType);
@@ -20814,18 +20853,18 @@ void PU::getAffineMergeCand( const PredictionUnit &pu, AffineMergeCtx& affMrgCtx
         if (idx == startIdx)
         {
 #if JVET_Z0118_GDR
-          if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, 0, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
+          if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, 0, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
 #else
-          if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, pu.cs->motionLut.lutAff, 0, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
+          if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, pu.cs->getMotionLut().lutAff, 0, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
 #endif
           {
             return;
           }
 
 #if JVET_Z0118_GDR
-          if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, (isClean) ? pu.cs->motionLut.lutAffInherit1 : pu.cs->motionLut.lutAffInherit0, 0))
+          if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, (isClean) ? pu.cs->getMotionLut().lutAffInherit1 : pu.cs->getMotionLut().lutAffInherit0, 0))
 #else
-          if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, pu.cs->motionLut.lutAffInherit, 0))
+          if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, pu.cs->getMotionLut().lutAffInherit, 0))
 #endif
           {
             if (affMrgCtx.numValidMergeCand == mrgCandIdx) // for decoder 
@@ -20887,9 +20926,9 @@ void PU::getAffineMergeCand( const PredictionUnit &pu, AffineMergeCtx& affMrgCtx
       Position posRB = pu.Y().bottomRight().offset(3, 3);
       if (addOneAffineMergeHMVPCand(pu, affMrgCtx
 #if JVET_Z0118_GDR
-                                 , (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0
+                                 , (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0
 #else
-                                 , pu.cs->motionLut.lutAff
+                                 , pu.cs->getMotionLut().lutAff
 #endif
                                  , 0, tmvpInfo, posRB, BCW_DEFAULT
 #if INTER_LIC
@@ -20925,9 +20964,9 @@ void PU::getAffineMergeCand( const PredictionUnit &pu, AffineMergeCtx& affMrgCtx
     for (int iAffListIdx = 1; iAffListIdx < MAX_NUM_AFF_HMVP_CANDS; iAffListIdx++)
     {
 #if JVET_Z0118_GDR
-      if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, iAffListIdx, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
+      if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, iAffListIdx, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
 #else
-      if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, pu.cs->motionLut.lutAff, iAffListIdx, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
+      if (addSpatialAffineMergeHMVPCand(pu, affMrgCtx, pu.cs->getMotionLut().lutAff, iAffListIdx, npuGroup2, posGroup2, numGroup2, mrgCandIdx))
 #endif
       {
         return;
@@ -20937,9 +20976,9 @@ void PU::getAffineMergeCand( const PredictionUnit &pu, AffineMergeCtx& affMrgCtx
         Position posRB = pu.Y().bottomRight().offset(3, 3);
         if (addOneAffineMergeHMVPCand(pu, affMrgCtx
 #if JVET_Z0118_GDR
-                                    , (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0
+                                    , (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0
 #else
-                                    , pu.cs->motionLut.lutAff
+                                    , pu.cs->getMotionLut().lutAff
 #endif
                                     , iAffListIdx, tmvpInfo, posRB, BCW_DEFAULT
 #if INTER_LIC
@@ -20967,9 +21006,9 @@ void PU::getAffineMergeCand( const PredictionUnit &pu, AffineMergeCtx& affMrgCtx
     for (int iAffListIdx = 1; iAffListIdx < MAX_NUM_AFF_INHERIT_HMVP_CANDS; iAffListIdx++)
     {
 #if JVET_Z0118_GDR
-      if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, (isClean) ? pu.cs->motionLut.lutAffInherit1 : pu.cs->motionLut.lutAffInherit0, iAffListIdx))
+      if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, (isClean) ? pu.cs->getMotionLut().lutAffInherit1 : pu.cs->getMotionLut().lutAffInherit0, iAffListIdx))
 #else
-      if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, pu.cs->motionLut.lutAffInherit, iAffListIdx))
+      if (addOneInheritedHMVPAffineMergeCand(pu, affMrgCtx, pu.cs->getMotionLut().lutAffInherit, iAffListIdx))
 #endif
       {
         if (affMrgCtx.numValidMergeCand == mrgCandIdx) // for decoder 
@@ -21584,7 +21623,7 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
             {
               continue;
             }
-            if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, 0, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
+            if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, 0, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
 #if INTER_LIC
               , puNei->cu->licFlag
 #endif
@@ -21623,7 +21662,7 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
             {
               continue;
             }
-            if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, pu.cs->motionLut.lutAff, 0, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->BcwIdx : BCW_DEFAULT
+            if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, pu.cs->getMotionLut().lutAff, 0, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->BcwIdx : BCW_DEFAULT
 #if INTER_LIC
               , puNei->cu->LICFlag
 #endif
@@ -21654,9 +21693,9 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
           } //for nei
 #endif
 #if JVET_Z0118_GDR
-          if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->motionLut.lutAffInherit1 : pu.cs->motionLut.lutAffInherit0, 0))
+          if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->getMotionLut().lutAffInherit1 : pu.cs->getMotionLut().lutAffInherit0, 0))
 #else
-          if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, pu.cs->motionLut.lutAffInherit, 0))
+          if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, pu.cs->getMotionLut().lutAffInherit, 0))
 #endif
           {
             if (affineBMMergeCtx.interDirNeighbours[affineBMMergeCtx.numValidMergeCand] == 3 && isBiPredFromDifferentDirEqDistPoc(pu, affineBMMergeCtx.mvFieldNeighbours[(affineBMMergeCtx.numValidMergeCand << 1) + 0][0].refIdx, affineBMMergeCtx.mvFieldNeighbours[(affineBMMergeCtx.numValidMergeCand << 1) + 1][0].refIdx))
@@ -21714,9 +21753,9 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
       Position posRB = pu.Y().bottomRight().offset(3, 3);
       if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx
 #if JVET_Z0118_GDR
-        , (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0
+        , (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0
 #else
-        , pu.cs->motionLut.lutAff
+        , pu.cs->getMotionLut().lutAff
 #endif
         , 0, tmvpInfo, posRB, BCW_DEFAULT
 #if INTER_LIC
@@ -21759,7 +21798,7 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
         {
           continue;
         }
-        if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0, iAffListIdx, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
+        if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0, iAffListIdx, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->bcwIdx : BCW_DEFAULT
 #if INTER_LIC
           , puNei->cu->licFlag
 #endif
@@ -21798,7 +21837,7 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
         {
           continue;
         }
-        if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, pu.cs->motionLut.lutAff, iAffListIdx, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->BcwIdx : BCW_DEFAULT
+        if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx, pu.cs->getMotionLut().lutAff, iAffListIdx, mvInfo, posGroup2[nei], puNei->interDir == 3 ? puNei->cu->BcwIdx : BCW_DEFAULT
 #if INTER_LIC
           , puNei->cu->LICFlag
 #endif
@@ -21834,9 +21873,9 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
         Position posRB = pu.Y().bottomRight().offset(3, 3);
         if (addOneAffineMergeHMVPCand(pu, affineBMMergeCtx
 #if JVET_Z0118_GDR
-          , (isClean) ? pu.cs->motionLut.lutAff1 : pu.cs->motionLut.lutAff0
+          , (isClean) ? pu.cs->getMotionLut().lutAff1 : pu.cs->getMotionLut().lutAff0
 #else
-          , pu.cs->motionLut.lutAff
+          , pu.cs->getMotionLut().lutAff
 #endif
           , iAffListIdx, tmvpInfo, posRB, BCW_DEFAULT
 #if INTER_LIC
@@ -21872,9 +21911,9 @@ void PU::getBMAffineMergeCand(const PredictionUnit &pu, AffineMergeCtx& affineBM
     for (int iAffListIdx = 1; iAffListIdx < MAX_NUM_AFF_INHERIT_HMVP_CANDS; iAffListIdx++)
     {
 #if JVET_Z0118_GDR
-      if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->motionLut.lutAffInherit1 : pu.cs->motionLut.lutAffInherit0, iAffListIdx))
+      if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, (isClean) ? pu.cs->getMotionLut().lutAffInherit1 : pu.cs->getMotionLut().lutAffInherit0, iAffListIdx))
 #else
-      if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, pu.cs->motionLut.lutAffInherit, iAffListIdx))
+      if (addOneInheritedHMVPAffineMergeCand(pu, affineBMMergeCtx, pu.cs->getMotionLut().lutAffInherit, iAffListIdx))
 #endif
       {
         if (affineBMMergeCtx.interDirNeighbours[affineBMMergeCtx.numValidMergeCand] == 3 && isBiPredFromDifferentDirEqDistPoc(pu, affineBMMergeCtx.mvFieldNeighbours[(affineBMMergeCtx.numValidMergeCand << 1) + 0][0].refIdx, affineBMMergeCtx.mvFieldNeighbours[(affineBMMergeCtx.numValidMergeCand << 1) + 1][0].refIdx))
@@ -29139,12 +29178,12 @@ void CU::saveModelsInHEIP(const CodingUnit &cu)
 #if JVET_Z0118_GDR   
     if (cu.cs->isGdrEnabled() && cu.cs->isClean(cu))
     {      
-      cs.addEipToLut(cs.eipLut.lutEip1, cu.eipModel, -1);
+      cs.addEipToLut(cs.getEipLut().lutEip1, cu.eipModel, -1);
     }
 
-    cs.addEipToLut(cs.eipLut.lutEip0, cu.eipModel, -1);
+    cs.addEipToLut(cs.getEipLut().lutEip0, cu.eipModel, -1);
 #else
-    cs.addEipToLut(cs.eipLut.lutEip, cu.eipModel, -1);
+    cs.addEipToLut(cs.getEipLut().lutEip, cu.eipModel, -1);
 #endif
   }
 }
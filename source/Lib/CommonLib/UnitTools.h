@@ -49,6 +49,8 @@ namespace CS
   uint64_t getEstBits                   ( const CodingStructure &cs );
   UnitArea getArea                    ( const CodingStructure &cs, const UnitArea &area, const ChannelType chType );
   bool   isDualITree                  ( const CodingStructure &cs );
+  uint32_t getWavefrontLag            ( const SPS &sps );
+  void   reserveUnitsOfPicture        ( CodingStructure &cs );
 #if !MULTI_PASS_DMVR
   void   setRefinedMotionField(CodingStructure &cs);
 #endif
@@ -50,12 +50,23 @@
 
 #include "CommonLib/IbcHashMap.h"
 
+#include <mutex>
+
 #if TRANSFORM_SIMD_OPT || ENABLE_SIMD_TMP
 #include "CommonLib/TrQuant.h"
 #endif
 #if ENABLE_SIMD_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER_ENABLE_SIMD
 #include "CommonLib/BilateralFilter.h"
 #endif
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+#include "CommonLib/LoopFilter.h"
+#endif
+#if ENABLE_SIMD_SAO
+#include "CommonLib/SampleAdaptiveOffset.h"
+#endif
+#if ENABLE_SIMD_MIP
+#include "CommonLib/MatrixIntraPrediction.h"
+#endif
 
 #ifdef TARGET_SIMD_X86
 
@@ -236,6 +247,51 @@ void IntraPrediction::initIntraX86()
   default:
     break;
   }
+
+  // the static kernels are shared by all instances and threads, the first instance sets them
+  static std::once_flag initStaticOnce;
+  std::call_once( initStaticOnce, [vext]()
+  {
+    switch( vext )
+    {
+    case AVX512:
+    case AVX2:
+      _initIntraStaticX86<AVX2>();
+      break;
+    case AVX:
+      _initIntraStaticX86<AVX>();
+      break;
+    case SSE42:
+    case SSE41:
+      _initIntraStaticX86<SSE41>();
+      break;
+    default:
+      break;
+    }
+  } );
+}
+#endif
+
+#if ENABLE_SIMD_MIP
+void MatrixIntraPrediction::initMatrixIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initMatrixIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initMatrixIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initMatrixIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
 }
 #endif
 
@@ -262,5 +318,51 @@ void BilateralFilter::initBilateralFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_DEBLOCKING_FILTER
+void LoopFilter::initLoopFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initLoopFilterX86<AVX2>();
+    break;
+  case AVX:
+    _initLoopFilterX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initLoopFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case AVX:
+    _initSampleAdaptiveOffsetX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #endif
 
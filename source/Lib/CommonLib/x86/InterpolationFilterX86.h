@@ -4183,7 +4183,8 @@ void xWeightedSgpm_SSE(const PredictionUnit &pu, const uint32_t width, const uin
   int16_t  hIdx   = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2_EX;
   int16_t  angle  = g_geoParams[splitDir][0];
   int16_t  stepY  = 0;
-  int16_t *weight = nullptr;
+  const int16_t *weight = nullptr;
+  const int blendShape = pu.cs->sps->getGeoMaskVariant() % GEO_NUM_BLEND_SHAPES;
 
 #if JVET_AC0189_SGPM_NO_BLENDING
   int blendWIdx = 0;
@@ -4199,7 +4200,7 @@ void xWeightedSgpm_SSE(const PredictionUnit &pu, const uint32_t width, const uin
   if (g_angle2mirror[angle] == 2)
   {
     stepY  = -GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights
+    weight = &g_geoWeights[blendShape]
 #if JVET_AC0189_SGPM_NO_BLENDING
                [blendWIdx]
 #else
@@ -4212,7 +4213,7 @@ void xWeightedSgpm_SSE(const PredictionUnit &pu, const uint32_t width, const uin
   else if (g_angle2mirror[angle] == 1)
   {
     stepY  = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights
+    weight = &g_geoWeights[blendShape]
 #if JVET_AC0189_SGPM_NO_BLENDING
                [blendWIdx]
 #else
@@ -4224,7 +4225,7 @@ void xWeightedSgpm_SSE(const PredictionUnit &pu, const uint32_t width, const uin
   else
   {
     stepY  = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights
+    weight = &g_geoWeights[blendShape]
 #if JVET_AC0189_SGPM_NO_BLENDING
                [blendWIdx]
 #else
@@ -4468,59 +4469,13 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
 
   int16_t wIdx = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t angle = g_geoParams[splitDir][0];
-  int16_t stepY = 0;
-  int16_t* weight = nullptr;
+  const GeoMaskView& maskView = g_geoMaskView[pu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+  const bool     mirrorX = maskView.stepX < 0;
+  int16_t        stepY   = maskView.stride;
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-    if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,pu.lwidth()))
-    {
-      weight = &g_geoCurveWeights[bldIdx][g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-#endif
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-#if GPM_CURVE
-    if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,pu.lwidth()))
-    {
-      weight = &g_geoCurveWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-    }
-#endif
-  }
-  else
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-    if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,pu.lwidth()))
-    {
-      weight = &g_geoCurveWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-#endif
-  }
+  const int16_t* weight  = maskView.weight[bldIdx];
 #else
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-  }
-  else
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
+  const int16_t* weight  = maskView.weight[0];
 #endif
 
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
@@ -4545,7 +4500,7 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
       __m128i s0 = _mm_loadl_epi64((__m128i *) (src0));
       __m128i s1 = _mm_loadl_epi64((__m128i *) (src1));
       __m128i w0;
-      if (g_angle2mirror[angle] == 1)
+      if (mirrorX)
       {
         w0 = _mm_loadu_si128((__m128i *) (weight - (8 - 1)));
         const __m128i shuffle_mask = _mm_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
@@ -4592,7 +4547,7 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
         {
           const __m256i mask = _mm256_set_epi16(0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1);
           __m256i w0p0, w0p1;
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0p0 = _mm256_lddqu_si256((__m256i *) (weight - (x << 1) - (16 - 1))); // first sub-sample the required weights.
             w0p1 = _mm256_lddqu_si256((__m256i *) (weight - (x << 1) - 16 - (16 - 1)));
@@ -4614,7 +4569,7 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
         }
         else
         {
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0 = _mm256_lddqu_si256((__m256i *) (weight - x - (16 - 1)));
             const __m256i shuffle_mask = _mm256_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
@@ -4662,7 +4617,7 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
         {
           const __m128i mask = _mm_set_epi16(0, 1, 0, 1, 0, 1, 0, 1);
           __m128i w0p0, w0p1;
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0p0 = _mm_lddqu_si128((__m128i *) (weight - (x << 1) - (8 - 1))); // first sub-sample the required weights.
             w0p1 = _mm_lddqu_si128((__m128i *) (weight - (x << 1) - 8 - (8 - 1)));
@@ -4681,7 +4636,7 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
         }
         else
         {
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0 = _mm_lddqu_si128((__m128i *) (weight - x - (8 - 1)));
             const __m128i shuffle_mask = _mm_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
@@ -4733,59 +4688,13 @@ void xWeightedGeoBlkRounded_SSE(const PredictionUnit &pu, const uint32_t width,
 
   int16_t wIdx = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t angle = g_geoParams[splitDir][0];
-  int16_t stepY = 0;
-  int16_t* weight = nullptr;
+  const GeoMaskView& maskView = g_geoMaskView[pu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+  const bool     mirrorX = maskView.stepX < 0;
+  int16_t        stepY   = maskView.stride;
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-    if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,pu.lwidth()))
-    {
-      weight = &g_geoCurveWeights[bldIdx][g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-#endif
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-#if GPM_CURVE
-    if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,pu.lwidth())) 
-    {
-      weight = &g_geoCurveWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-    }
-#endif
-  }
-  else
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-    if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,pu.lwidth()))
-    {
-      weight = &g_geoCurveWeights[bldIdx][g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-#endif
-  }
+  const int16_t* weight  = maskView.weight[bldIdx];
 #else
-  if (g_angle2mirror[angle] == 2)
-  {
-    stepY = -GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
-  else if (g_angle2mirror[angle] == 1)
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-  }
-  else
-  {
-    stepY = GEO_WEIGHT_MASK_SIZE;
-    weight = &g_geoWeights[g_angle2mask[angle]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-  }
+  const int16_t* weight  = maskView.weight[0];
 #endif
 
 #if JVET_AA0058_GPM_ADAPTIVE_BLENDING
@@ -4810,7 +4719,7 @@ void xWeightedGeoBlkRounded_SSE(const PredictionUnit &pu, const uint32_t width,
       __m128i s0 = _mm_loadl_epi64((__m128i *) (src0));
       __m128i s1 = _mm_loadl_epi64((__m128i *) (src1));
       __m128i w0;
-      if (g_angle2mirror[angle] == 1)
+      if (mirrorX)
       {
         w0 = _mm_loadu_si128((__m128i *) (weight - (8 - 1)));
         const __m128i shuffle_mask = _mm_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
@@ -4855,7 +4764,7 @@ void xWeightedGeoBlkRounded_SSE(const PredictionUnit &pu, const uint32_t width,
         {
           const __m256i mask = _mm256_set_epi16(0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1);
           __m256i w0p0, w0p1;
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0p0 = _mm256_lddqu_si256((__m256i *) (weight - (x << 1) - (16 - 1))); // first sub-sample the required weights.
             w0p1 = _mm256_lddqu_si256((__m256i *) (weight - (x << 1) - 16 - (16 - 1)));
@@ -4877,7 +4786,7 @@ void xWeightedGeoBlkRounded_SSE(const PredictionUnit &pu, const uint32_t width,
         }
         else
         {
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0 = _mm256_lddqu_si256((__m256i *) (weight - x - (16 - 1)));
             const __m256i shuffle_mask = _mm256_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
@@ -4924,7 +4833,7 @@ void xWeightedGeoBlkRounded_SSE(const PredictionUnit &pu, const uint32_t width,
         {
           const __m128i mask = _mm_set_epi16(0, 1, 0, 1, 0, 1, 0, 1);
           __m128i w0p0, w0p1;
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0p0 = _mm_lddqu_si128((__m128i *) (weight - (x << 1) - (8 - 1))); // first sub-sample the required weights.
             w0p1 = _mm_lddqu_si128((__m128i *) (weight - (x << 1) - 8 - (8 - 1)));
@@ -4943,7 +4852,7 @@ void xWeightedGeoBlkRounded_SSE(const PredictionUnit &pu, const uint32_t width,
         }
         else
         {
-          if (g_angle2mirror[angle] == 1)
+          if (mirrorX)
           {
             w0 = _mm_lddqu_si128((__m128i *) (weight - x - (8 - 1)));
             const __m128i shuffle_mask = _mm_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
@@ -4999,29 +4908,22 @@ void xWeightedGeoTpl_SSE(const PredictionUnit &pu, const uint8_t splitDir, PelUn
   const uint32_t scaleX = getComponentScaleX(compIdx, pu.chromaFormat);
   const uint32_t scaleY = getComponentScaleY(compIdx, pu.chromaFormat);
 
-  int16_t angle = g_geoParams[splitDir][0];
   int16_t wIdx  = floorLog2(pu.lwidth()) - GEO_MIN_CU_LOG2;
   int16_t hIdx  = floorLog2(pu.lheight()) - GEO_MIN_CU_LOG2;
-  int16_t stepX = 1 << scaleX;
-  int16_t stepY = 0;
-  Pel*   weight = &g_geoWeightsTpl[g_angle2mask[angle]][GEO_TM_ADDED_WEIGHT_MASK_SIZE * GEO_WEIGHT_MASK_SIZE_EXT + GEO_TM_ADDED_WEIGHT_MASK_SIZE];
-  if (g_angle2mirror[angle] == 2)
+  const GeoMaskView& maskView = g_geoMaskView[pu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+  int16_t stepX = maskView.stepX << scaleX;
+  int16_t stepY = maskView.tplStride << scaleY;
+  const Pel* weight = maskView.tplMask;
+  if (maskView.stride < 0)
   {
-    stepY = -(int)(GEO_WEIGHT_MASK_SIZE_EXT << scaleY);
-    weight += ((GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE_EXT + g_weightOffset[splitDir][hIdx][wIdx][0]);
     weight += (trueTFalseL ? GEO_WEIGHT_MASK_SIZE_EXT * GEO_MODE_SEL_TM_SIZE : -GEO_MODE_SEL_TM_SIZE ); // Shift to template pos
   }
-  else if (g_angle2mirror[angle] == 1)
+  else if (maskView.stepX < 0)
   {
-    stepX = -1 << scaleX;
-    stepY = (GEO_WEIGHT_MASK_SIZE_EXT << scaleY);
-    weight += (g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE_EXT + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0]));
     weight -= (trueTFalseL ? GEO_WEIGHT_MASK_SIZE_EXT * GEO_MODE_SEL_TM_SIZE : -GEO_MODE_SEL_TM_SIZE ); // Shift to template pos
   }
   else
   {
-    stepY = (GEO_WEIGHT_MASK_SIZE_EXT << scaleY);
-    weight += (g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE_EXT + g_weightOffset[splitDir][hIdx][wIdx][0]);
     weight -= (trueTFalseL ? GEO_WEIGHT_MASK_SIZE_EXT * GEO_MODE_SEL_TM_SIZE : GEO_MODE_SEL_TM_SIZE ); // Shift to template pos
   }
 
@@ -38,6 +38,12 @@
 
 #include "CommonDefX86.h"
 #include "../IntraPrediction.h"
+#if ENABLE_SIMD_MIP
+#include "../MipData.h"
+#endif
+#if ENABLE_SIMD_DIMD && JVET_AG0061_INTER_LFNST_NSPT
+#include "../UnitTools.h"
+#endif
 
 #ifdef TARGET_SIMD_X86
 
@@ -1795,49 +1801,596 @@ void ibcCiipBlendingSIMD( Pel *pDst, int strideDst, const Pel *pSrc0, int stride
 }
 #endif
 
-#if JVET_AG0058_EIP && INTRA_TRANS_ENC_OPT
+#if ENABLE_SIMD_DIMD
 template< X86_VEXT vext >
-int64_t calcAeipGroupSumSIMD(const Pel* src1, const Pel* src2, const int numSamples)
+int buildHistogramSIMD( const Pel *pReco, int iStride, uint32_t uiHeight, uint32_t uiWidth, int* piHistogram, int direction, int bw, int bh )
 {
-  int i = 0;
 #if USE_AVX2
-  __m256i vzero = _mm256_setzero_si256();
-  __m256i vsum32 = vzero;
-  const int samplesBySIMD = (numSamples >> 4) << 4;
-  for (; i < samplesBySIMD; i += 16)
+  const int numLanes = 8;
+#else
+  const int numLanes = 4;
+#endif
+  // below 16 samples clearing and merging the sub-histograms costs more than the vectorized gradients save, see
+  // Intra.dimdHistogram.above1/above2 in KernelBench
+  const int minSimdSamples = 16;
+  const int simdWidth      = direction == 3 || int( uiWidth * uiHeight ) < minSimdSamples ? 0 : int( uiWidth ) & ~( numLanes - 1 );
+
+  if( simdWidth )
   {
-    __m256i vsrc1 = _mm256_lddqu_si256((__m256i*)(&src1[i]));
-    __m256i vsrc2 = _mm256_lddqu_si256((__m256i*)(&src2[i]));
-    __m256i vsumtemp = _mm256_madd_epi16(vsrc1, vsrc2);
-    vsum32 = _mm256_add_epi32(vsum32, vsumtemp);
+    // the histogram updates of the lanes go to separate sub-histograms, so that neighbouring samples with the same
+    // angle do not serialize on one counter
+    int subHistogram[8][NUM_LUMA_MODE];
+    int laneMode[8];
+    int laneAmp[8];
+    memset( subHistogram, 0, numLanes * sizeof( subHistogram[0] ) );
+
+    // ratio thresholds halfway between the entries of the angle table
+    static const int halfAngTable[16] = { 1024, 3072, 5120, 7168, 10240, 14336, 18432, 22528, 26624, 30720, 34816, 38912, 44032, 50176, 56320, 62464 };
+
+    const __m128i vdivTable = _mm_setr_epi8( g_gradDivTable[ 0] | 8, g_gradDivTable[ 1] | 8, g_gradDivTable[ 2] | 8, g_gradDivTable[ 3] | 8,
+                                             g_gradDivTable[ 4] | 8, g_gradDivTable[ 5] | 8, g_gradDivTable[ 6] | 8, g_gradDivTable[ 7] | 8,
+                                             g_gradDivTable[ 8] | 8, g_gradDivTable[ 9] | 8, g_gradDivTable[10] | 8, g_gradDivTable[11] | 8,
+                                             g_gradDivTable[12] | 8, g_gradDivTable[13] | 8, g_gradDivTable[14] | 8, g_gradDivTable[15] | 8 );
+
+    for( uint32_t y = 0; y < uiHeight; y++ )
+    {
+      for( int x = 0; x < simdWidth; x += numLanes )
+      {
+        const Pel *pRec = pReco + y * iStride + x;
+#if USE_AVX2
+        const __m256i vtl = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec - iStride - 1 ) ) );
+        const __m256i vt  = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec - iStride ) ) );
+        const __m256i vtr = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec - iStride + 1 ) ) );
+        const __m256i vl  = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec - 1 ) ) );
+        const __m256i vr  = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec + 1 ) ) );
+        const __m256i vbl = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec + iStride - 1 ) ) );
+        const __m256i vb  = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec + iStride ) ) );
+        const __m256i vbr = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) ( pRec + iStride + 1 ) ) );
+
+        const __m256i vdy = _mm256_sub_epi32( _mm256_add_epi32( _mm256_add_epi32( vtl, vbl ), _mm256_slli_epi32( vl, 1 ) ),
+                                              _mm256_add_epi32( _mm256_add_epi32( vtr, vbr ), _mm256_slli_epi32( vr, 1 ) ) );
+        const __m256i vdx = _mm256_sub_epi32( _mm256_add_epi32( _mm256_add_epi32( vbl, vbr ), _mm256_slli_epi32( vb, 1 ) ),
+                                              _mm256_add_epi32( _mm256_add_epi32( vtl, vtr ), _mm256_slli_epi32( vt, 1 ) ) );
+        const __m256i vabsx = _mm256_abs_epi32( vdx );
+        const __m256i vabsy = _mm256_abs_epi32( vdy );
+        const __m256i vgtY  = _mm256_cmpgt_epi32( vabsx, vabsy );
+        const __m256i vs0   = _mm256_min_epi32( vabsx, vabsy );
+        const __m256i vs1   = _mm256_max_epi32( _mm256_max_epi32( vabsx, vabsy ), _mm256_set1_epi32( 1 ) );
+
+        // floorLog2 and the four bits below the leading one are read from the exactly converted float
+        const __m256i vs1f  = _mm256_castps_si256( _mm256_cvtepi32_ps( vs1 ) );
+        const __m256i vnorm = _mm256_and_si256( _mm256_srli_epi32( vs1f, 19 ), _mm256_set1_epi32( 15 ) );
+        const __m256i vv    = _mm256_shuffle_epi8( _mm256_broadcastsi128_si256( vdivTable ), _mm256_or_si256( vnorm, _mm256_set1_epi32( 0x80808000 ) ) );
+        __m256i vlog2 = _mm256_sub_epi32( _mm256_srli_epi32( vs1f, 23 ), _mm256_set1_epi32( 127 ) );
+        vlog2 = _mm256_sub_epi32( vlog2, _mm256_andnot_si256( _mm256_cmpeq_epi32( vnorm, _mm256_setzero_si256() ), _mm256_set1_epi32( -1 ) ) );
+
+        // (s0 * v) << (13 - x) resp. rounded >> (x - 13), evaluated as (s0 * v * 2^(17 - x) + round) >> 4
+        const __m256i vscale = _mm256_sllv_epi32( _mm256_set1_epi32( 1 ), _mm256_sub_epi32( _mm256_set1_epi32( 17 ), vlog2 ) );
+        const __m256i vround = _mm256_and_si256( _mm256_cmpgt_epi32( vlog2, _mm256_set1_epi32( 13 ) ), _mm256_set1_epi32( 8 ) );
+        const __m256i vratio = _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( _mm256_mullo_epi32( vs0, vv ), vscale ), vround ), 4 );
+
+        __m256i vidx = _mm256_setzero_si256();
+        for( int i = 0; i < 16; i++ )
+        {
+          vidx = _mm256_sub_epi32( vidx, _mm256_cmpgt_epi32( vratio, _mm256_set1_epi32( halfAngTable[i] - 1 ) ) );
+        }
+
+        // regions with the same signs run from HOR_IDX upwards resp. from VER_IDX downwards
+        const __m256i vneg  = _mm256_xor_si256( _mm256_xor_si256( vgtY, _mm256_srai_epi32( _mm256_xor_si256( vdx, vdy ), 31 ) ), _mm256_set1_epi32( -1 ) );
+        const __m256i vbase = _mm256_blendv_epi8( _mm256_set1_epi32( VER_IDX ), _mm256_set1_epi32( HOR_IDX ), vgtY );
+        const __m256i vmode = _mm256_add_epi32( vbase, _mm256_sub_epi32( _mm256_xor_si256( vidx, vneg ), vneg ) );
+
+        _mm256_storeu_si256( ( __m256i* ) laneMode, vmode );
+        _mm256_storeu_si256( ( __m256i* ) laneAmp, _mm256_add_epi32( vabsx, vabsy ) );
+#else
+        const __m128i vtl = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec - iStride - 1 ) ) );
+        const __m128i vt  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec - iStride ) ) );
+        const __m128i vtr = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec - iStride + 1 ) ) );
+        const __m128i vl  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec - 1 ) ) );
+        const __m128i vr  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec + 1 ) ) );
+        const __m128i vbl = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec + iStride - 1 ) ) );
+        const __m128i vb  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec + iStride ) ) );
+        const __m128i vbr = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) ( pRec + iStride + 1 ) ) );
+
+        const __m128i vdy = _mm_sub_epi32( _mm_add_epi32( _mm_add_epi32( vtl, vbl ), _mm_slli_epi32( vl, 1 ) ),
+                                           _mm_add_epi32( _mm_add_epi32( vtr, vbr ), _mm_slli_epi32( vr, 1 ) ) );
+        const __m128i vdx = _mm_sub_epi32( _mm_add_epi32( _mm_add_epi32( vbl, vbr ), _mm_slli_epi32( vb, 1 ) ),
+                                           _mm_add_epi32( _mm_add_epi32( vtl, vtr ), _mm_slli_epi32( vt, 1 ) ) );
+        const __m128i vabsx = _mm_abs_epi32( vdx );
+        const __m128i vabsy = _mm_abs_epi32( vdy );
+        const __m128i vgtY  = _mm_cmpgt_epi32( vabsx, vabsy );
+        const __m128i vs0   = _mm_min_epi32( vabsx, vabsy );
+        const __m128i vs1   = _mm_max_epi32( _mm_max_epi32( vabsx, vabsy ), _mm_set1_epi32( 1 ) );
+
+        // floorLog2 and the four bits below the leading one are read from the exactly converted float
+        const __m128i vs1f  = _mm_castps_si128( _mm_cvtepi32_ps( vs1 ) );
+        const __m128i vnorm = _mm_and_si128( _mm_srli_epi32( vs1f, 19 ), _mm_set1_epi32( 15 ) );
+        const __m128i vv    = _mm_shuffle_epi8( vdivTable, _mm_or_si128( vnorm, _mm_set1_epi32( 0x80808000 ) ) );
+        __m128i vlog2 = _mm_sub_epi32( _mm_srli_epi32( vs1f, 23 ), _mm_set1_epi32( 127 ) );
+        vlog2 = _mm_sub_epi32( vlog2, _mm_andnot_si128( _mm_cmpeq_epi32( vnorm, _mm_setzero_si128() ), _mm_set1_epi32( -1 ) ) );
+
+        // (s0 * v) << (13 - x) resp. rounded >> (x - 13), evaluated as (s0 * v * 2^(17 - x) + round) >> 4,
+        // the power of two is built as float exponent
+        const __m128i vscale = _mm_cvttps_epi32( _mm_castsi128_ps( _mm_slli_epi32( _mm_sub_epi32( _mm_set1_epi32( 17 + 127 ), vlog2 ), 23 ) ) );
+        const __m128i vround = _mm_and_si128( _mm_cmpgt_epi32( vlog2, _mm_set1_epi32( 13 ) ), _mm_set1_epi32( 8 ) );
+        const __m128i vratio = _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( _mm_mullo_epi32( vs0, vv ), vscale ), vround ), 4 );
+
+        __m128i vidx = _mm_setzero_si128();
+        for( int i = 0; i < 16; i++ )
+        {
+          vidx = _mm_sub_epi32( vidx, _mm_cmpgt_epi32( vratio, _mm_set1_epi32( halfAngTable[i] - 1 ) ) );
+        }
+
+        // regions with the same signs run from HOR_IDX upwards resp. from VER_IDX downwards
+        const __m128i vneg  = _mm_xor_si128( _mm_xor_si128( vgtY, _mm_srai_epi32( _mm_xor_si128( vdx, vdy ), 31 ) ), _mm_set1_epi32( -1 ) );
+        const __m128i vbase = _mm_blendv_epi8( _mm_set1_epi32( VER_IDX ), _mm_set1_epi32( HOR_IDX ), vgtY );
+        const __m128i vmode = _mm_add_epi32( vbase, _mm_sub_epi32( _mm_xor_si128( vidx, vneg ), vneg ) );
+
+        _mm_storeu_si128( ( __m128i* ) laneMode, vmode );
+        _mm_storeu_si128( ( __m128i* ) laneAmp, _mm_add_epi32( vabsx, vabsy ) );
+#endif
+        // samples without gradient add a zero amplitude
+        for( int lane = 0; lane < numLanes; lane++ )
+        {
+          subHistogram[lane][laneMode[lane]] += laneAmp[lane];
+        }
+      }
+    }
+
+    for( int lane = 0; lane < numLanes; lane++ )
+    {
+      for( int mode = 0; mode < NUM_LUMA_MODE; mode++ )
+      {
+        piHistogram[mode] += subHistogram[lane][mode];
+      }
+    }
   }
-  vsum32 = _mm256_hadd_epi32(vsum32, vsum32);
-  vsum32 = _mm256_hadd_epi32(vsum32, vsum32);
-  int64_t sum = (_mm_cvtsi128_si32(_mm256_castsi256_si128(vsum32)) + _mm_cvtsi128_si32(_mm256_castsi256_si128(_mm256_permute2x128_si256(vsum32, vsum32, 0x11))));
+
+  if( simdWidth < int( uiWidth ) )
+  {
+#if JVET_AG0061_INTER_LFNST_NSPT
+    buildHistogram( pReco + simdWidth, iStride, uiHeight, uiWidth - simdWidth, piHistogram, direction, bw, bh );
 #else
-  __m128i vzero = _mm_setzero_si128();
-  __m128i vsum32 = vzero;
-  const int samplesBySIMD = (numSamples >> 4) << 4;
-  for (; i < samplesBySIMD; i += 8)
+    IntraPrediction::buildHistogram( pReco + simdWidth, iStride, uiHeight, uiWidth - simdWidth, piHistogram, direction, bw, bh );
+#endif
+  }
+  return 0;
+}
+#endif
+
+#if ENABLE_SIMD_CCCM
+template< X86_VEXT vext >
+void cccmCalcCovarianceSIMD( const Pel A[CCCM_NUM_PARAMS_MAX][CCCM_REF_SAMPLES_MAX], const Pel* C0, const Pel* C1, const int numParams, const int sampleNum, TCccmCoeff ATA[CCCM_NUM_PARAMS_MAX][CCCM_NUM_PARAMS_MAX], TCccmCoeff* ATC0, TCccmCoeff* ATC1 )
+{
+#if USE_AVX2
+  const int numLanes = 16;
+#else
+  const int numLanes = 8;
+#endif
+  // two vectors of samples per iteration, which halves the accumulator updates
+  const int numCols   = numParams + ( C1 ? 2 : 1 );
+  const int simdNum   = sampleNum & ~( 2 * numLanes - 1 );
+  const Pel* cols[CCCM_NUM_PARAMS_MAX + 2];
+
+  for( int coli = 0; coli < numParams; coli++ )
+  {
+    cols[coli] = A[coli];
+  }
+  cols[numParams] = C0;
+  if( C1 )
+  {
+    cols[numParams + 1] = C1;
+  }
+
+  // the madd products are summed up in 32 bit lanes, which are flushed to 64 bit before they can overflow
+  __m128i vmaxAbs = _mm_setzero_si128();
+  for( int coli = 0; coli < numCols; coli++ )
+  {
+    for( int rowi = 0; rowi < simdNum; rowi += 8 )
+    {
+      vmaxAbs = _mm_max_epu16( vmaxAbs, _mm_abs_epi16( _mm_loadu_si128( ( const __m128i* ) &cols[coli][rowi] ) ) );
+    }
+  }
+  vmaxAbs = _mm_max_epu16( vmaxAbs, _mm_srli_si128( vmaxAbs, 8 ) );
+  vmaxAbs = _mm_max_epu16( vmaxAbs, _mm_srli_si128( vmaxAbs, 4 ) );
+  vmaxAbs = _mm_max_epu16( vmaxAbs, _mm_srli_si128( vmaxAbs, 2 ) );
+  const int64_t maxAbs        = _mm_extract_epi16( vmaxAbs, 0 );
+  const int64_t flushInterval = maxAbs ? int64_t( std::numeric_limits<int32_t>::max() ) / ( 4 * maxAbs * maxAbs ) : simdNum;
+
+  if( flushInterval == 0 )
+  {
+    CccmCovariance::calcCovariance( A, C0, C1, numParams, sampleNum, ATA, ATC0, ATC1 );
+    return;
+  }
+
+  // pairs in the order of the upper triangle of the parameters, each row followed by its cross-correlations
+  const int numPairs = numParams * ( numParams + 1 ) / 2 + numParams * ( numCols - numParams );
+  int64_t   sums[CCCM_NUM_PARAMS_MAX * ( CCCM_NUM_PARAMS_MAX + 1 ) / 2 + 2 * CCCM_NUM_PARAMS_MAX];
+  memset( sums, 0, sizeof( int64_t ) * numPairs );
+
+#if USE_AVX2
+  __m256i vacc[CCCM_NUM_PARAMS_MAX * ( CCCM_NUM_PARAMS_MAX + 1 ) / 2 + 2 * CCCM_NUM_PARAMS_MAX];
+  __m256i vcol[2][CCCM_NUM_PARAMS_MAX + 2];
+  for( int pair = 0; pair < numPairs; pair++ )
+  {
+    vacc[pair] = _mm256_setzero_si256();
+  }
+  auto flush = [&]()
+  {
+    for( int pair = 0; pair < numPairs; pair++ )
+    {
+      __m256i vsum = _mm256_add_epi64( _mm256_cvtepi32_epi64( _mm256_castsi256_si128( vacc[pair] ) ), _mm256_cvtepi32_epi64( _mm256_extracti128_si256( vacc[pair], 1 ) ) );
+      __m128i vs   = _mm_add_epi64( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+      sums[pair] += _mm_cvtsi128_si64( vs ) + _mm_extract_epi64( vs, 1 );
+      vacc[pair]  = _mm256_setzero_si256();
+    }
+  };
+#else
+  __m128i vacc[CCCM_NUM_PARAMS_MAX * ( CCCM_NUM_PARAMS_MAX + 1 ) / 2 + 2 * CCCM_NUM_PARAMS_MAX];
+  __m128i vcol[2][CCCM_NUM_PARAMS_MAX + 2];
+  for( int pair = 0; pair < numPairs; pair++ )
   {
-    __m128i vsrc1 = _mm_loadu_si128((__m128i*)(&src1[i]));
-    __m128i vsrc2 = _mm_loadu_si128((__m128i*)(&src2[i]));
-    __m128i vsumtemp = _mm_madd_epi16(vsrc1, vsrc2);
-    vsum32 = _mm_add_epi32(vsum32, vsumtemp);
+    vacc[pair] = _mm_setzero_si128();
   }
-  vsum32 = _mm_add_epi32(vsum32, _mm_shuffle_epi32(vsum32, 0x4e));   // 01001110
-  vsum32 = _mm_add_epi32(vsum32, _mm_shuffle_epi32(vsum32, 0xb1));   // 10110001
-  int64_t sum = _mm_cvtsi128_si32(vsum32);
+  auto flush = [&]()
+  {
+    for( int pair = 0; pair < numPairs; pair++ )
+    {
+      __m128i vs = _mm_add_epi64( _mm_cvtepi32_epi64( vacc[pair] ), _mm_cvtepi32_epi64( _mm_unpackhi_epi64( vacc[pair], vacc[pair] ) ) );
+      sums[pair] += _mm_cvtsi128_si64( vs ) + _mm_extract_epi64( vs, 1 );
+      vacc[pair]  = _mm_setzero_si128();
+    }
+  };
 #endif
-  for (; i < numSamples; i++)
+
+  int64_t sinceFlush = 0;
+  for( int rowi = 0; rowi < simdNum; rowi += 2 * numLanes )
   {
-    sum += src1[i] * src2[i];
+    for( int coli = 0; coli < numCols; coli++ )
+    {
+#if USE_AVX2
+      vcol[0][coli] = _mm256_loadu_si256( ( const __m256i* ) &cols[coli][rowi] );
+      vcol[1][coli] = _mm256_loadu_si256( ( const __m256i* ) &cols[coli][rowi + numLanes] );
+#else
+      vcol[0][coli] = _mm_loadu_si128( ( const __m128i* ) &cols[coli][rowi] );
+      vcol[1][coli] = _mm_loadu_si128( ( const __m128i* ) &cols[coli][rowi + numLanes] );
+#endif
+    }
+
+    int pair = 0;
+    for( int coli0 = 0; coli0 < numParams; coli0++ )
+    {
+      for( int coli1 = coli0; coli1 < numCols; coli1++, pair++ )
+      {
+#if USE_AVX2
+        const __m256i vprod = _mm256_add_epi32( _mm256_madd_epi16( vcol[0][coli0], vcol[0][coli1] ), _mm256_madd_epi16( vcol[1][coli0], vcol[1][coli1] ) );
+        vacc[pair] = _mm256_add_epi32( vacc[pair], vprod );
+#else
+        const __m128i vprod = _mm_add_epi32( _mm_madd_epi16( vcol[0][coli0], vcol[0][coli1] ), _mm_madd_epi16( vcol[1][coli0], vcol[1][coli1] ) );
+        vacc[pair] = _mm_add_epi32( vacc[pair], vprod );
+#endif
+      }
+    }
+
+    if( ++sinceFlush == flushInterval )
+    {
+      flush();
+      sinceFlush = 0;
+    }
+  }
+  flush();
+
+  for( int rowi = simdNum; rowi < sampleNum; rowi++ )
+  {
+    int pair = 0;
+    for( int coli0 = 0; coli0 < numParams; coli0++ )
+    {
+      for( int coli1 = coli0; coli1 < numCols; coli1++, pair++ )
+      {
+        sums[pair] += cols[coli0][rowi] * cols[coli1][rowi];
+      }
+    }
+  }
+
+  for( int coli = 0; coli < numParams; coli++ )
+  {
+    memset( ATA[coli], 0x00, sizeof( TCccmCoeff ) * numParams );
   }
 
-  return sum;
+  int pair = 0;
+  for( int coli0 = 0; coli0 < numParams; coli0++ )
+  {
+    for( int coli1 = coli0; coli1 < numParams; coli1++ )
+    {
+      ATA[coli0][coli1] = sums[pair++];
+    }
+    ATC0[coli0] = sums[pair++];
+    if( C1 )
+    {
+      ATC1[coli0] = sums[pair++];
+    }
+  }
 }
 #endif
 
+#if ENABLE_SIMD_TIMD
+template< X86_VEXT vext >
+void timdAngLumaSIMD( Pel* pDstBuf, const ptrdiff_t dstStride, Pel* refMain, int width, int height, int deltaPos, int intraPredAngle, const ClpRng& clpRng, int xOffset, int yOffset )
+{
+  const int simdWidth = ( width - xOffset ) & ~3;
+  if( simdWidth == 0 )
+  {
+    IntraPrediction::xIntraPredTimdAngLuma( pDstBuf, dstStride, refMain, width, height, deltaPos, intraPredAngle, clpRng, xOffset, yOffset );
+    return;
+  }
+
+  const __m128i voffset = _mm_set1_epi32( 128 );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+#if USE_AVX2
+  const __m256i voffset256 = _mm256_set1_epi32( 128 );
+  const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+  const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int y = yOffset; y < height; y++ )
+  {
+    const int deltaInt   = deltaPos >> 6;
+    const int deltaFract = deltaPos & 63;
+    const TFilterCoeff* const f = InterpolationFilter::getExtIntraCubicFilter( deltaFract );
+    // the taps are applied pairwise, the first pair on the samples at -1 and 0 and the second one on 1 and 2
+    const int coeff01 = ( f[0] & 0xffff ) | ( f[1] << 16 );
+    const int coeff23 = ( f[2] & 0xffff ) | ( f[3] << 16 );
+    const Pel* ref = refMain + deltaInt + xOffset;
+    Pel*       dst = pDstBuf + y * dstStride + xOffset;
+
+    int x = 0;
+#if USE_AVX2
+    const __m256i vcoeff256_01 = _mm256_set1_epi32( coeff01 );
+    const __m256i vcoeff256_23 = _mm256_set1_epi32( coeff23 );
+    for( ; x + 16 <= simdWidth; x += 16 )
+    {
+      const __m256i vr0 = _mm256_loadu_si256( ( const __m256i* ) ( ref + x ) );
+      const __m256i vr1 = _mm256_loadu_si256( ( const __m256i* ) ( ref + x + 1 ) );
+      const __m256i vr2 = _mm256_loadu_si256( ( const __m256i* ) ( ref + x + 2 ) );
+      const __m256i vr3 = _mm256_loadu_si256( ( const __m256i* ) ( ref + x + 3 ) );
+
+      __m256i vlo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vr0, vr1 ), vcoeff256_01 ), _mm256_madd_epi16( _mm256_unpacklo_epi16( vr2, vr3 ), vcoeff256_23 ) );
+      __m256i vhi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vr0, vr1 ), vcoeff256_01 ), _mm256_madd_epi16( _mm256_unpackhi_epi16( vr2, vr3 ), vcoeff256_23 ) );
+      vlo = _mm256_srai_epi32( _mm256_add_epi32( vlo, voffset256 ), 8 );
+      vhi = _mm256_srai_epi32( _mm256_add_epi32( vhi, voffset256 ), 8 );
+
+      // the unpacks and the pack both work within the 128-bit lanes, so the samples end up in their original order
+      const __m256i vdst = _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_packs_epi32( vlo, vhi ) ) );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + x ), vdst );
+    }
+#endif
+    const __m128i vcoeff01 = _mm_set1_epi32( coeff01 );
+    const __m128i vcoeff23 = _mm_set1_epi32( coeff23 );
+    for( ; x + 8 <= simdWidth; x += 8 )
+    {
+      const __m128i vr0 = _mm_loadu_si128( ( const __m128i* ) ( ref + x ) );
+      const __m128i vr1 = _mm_loadu_si128( ( const __m128i* ) ( ref + x + 1 ) );
+      const __m128i vr2 = _mm_loadu_si128( ( const __m128i* ) ( ref + x + 2 ) );
+      const __m128i vr3 = _mm_loadu_si128( ( const __m128i* ) ( ref + x + 3 ) );
+
+      __m128i vlo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vr0, vr1 ), vcoeff01 ), _mm_madd_epi16( _mm_unpacklo_epi16( vr2, vr3 ), vcoeff23 ) );
+      __m128i vhi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vr0, vr1 ), vcoeff01 ), _mm_madd_epi16( _mm_unpackhi_epi16( vr2, vr3 ), vcoeff23 ) );
+      vlo = _mm_srai_epi32( _mm_add_epi32( vlo, voffset ), 8 );
+      vhi = _mm_srai_epi32( _mm_add_epi32( vhi, voffset ), 8 );
+
+      const __m128i vdst = _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vlo, vhi ) ) );
+      _mm_storeu_si128( ( __m128i* ) ( dst + x ), vdst );
+    }
+    // the left template is 4 samples wide for most of the blocks
+    for( ; x < simdWidth; x += 4 )
+    {
+      const __m128i vr0 = _mm_loadl_epi64( ( const __m128i* ) ( ref + x ) );
+      const __m128i vr1 = _mm_loadl_epi64( ( const __m128i* ) ( ref + x + 1 ) );
+      const __m128i vr2 = _mm_loadl_epi64( ( const __m128i* ) ( ref + x + 2 ) );
+      const __m128i vr3 = _mm_loadl_epi64( ( const __m128i* ) ( ref + x + 3 ) );
+
+      __m128i vsum = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vr0, vr1 ), vcoeff01 ), _mm_madd_epi16( _mm_unpacklo_epi16( vr2, vr3 ), vcoeff23 ) );
+      vsum = _mm_srai_epi32( _mm_add_epi32( vsum, voffset ), 8 );
+
+      const __m128i vdst = _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_packs_epi32( vsum, vsum ) ) );
+      _mm_storel_epi64( ( __m128i* ) ( dst + x ), vdst );
+    }
+    for( ; x < width - xOffset; x++ )
+    {
+      const Pel val = ( f[0] * ref[x] + f[1] * ref[x + 1] + f[2] * ref[x + 2] + f[3] * ref[x + 3] + 128 ) >> 8;
+      dst[x] = ClipPel( val, clpRng );
+    }
+    deltaPos += intraPredAngle;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_MIP
+template< X86_VEXT vext >
+void mipReducedPredMulSIMD( int* const result, const int* const input, const uint8_t* matrix, const int sizeId,
+                            const int offset, const int inputOffset, const int bitDepth )
+{
+  // at most 64 dot products of length 8, 128 bit registers for all extensions
+  const __m128i vzero   = _mm_setzero_si128();
+  const __m128i vmax    = _mm_set1_epi32( ( 1 << bitDepth ) - 1 );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vinOff  = _mm_set1_epi32( inputOffset );
+
+  // the rebased boundary fits in 16 bit, the first input is repeated for the 4 input samples of 4x4 blocks
+  const __m128i vin = sizeId == 0 ? _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) input ) )
+                                  : _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) ) );
+  const int numOutputs = sizeId < 2 ? 16 : 64;
+
+  for( int pos = 0; pos < numOutputs; pos += 4 )
+  {
+    __m128i vsum;
+    if( sizeId == 0 )
+    {
+      __m128i vw  = _mm_loadu_si128( ( const __m128i* ) ( matrix + pos * 4 ) );
+      __m128i m01 = _mm_madd_epi16( vin, _mm_cvtepu8_epi16( vw ) );
+      __m128i m23 = _mm_madd_epi16( vin, _mm_cvtepu8_epi16( _mm_srli_si128( vw, 8 ) ) );
+      vsum        = _mm_hadd_epi32( m01, m23 );
+    }
+    else if( sizeId == 1 )
+    {
+      __m128i vw01 = _mm_loadu_si128( ( const __m128i* ) ( matrix + pos * 8 ) );
+      __m128i vw23 = _mm_loadu_si128( ( const __m128i* ) ( matrix + pos * 8 + 16 ) );
+      __m128i m0   = _mm_madd_epi16( vin, _mm_cvtepu8_epi16( vw01 ) );
+      __m128i m1   = _mm_madd_epi16( vin, _mm_cvtepu8_epi16( _mm_srli_si128( vw01, 8 ) ) );
+      __m128i m2   = _mm_madd_epi16( vin, _mm_cvtepu8_epi16( vw23 ) );
+      __m128i m3   = _mm_madd_epi16( vin, _mm_cvtepu8_epi16( _mm_srli_si128( vw23, 8 ) ) );
+      vsum         = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+    }
+    else
+    {
+      // rows of 7 weights skip the first input, the second load ends with the last row of the matrix
+      const __m128i vsh0 = _mm_setr_epi8( -1, -1,  0, -1,  1, -1,  2, -1,  3, -1,  4, -1,  5, -1,  6, -1 );
+      const __m128i vsh1 = _mm_setr_epi8( -1, -1,  7, -1,  8, -1,  9, -1, 10, -1, 11, -1, 12, -1, 13, -1 );
+      const __m128i vsh2 = _mm_setr_epi8( -1, -1,  2, -1,  3, -1,  4, -1,  5, -1,  6, -1,  7, -1,  8, -1 );
+      const __m128i vsh3 = _mm_setr_epi8( -1, -1,  9, -1, 10, -1, 11, -1, 12, -1, 13, -1, 14, -1, 15, -1 );
+      __m128i vw01 = _mm_loadu_si128( ( const __m128i* ) ( matrix + pos * 7 ) );
+      __m128i vw23 = _mm_loadu_si128( ( const __m128i* ) ( matrix + pos * 7 + 12 ) );
+      __m128i m0   = _mm_madd_epi16( vin, _mm_shuffle_epi8( vw01, vsh0 ) );
+      __m128i m1   = _mm_madd_epi16( vin, _mm_shuffle_epi8( vw01, vsh1 ) );
+      __m128i m2   = _mm_madd_epi16( vin, _mm_shuffle_epi8( vw23, vsh2 ) );
+      __m128i m3   = _mm_madd_epi16( vin, _mm_shuffle_epi8( vw23, vsh3 ) );
+      vsum         = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+    }
+    vsum = _mm_add_epi32( _mm_srai_epi32( _mm_add_epi32( vsum, voffset ), MIP_SHIFT_MATRIX ), vinOff );
+    vsum = _mm_min_epi32( _mm_max_epi32( vsum, vzero ), vmax );
+    _mm_storeu_si128( ( __m128i* ) ( result + pos ), vsum );
+  }
+}
+
+template< X86_VEXT vext >
+void mipPredUpsamplingSIMD( int* const dst, const int* const src, const int* const refTop, const int* const refLeft,
+                            const SizeType width, const SizeType height, const SizeType reducedPredSize,
+                            const unsigned int upsmpFactorHor, const unsigned int upsmpFactorVer )
+{
+  // (before * (factor - pos) + behind * pos + round) >> log2(factor) as (before << log2(factor) + round + (behind - before) * pos) >> log2(factor)
+  const int* verSrc     = src;
+  SizeType   verSrcStep = width;
+
+  if( upsmpFactorHor > 1 )
+  {
+    int* const horDst = dst + ( upsmpFactorVer - 1 ) * width;
+    verSrc            = horDst;
+    verSrcStep       *= upsmpFactorVer;
+
+    const int log2UpsmpFactor = floorLog2( upsmpFactorHor );
+    const int roundingOffset  = 1 << ( log2UpsmpFactor - 1 );
+
+    for( int y = 0; y < reducedPredSize; y++ )
+    {
+      const int* srcLine = src + y * reducedPredSize;
+      int*       dstLine = horDst + y * verSrcStep;
+      const int  before  = refLeft[( y + 1 ) * upsmpFactorVer - 1];
+
+      if( upsmpFactorHor == 2 )
+      {
+        for( int x = 0; x < reducedPredSize; x += 4 )
+        {
+          __m128i vbehind = _mm_loadu_si128( ( const __m128i* ) ( srcLine + x ) );
+          __m128i vbefore = x == 0 ? _mm_insert_epi32( _mm_slli_si128( vbehind, 4 ), before, 0 ) : _mm_loadu_si128( ( const __m128i* ) ( srcLine + x - 1 ) );
+          __m128i vavg    = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( vbefore, vbehind ), _mm_set1_epi32( 1 ) ), 1 );
+          _mm_storeu_si128( ( __m128i* ) ( dstLine + 2 * x ),     _mm_unpacklo_epi32( vavg, vbehind ) );
+          _mm_storeu_si128( ( __m128i* ) ( dstLine + 2 * x + 4 ), _mm_unpackhi_epi32( vavg, vbehind ) );
+        }
+        continue;
+      }
+
+      for( int x = 0; x < reducedPredSize; x++ )
+      {
+        const int prev   = x == 0 ? before : srcLine[x - 1];
+        const int base   = ( prev << log2UpsmpFactor ) + roundingOffset;
+        const int diff   = srcLine[x] - prev;
+        int*      currDst = dstLine + x * upsmpFactorHor;
+#if USE_AVX2
+        if( vext >= AVX2 && upsmpFactorHor >= 8 )
+        {
+          const __m256i vbase = _mm256_set1_epi32( base );
+          const __m256i vdiff = _mm256_set1_epi32( diff );
+          for( int pos = 0; pos < upsmpFactorHor; pos += 8 )
+          {
+            __m256i vpos = _mm256_add_epi32( _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ), _mm256_set1_epi32( pos ) );
+            __m256i vval = _mm256_add_epi32( vbase, _mm256_mullo_epi32( vdiff, vpos ) );
+            _mm256_storeu_si256( ( __m256i* ) ( currDst + pos ), _mm256_srai_epi32( vval, log2UpsmpFactor ) );
+          }
+          continue;
+        }
+#endif
+        const __m128i vbase = _mm_set1_epi32( base );
+        const __m128i vdiff = _mm_set1_epi32( diff );
+        for( int pos = 0; pos < upsmpFactorHor; pos += 4 )
+        {
+          __m128i vpos = _mm_add_epi32( _mm_setr_epi32( 1, 2, 3, 4 ), _mm_set1_epi32( pos ) );
+          __m128i vval = _mm_add_epi32( vbase, _mm_mullo_epi32( vdiff, vpos ) );
+          _mm_storeu_si128( ( __m128i* ) ( currDst + pos ), _mm_srai_epi32( vval, log2UpsmpFactor ) );
+        }
+      }
+    }
+  }
+
+  if( upsmpFactorVer > 1 )
+  {
+    const int log2UpsmpFactor = floorLog2( upsmpFactorVer );
+    const int roundingOffset  = 1 << ( log2UpsmpFactor - 1 );
+
+    // the last row of each band is the source row itself, it is read before it is rewritten
+    for( int y = 0; y < reducedPredSize; y++ )
+    {
+      const int* before  = y == 0 ? refTop : verSrc + ( y - 1 ) * verSrcStep;
+      const int* behind  = verSrc + y * verSrcStep;
+      int*       dstBand = dst + y * upsmpFactorVer * width;
+      int        x       = 0;
+#if USE_AVX2
+      if( vext >= AVX2 )
+      {
+        const __m256i vrnd = _mm256_set1_epi32( roundingOffset );
+        for( ; x + 8 <= width; x += 8 )
+        {
+          __m256i vbefore = _mm256_loadu_si256( ( const __m256i* ) ( before + x ) );
+          __m256i vdiff   = _mm256_sub_epi32( _mm256_loadu_si256( ( const __m256i* ) ( behind + x ) ), vbefore );
+          __m256i vval    = _mm256_add_epi32( _mm256_slli_epi32( vbefore, log2UpsmpFactor ), vrnd );
+          int*    currDst = dstBand + x;
+          for( int pos = 0; pos < upsmpFactorVer; pos++ )
+          {
+            vval = _mm256_add_epi32( vval, vdiff );
+            _mm256_storeu_si256( ( __m256i* ) currDst, _mm256_srai_epi32( vval, log2UpsmpFactor ) );
+            currDst += width;
+          }
+        }
+      }
+#endif
+      const __m128i vrnd = _mm_set1_epi32( roundingOffset );
+      for( ; x < width; x += 4 )
+      {
+        __m128i vbefore = _mm_loadu_si128( ( const __m128i* ) ( before + x ) );
+        __m128i vdiff   = _mm_sub_epi32( _mm_loadu_si128( ( const __m128i* ) ( behind + x ) ), vbefore );
+        __m128i vval    = _mm_add_epi32( _mm_slli_epi32( vbefore, log2UpsmpFactor ), vrnd );
+        int*    currDst = dstBand + x;
+        for( int pos = 0; pos < upsmpFactorVer; pos++ )
+        {
+          vval = _mm_add_epi32( vval, vdiff );
+          _mm_storeu_si128( ( __m128i* ) currDst, _mm_srai_epi32( vval, log2UpsmpFactor ) );
+          currDst += width;
+        }
+      }
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void MatrixIntraPrediction::_initMatrixIntraPredictionX86()
+{
+  m_reducedPredMul = mipReducedPredMulSIMD<vext>;
+  m_predUpsampling = mipPredUpsamplingSIMD<vext>;
+}
+
+template void MatrixIntraPrediction::_initMatrixIntraPredictionX86<SIMDX86>();
+#endif
+
 template <X86_VEXT vext>
 void IntraPrediction::_initIntraX86()
 {
@@ -1857,12 +2410,25 @@ void IntraPrediction::_initIntraX86()
 #if JVET_AC0112_IBC_CIIP && INTRA_TRANS_ENC_OPT
   m_ibcCiipBlending = ibcCiipBlendingSIMD<vext>;
 #endif
-#if JVET_AG0058_EIP && INTRA_TRANS_ENC_OPT
-  m_calcAeipGroupSum = calcAeipGroupSumSIMD<vext>;
-#endif
 }
 
 template void IntraPrediction::_initIntraX86<SIMDX86>();
 
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraStaticX86()
+{
+#if ENABLE_SIMD_DIMD
+  m_buildHistogram = buildHistogramSIMD<vext>;
+#endif
+#if ENABLE_SIMD_CCCM
+  CccmCovariance::m_calcCovariance = cccmCalcCovarianceSIMD<vext>;
+#endif
+#if ENABLE_SIMD_TIMD
+  m_timdAngLuma = timdAngLumaSIMD<vext>;
+#endif
+}
+
+template void IntraPrediction::_initIntraStaticX86<SIMDX86>();
+
 #endif //#ifdef TARGET_SIMD_X86
 //! \}
@@ -0,0 +1,573 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the SIMD kernels of the LoopFilter class
+ */
+
+#pragma once
+
+#include "CommonDefX86.h"
+#include "../LoopFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// The kernels filter the lines of one edge segment together, each line being a 32-bit lane of the vectors.
+// p[i] and q[i] hold the samples pi and qi of the lines at the distance i from the edge.
+
+template<X86_VEXT vext>
+static inline void loadLines( const Pel* src, const int stride, const bool verEdge, const int numLines, const int first, const int num, __m128i* v )
+{
+  if( verEdge )
+  {
+    // the lines are rows: load num samples of each row from the position first on and transpose them
+    // two lines are duplicated into the lanes 2 and 3
+    __m128i r[4];
+    for( int k = 0; k < 4; k++ )
+    {
+      const Pel* row = src + ( k < numLines ? k : k - 2 ) * stride + first;
+      r[k] = num == 8 ? _mm_loadu_si128( ( const __m128i* ) row ) : _mm_loadl_epi64( ( const __m128i* ) row );
+    }
+    const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+    const __m128i t1 = _mm_unpacklo_epi16( r[2], r[3] );
+    const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+    const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+    v[0] = _mm_cvtepi16_epi32( u0 );
+    v[1] = _mm_cvtepi16_epi32( _mm_srli_si128( u0, 8 ) );
+    v[2] = _mm_cvtepi16_epi32( u1 );
+    v[3] = _mm_cvtepi16_epi32( _mm_srli_si128( u1, 8 ) );
+    if( num == 8 )
+    {
+      const __m128i t2 = _mm_unpackhi_epi16( r[0], r[1] );
+      const __m128i t3 = _mm_unpackhi_epi16( r[2], r[3] );
+      const __m128i u2 = _mm_unpacklo_epi32( t2, t3 );
+      const __m128i u3 = _mm_unpackhi_epi32( t2, t3 );
+      v[4] = _mm_cvtepi16_epi32( u2 );
+      v[5] = _mm_cvtepi16_epi32( _mm_srli_si128( u2, 8 ) );
+      v[6] = _mm_cvtepi16_epi32( u3 );
+      v[7] = _mm_cvtepi16_epi32( _mm_srli_si128( u3, 8 ) );
+    }
+  }
+  else
+  {
+    for( int j = 0; j < num; j++ )
+    {
+      const Pel* pos = src + ( first + j ) * stride;
+      v[j] = _mm_cvtepi16_epi32( numLines == 4 ? _mm_loadl_epi64( ( const __m128i* ) pos ) : _mm_cvtsi32_si128( *( const int* ) pos ) );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static inline void storeLines( Pel* src, const int stride, const bool verEdge, const int numLines, const int first, const int num, const __m128i* v )
+{
+  if( verEdge )
+  {
+    // transpose back to rows of num (4 or 8) samples
+    const __m128i x0 = _mm_packs_epi32( v[0], v[1] );
+    const __m128i x1 = _mm_packs_epi32( v[2], v[3] );
+    const __m128i y0 = _mm_unpacklo_epi16( x0, x1 );
+    const __m128i y1 = _mm_unpackhi_epi16( x0, x1 );
+    const __m128i w0 = _mm_unpacklo_epi16( y0, y1 );
+    const __m128i w1 = _mm_unpackhi_epi16( y0, y1 );
+    __m128i r[4];
+    if( num == 8 )
+    {
+      const __m128i x2 = _mm_packs_epi32( v[4], v[5] );
+      const __m128i x3 = _mm_packs_epi32( v[6], v[7] );
+      const __m128i y2 = _mm_unpacklo_epi16( x2, x3 );
+      const __m128i y3 = _mm_unpackhi_epi16( x2, x3 );
+      const __m128i w2 = _mm_unpacklo_epi16( y2, y3 );
+      const __m128i w3 = _mm_unpackhi_epi16( y2, y3 );
+      r[0] = _mm_unpacklo_epi64( w0, w2 );
+      r[1] = _mm_unpackhi_epi64( w0, w2 );
+      r[2] = _mm_unpacklo_epi64( w1, w3 );
+      r[3] = _mm_unpackhi_epi64( w1, w3 );
+      for( int k = 0; k < numLines; k++ )
+      {
+        _mm_storeu_si128( ( __m128i* ) ( src + k * stride + first ), r[k] );
+      }
+    }
+    else
+    {
+      r[0] = w0;
+      r[1] = _mm_unpackhi_epi64( w0, w0 );
+      r[2] = w1;
+      r[3] = _mm_unpackhi_epi64( w1, w1 );
+      for( int k = 0; k < numLines; k++ )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( src + k * stride + first ), r[k] );
+      }
+    }
+  }
+  else
+  {
+    for( int j = 0; j < num; j++ )
+    {
+      Pel*          pos = src + ( first + j ) * stride;
+      const __m128i s   = _mm_packs_epi32( v[j], v[j] );
+      if( numLines == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* ) pos, s );
+      }
+      else
+      {
+        *( int* ) pos = _mm_cvtsi128_si32( s );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static inline void loadEdge( const Pel* src, const int stride, const bool verEdge, const int numLines, const int numP, const int numQ, __m128i* p, __m128i* q )
+{
+  __m128i v[8];
+  loadLines<vext>( src, stride, verEdge, numLines, -numP, numP, v );
+  for( int i = 0; i < numP; i++ )
+  {
+    p[i] = v[numP - 1 - i];
+  }
+  loadLines<vext>( src, stride, verEdge, numLines, 0, numQ, q );
+}
+
+// stores the numP and numQ samples next to the edge, a vertical edge stores them in units of 4 samples
+template<X86_VEXT vext>
+static inline void storeEdge( Pel* src, const int stride, const bool verEdge, const int numLines, int numP, int numQ, const __m128i* p, const __m128i* q )
+{
+  if( verEdge )
+  {
+    numP = numP == 0 ? 0 : numP > 4 ? 8 : 4;
+    numQ = numQ == 0 ? 0 : numQ > 4 ? 8 : 4;
+  }
+  if( numP )
+  {
+    __m128i v[8];
+    for( int i = 0; i < numP; i++ )
+    {
+      v[i] = p[numP - 1 - i];
+    }
+    storeLines<vext>( src, stride, verEdge, numLines, -numP, numP, v );
+  }
+  if( numQ )
+  {
+    storeLines<vext>( src, stride, verEdge, numLines, 0, numQ, q );
+  }
+}
+
+// Clip3( org - c, org + c, val )
+template<X86_VEXT vext>
+static inline __m128i clipAround( const __m128i val, const __m128i org, const __m128i c )
+{
+  return _mm_min_epi32( _mm_max_epi32( val, _mm_sub_epi32( org, c ) ), _mm_add_epi32( org, c ) );
+}
+
+template<X86_VEXT vext>
+static inline __m128i clipPel( const __m128i val, const ClpRng& clpRng )
+{
+  return _mm_min_epi32( _mm_max_epi32( val, _mm_set1_epi32( clpRng.min ) ), _mm_set1_epi32( clpRng.max ) );
+}
+
+// ( a + b + 1 ) >> 1
+template<X86_VEXT vext>
+static inline __m128i avg2( const __m128i a, const __m128i b )
+{
+  return _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( a, b ), _mm_set1_epi32( 1 ) ), 1 );
+}
+
+// | a - 2 * b + c |
+template<X86_VEXT vext>
+static inline __m128i secondDiff( const __m128i a, const __m128i b, const __m128i c )
+{
+  return _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( a, _mm_slli_epi32( b, 1 ) ), c ) );
+}
+
+// bilinear long filter of the sides with numberP and numberQ (3, 5 or 7) samples, see LoopFilter::xFilteringPandQ()
+template<X86_VEXT vext>
+static inline void filterLong( __m128i* p, __m128i* q, const int numberP, const int numberQ, const int tc )
+{
+  static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const int dbCoeffs3[3] = { 53, 32, 11 };
+  static const int tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int tc3[3]       = { 6, 4, 2 };
+
+  const __m128i refP = avg2<vext>( p[numberP - 1], p[numberP] );
+  const __m128i refQ = avg2<vext>( q[numberQ - 1], q[numberQ] );
+
+  __m128i refMiddle;
+  if( numberP == numberQ )
+  {
+    if( numberP == 5 )
+    {
+      __m128i sum = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p[0], q[0] ), _mm_add_epi32( p[1], q[1] ) ), _mm_add_epi32( p[2], q[2] ) );
+      sum         = _mm_add_epi32( _mm_slli_epi32( sum, 1 ), _mm_add_epi32( _mm_add_epi32( p[3], q[3] ), _mm_add_epi32( p[4], q[4] ) ) );
+      refMiddle   = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else
+    {
+      __m128i sum = _mm_slli_epi32( _mm_add_epi32( p[0], q[0] ), 1 );
+      for( int i = 1; i < 7; i++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_add_epi32( p[i], q[i] ) );
+      }
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+    }
+  }
+  else
+  {
+    const __m128i* l       = numberQ > numberP ? q : p;
+    const __m128i* s       = numberQ > numberP ? p : q;
+    const int      numberL = std::max( numberP, numberQ );
+    const int      numberS = std::min( numberP, numberQ );
+    if( numberL == 7 && numberS == 5 )
+    {
+      __m128i sum = _mm_slli_epi32( _mm_add_epi32( _mm_add_epi32( p[0], q[0] ), _mm_add_epi32( p[1], q[1] ) ), 1 );
+      for( int i = 2; i < 6; i++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_add_epi32( p[i], q[i] ) );
+      }
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else if( numberL == 7 && numberS == 3 )
+    {
+      __m128i sum = _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( l[0], s[0] ), 1 ), s[0] );
+      sum         = _mm_add_epi32( sum, _mm_slli_epi32( _mm_add_epi32( s[1], s[2] ), 1 ) );
+      sum         = _mm_add_epi32( sum, _mm_add_epi32( l[1], s[1] ) );
+      for( int i = 2; i < 7; i++ )
+      {
+        sum = _mm_add_epi32( sum, l[i] );
+      }
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else
+    {
+      __m128i sum = _mm_add_epi32( p[0], q[0] );
+      for( int i = 1; i < 4; i++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_add_epi32( p[i], q[i] ) );
+      }
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 4 ) ), 3 );
+    }
+  }
+
+  // ( refMiddle * coeff + ref * ( 64 - coeff ) + 32 ) >> 6, clipped to the modification allowed at the position
+  const int*    dbCoeffsP = numberP == 7 ? dbCoeffs7 : numberP == 5 ? dbCoeffs5 : dbCoeffs3;
+  const int*    dbCoeffsQ = numberQ == 7 ? dbCoeffs7 : numberQ == 5 ? dbCoeffs5 : dbCoeffs3;
+  const int*    tcP       = numberP == 3 ? tc3 : tc7;
+  const int*    tcQ       = numberQ == 3 ? tc3 : tc7;
+  const __m128i round     = _mm_set1_epi32( 32 );
+  const __m128i diffP     = _mm_sub_epi32( refMiddle, refP );
+  const __m128i diffQ     = _mm_sub_epi32( refMiddle, refQ );
+  const __m128i baseP     = _mm_add_epi32( _mm_slli_epi32( refP, 6 ), round );
+  const __m128i baseQ     = _mm_add_epi32( _mm_slli_epi32( refQ, 6 ), round );
+
+  for( int i = 0; i < numberP; i++ )
+  {
+    const __m128i val = _mm_srai_epi32( _mm_add_epi32( baseP, _mm_mullo_epi32( diffP, _mm_set1_epi32( dbCoeffsP[i] ) ) ), 6 );
+    p[i] = clipAround<vext>( val, p[i], _mm_set1_epi32( ( tc * tcP[i] ) >> 1 ) );
+  }
+  for( int i = 0; i < numberQ; i++ )
+  {
+    const __m128i val = _mm_srai_epi32( _mm_add_epi32( baseQ, _mm_mullo_epi32( diffQ, _mm_set1_epi32( dbCoeffsQ[i] ) ) ), 6 );
+    q[i] = clipAround<vext>( val, q[i], _mm_set1_epi32( ( tc * tcQ[i] ) >> 1 ) );
+  }
+}
+
+/**
+ - Deblocking of a luma edge segment of 4 lines, decisions and filtering
+ .
+ Bit-exact with LoopFilter::xDeblockLumaSegment() outside of the asymmetric deblocking of GDR virtual boundaries. The decisions are
+ derived for all lines at once and taken on the lines 0 and 3, the selected filter is then applied to the 4 lines.
+ */
+template<X86_VEXT vext>
+static void simdDeblockLumaSegment( Pel* src, const int stride, const bool verEdge, const int tc, const int beta, const int maxFilterLengthP, const int maxFilterLengthQ, const bool sidePisLarge, const bool sideQisLarge, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng )
+{
+  __m128i p[8], q[8];
+  loadEdge<vext>( src, stride, verEdge, 4, sidePisLarge ? 8 : 4, sideQisLarge ? 8 : 4, p, q );
+
+  const __m128i dp  = secondDiff<vext>( p[2], p[1], p[0] );
+  const __m128i dq  = secondDiff<vext>( q[2], q[1], q[0] );
+  const __m128i sp  = _mm_abs_epi32( _mm_sub_epi32( p[3], p[0] ) );
+  const __m128i sq  = _mm_abs_epi32( _mm_sub_epi32( q[3], q[0] ) );
+  const __m128i spq = _mm_add_epi32( sp, sq );
+  const __m128i pq  = _mm_abs_epi32( _mm_sub_epi32( p[0], q[0] ) );
+
+  const int dp0 = _mm_extract_epi32( dp, 0 ), dp3 = _mm_extract_epi32( dp, 3 );
+  const int dq0 = _mm_extract_epi32( dq, 0 ), dq3 = _mm_extract_epi32( dq, 3 );
+  const int pq0 = _mm_extract_epi32( pq, 0 ), pq3 = _mm_extract_epi32( pq, 3 );
+  const int tcStrong = ( tc * 5 + 1 ) >> 1;
+
+  int numModP = 0;
+  int numModQ = 0;
+
+  bool useLongtapFilter = false;
+  if( sidePisLarge || sideQisLarge )
+  {
+    __m128i dpL = dp, dqL = dq, spL = sp, sqL = sq;
+    if( sidePisLarge )
+    {
+      dpL = avg2<vext>( dp, secondDiff<vext>( p[5], p[4], p[3] ) );
+      __m128i mP4 = p[5];
+      if( maxFilterLengthP == 7 )
+      {
+        spL = _mm_add_epi32( spL, _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( _mm_sub_epi32( p[4], p[5] ), p[6] ), p[7] ) ) );
+        mP4 = p[7];
+      }
+      spL = avg2<vext>( spL, _mm_abs_epi32( _mm_sub_epi32( p[3], mP4 ) ) );
+    }
+    if( sideQisLarge )
+    {
+      dqL = avg2<vext>( dq, secondDiff<vext>( q[3], q[4], q[5] ) );
+      __m128i m11 = q[5];
+      if( maxFilterLengthQ == 7 )
+      {
+        sqL = _mm_add_epi32( sqL, _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( _mm_sub_epi32( q[4], q[5] ), q[6] ), q[7] ) ) );
+        m11 = q[7];
+      }
+      sqL = avg2<vext>( sqL, _mm_abs_epi32( _mm_sub_epi32( m11, q[3] ) ) );
+    }
+    const __m128i dL  = _mm_add_epi32( dpL, dqL );
+    const __m128i spqL = _mm_add_epi32( spL, sqL );
+    const int     d0L = _mm_extract_epi32( dL, 0 );
+    const int     d3L = _mm_extract_epi32( dL, 3 );
+
+    if( d0L + d3L < beta )
+    {
+      const bool swL = _mm_extract_epi32( spqL, 0 ) < ( beta * 3 >> 5 ) && 2 * d0L < ( beta >> 4 ) && pq0 < tcStrong
+                    && _mm_extract_epi32( spqL, 3 ) < ( beta * 3 >> 5 ) && 2 * d3L < ( beta >> 4 ) && pq3 < tcStrong;
+      if( swL )
+      {
+        useLongtapFilter = true;
+        numModP = sidePisLarge ? maxFilterLengthP : 3;
+        numModQ = sideQisLarge ? maxFilterLengthQ : 3;
+        filterLong<vext>( p, q, numModP, numModQ, tc );
+      }
+    }
+  }
+
+  if( !useLongtapFilter )
+  {
+    const int d0 = dp0 + dq0;
+    const int d3 = dp3 + dq3;
+    if( d0 + d3 >= beta )
+    {
+      return;
+    }
+
+    bool filterP = false;
+    bool filterQ = false;
+    if( maxFilterLengthP > 1 && maxFilterLengthQ > 1 )
+    {
+      const int sideThreshold = ( beta + ( beta >> 1 ) ) >> 3;
+      filterP = dp0 + dp3 < sideThreshold;
+      filterQ = dq0 + dq3 < sideThreshold;
+    }
+    bool sw = false;
+    if( maxFilterLengthP > 2 && maxFilterLengthQ > 2 )
+    {
+      sw = _mm_extract_epi32( spq, 0 ) < ( beta >> 3 ) && 2 * d0 < ( beta >> 2 ) && pq0 < tcStrong
+        && _mm_extract_epi32( spq, 3 ) < ( beta >> 3 ) && 2 * d3 < ( beta >> 2 ) && pq3 < tcStrong;
+    }
+
+    if( sw )
+    {
+      const __m128i tc1 = _mm_set1_epi32( tc );
+      const __m128i tc2 = _mm_set1_epi32( 2 * tc );
+      const __m128i tc3 = _mm_set1_epi32( 3 * tc );
+      const __m128i p0q0 = _mm_add_epi32( p[0], q[0] );
+      const __m128i p1p0q0 = _mm_add_epi32( p[1], p0q0 );
+      const __m128i p0q0q1 = _mm_add_epi32( p0q0, q[1] );
+
+      // ( p2 + 2 * p1 + 2 * p0 + 2 * q0 + q1 + 4 ) >> 3
+      const __m128i np0 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( p1p0q0, 1 ), _mm_add_epi32( p[2], q[1] ) ), _mm_set1_epi32( 4 ) ), 3 );
+      // ( p1 + 2 * p0 + 2 * q0 + 2 * q1 + q2 + 4 ) >> 3
+      const __m128i nq0 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( p0q0q1, 1 ), _mm_add_epi32( p[1], q[2] ) ), _mm_set1_epi32( 4 ) ), 3 );
+      // ( p2 + p1 + p0 + q0 + 2 ) >> 2
+      const __m128i np1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( p1p0q0, p[2] ), _mm_set1_epi32( 2 ) ), 2 );
+      // ( p0 + q0 + q1 + q2 + 2 ) >> 2
+      const __m128i nq1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( p0q0q1, q[2] ), _mm_set1_epi32( 2 ) ), 2 );
+      // ( 2 * p3 + 3 * p2 + p1 + p0 + q0 + 4 ) >> 3
+      const __m128i np2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( p[3], p[2] ), 1 ), _mm_add_epi32( p[2], p1p0q0 ) ), _mm_set1_epi32( 4 ) ), 3 );
+      // ( p0 + q0 + q1 + 3 * q2 + 2 * q3 + 4 ) >> 3
+      const __m128i nq2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( q[3], q[2] ), 1 ), _mm_add_epi32( q[2], p0q0q1 ) ), _mm_set1_epi32( 4 ) ), 3 );
+
+      p[0] = clipAround<vext>( np0, p[0], tc3 );
+      q[0] = clipAround<vext>( nq0, q[0], tc3 );
+      p[1] = clipAround<vext>( np1, p[1], tc2 );
+      q[1] = clipAround<vext>( nq1, q[1], tc2 );
+      p[2] = clipAround<vext>( np2, p[2], tc1 );
+      q[2] = clipAround<vext>( nq2, q[2], tc1 );
+      numModP = numModQ = 3;
+    }
+    else
+    {
+      // weak filter, applied to the lines with | delta | < 10 * tc
+      const __m128i diff0 = _mm_sub_epi32( q[0], p[0] );
+      const __m128i diff1 = _mm_sub_epi32( q[1], p[1] );
+      __m128i delta = _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( diff0, 3 ), diff0 ), _mm_add_epi32( _mm_slli_epi32( diff1, 1 ), diff1 ) );
+      delta = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 8 ) ), 4 );
+      const __m128i mask = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( tc * 10 ) );
+      delta = _mm_min_epi32( _mm_max_epi32( delta, _mm_set1_epi32( -tc ) ), _mm_set1_epi32( tc ) );
+
+      const __m128i tc2  = _mm_set1_epi32( tc >> 1 );
+      const __m128i ntc2 = _mm_set1_epi32( -( tc >> 1 ) );
+      if( filterP )
+      {
+        __m128i delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( avg2<vext>( p[2], p[0] ), p[1] ), delta ), 1 );
+        delta1 = _mm_min_epi32( _mm_max_epi32( delta1, ntc2 ), tc2 );
+        p[1] = _mm_blendv_epi8( p[1], clipPel<vext>( _mm_add_epi32( p[1], delta1 ), clpRng ), mask );
+      }
+      if( filterQ )
+      {
+        __m128i delta2 = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( avg2<vext>( q[2], q[0] ), q[1] ), delta ), 1 );
+        delta2 = _mm_min_epi32( _mm_max_epi32( delta2, ntc2 ), tc2 );
+        q[1] = _mm_blendv_epi8( q[1], clipPel<vext>( _mm_add_epi32( q[1], delta2 ), clpRng ), mask );
+      }
+      p[0] = _mm_blendv_epi8( p[0], clipPel<vext>( _mm_add_epi32( p[0], delta ), clpRng ), mask );
+      q[0] = _mm_blendv_epi8( q[0], clipPel<vext>( _mm_sub_epi32( q[0], delta ), clpRng ), mask );
+      numModP = filterP ? 2 : 1;
+      numModQ = filterQ ? 2 : 1;
+    }
+  }
+
+  storeEdge<vext>( src, stride, verEdge, 4, partPNoFilter ? 0 : numModP, partQNoFilter ? 0 : numModQ, p, q );
+}
+
+/**
+ - Deblocking of a chroma edge segment of 2 or 4 lines, decisions and filtering
+ .
+ Bit-exact with LoopFilter::xDeblockChromaSegment() outside of the asymmetric deblocking of GDR virtual boundaries. The decisions are
+ taken on the lines 0 and decisionLine (1 or 3).
+ */
+template<X86_VEXT vext>
+static void simdDeblockChromaSegment( Pel* src, const int stride, const bool verEdge, const int numLines, const int decisionLine, const int tc, const int beta, const bool largeBoundary, const bool isChromaHorCTBBoundary, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng )
+{
+  __m128i p[4], q[4];
+  loadEdge<vext>( src, stride, verEdge, numLines, 4, 4, p, q );
+
+  bool sw = false;
+  if( largeBoundary )
+  {
+    const __m128i dp = isChromaHorCTBBoundary ? _mm_abs_epi32( _mm_sub_epi32( p[0], p[1] ) ) : secondDiff<vext>( p[2], p[1], p[0] );
+    const __m128i d  = _mm_add_epi32( dp, secondDiff<vext>( q[0], q[1], q[2] ) );
+    const int     d0 = _mm_extract_epi32( d, 0 );
+    const int     d3 = decisionLine == 1 ? _mm_extract_epi32( d, 1 ) : _mm_extract_epi32( d, 3 );
+
+    if( d0 + d3 < beta )
+    {
+      const __m128i sp  = _mm_abs_epi32( _mm_sub_epi32( isChromaHorCTBBoundary ? p[1] : p[3], p[0] ) );
+      const __m128i spq = _mm_add_epi32( sp, _mm_abs_epi32( _mm_sub_epi32( q[3], q[0] ) ) );
+      const __m128i pq  = _mm_abs_epi32( _mm_sub_epi32( p[0], q[0] ) );
+      const int     spq3 = decisionLine == 1 ? _mm_extract_epi32( spq, 1 ) : _mm_extract_epi32( spq, 3 );
+      const int     pq3  = decisionLine == 1 ? _mm_extract_epi32( pq, 1 ) : _mm_extract_epi32( pq, 3 );
+      const int     tcStrong = ( tc * 5 + 1 ) >> 1;
+
+      sw = _mm_extract_epi32( spq, 0 ) < ( beta >> 3 ) && 2 * d0 < ( beta >> 2 ) && _mm_extract_epi32( pq, 0 ) < tcStrong
+        && spq3 < ( beta >> 3 ) && 2 * d3 < ( beta >> 2 ) && pq3 < tcStrong;
+    }
+  }
+
+  int numModP = 1;
+  int numModQ = 1;
+  if( sw )
+  {
+    const __m128i c     = _mm_set1_epi32( tc );
+    const __m128i four  = _mm_set1_epi32( 4 );
+    const __m128i p0q0  = _mm_add_epi32( p[0], q[0] );
+    // ( p1 + p0 + q0 + 2 * q1 + q2 + 2 * q3 + 4 ) >> 3
+    const __m128i nq1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p[1], p0q0 ), _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( q[1], q[3] ), 1 ), q[2] ) ), four ), 3 );
+    // ( p0 + q0 + q1 + 2 * q2 + 3 * q3 + 4 ) >> 3
+    const __m128i nq2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p0q0, q[1] ), _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( q[2], q[3] ), 1 ), q[3] ) ), four ), 3 );
+    if( isChromaHorCTBBoundary )
+    {
+      // ( 3 * p1 + 2 * p0 + q0 + q1 + q2 + 4 ) >> 3
+      const __m128i np0 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( p[1], 1 ), p[1] ), _mm_slli_epi32( p[0], 1 ) ), _mm_add_epi32( _mm_add_epi32( q[0], q[1] ), q[2] ) ), four ), 3 );
+      // ( 2 * p1 + p0 + 2 * q0 + q1 + q2 + q3 + 4 ) >> 3
+      const __m128i nq0 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( p[1], q[0] ), 1 ), p[0] ), _mm_add_epi32( _mm_add_epi32( q[1], q[2] ), q[3] ) ), four ), 3 );
+      p[0] = clipAround<vext>( np0, p[0], c );
+      q[0] = clipAround<vext>( nq0, q[0], c );
+    }
+    else
+    {
+      // ( 3 * p3 + 2 * p2 + p1 + p0 + q0 + 4 ) >> 3
+      const __m128i np2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( p[3], 1 ), p[3] ), _mm_slli_epi32( p[2], 1 ) ), _mm_add_epi32( p[1], p0q0 ) ), four ), 3 );
+      // ( 2 * p3 + p2 + 2 * p1 + p0 + q0 + q1 + 4 ) >> 3
+      const __m128i np1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( _mm_add_epi32( p[3], p[1] ), 1 ), p[2] ), _mm_add_epi32( p0q0, q[1] ) ), four ), 3 );
+      // ( p3 + p2 + p1 + 2 * p0 + q0 + q1 + q2 + 4 ) >> 3
+      const __m128i np0 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p[3], p[2] ), _mm_add_epi32( p[1], p[0] ) ), _mm_add_epi32( _mm_add_epi32( p0q0, q[1] ), q[2] ) ), four ), 3 );
+      // ( p2 + p1 + p0 + 2 * q0 + q1 + q2 + q3 + 4 ) >> 3
+      const __m128i nq0 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p[2], p[1] ), _mm_add_epi32( p0q0, q[0] ) ), _mm_add_epi32( _mm_add_epi32( q[1], q[2] ), q[3] ) ), four ), 3 );
+      p[2] = clipAround<vext>( np2, p[2], c );
+      p[1] = clipAround<vext>( np1, p[1], c );
+      p[0] = clipAround<vext>( np0, p[0], c );
+      q[0] = clipAround<vext>( nq0, q[0], c );
+      numModP = 3;
+    }
+    q[1] = clipAround<vext>( nq1, q[1], c );
+    q[2] = clipAround<vext>( nq2, q[2], c );
+    numModQ = 3;
+  }
+  else
+  {
+    // ( ( ( q0 - p0 ) << 2 ) + p1 - q1 + 4 ) >> 3
+    __m128i delta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( q[0], p[0] ), 2 ), _mm_sub_epi32( p[1], q[1] ) );
+    delta = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 4 ) ), 3 );
+    delta = _mm_min_epi32( _mm_max_epi32( delta, _mm_set1_epi32( -tc ) ), _mm_set1_epi32( tc ) );
+    p[0] = clipPel<vext>( _mm_add_epi32( p[0], delta ), clpRng );
+    q[0] = clipPel<vext>( _mm_sub_epi32( q[0], delta ), clpRng );
+  }
+
+  storeEdge<vext>( src, stride, verEdge, numLines, partPNoFilter ? 0 : numModP, partQNoFilter ? 0 : numModQ, p, q );
+}
+
+template <X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_deblockLumaSegment   = simdDeblockLumaSegment<vext>;
+  m_deblockChromaSegment = simdDeblockChromaSegment<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
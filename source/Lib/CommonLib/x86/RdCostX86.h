@@ -2440,6 +2440,111 @@ Distortion RdCost::xGetSADwMask_SIMD( const DistParam &rcDtParam )
   return sum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
 
+template< X86_VEXT vext >
+void RdCost::xGetGeoSADAllSplits_SIMD( const DistParam &rcDtParam, const int maskVariant, Distortion* sadPart0 )
+{
+  const int cols = rcDtParam.org.width;
+  if( ( cols & 7 ) != 0 || rcDtParam.bitDepth > 10 || rcDtParam.applyWeight )
+  {
+    RdCost::xGetGeoSADAllSplits( rcDtParam, maskVariant, sadPart0 );
+    return;
+  }
+
+  const int rows       = rcDtParam.org.height;
+  const int wIdx       = floorLog2( cols ) - GEO_MIN_CU_LOG2;
+  const int hIdx       = floorLog2( rows ) - GEO_MIN_CU_LOG2;
+  const int subShift   = rcDtParam.subShift;
+  const int subStep    = 1 << subShift;
+  const int strideOrg  = rcDtParam.org.stride * subStep;
+  const int strideCur  = rcDtParam.cur.stride * subStep;
+  const int numRow     = rows >> subShift;
+  const int numSamples = numRow * cols;
+
+  // absolute differences of the candidate, computed once and shared by all split directions
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, short absDiff[GEO_MAX_CU_SIZE * GEO_MAX_CU_SIZE] );
+  const short* src1 = (const short*) rcDtParam.org.buf;
+  const short* src2 = (const short*) rcDtParam.cur.buf;
+  for( int y = 0; y < numRow; y++ )
+  {
+    for( int x = 0; x < cols; x += 8 )
+    {
+      __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )( &src1[x] ) );
+      __m128i vsrc2 = _mm_loadu_si128( ( const __m128i* )( &src2[x] ) );
+      _mm_store_si128( ( __m128i* )( &absDiff[y * cols + x] ), _mm_abs_epi16( _mm_sub_epi16( vsrc1, vsrc2 ) ) );
+    }
+    src1 += strideOrg;
+    src2 += strideCur;
+  }
+
+  for( int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++ )
+  {
+    const GeoMaskView& maskView   = g_geoMaskView[maskVariant][splitDir][hIdx][wIdx];
+    const short*       weightMask = (const short*) maskView.sadMask;
+    const int          strideMask = maskView.stride * subStep;
+    const bool         mirrorX    = maskView.stepX < 0;
+
+    Distortion sum = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 && ( cols & 15 ) == 0 )
+    {
+      const __m256i shuffleMask = _mm256_set_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+      __m256i vsum32 = _mm256_setzero_si256();
+      for( int pos = 0; pos < numSamples; pos += cols )
+      {
+        for( int x = 0; x < cols; x += 16 )
+        {
+          __m256i vmask;
+          if( mirrorX )
+          {
+            vmask = _mm256_lddqu_si256( ( const __m256i* )( weightMask - x - ( 16 - 1 ) ) );
+            vmask = _mm256_shuffle_epi8( vmask, shuffleMask );
+            vmask = _mm256_permute4x64_epi64( vmask, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+          }
+          else
+          {
+            vmask = _mm256_lddqu_si256( ( const __m256i* )( weightMask + x ) );
+          }
+          vsum32 = _mm256_add_epi32( vsum32, _mm256_madd_epi16( vmask, _mm256_load_si256( ( const __m256i* )( &absDiff[pos + x] ) ) ) );
+        }
+        weightMask += strideMask;
+      }
+      __m128i vsum = _mm_add_epi32( _mm256_castsi256_si128( vsum32 ), _mm256_extracti128_si256( vsum32, 1 ) );
+      vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0x4e ) );   // 01001110
+      vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0xb1 ) );   // 10110001
+      sum  = _mm_cvtsi128_si32( vsum );
+    }
+    else
+#endif
+    {
+      const __m128i shuffleMask = _mm_set_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+      __m128i vsum32 = _mm_setzero_si128();
+      for( int pos = 0; pos < numSamples; pos += cols )
+      {
+        for( int x = 0; x < cols; x += 8 )
+        {
+          __m128i vmask;
+          if( mirrorX )
+          {
+            vmask = _mm_lddqu_si128( ( const __m128i* )( weightMask - x - ( 8 - 1 ) ) );
+            vmask = _mm_shuffle_epi8( vmask, shuffleMask );
+          }
+          else
+          {
+            vmask = _mm_lddqu_si128( ( const __m128i* )( weightMask + x ) );
+          }
+          vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( vmask, _mm_load_si128( ( const __m128i* )( &absDiff[pos + x] ) ) ) );
+        }
+        weightMask += strideMask;
+      }
+      vsum32 = _mm_add_epi32( vsum32, _mm_shuffle_epi32( vsum32, 0x4e ) );   // 01001110
+      vsum32 = _mm_add_epi32( vsum32, _mm_shuffle_epi32( vsum32, 0xb1 ) );   // 10110001
+      sum    = _mm_cvtsi128_si32( vsum32 );
+    }
+    sum <<= subShift;
+    sadPart0[splitDir] = sum >> DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth );
+  }
+}
+
 template<X86_VEXT vext>
 Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 {
@@ -2654,6 +2759,7 @@ void RdCost::_initRdCostX86()
 #endif
 
   m_afpDistortFunc[DF_SAD_WITH_MASK] = xGetSADwMask_SIMD<vext>;
+  m_fpGeoSADAllSplits                = xGetGeoSADAllSplits_SIMD<vext>;
 }
 
 #if INTER_LIC || (TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM)
@@ -0,0 +1,303 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2023, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the SIMD kernels of the SampleAdaptiveOffset class
+ */
+
+#pragma once
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// The offsets are looked up with byte shuffles instead of gathers: the 32 band offsets are split into
+// the low and the high bytes of their 16-bit values, the edge offsets are read as byte pairs of one table.
+
+template<X86_VEXT vext>
+static void simdOffsetBandBlk( const Pel* src, const int srcStride, Pel* res, const int resStride, const int width, const int height, const int* offset, const int shiftBits, const ClpRng& clpRng, const bool clip )
+{
+  // bands 0..15 and 16..31
+  int8_t lowBytes[2][16];
+  int8_t highBytes[2][16];
+  for( int i = 0; i < 32; i++ )
+  {
+    const int16_t val = int16_t( offset[i] );
+    lowBytes [i >> 4][i & 15] = int8_t( val & 0xff );
+    highBytes[i >> 4][i & 15] = int8_t( val >> 8 );
+  }
+
+  const __m128i lowTab0  = _mm_loadu_si128( ( const __m128i* ) lowBytes[0] );
+  const __m128i lowTab1  = _mm_loadu_si128( ( const __m128i* ) lowBytes[1] );
+  const __m128i highTab0 = _mm_loadu_si128( ( const __m128i* ) highBytes[0] );
+  const __m128i highTab1 = _mm_loadu_si128( ( const __m128i* ) highBytes[1] );
+  const __m128i vmin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax     = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++, src += srcStride, res += resStride )
+  {
+    int x = 0;
+#if USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i lowTab0x2  = _mm256_broadcastsi128_si256( lowTab0 );
+      const __m256i lowTab1x2  = _mm256_broadcastsi128_si256( lowTab1 );
+      const __m256i highTab0x2 = _mm256_broadcastsi128_si256( highTab0 );
+      const __m256i highTab1x2 = _mm256_broadcastsi128_si256( highTab1 );
+      const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+      const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+
+      for( ; x + 32 <= width; x += 32 )
+      {
+        const __m256i s0   = _mm256_loadu_si256( ( const __m256i* ) ( src + x ) );
+        const __m256i s1   = _mm256_loadu_si256( ( const __m256i* ) ( src + x + 16 ) );
+        // the packing interleaves the 128-bit lanes, the unpacking below restores the order
+        const __m256i band = _mm256_packus_epi16( _mm256_srli_epi16( s0, shiftBits ), _mm256_srli_epi16( s1, shiftBits ) );
+        const __m256i sel  = _mm256_slli_epi16( band, 3 );
+        const __m256i lo   = _mm256_blendv_epi8( _mm256_shuffle_epi8( lowTab0x2, band ), _mm256_shuffle_epi8( lowTab1x2, band ), sel );
+        const __m256i hi   = _mm256_blendv_epi8( _mm256_shuffle_epi8( highTab0x2, band ), _mm256_shuffle_epi8( highTab1x2, band ), sel );
+        __m256i r0 = _mm256_add_epi16( s0, _mm256_unpacklo_epi8( lo, hi ) );
+        __m256i r1 = _mm256_add_epi16( s1, _mm256_unpackhi_epi8( lo, hi ) );
+        if( clip )
+        {
+          r0 = _mm256_min_epi16( _mm256_max_epi16( r0, vmin256 ), vmax256 );
+          r1 = _mm256_min_epi16( _mm256_max_epi16( r1, vmin256 ), vmax256 );
+        }
+        _mm256_storeu_si256( ( __m256i* ) ( res + x ), r0 );
+        _mm256_storeu_si256( ( __m256i* ) ( res + x + 16 ), r1 );
+      }
+    }
+#endif
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m128i s0   = _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+      const __m128i s1   = _mm_loadu_si128( ( const __m128i* ) ( src + x + 8 ) );
+      const __m128i band = _mm_packus_epi16( _mm_srli_epi16( s0, shiftBits ), _mm_srli_epi16( s1, shiftBits ) );
+      // bit 4 of the band selects the table, the shuffles only use the bits 0..3
+      const __m128i sel  = _mm_slli_epi16( band, 3 );
+      const __m128i lo   = _mm_blendv_epi8( _mm_shuffle_epi8( lowTab0, band ), _mm_shuffle_epi8( lowTab1, band ), sel );
+      const __m128i hi   = _mm_blendv_epi8( _mm_shuffle_epi8( highTab0, band ), _mm_shuffle_epi8( highTab1, band ), sel );
+      __m128i r0 = _mm_add_epi16( s0, _mm_unpacklo_epi8( lo, hi ) );
+      __m128i r1 = _mm_add_epi16( s1, _mm_unpackhi_epi8( lo, hi ) );
+      if( clip )
+      {
+        r0 = _mm_min_epi16( _mm_max_epi16( r0, vmin ), vmax );
+        r1 = _mm_min_epi16( _mm_max_epi16( r1, vmin ), vmax );
+      }
+      _mm_storeu_si128( ( __m128i* ) ( res + x ), r0 );
+      _mm_storeu_si128( ( __m128i* ) ( res + x + 8 ), r1 );
+    }
+    for( ; x < width; x++ )
+    {
+      const int val = src[x] + offset[src[x] >> shiftBits];
+      res[x] = clip ? ClipPel<int>( val, clpRng ) : val;
+    }
+  }
+}
+
+// sgn( c - a ) + sgn( c - b ) + 2 of 16-bit samples
+template<X86_VEXT vext>
+static inline __m128i edgeIdx( const __m128i c, const __m128i a, const __m128i b )
+{
+  const __m128i signA = _mm_sub_epi16( _mm_cmpgt_epi16( a, c ), _mm_cmpgt_epi16( c, a ) );
+  const __m128i signB = _mm_sub_epi16( _mm_cmpgt_epi16( b, c ), _mm_cmpgt_epi16( c, b ) );
+  return _mm_add_epi16( _mm_add_epi16( signA, signB ), _mm_set1_epi16( 2 ) );
+}
+
+template<X86_VEXT vext>
+static void simdOffsetEdgeLine( const Pel* src, Pel* res, const int width, const ptrdiff_t posA, const ptrdiff_t posB, const int* offset, const ClpRng& clpRng, const bool clip )
+{
+  // the offset of the edge index i is the 16-bit value at the bytes 2 * i and 2 * i + 1
+  const __m128i offTab   = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i pairMul  = _mm_set1_epi16( 0x0202 );
+  const __m128i pairAdd  = _mm_set1_epi16( 0x0100 );
+  const __m128i vmin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax     = _mm_set1_epi16( clpRng.max );
+
+  int x = 0;
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i offTabx2   = _mm256_broadcastsi128_si256( offTab );
+    const __m256i pairMul256 = _mm256_set1_epi16( 0x0202 );
+    const __m256i pairAdd256 = _mm256_set1_epi16( 0x0100 );
+    const __m256i two        = _mm256_set1_epi16( 2 );
+    const __m256i vmin256    = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax256    = _mm256_set1_epi16( clpRng.max );
+
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i c     = _mm256_loadu_si256( ( const __m256i* ) ( src + x ) );
+      const __m256i a     = _mm256_loadu_si256( ( const __m256i* ) ( src + x + posA ) );
+      const __m256i b     = _mm256_loadu_si256( ( const __m256i* ) ( src + x + posB ) );
+      const __m256i signA = _mm256_sub_epi16( _mm256_cmpgt_epi16( a, c ), _mm256_cmpgt_epi16( c, a ) );
+      const __m256i signB = _mm256_sub_epi16( _mm256_cmpgt_epi16( b, c ), _mm256_cmpgt_epi16( c, b ) );
+      const __m256i idx   = _mm256_add_epi16( _mm256_add_epi16( signA, signB ), two );
+      const __m256i off   = _mm256_shuffle_epi8( offTabx2, _mm256_add_epi16( _mm256_mullo_epi16( idx, pairMul256 ), pairAdd256 ) );
+      __m256i       r     = _mm256_add_epi16( c, off );
+      if( clip )
+      {
+        r = _mm256_min_epi16( _mm256_max_epi16( r, vmin256 ), vmax256 );
+      }
+      _mm256_storeu_si256( ( __m256i* ) ( res + x ), r );
+    }
+  }
+#endif
+  for( ; x + 8 <= width; x += 8 )
+  {
+    const __m128i c   = _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+    const __m128i a   = _mm_loadu_si128( ( const __m128i* ) ( src + x + posA ) );
+    const __m128i b   = _mm_loadu_si128( ( const __m128i* ) ( src + x + posB ) );
+    const __m128i idx = edgeIdx<vext>( c, a, b );
+    const __m128i off = _mm_shuffle_epi8( offTab, _mm_add_epi16( _mm_mullo_epi16( idx, pairMul ), pairAdd ) );
+    __m128i       r   = _mm_add_epi16( c, off );
+    if( clip )
+    {
+      r = _mm_min_epi16( _mm_max_epi16( r, vmin ), vmax );
+    }
+    _mm_storeu_si128( ( __m128i* ) ( res + x ), r );
+  }
+  for( ; x < width; x++ )
+  {
+    const int val = src[x] + offset[sgn( src[x] - src[x + posA] ) + sgn( src[x] - src[x + posB] ) + 2];
+    res[x] = clip ? ClipPel<int>( val, clpRng ) : val;
+  }
+}
+
+#if JVET_W0066_CCSAO
+template<X86_VEXT vext>
+static void simdOffsetCcSaoBandBlk( const Pel* srcY, const Pel* srcU, const Pel* srcV, Pel* dst, const int srcStrideY, const int srcStrideU, const int srcStrideV, const int dstStride,
+                                    const int startX, const int endX, const int height, const int lumaScaleX, const int lumaScaleY, const int chromaScaleX, const int chromaScaleY,
+                                    const int bandNumY, const int bandNumU, const int bandNumV, const short* offset, const int bitDepth )
+{
+  const __m128i numY     = _mm_set1_epi16( bandNumY );
+  const __m128i numU     = _mm_set1_epi16( bandNumU );
+  const __m128i numV     = _mm_set1_epi16( bandNumV );
+  const __m128i mulY     = _mm_set1_epi16( bandNumU * bandNumV );
+  const __m128i evenMask = _mm_set1_epi32( 0xffff );
+  // the classification of 8 samples is vectorized, the class offsets are looked up per sample
+  int16_t classIdx[8];
+  int16_t classOff[8];
+
+  auto classify = [&]( const Pel* rowY, const Pel* rowU, const Pel* rowV, const int x )
+  {
+    const int bandY = ( rowY[x << lumaScaleX] * bandNumY ) >> bitDepth;
+    const int bandU = ( rowU[x >> chromaScaleX] * bandNumU ) >> bitDepth;
+    const int bandV = ( rowV[x >> chromaScaleX] * bandNumV ) >> bitDepth;
+    return bandY * bandNumU * bandNumV + bandU * bandNumV + bandV;
+  };
+
+  for( int y = 0; y < height; y++, dst += dstStride )
+  {
+    const Pel* rowY = srcY + ( y << lumaScaleY ) * srcStrideY;
+    const Pel* rowU = srcU + ( y >> chromaScaleY ) * srcStrideU;
+    const Pel* rowV = srcV + ( y >> chromaScaleY ) * srcStrideV;
+
+    int x = startX;
+    if( chromaScaleX && ( x & 1 ) )
+    {
+      // the vectors start at a shared chroma sample
+      dst[x] += offset[classify( rowY, rowU, rowV, x )];
+      x++;
+    }
+    // the subsampled luma vectors read up to 2 * x + 15, keep it inside the row
+    for( ; x + 8 + lumaScaleX <= endX; x += 8 )
+    {
+      __m128i valY, valU, valV;
+      if( lumaScaleX )
+      {
+        const __m128i y0 = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) ( rowY + 2 * x ) ), evenMask );
+        const __m128i y1 = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) ( rowY + 2 * x + 8 ) ), evenMask );
+        valY = _mm_packus_epi32( y0, y1 );
+      }
+      else
+      {
+        valY = _mm_loadu_si128( ( const __m128i* ) ( rowY + x ) );
+      }
+      if( chromaScaleX )
+      {
+        valU = _mm_loadl_epi64( ( const __m128i* ) ( rowU + ( x >> 1 ) ) );
+        valV = _mm_loadl_epi64( ( const __m128i* ) ( rowV + ( x >> 1 ) ) );
+        valU = _mm_unpacklo_epi16( valU, valU );
+        valV = _mm_unpacklo_epi16( valV, valV );
+      }
+      else
+      {
+        valU = _mm_loadu_si128( ( const __m128i* ) ( rowU + x ) );
+        valV = _mm_loadu_si128( ( const __m128i* ) ( rowV + x ) );
+      }
+      // the products fit into 16 bits, the caller limits the bit depth
+      const __m128i bandY = _mm_srli_epi16( _mm_mullo_epi16( valY, numY ), bitDepth );
+      const __m128i bandU = _mm_srli_epi16( _mm_mullo_epi16( valU, numU ), bitDepth );
+      const __m128i bandV = _mm_srli_epi16( _mm_mullo_epi16( valV, numV ), bitDepth );
+      const __m128i cls   = _mm_add_epi16( _mm_add_epi16( _mm_mullo_epi16( bandY, mulY ), _mm_mullo_epi16( bandU, numV ) ), bandV );
+      _mm_storeu_si128( ( __m128i* ) classIdx, cls );
+      for( int i = 0; i < 8; i++ )
+      {
+        classOff[i] = offset[classIdx[i]];
+      }
+      _mm_storeu_si128( ( __m128i* ) ( dst + x ), _mm_add_epi16( _mm_loadu_si128( ( const __m128i* ) ( dst + x ) ), _mm_loadu_si128( ( const __m128i* ) classOff ) ) );
+    }
+    for( ; x < endX; x++ )
+    {
+      dst[x] += offset[classify( rowY, rowU, rowV, x )];
+    }
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetBandBlk  = simdOffsetBandBlk<vext>;
+  m_offsetEdgeLine = simdOffsetEdgeLine<vext>;
+#if JVET_W0066_CCSAO
+  m_offsetCcSaoBandBlk = simdOffsetCcSaoBandBlk<vext>;
+#endif
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -635,6 +635,68 @@ void TrQuant::computeInvNspt( int* src, int* dst, const uint32_t mode, const uin
   }
 }
 #endif
+#if SIGN_PREDICTION
+template< X86_VEXT vext >
+void signPredCosts_SIMD( const Pel* predResiBorder, Pel* resiTemplate, const Pel* signTemplates, const int stride, const int first, const int last, const int numPredSigns, uint32_t* costs )
+{
+  // first and last are multiples of 4, the absolute difference of two 16-bit samples is exact as unsigned max - min
+  const __m128i vzero = _mm_setzero_si128();
+
+  for( uint32_t idx = 0; idx < ( 1u << numPredSigns ); idx++ )
+  {
+    const uint32_t signXor  = idx & ~( idx - 1 );
+    const uint32_t curSigns = idx ^ ( idx >> 1 );
+    // the hypothesis without sign changes only measures the border cost
+    const int16_t  scale    = idx == 0 ? 0 : ( curSigns & signXor ) != 0 ? -2 : 2;
+    const Pel*     templ    = idx == 0 ? signTemplates : signTemplates + ( numPredSigns - 1 - floorLog2( signXor ) ) * stride;
+
+    __m128i vcost = vzero;
+    int     i     = first;
+#if USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vscale = _mm256_set1_epi16( scale );
+      __m256i       vsum   = _mm256_setzero_si256();
+      for( ; i + 16 <= last; i += 16 )
+      {
+        __m256i vresi = _mm256_loadu_si256( ( const __m256i* ) &resiTemplate[i] );
+        vresi         = _mm256_add_epi16( vresi, _mm256_mullo_epi16( _mm256_loadu_si256( ( const __m256i* ) &templ[i] ), vscale ) );
+        _mm256_storeu_si256( ( __m256i* ) &resiTemplate[i], vresi );
+        __m256i vbord = _mm256_loadu_si256( ( const __m256i* ) &predResiBorder[i] );
+        __m256i vdiff = _mm256_sub_epi16( _mm256_max_epi16( vbord, vresi ), _mm256_min_epi16( vbord, vresi ) );
+        vsum          = _mm256_add_epi32( vsum, _mm256_unpacklo_epi16( vdiff, _mm256_setzero_si256() ) );
+        vsum          = _mm256_add_epi32( vsum, _mm256_unpackhi_epi16( vdiff, _mm256_setzero_si256() ) );
+      }
+      vcost = _mm_add_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+    }
+#endif
+    const __m128i vscale = _mm_set1_epi16( scale );
+    for( ; i + 8 <= last; i += 8 )
+    {
+      __m128i vresi = _mm_loadu_si128( ( const __m128i* ) &resiTemplate[i] );
+      vresi         = _mm_add_epi16( vresi, _mm_mullo_epi16( _mm_loadu_si128( ( const __m128i* ) &templ[i] ), vscale ) );
+      _mm_storeu_si128( ( __m128i* ) &resiTemplate[i], vresi );
+      __m128i vbord = _mm_loadu_si128( ( const __m128i* ) &predResiBorder[i] );
+      __m128i vdiff = _mm_sub_epi16( _mm_max_epi16( vbord, vresi ), _mm_min_epi16( vbord, vresi ) );
+      vcost         = _mm_add_epi32( vcost, _mm_unpacklo_epi16( vdiff, vzero ) );
+      vcost         = _mm_add_epi32( vcost, _mm_unpackhi_epi16( vdiff, vzero ) );
+    }
+    if( i < last )
+    {
+      __m128i vresi = _mm_loadl_epi64( ( const __m128i* ) &resiTemplate[i] );
+      vresi         = _mm_add_epi16( vresi, _mm_mullo_epi16( _mm_loadl_epi64( ( const __m128i* ) &templ[i] ), vscale ) );
+      _mm_storel_epi64( ( __m128i* ) &resiTemplate[i], vresi );
+      __m128i vbord = _mm_loadl_epi64( ( const __m128i* ) &predResiBorder[i] );
+      __m128i vdiff = _mm_sub_epi16( _mm_max_epi16( vbord, vresi ), _mm_min_epi16( vbord, vresi ) );
+      vcost         = _mm_add_epi32( vcost, _mm_unpacklo_epi16( vdiff, vzero ) );
+    }
+    vcost = _mm_add_epi32( vcost, _mm_shuffle_epi32( vcost, 0x4e ) );
+    vcost = _mm_add_epi32( vcost, _mm_shuffle_epi32( vcost, 0xb1 ) );
+
+    costs[curSigns] = ( ( uint32_t ) _mm_cvtsi128_si32( vcost ) << SIGN_PRED_MAX_NUM ) | curSigns;
+  }
+}
+#endif
 #if TRANSFORM_SIMD_OPT
 template <X86_VEXT vext>
 void TrQuant::_initTrQuantX86()
@@ -647,6 +709,9 @@ void TrQuant::_initTrQuantX86()
   m_computeFwdNspt = computeFwdNspt_SIMD<vext>;
   m_computeInvNspt = computeInvNspt_SIMD<vext>;
 #endif
+#if SIGN_PREDICTION
+  m_signPredCosts = signPredCosts_SIMD<vext>;
+#endif
 #if TRANSFORM_SIMD_OPT
 #if TU_256
   m_forwardTransformKernels =
@@ -981,7 +981,7 @@ void CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
   }
   if (CU::isPLT(cu))
   {
-    cs.reorderPrevPLT(cs.prevPLT, cu.curPLTSize, cu.curPLT, cu.reuseflag, compBegin, numComp, jointPLT);
+    cs.reorderPrevPLT(cs.getPrevPLT(), cu.curPLTSize, cu.curPLT, cu.reuseflag, compBegin, numComp, jointPLT);
   }
 #if !INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
   if( cu.chType == CHANNEL_TYPE_CHROMA )
@@ -3180,9 +3180,9 @@ void CABACReader::cu_palette_info(CodingUnit& cu, ComponentID compBegin, uint32_
   int curPLTidx = 0;
 #if !INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
   if( cu.isLocalSepTree() )
-    cu.cs->prevPLT.curPLTSize[compBegin] = cu.cs->prevPLT.curPLTSize[COMPONENT_Y];
+    cu.cs->getPrevPLT().curPLTSize[compBegin] = cu.cs->getPrevPLT().curPLTSize[COMPONENT_Y];
 #endif
-  cu.lastPLTSize[compBegin] = cu.cs->prevPLT.curPLTSize[compBegin];
+  cu.lastPLTSize[compBegin] = cu.cs->getPrevPLT().curPLTSize[compBegin];
 #if INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
   int maxPltSize = CS::isDualITree(*cu.cs) ? MAXPLTSIZE_DUALTREE : MAXPLTSIZE;
 #else
@@ -3202,7 +3202,7 @@ void CABACReader::cu_palette_info(CodingUnit& cu, ComponentID compBegin, uint32_
       {
         for( int comp = COMPONENT_Y; comp < MAX_NUM_COMPONENT; comp++ )
         {
-          cu.curPLT[comp][curPLTidx] = cu.cs->prevPLT.curPLT[comp][idx];
+          cu.curPLT[comp][curPLTidx] = cu.cs->getPrevPLT().curPLT[comp][idx];
         }
       }
       else
@@ -3210,7 +3210,7 @@ void CABACReader::cu_palette_info(CodingUnit& cu, ComponentID compBegin, uint32_
 #endif
         for (int comp = compBegin; comp < (compBegin + numComp); comp++)
         {
-          cu.curPLT[comp][curPLTidx] = cu.cs->prevPLT.curPLT[comp][idx];
+          cu.curPLT[comp][curPLTidx] = cu.cs->getPrevPLT().curPLT[comp][idx];
         }
 #if !INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
       }
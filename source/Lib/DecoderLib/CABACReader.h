@@ -480,6 +480,18 @@ public:
 #endif
 
   CABACReader*                getCABACReader    ( int           id    )       { return m_CABACReader[id]; }
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING && JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+  // readers use the context state store of another decoder, the own store is only released
+  void                        shareCABACDataStore( CABACDecoder& other )
+  {
+    m_CABACReaderStd.m_CABACDataStore = other.m_CABACDataStore;
+
+    for( int i = 0; i < BPM_NUM - 1; i++ )
+    {
+      m_CABACReader[i]->m_CABACDataStore = other.m_CABACDataStore;
+    }
+  }
+#endif
 
 private:
   BinDecoder_Std          m_BinDecoderStd;
@@ -62,6 +62,7 @@
 DecCu::DecCu()
 {
   m_tmpStorageLCU = NULL;
+  m_stageTimes    = nullptr;
 }
 
 DecCu::~DecCu()
@@ -260,6 +261,13 @@ void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
         }
       }
 #endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+      if( currCU.predMode == MODE_INTER && !xReadsReferencesInMcOnly( currCU ) )
+      {
+        xWaitForReferences( *currCU.slice );
+      }
+#endif
+      StageTimer cuTimer( m_stageTimes, currCU.predMode == MODE_INTRA || currCU.predMode == MODE_PLT ? STAGE_INTRA : STAGE_INTER );
       if (currCU.predMode != MODE_INTRA && currCU.predMode != MODE_PLT && currCU.Y().valid())
       {
         xDeriveCUMV(currCU);
@@ -2602,6 +2610,103 @@ void DecCu::xDecodeInterTexture(CodingUnit &cu)
 #endif
 }
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+// The motion compensation fetch (InterPrediction::xPredInterBlk) waits for the reference rows it reaches: the MV, the
+// block height and the interpolation, BDOF and DMVR/TM margins below the block. The merge list reordering (ARMC),
+// bilateral and template matching, the MVD sign prediction, the reference reordering and LIC however evaluate
+// templates at the positions of all the candidates, whose motion vectors come from spatial, non-adjacent, temporal and
+// history based neighbours and are only bounded by the MV range. A CU that may use one of them waits for the whole
+// reference pictures before its motion is derived.
+bool DecCu::xReadsReferencesInMcOnly( const CodingUnit& cu ) const
+{
+  const SPS& sps = *cu.cs->sps;
+#if JVET_W0090_ARMC_TM || JVET_Y0058_IBC_LIST_MODIFY || JVET_Z0075_IBC_HMVP_ENLARGE
+  if( sps.getUseAML() )
+  {
+    return false;
+  }
+#endif
+#if TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM || MULTI_PASS_DMVR
+  if( sps.getUseDMVDMode() )
+  {
+    return false;
+  }
+#endif
+#if JVET_AA0132_CONFIGURABLE_TM_TOOLS && TM_AMVP
+  if( sps.getUseTMAmvpMode() )
+  {
+    return false;
+  }
+#endif
+#if JVET_AA0132_CONFIGURABLE_TM_TOOLS && JVET_Z0061_TM_OBMC && ENABLE_OBMC
+  if( sps.getUseOBMCTMMode() )
+  {
+    return false;
+  }
+#endif
+#if JVET_Y0067_ENHANCED_MMVD_MVD_SIGN_PRED || JVET_AD0140_MVD_PREDICTION
+  if( sps.getUseMvdPred() )
+  {
+    return false;
+  }
+#endif
+#if JVET_Z0054_BLK_REF_PIC_REORDER
+  if( sps.getUseARL() )
+  {
+    return false;
+  }
+#endif
+#if INTER_LIC
+  if( sps.getLicEnabledFlag() )
+  {
+    return false;
+  }
+#endif
+
+  if( cu.affine || cu.geoFlag )
+  {
+    return false;
+  }
+  for( const auto& pu: CU::traversePUs( cu ) )
+  {
+    if( pu.mergeFlag )
+    {
+      return false;
+    }
+#if JVET_X0083_BM_AMVP_MERGE_MODE
+    if( pu.amvpMergeModeFlag[REF_PIC_LIST_0] || pu.amvpMergeModeFlag[REF_PIC_LIST_1] )
+    {
+      return false;
+    }
+#endif
+#if JVET_AG0098_AMVP_WITH_SBTMVP
+    if( pu.amvpSbTmvpFlag )
+    {
+      return false;
+    }
+#endif
+#if MULTI_HYP_PRED
+    if( !pu.addHypData.empty() )
+    {
+      return false;
+    }
+#endif
+  }
+  return true;
+}
+
+void DecCu::xWaitForReferences( const Slice& slice )
+{
+  for( int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( RefPicList( list ) ); refIdx++ )
+    {
+      slice.getRefPic( RefPicList( list ), refIdx )->waitUntilFinished();
+    }
+  }
+}
+#endif
+
 void DecCu::xDeriveCUMV(CodingUnit &cu)
 {
   for (auto &pu : CU::traversePUs(cu))
@@ -4891,7 +4996,7 @@ void DecCu::xDeriveCUMV(CodingUnit &cu)
 #endif
             pu.bvdSuffixInfo.initPrefixes(mvd, pu.cu->imv, true);
 #if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
-            static std::vector<Mv> cMvdDerivedVec;
+            static thread_local std::vector<Mv> cMvdDerivedVec;
             cMvdDerivedVec.resize(0);
 #else
             std::vector<Mv> cMvdDerivedVec;
@@ -68,6 +68,7 @@ public:
 
   /// destroy internal buffers
   void  decompressCtu     ( CodingStructure& cs, const UnitArea& ctuArea );
+  void  setStageTimes     ( StageTimes* stageTimes ) { m_stageTimes = stageTimes; }
   Reshape*          m_pcReshape;
   Reshape* getReshape     () { return m_pcReshape; }
   void initDecCuReshaper  ( Reshape* pcReshape, ChromaFormat chromaFormatIDC) ;
@@ -90,12 +91,17 @@ protected:
   void xDecodeInterTU     ( TransformUnit&   tu, const ComponentID compID );
 
   void xDeriveCUMV        ( CodingUnit&      cu );
+#if ENABLE_FRAME_PARALLEL_DECODING
+  bool xReadsReferencesInMcOnly( const CodingUnit& cu ) const;
+  void xWaitForReferences ( const Slice&     slice );
+#endif
   void xReconPLT          ( CodingUnit&      cu,       ComponentID compBegin, uint32_t numComp );
   PelStorage        *m_tmpStorageLCU;
 private:
   TrQuant*          m_pcTrQuant;
   IntraPrediction*  m_pcIntraPred;
   InterPrediction*  m_pcInterPred;
+  StageTimes*       m_stageTimes;
 
   PelStorage        m_ciipBuffer;
 
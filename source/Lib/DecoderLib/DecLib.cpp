@@ -553,6 +553,17 @@ DecLib::DecLib()
 #endif
   , m_decodedPictureHashSEIEnabled(false)
   , m_numberOfChecksumErrorsDetected(0)
+  , m_stageTimesEnabled(false)
+  , m_printStageTimes(false)
+#if ENABLE_FRAME_PARALLEL_DECODING
+  , m_numFrameThreads( 1 )
+  , m_finishInWorker( false )
+  , m_filteredSlice( nullptr )
+  , m_adaptiveClipPending( false )
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  , m_numLoopFilterThreads( 1 )
+#endif
   , m_warningMessageSkipPicture(false)
   , m_prefixSEINALUs()
   , m_debugPOC( -1 )
@@ -586,10 +597,19 @@ DecLib::DecLib()
     memset(m_prevIRAPSubpicDecOrderNo[i], 0, sizeof(int)*MAX_NUM_SUB_PICS);
     std::fill_n(m_prevIRAPSubpicType[i], MAX_NUM_SUB_PICS, NAL_UNIT_INVALID);
   }
+#if ENABLE_FRAME_PARALLEL_DECODING
+  m_finishing.pic = nullptr;
+#endif
 }
 
 DecLib::~DecLib()
 {
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( m_finishing.thread.joinable() )
+  {
+    m_finishing.thread.join();
+  }
+#endif
   while (!m_prefixSEINALUs.empty())
   {
     delete m_prefixSEINALUs.front();
@@ -614,6 +634,9 @@ void DecLib::create()
 
 void DecLib::destroy()
 {
+#if ENABLE_FRAME_PARALLEL_DECODING
+  waitForPictureFinishing();
+#endif
   delete m_apcSlicePilot;
   m_apcSlicePilot = NULL;
 
@@ -644,8 +667,68 @@ void DecLib::init(
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "final", 1 ) );
 }
 
+void DecLib::setStageTimesOutput( bool printStageTimes, const std::string& stageTimesFileName )
+{
+  m_printStageTimes = printStageTimes;
+
+  if( !stageTimesFileName.empty() )
+  {
+    m_stageTimesFile.open( stageTimesFileName.c_str(), std::ios::out );
+    CHECK( !m_stageTimesFile.is_open(), "Cannot open stage times file " << stageTimesFileName );
+
+    m_stageTimesFile << "POC,LayerId,TId,SliceType";
+    for( int stage = 0; stage < NUM_PROCESSING_STAGES; stage++ )
+    {
+      m_stageTimesFile << "," << StageTimes::getStageName( ProcessingStage( stage ) );
+    }
+    m_stageTimesFile << "\n";
+  }
+
+  m_stageTimesEnabled = m_printStageTimes || m_stageTimesFile.is_open();
+  m_stageTimes.reset();
+
+  m_cSliceDecoder.setStageTimes( xGetStageTimes() );
+  m_cCuDecoder.setStageTimes( xGetStageTimes() );
+  m_cInterPred.setStageTimes( xGetStageTimes() );
+}
+
+void DecLib::xReportStageTimes( const Slice* slice, StageTimes& stageTimes, MsgLevel msgl )
+{
+  if( m_printStageTimes )
+  {
+    msg( msgl, "[ST parse %.3f intra %.3f inter %.3f (", stageTimes.getSeconds( STAGE_PARSE ), stageTimes.getSeconds( STAGE_INTRA ), stageTimes.getSeconds( STAGE_INTER ) );
+    for( int stage = STAGE_INTER_DMVR; stage <= STAGE_INTER_AFFINE; stage++ )
+    {
+      msg( msgl, stage == STAGE_INTER_DMVR ? "%s %.3f" : " %s %.3f", StageTimes::getStageName( ProcessingStage( stage ) ), stageTimes.getSeconds( ProcessingStage( stage ) ) );
+    }
+    msg( msgl, ")" );
+    for( int stage = STAGE_LMCS; stage < NUM_PROCESSING_STAGES; stage++ )
+    {
+      msg( msgl, " %s %.3f", StageTimes::getStageName( ProcessingStage( stage ) ), stageTimes.getSeconds( ProcessingStage( stage ) ) );
+    }
+    msg( msgl, "] " );
+  }
+
+  if( m_stageTimesFile.is_open() )
+  {
+    m_stageTimesFile << slice->getPOC() << "," << slice->getPic()->layerId << "," << slice->getTLayer() << ","
+                     << ( slice->isIntra() ? 'I' : slice->isInterP() ? 'P' : 'B' );
+    for( int stage = 0; stage < NUM_PROCESSING_STAGES; stage++ )
+    {
+      m_stageTimesFile << "," << stageTimes.getSeconds( ProcessingStage( stage ) );
+    }
+    m_stageTimesFile << "\n";
+  }
+
+  stageTimes.reset();
+}
+
 void DecLib::deletePicBuffer ( )
 {
+#if ENABLE_FRAME_PARALLEL_DECODING
+  waitForPictureFinishing();
+#endif
+
   PicList::iterator  iterPic   = m_cListPic.begin();
   int iSize = int( m_cListPic.size() );
 
@@ -711,6 +794,13 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
     }
   }
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( bBufferIsAvailable && pcPic == m_finishing.pic )
+  {
+    waitForPictureFinishing();
+  }
+#endif
+
   if( ! bBufferIsAvailable )
   {
     //There is no room for this picture, either because of faulty encoder or dropped NAL. Extend the buffer.
@@ -774,12 +864,74 @@ void DecLib::executeLoopFilters()
   m_pcPic->setCleanDirty(false);
 #endif
 
-  m_pcPic->cs->slice->startProcessingTimer();
-
   CodingStructure& cs = *m_pcPic->cs;
 
   if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
   {
+    m_cReshaper.setRecReshaped(false);
+    m_cSAO.setReshaper(&m_cReshaper);
+  }
+#if !MULTI_PASS_DMVR
+  CS::setRefinedMotionField(cs);
+#endif
+
+#if JVET_AE0043_CCP_MERGE_TEMPORAL
+  if ((cs.picture->temporalId == 0) || (cs.picture->temporalId < cs.slice->getSPS()->getMaxTLayers() - 1))
+  {
+    CS::saveTemporalCcpModel(cs);
+  }
+#endif
+#if JVET_AG0058_EIP
+  if ((cs.picture->temporalId == 0) || (cs.picture->temporalId < cs.slice->getSPS()->getMaxTLayers() - 1))
+  {
+    CS::saveTemporalEipModel(cs);
+  }
+#endif
+
+#if ENABLE_FRAME_PARALLEL_DECODING
+  m_finishInWorker = m_numFrameThreads > 1 && !cs.sps->getGDREnabledFlag();
+  if( m_finishInWorker )
+  {
+    // the filters run in the worker thread, only the state they leave for the next picture is derived here:
+    // the deblocking ends with the slice of the last CTU, the ALF with the last slice that has ALF enabled
+    const PreCalcValues& pcv = *cs.pcv;
+    const Position lastCtuPos( ( pcv.widthInCtus - 1 ) << pcv.maxCUWidthLog2, ( pcv.heightInCtus - 1 ) << pcv.maxCUHeightLog2 );
+    Slice* lastCtuSlice = cs.getCU( lastCtuPos, CHANNEL_TYPE_LUMA )->slice;
+
+    m_filteredSlice = lastCtuSlice;
+#if JVET_W0066_CCSAO
+    if( cs.sps->getCCSAOEnabledFlag() )
+    {
+      m_cSAO.getCcSaoComParam() = lastCtuSlice->m_ccSaoComParam;
+    }
+#endif
+    if( cs.sps->getALFEnabledFlag() )
+    {
+      for( int ctuRsAddr = 0; ctuRsAddr < pcv.sizeInCtus; ctuRsAddr++ )
+      {
+        const Position ctuPos( ( ctuRsAddr % pcv.widthInCtus ) << pcv.maxCUWidthLog2, ( ctuRsAddr / pcv.widthInCtus ) << pcv.maxCUHeightLog2 );
+        Slice* slice = cs.getCU( ctuPos, CHANNEL_TYPE_LUMA )->slice;
+        if( slice->getTileGroupAlfEnabledFlag( COMPONENT_Y ) || slice->getTileGroupAlfEnabledFlag( COMPONENT_Cb ) || slice->getTileGroupAlfEnabledFlag( COMPONENT_Cr ) )
+        {
+          m_filteredSlice = slice;
+        }
+      }
+      m_cALF.getCcAlfFilterParam() = m_filteredSlice->m_ccAlfFilterParam;
+    }
+    return;
+  }
+#endif
+
+  xFilterPicture( cs, m_cLoopFilter, m_cSAO, m_cALF, m_cReshaper.getInvLUT(), xGetStageTimes() );
+}
+
+void DecLib::xFilterPicture( CodingStructure& cs, LoopFilter& loopFilter, SampleAdaptiveOffset& sao, AdaptiveLoopFilter& alf, std::vector<Pel>& invLUT, StageTimes* stageTimes )
+{
+  cs.slice->startProcessingTimer();
+
+  if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
+  {
+      StageTimer lmcsTimer( stageTimes, STAGE_LMCS );
       const PreCalcValues& pcv = *cs.pcv;
       for (uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
       {
@@ -791,24 +943,24 @@ void DecLib::executeLoopFilters()
             const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
             const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
             const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
-            cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
+            cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(invLUT);
           }
         }
       }
-      m_cReshaper.setRecReshaped(false);
-      m_cSAO.setReshaper(&m_cReshaper);
   }
 
 #if JVET_AA0095_ALF_WITH_SAMPLES_BEFORE_DBF
   if (cs.sps->getALFEnabledFlag())
   {
-    m_cALF.copyDbData(cs);
+    StageTimer alfTimer( stageTimes, STAGE_ALF );
+    alf.copyDbData(cs);
   }
 #endif
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
   if (cs.sps->getALFEnabledFlag())
   {
-    m_cALF.copyResiData(cs);
+    StageTimer alfTimer( stageTimes, STAGE_ALF );
+    alf.copyResiData(cs);
   }
 #endif
 
@@ -830,36 +982,24 @@ void DecLib::executeLoopFilters()
 #if JVET_AB0171_ASYMMETRIC_DB_FOR_GDR
   if (pcPPS->getAsymmetricILF() && (cs.picHeader->getInGdrInterval() || cs.picHeader->getIsGdrRecoveryPocPic()))
   {
-    m_cLoopFilter.setAsymmetricDB(true);
+    loopFilter.setAsymmetricDB(true);
   }
   else
   {
-    m_cLoopFilter.setAsymmetricDB(false);
-  }  
+    loopFilter.setAsymmetricDB(false);
+  }
 #endif
 
 
-  m_cLoopFilter.loopFilterPic( cs );
-#if !MULTI_PASS_DMVR
-  CS::setRefinedMotionField(cs);
-#endif
-
-#if JVET_AE0043_CCP_MERGE_TEMPORAL
-  if ((cs.picture->temporalId == 0) || (cs.picture->temporalId < cs.slice->getSPS()->getMaxTLayers() - 1))
-  {
-    CS::saveTemporalCcpModel(cs);
-  }
-#endif
-#if JVET_AG0058_EIP
-  if ((cs.picture->temporalId == 0) || (cs.picture->temporalId < cs.slice->getSPS()->getMaxTLayers() - 1))
   {
-    CS::saveTemporalEipModel(cs);
+    StageTimer deblockingTimer( stageTimes, STAGE_DEBLOCKING );
+    loopFilter.loopFilterPic( cs );
   }
-#endif
 #if JVET_W0066_CCSAO
   if (cs.sps->getCCSAOEnabledFlag())
   {
-    m_cSAO.getCcSaoBuf().copyFrom( cs.getRecoBuf() );
+    StageTimer ccSaoTimer( stageTimes, STAGE_CCSAO );
+    sao.getCcSaoBuf().copyFrom( cs.getRecoBuf() );
   }
 #endif
 
@@ -877,29 +1017,34 @@ void DecLib::executeLoopFilters()
 #endif
 #endif
   {
-    m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
+    StageTimer saoTimer( stageTimes, STAGE_SAO );
+    sao.SAOProcess( cs, cs.picture->getSAO() );
   }
-    
+
 #if JVET_W0066_CCSAO
-  if (cs.sps->getCCSAOEnabledFlag())
   {
-    m_cSAO.getCcSaoComParam() = cs.slice->m_ccSaoComParam;
-    m_cSAO.CCSAOProcess( cs );
+    StageTimer ccSaoTimer( stageTimes, STAGE_CCSAO );
+    if (cs.sps->getCCSAOEnabledFlag())
+    {
+      sao.getCcSaoComParam() = cs.slice->m_ccSaoComParam;
+      sao.CCSAOProcess( cs );
+    }
+    sao.jointClipSaoBifCcSao( cs );
   }
-  m_cSAO.jointClipSaoBifCcSao( cs );
 #endif
 
   if( cs.sps->getALFEnabledFlag() )
   {
-    m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+    StageTimer alfTimer( stageTimes, STAGE_ALF );
+    alf.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
     // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
     // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
     // copy in case the APS gets used more than once.
-    m_cALF.ALFProcess(cs);
+    alf.ALFProcess(cs);
   }
 
   // Use residual buffer to store post-filtered image
-  
+
   for (int i = 0; i < cs.pps->getNumSubPics() && m_targetSubPicIdx; i++)
   {
     // keep target subpic samples untouched, for other subpics mask their output sample value to 0
@@ -920,7 +1065,7 @@ void DecLib::executeLoopFilters()
     }
   }
 
-  m_pcPic->cs->slice->stopProcessingTimer();
+  cs.slice->stopProcessingTimer();
 }
 
 void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
@@ -929,6 +1074,7 @@ void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
 
   m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
   m_pcPic->reconstructed = true;
+  m_stageTimes.reset();
 
   Slice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcSlice->getPOC();
@@ -939,18 +1085,34 @@ void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
 #if JVET_AG0145_ADAPTIVE_CLIPPING
 void DecLib::adaptiveClipToRealRange()
 {
-  ClpRng clpRng;
-  clpRng.min = m_pcPic->cs->slice->getLumaPelMin();
-  clpRng.max = m_pcPic->cs->slice->getLumaPelMax();
-  m_pcPic->lumaClpRng.max = clpRng.max;
-  m_pcPic->lumaClpRng.min = clpRng.min;
+#if ENABLE_FRAME_PARALLEL_DECODING
+  const Slice* slice = m_finishInWorker ? m_filteredSlice : m_pcPic->cs->slice;
+#else
+  const Slice* slice = m_pcPic->cs->slice;
+#endif
+  m_pcPic->lumaClpRng.max = slice->getLumaPelMax();
+  m_pcPic->lumaClpRng.min = slice->getLumaPelMin();
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( m_finishInWorker )
+  {
+    // the previous picture may still be finished, the flag is handed to the worker with the current one
+    m_adaptiveClipPending = true;
+    return;
+  }
+#endif
+  xClipToRealRange( *m_pcPic, 0, m_pcPic->cs->pps->getPicHeightInLumaSamples() );
+}
+
+// clips the luma rows from startRow to endRow (exclusive)
+void DecLib::xClipToRealRange( Picture& pic, int startRow, int endRow )
+{
+  const ClpRng& clpRng = pic.lumaClpRng;
   int compIdx = 0;
   ComponentID compID = ComponentID(compIdx);
-  int width = m_pcPic->cs->pps->getPicWidthInLumaSamples();
-  int height = m_pcPic->cs->pps->getPicHeightInLumaSamples();
-  Pel* reconPel = m_pcPic->getRecoBuf().get(compID).buf;
-  int stride = m_pcPic->getRecoBuf().get(compID).stride;
-  for (uint32_t yPos = 0; yPos < height; yPos++)
+  int width = pic.cs->pps->getPicWidthInLumaSamples();
+  Pel* reconPel = pic.getRecoBuf().get(compID).buf;
+  int stride = pic.getRecoBuf().get(compID).stride;
+  for (int yPos = startRow; yPos < endRow; yPos++)
   {
     for (uint32_t xPos = 0; xPos < width; xPos++)
     {
@@ -977,26 +1139,108 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
  m_pcPic->copyCleanCurPicture();
 #endif
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+  Slice*  pcSlice = m_finishInWorker ? m_filteredSlice : m_pcPic->cs->slice;
+#else
   Slice*  pcSlice = m_pcPic->cs->slice;
+#endif
   m_prevPicPOC = pcSlice->getPOC();
 
+#if JVET_AG0196_CABAC_RETRAIN
+  CabacRetrain::endFrame(pcSlice->getPOC(),pcSlice->getSliceQp(),pcSlice->getCabacInitFlag(),pcSlice->isIntra()?I_SLICE:pcSlice->isInterP()?P_SLICE:B_SLICE);
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( !m_finishInWorker )
+#endif
+  {
+    xPrintPictureInfo( *m_pcPic, pcSlice, m_pcPic->referenced, *pcSlice->getPicHeader(), m_stageTimes, m_numberOfChecksumErrorsDetected, msgl );
+  }
+
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+    m_cacheModel.reportFrame();
+    m_cacheModel.accumulateFrame();
+    m_cacheModel.clear();
+#endif
+
+  m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
+#if JVET_R0270
+  if (associatedWithNewClvs && m_pcPic->neededForOutput)
+  {
+    if (!pcSlice->getPPS()->getMixedNaluTypesInPicFlag() && pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL)
+    {
+      m_pcPic->neededForOutput = false;
+    }
+    else if (pcSlice->getPPS()->getMixedNaluTypesInPicFlag())
+    {
+      bool isRaslPic = true;
+      for (int i = 0; isRaslPic && i < m_pcPic->numSlices; i++)
+      {
+        if (!(pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL))
+        {
+          isRaslPic = false;
+        }
+      }
+      if (isRaslPic)
+      {
+        m_pcPic->neededForOutput = false;
+      }
+    }
+  }
+#endif
+  m_pcPic->reconstructed = true;
+
+
+  Slice::sortPicList( m_cListPic ); // sorting for application output
+  poc                 = pcSlice->getPOC();
+  rpcListPic          = &m_cListPic;
+  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
+  m_maxDecSubPicIdx = 0;
+  m_maxDecSliceAddrInSubPic = -1;
+
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( m_finishInWorker )
+  {
+    xStartPictureFinishing( msgl );
+    m_finishInWorker = false;
+  }
+  else
+#endif
+  {
+  m_pcPic->destroyTempBuffers();
+  m_pcPic->cs->destroyTemporaryCsData();
+#if JVET_AA0096_MC_BOUNDARY_PADDING
+  m_cFrameMcPadPrediction.init(&m_cRdCost, pcSlice->getSPS()->getChromaFormatIdc(), pcSlice->getSPS()->getMaxCUHeight(),
+                               NULL, m_pcPic->getPicWidthInLumaSamples());
+  m_cFrameMcPadPrediction.mcFramePad(m_pcPic, *(m_pcPic->slices[0]));
+#endif
+  }
+
+#if !JVET_Z0118_GDR
+  m_pcPic->cs->picHeader->initPicHeader();
+#endif
+  m_puCounter++;
+}
+
+void DecLib::xPrintPictureInfo( Picture& pic, const Slice* pcSlice, bool referenced, const PicHeader& picHeader, StageTimes& stageTimes, uint32_t& numChecksumErrors, MsgLevel msgl )
+{
   char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!m_pcPic->referenced)
+  if (!referenced)
   {
     c += 32;  // tolower
   }
-#if JVET_AG0196_CABAC_RETRAIN
-  CabacRetrain::endFrame(pcSlice->getPOC(),pcSlice->getSliceQp(),pcSlice->getCabacInitFlag(),pcSlice->isIntra()?I_SLICE:pcSlice->isInterP()?P_SLICE:B_SLICE);
-#endif
   if (pcSlice->isDRAP()) c = 'D';
 
   //-- For time output for each slice
-  msg( msgl, "POC %4d LId: %2d TId: %1d ( %s, %c-SLICE, QP%3d ) ", pcSlice->getPOC(), pcSlice->getPic()->layerId,
+  msg( msgl, "POC %4d LId: %2d TId: %1d ( %s, %c-SLICE, QP%3d ) ", pcSlice->getPOC(), pic.layerId,
          pcSlice->getTLayer(),
          nalUnitTypeToString(pcSlice->getNalUnitType()),
          c,
          pcSlice->getSliceQp() );
   msg( msgl, "[DT %6.3f] ", pcSlice->getProcessingTime() );
+  if( m_stageTimesEnabled )
+  {
+    xReportStageTimes( pcSlice, stageTimes, msgl );
+  }
 
   for (int iRefList = 0; iRefList < 2; iRefList++)
   {
@@ -1005,7 +1249,7 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
     {
       const std::pair<int, int>& scaleRatio = pcSlice->getScalingRatio( RefPicList( iRefList ), iRefIndex );
 
-      if( pcSlice->getPicHeader()->getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - iRefList) && pcSlice->getColRefIdx() == iRefIndex )
+      if( picHeader.getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - iRefList) && pcSlice->getColRefIdx() == iRefIndex )
       {
         if( scaleRatio.first != 1 << SCALE_RATIO_BITS || scaleRatio.second != 1 << SCALE_RATIO_BITS )
         {
@@ -1037,71 +1281,206 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
   }
   if (m_decodedPictureHashSEIEnabled)
   {
-    SEIMessages pictureHashes = getSeisByType(m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    SEIMessages pictureHashes = getSeisByType(pic.SEIs, SEI::DECODED_PICTURE_HASH );
     const SEIDecodedPictureHash *hash = ( pictureHashes.size() > 0 ) ? (SEIDecodedPictureHash*) *(pictureHashes.begin()) : NULL;
     if (pictureHashes.size() > 1)
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    numChecksumErrors += calcAndPrintHashStatus(((const Picture&) pic).getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
   }
 
   msg( msgl, "\n");
+}
 
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-    m_cacheModel.reportFrame();
-    m_cacheModel.accumulateFrame();
-    m_cacheModel.clear();
+#if ENABLE_FRAME_PARALLEL_DECODING
+// hands the current picture to the worker thread, which filters it while the next picture is decoded; the picture
+// header, ALF APSs, LMCS mapping and CC-SAO/CC-ALF control of the decoder are copied since the next picture
+// overwrites them, and the next picture waits for the rows of its reference pictures in DecCu and InterPrediction
+void DecLib::xStartPictureFinishing( MsgLevel msgl )
+{
+  waitForPictureFinishing();
+
+  PictureFinishing& job = m_finishing;
+  CodingStructure&  cs  = *m_pcPic->cs;
+
+  job.pic          = m_pcPic;
+  job.msgl         = msgl;
+  job.referenced   = m_pcPic->referenced;
+  job.numChecksumErrors = 0;
+  job.stageTimes   = m_stageTimes;
+  m_stageTimes.reset();
+
+  job.sharedPicHeader = cs.picHeader;
+  job.picHeader       = *cs.picHeader;
+  cs.picHeader        = &job.picHeader;
+
+  job.alfApss.clear();
+  for( auto slice: m_pcPic->slices )
+  {
+    slice->setPicHeader( &job.picHeader );
+    APS** alfApss = slice->getAlfAPSs();
+    for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+    {
+      if( alfApss[i] )
+      {
+        alfApss[i] = &job.alfApss.emplace( alfApss[i], *alfApss[i] ).first->second;
+      }
+    }
+  }
+
+  job.invLUT = m_cReshaper.getInvLUT();
+  job.adaptiveClip = m_adaptiveClipPending;
+  m_adaptiveClipPending = false;
+
+  const int numCtus = cs.pcv->sizeInCtus;
+#if JVET_W0066_CCSAO
+  for( int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+  {
+    job.ccSaoControl[compIdx].clear();
+    if( cs.sps->getCCSAOEnabledFlag() )
+    {
+      const uint8_t* control = m_cSAO.getCcSaoControlIdc( ComponentID( compIdx ) );
+      job.ccSaoControl[compIdx].assign( control, control + numCtus );
+    }
+  }
 #endif
+  for( int compIdx = 0; compIdx < 2; compIdx++ )
+  {
+    job.ccAlfControl[compIdx].clear();
+    if( cs.sps->getALFEnabledFlag() )
+    {
+      const uint8_t* control = m_cALF.getCcAlfControlIdc( ComponentID( compIdx + 1 ) );
+      job.ccAlfControl[compIdx].assign( control, control + numCtus );
+    }
+  }
 
-  m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
-#if JVET_R0270
-  if (associatedWithNewClvs && m_pcPic->neededForOutput)
+  m_pcPic->setFinished( false );
+  job.thread = std::thread( &DecLib::xFinishPicture, this );
+}
+
+// runs in the worker thread, mirrors the initialization of the filters in xActivateParameterSets
+void DecLib::xFinishPicture()
+{
+  PictureFinishing& job = m_finishing;
+  Picture&          pic = *job.pic;
+  CodingStructure&  cs  = *pic.cs;
+
+  try
   {
-    if (!pcSlice->getPPS()->getMixedNaluTypesInPicFlag() && pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL)
+    const SPS& sps = *cs.sps;
+    const PPS& pps = *cs.pps;
+
+    const int maxDepth = floorLog2( sps.getMaxCUWidth() ) - pps.pcv->minCUWidthLog2;
+    const uint32_t log2SaoOffsetScaleLuma   = (uint32_t) std::max( 0, sps.getBitDepth( CHANNEL_TYPE_LUMA   ) - MAX_SAO_TRUNCATED_BITDEPTH );
+    const uint32_t log2SaoOffsetScaleChroma = (uint32_t) std::max( 0, sps.getBitDepth( CHANNEL_TYPE_CHROMA ) - MAX_SAO_TRUNCATED_BITDEPTH );
+    job.sao.create( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(),
+                    maxDepth, log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
+    job.loopFilter.create( maxDepth );
+#if ENABLE_PARALLEL_DEBLOCKING
+    job.loopFilter.setNumThreads( m_numLoopFilterThreads );
+#endif
+    if( sps.getALFEnabledFlag() )
     {
-      m_pcPic->neededForOutput = false;
+      const int alfMaxDepth = floorLog2( sps.getMaxCUWidth() ) - sps.getLog2MinCodingBlockSize();
+      job.alf.create( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(),
+                      alfMaxDepth, sps.getBitDepths().recon );
+#if ENABLE_PARALLEL_ALF
+      job.alf.setNumThreads( m_numLoopFilterThreads );
+#endif
     }
-    else if (pcSlice->getPPS()->getMixedNaluTypesInPicFlag())
+#if JVET_W0066_CCSAO
+    for( int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++ )
     {
-      bool isRaslPic = true;
-      for (int i = 0; isRaslPic && i < m_pcPic->numSlices; i++) 
-      {
-        if (!(pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL))
-        {
-          isRaslPic = false;
-        }
-      }
-      if (isRaslPic)
+      std::copy( job.ccSaoControl[compIdx].begin(), job.ccSaoControl[compIdx].end(), job.sao.getCcSaoControlIdc( ComponentID( compIdx ) ) );
+    }
+#endif
+    for( int compIdx = 0; compIdx < 2; compIdx++ )
+    {
+      std::copy( job.ccAlfControl[compIdx].begin(), job.ccAlfControl[compIdx].end(), job.alf.getCcAlfControlIdc( ComponentID( compIdx + 1 ) ) );
+    }
+
+    // the rows are final once filtered by ALF, the last filter, and clipped; the next picture may reference them from
+    // then on, unless the subpictures other than the target one are masked afterwards
+    const int picHeight    = pps.getPicHeightInLumaSamples();
+    int       filteredRows = 0;
+    auto      publishRows  = [&]( int numRows )
+    {
+#if JVET_AG0145_ADAPTIVE_CLIPPING
+      if( job.adaptiveClip )
       {
-        m_pcPic->neededForOutput = false;
+        xClipToRealRange( pic, filteredRows, numRows );
       }
-    }
-  }
 #endif
-  m_pcPic->reconstructed = true;
+      filteredRows = numRows;
+      pic.setReconstructedRows( numRows );
+    };
+    if( m_targetSubPicIdx )
+    {
+      job.alf.setRowsFilteredCallback( nullptr );
+    }
+    else
+    {
+      job.alf.setRowsFilteredCallback( [&]( int numCtuRows ) { publishRows( std::min( numCtuRows << pps.pcv->maxCUHeightLog2, picHeight ) ); } );
+    }
 
+    xFilterPicture( cs, job.loopFilter, job.sao, job.alf, job.invLUT, m_stageTimesEnabled ? &job.stageTimes : nullptr );
+    job.alf.setRowsFilteredCallback( nullptr );
+    publishRows( picHeight );
 
-  Slice::sortPicList( m_cListPic ); // sorting for application output
-  poc                 = pcSlice->getPOC();
-  rpcListPic          = &m_cListPic;
-  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
-  m_maxDecSubPicIdx = 0;
-  m_maxDecSliceAddrInSubPic = -1;
+    xPrintPictureInfo( pic, cs.slice, job.referenced, job.picHeader, job.stageTimes, job.numChecksumErrors, job.msgl );
 
-  m_pcPic->destroyTempBuffers();
-  m_pcPic->cs->destroyTemporaryCsData();
+    pic.destroyTempBuffers();
 #if JVET_AA0096_MC_BOUNDARY_PADDING
-  m_cFrameMcPadPrediction.init(&m_cRdCost, pcSlice->getSPS()->getChromaFormatIdc(), pcSlice->getSPS()->getMaxCUHeight(),
-                               NULL, m_pcPic->getPicWidthInLumaSamples());
-  m_cFrameMcPadPrediction.mcFramePad(m_pcPic, *(m_pcPic->slices[0]));
+    job.rdCost.setCostMode( COST_STANDARD_LOSSY );
+    job.mcPadPrediction.init( &job.rdCost, sps.getChromaFormatIdc(), sps.getMaxCUHeight(), NULL, pic.getPicWidthInLumaSamples() );
+    job.mcPadPrediction.mcFramePad( &pic, *pic.slices[0] );
 #endif
+  }
+  catch( ... )
+  {
+    job.alf.setRowsFilteredCallback( nullptr );
+    job.failure = std::current_exception();
+  }
 
-#if !JVET_Z0118_GDR
-  m_pcPic->cs->picHeader->initPicHeader();
-#endif
-  m_puCounter++;
+  // also on failure, the decoder must not wait forever for the picture
+  pic.setFinished( true );
+}
+
+void DecLib::waitForPictureFinishing()
+{
+  PictureFinishing& job = m_finishing;
+  if( !job.thread.joinable() )
+  {
+    return;
+  }
+  job.thread.join();
+
+  // the CUs, PUs and TUs go back to the unit cache the decoder allocates from, hence not in the worker thread
+  CodingStructure& cs = *job.pic->cs;
+  cs.destroyTemporaryCsData();
+  cs.picHeader = job.sharedPicHeader;
+  for( auto slice: job.pic->slices )
+  {
+    slice->setPicHeader( job.sharedPicHeader );
+    APS** alfApss = slice->getAlfAPSs();
+    for( auto& aps: job.alfApss )
+    {
+      std::replace( alfApss, alfApss + ALF_CTB_MAX_NUM_APS, &aps.second, aps.first );
+    }
+  }
+  job.alfApss.clear();
+  job.pic = nullptr;
+  m_numberOfChecksumErrorsDetected += job.numChecksumErrors;
+
+  if( job.failure )
+  {
+    std::exception_ptr failure = job.failure;
+    job.failure = nullptr;
+    std::rethrow_exception( failure );
+  }
 }
+#endif
 
 void DecLib::checkNoOutputPriorPics (PicList* pcListPic)
 {
@@ -1139,6 +1518,9 @@ void DecLib::xUpdateRasInit(Slice* slice)
 void DecLib::xCreateLostPicture( int iLostPoc, const int layerId )
 {
   msg( INFO, "\ninserting lost poc : %d\n",iLostPoc);
+#if ENABLE_FRAME_PARALLEL_DECODING
+  waitForPictureFinishing();
+#endif
   Picture *cFillPic = xGetNewPicBuffer( *( m_parameterSetManager.getFirstSPS() ), *( m_parameterSetManager.getFirstPPS() ), 0, layerId );
 
   CHECK( !cFillPic->slices.size(), "No slices in picture" );
@@ -1999,6 +2381,9 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
       m_cCuDecoder.initDecCuReshaper(&m_cReshaper, sps->getChromaFormatIdc());
     }
     m_cTrQuant.init(m_cTrQuantScalingList.getQuant(), sps->getMaxTbSize(), false, false, false, false);
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+    m_cSliceDecoder.initSubstreamDecoders( *sps, &m_cReshaper, m_cTrQuantScalingList.getQuant() );
+#endif
 
     // RdCost
     m_cRdCost.setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
@@ -3508,6 +3893,14 @@ bool DecLib::decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay, i
   auInfo.m_temporalId = nalu.m_temporalId;
   m_accessUnitNals.push_back(auInfo);
   m_pictureUnitNals.push_back( nalu.m_nalUnitType );
+#if ENABLE_FRAME_PARALLEL_DECODING
+  if( nalu.m_nalUnitType == NAL_UNIT_VPS || nalu.m_nalUnitType == NAL_UNIT_SPS || nalu.m_nalUnitType == NAL_UNIT_PPS
+    || ( nalu.m_nalUnitType == NAL_UNIT_SUFFIX_SEI && m_pcPic && m_pcPic == m_finishing.pic ) )
+  {
+    // the picture filtered by the worker thread refers to the parameter sets and reads its SEI messages
+    waitForPictureFinishing();
+  }
+#endif
   switch (nalu.m_nalUnitType)
   {
     case NAL_UNIT_VPS:
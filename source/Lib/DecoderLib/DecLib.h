@@ -54,6 +54,13 @@
 #include "CommonLib/SEI.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/Reshape.h"
+#include "CommonLib/StageTimer.h"
+#include <fstream>
+#if ENABLE_FRAME_PARALLEL_DECODING
+#include <exception>
+#include <map>
+#include <thread>
+#endif
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER
 #include "BilateralFilter.h"
 #endif
@@ -67,6 +74,38 @@ bool tryDecodePicture( Picture* pcPic, const int expectedPoc, const std::string&
 // Class definition
 // ====================================================================================================================
 
+#if ENABLE_FRAME_PARALLEL_DECODING
+/// a picture in-loop filtered and finished by a worker thread while the next picture is decoded, with copies of the
+/// decoder state the next picture overwrites
+struct PictureFinishing
+{
+  Picture*             pic;
+  MsgLevel             msgl;
+  bool                 referenced;
+  bool                 adaptiveClip;
+  PicHeader*           sharedPicHeader;                     ///< picture header of the decoder, restored when finished
+  PicHeader            picHeader;
+  std::map<APS*, APS>  alfApss;                             ///< copies of the ALF APSs of the slices, keyed by the originals
+  std::vector<Pel>     invLUT;
+  std::vector<uint8_t> ccSaoControl[MAX_NUM_COMPONENT];
+  std::vector<uint8_t> ccAlfControl[2];
+  uint32_t             numChecksumErrors;
+  StageTimes           stageTimes;
+
+  LoopFilter           loopFilter;
+  SampleAdaptiveOffset sao;
+  AdaptiveLoopFilter   alf;
+#if JVET_AA0096_MC_BOUNDARY_PADDING
+  RdCost               rdCost;
+  InterPrediction      mcPadPrediction;
+#endif
+
+  std::thread          thread;
+  std::exception_ptr   failure;
+};
+
+#endif
+
 /// decoder class
 class DecLib
 {
@@ -167,6 +206,22 @@ private:
   int                     m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   uint32_t                m_numberOfChecksumErrorsDetected;
 
+  StageTimes              m_stageTimes;             ///< time of the decoding stages of the current picture
+  bool                    m_stageTimesEnabled;
+  bool                    m_printStageTimes;
+  std::ofstream           m_stageTimesFile;
+
+#if ENABLE_FRAME_PARALLEL_DECODING
+  int                     m_numFrameThreads;
+  bool                    m_finishInWorker;         ///< the current picture is in-loop filtered by the worker thread
+  Slice*                  m_filteredSlice;          ///< slice the in-loop filters of the current picture end with
+  bool                    m_adaptiveClipPending;    ///< the worker thread clips the current picture to the signalled range
+  PictureFinishing        m_finishing;
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  int                     m_numLoopFilterThreads;
+#endif
+
   bool                    m_warningMessageSkipPicture;
 
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
@@ -271,6 +326,24 @@ public:
   void  setDecoded360SEIMessageFileName(std::string &Dump360SeiFileName) { m_decoded360SeiDumpFileName = Dump360SeiFileName; }
 #endif
   uint32_t  getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
+  void  setStageTimesOutput( bool printStageTimes, const std::string& stageTimesFileName );
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  void  setNumSubstreamThreads( int numThreads )       { m_cSliceDecoder.setNumSubstreamThreads( numThreads ); }
+#endif
+#if ENABLE_FRAME_PARALLEL_DECODING
+  void  setNumFrameThreads( int numThreads )           { m_numFrameThreads = numThreads; }
+  void  waitForPictureFinishing();
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  void  setParseAheadCtus( int numCtus )               { m_cSliceDecoder.setParseAheadCtus( numCtus ); }
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+#if ENABLE_PARALLEL_ALF
+  void  setNumLoopFilterThreads( int numThreads )      { m_numLoopFilterThreads = numThreads; m_cLoopFilter.setNumThreads( numThreads ); m_cALF.setNumThreads( numThreads ); }
+#else
+  void  setNumLoopFilterThreads( int numThreads )      { m_numLoopFilterThreads = numThreads; m_cLoopFilter.setNumThreads( numThreads ); }
+#endif
+#endif
 
   int  getDebugCTU( )               const { return m_debugCTU; }
   void setDebugCTU( int debugCTU )        { m_debugCTU = debugCTU; }
@@ -315,6 +388,17 @@ public:
 
 protected:
   void  xUpdateRasInit(Slice* slice);
+  StageTimes* xGetStageTimes()            { return m_stageTimesEnabled ? &m_stageTimes : nullptr; }
+  void  xReportStageTimes( const Slice* slice, StageTimes& stageTimes, MsgLevel msgl );
+  void  xFilterPicture( CodingStructure& cs, LoopFilter& loopFilter, SampleAdaptiveOffset& sao, AdaptiveLoopFilter& alf, std::vector<Pel>& invLUT, StageTimes* stageTimes );
+#if JVET_AG0145_ADAPTIVE_CLIPPING
+  void  xClipToRealRange( Picture& pic, int startRow, int endRow );
+#endif
+  void  xPrintPictureInfo( Picture& pic, const Slice* slice, bool referenced, const PicHeader& picHeader, StageTimes& stageTimes, uint32_t& numChecksumErrors, MsgLevel msgl );
+#if ENABLE_FRAME_PARALLEL_DECODING
+  void  xStartPictureFinishing( MsgLevel msgl );
+  void  xFinishPicture();
+#endif
 
   Picture * xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId );
   void  xCreateLostPicture( int iLostPOC, const int layerId );
@@ -40,6 +40,19 @@
 #include "CommonLib/dtrace_next.h"
 
 #include <vector>
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING && JVET_AG0196_CABAC_RETRAIN
+namespace CabacRetrain
+{
+  extern bool activate;
+}
+#endif
 
 //! \ingroup DecoderLib
 //! \{
@@ -49,11 +62,22 @@
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_stageTimes( nullptr )
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  , m_numSubstreamThreads( 1 )
+  , m_reshaper( nullptr )
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  , m_parseAheadCtus( 0 )
+#endif
 {
 }
 
 DecSlice::~DecSlice()
 {
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  destroy();
+#endif
 }
 
 #if JVET_AG0117_CABAC_SPATIAL_TUNING
@@ -78,6 +102,14 @@ void DecSlice::destroy()
 #if JVET_AG0117_CABAC_SPATIAL_TUNING
   m_binVectors.clear();
 #endif
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  for( auto substreamDecoder: m_substreamDecoders )
+  {
+    substreamDecoder->cuDecoder.destoryDecCuReshaprBuf();
+    delete substreamDecoder;
+  }
+  m_substreamDecoders.clear();
+#endif
 }
 
 void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
@@ -86,6 +118,119 @@ void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
   m_pcCuDecoder     = pcCuDecoder;
 }
 
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+void DecSlice::setNumSubstreamThreads( int numThreads )
+{
+  m_numSubstreamThreads = numThreads;
+  while( (int)m_substreamDecoders.size() < numThreads - 1 )
+  {
+    m_substreamDecoders.push_back( new SubstreamDecoder );
+  }
+}
+
+// mirrors the initialization of the tools of the calling thread in DecLib
+void DecSlice::initSubstreamDecoders( const SPS& sps, Reshape* reshaper, const Quant* scalingListQuant )
+{
+  m_reshaper = reshaper;
+
+  for( auto substreamDecoder: m_substreamDecoders )
+  {
+    SubstreamDecoder& dec = *substreamDecoder;
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+    dec.cabacDecoder.shareCABACDataStore( *m_CABACDecoder );
+#endif
+    dec.intraPred.init( sps.getChromaFormatIdc(), sps.getBitDepth( CHANNEL_TYPE_LUMA ) );
+#if INTER_LIC || (TM_AMVP || TM_MRG || JVET_Z0084_IBC_TM) || JVET_W0090_ARMC_TM || JVET_Z0056_GPM_SPLIT_MODE_REORDERING
+#if JVET_Z0153_IBC_EXT_REF
+    dec.interPred.init( &dec.rdCost, sps.getChromaFormatIdc(), sps.getMaxCUHeight(), &dec.reshaper, sps.getMaxPicWidthInLumaSamples() );
+#else
+    dec.interPred.init( &dec.rdCost, sps.getChromaFormatIdc(), sps.getMaxCUHeight(), &dec.reshaper );
+#endif
+#else
+    dec.interPred.init( &dec.rdCost, sps.getChromaFormatIdc(), sps.getMaxCUHeight() );
+#endif
+    dec.cuDecoder.init( &dec.trQuant, &dec.intraPred, &dec.interPred );
+#if !JVET_V0094_BILATERAL_FILTER && !JVET_X0071_CHROMA_BILATERAL_FILTER
+    if( sps.getUseLmcs() )
+#endif
+    {
+      dec.cuDecoder.initDecCuReshaper( &dec.reshaper, sps.getChromaFormatIdc() );
+    }
+    dec.trQuant.init( scalingListQuant, sps.getMaxTbSize(), false, false, false, false );
+    dec.rdCost.setCostMode( COST_STANDARD_LOSSY );
+  }
+}
+#endif
+
+// resets the history based predictors at the start of a CTU row of a tile
+static void resetCtuRowHistory( CodingStructure& cs )
+{
+#if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
+  if (cs.slice->getSliceType() != I_SLICE || cs.slice->getUseIBC())
+#else
+  if (cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag())
+#endif
+  {
+    LutMotionCand& motionLut = cs.getMotionLut();
+#if JVET_Z0118_GDR
+    motionLut.lut0.resize(0);
+    motionLut.lutIbc0.resize(0);
+
+    if (cs.isGdrEnabled())
+    {
+      motionLut.lut1.resize(0);
+      motionLut.lutIbc1.resize(0);
+    }
+#else
+    motionLut.lut.resize(0);
+    motionLut.lutIbc.resize(0);
+#endif
+
+#if JVET_Z0139_HIST_AFF
+    for (int i = 0; i < 2 * MAX_NUM_AFFHMVP_ENTRIES_ONELIST; i++)
+    {
+#if JVET_Z0118_GDR
+      motionLut.lutAff0[i].resize(0);
+      if (cs.isGdrEnabled())
+      {
+        motionLut.lutAff1[i].resize(0);
+      }
+#else
+      motionLut.lutAff[i].resize(0);
+#endif
+    }
+#if JVET_Z0118_GDR
+    motionLut.lutAffInherit0.resize(0);
+    if (cs.isGdrEnabled())
+    {
+      motionLut.lutAffInherit1.resize(0);
+    }
+#else
+    motionLut.lutAffInherit.resize(0);
+#endif
+#endif
+#if !JVET_Z0153_IBC_EXT_REF
+    cs.resetIBCBuffer = true;
+#endif
+  }
+#if JVET_AD0188_CCP_MERGE
+#if JVET_Z0118_GDR
+  cs.getCcpLut().lutCCP0.resize(0);
+  cs.getCcpLut().lutCCP1.resize(0);
+#else
+  cs.getCcpLut().lutCCP.resize(0);
+#endif
+#endif
+#if JVET_AG0058_EIP
+#if JVET_Z0118_GDR
+  cs.getEipLut().lutEip0.resize(0);
+  cs.getEipLut().lutEip1.resize(0);
+#else
+  cs.getEipLut().lutEip.resize(0);
+#endif
+#endif
+}
+
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
 {
   //-- For time output for each slice
@@ -339,9 +484,35 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     cs.eipLut.lutEip.resize(0);
 #endif
   }
+#endif
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  bool           decodedConcurrently = false;
+  if( xUseParallelSubstreams( slice, numSubstreams, debugCTU ) )
+  {
+    xDecompressSubstreams( slice, ppcSubstreams
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+                         , storedCtx
+#endif
+                         );
+    decodedConcurrently = true;
+  }
+#if ENABLE_PIPELINED_CTU_DECODING
+  else if( xUsePipelinedCtus( slice, debugCTU ) )
+  {
+    xDecompressPipelined( slice, ppcSubstreams
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+                        , storedCtx
+#endif
+                        );
+    decodedConcurrently = true;
+  }
+#endif
+  const unsigned numSerialCtus  = decodedConcurrently ? 0 : slice->getNumCtuInSlice();
+#else
+  const unsigned numSerialCtus  = slice->getNumCtuInSlice();
 #endif
   unsigned subStrmId = 0;
-  for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+  for( unsigned ctuIdx = 0; ctuIdx < numSerialCtus; ctuIdx++ )
   {
     const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
     const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
@@ -422,75 +593,10 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
       resetBcwCodingOrder(true, cs);
     }
 
-#if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
-    if ((cs.slice->getSliceType() != I_SLICE || cs.slice->getUseIBC()) && ctuXPosInCtus == tileXPosInCtus)
-#else
-    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == tileXPosInCtus)
-#endif
+    if( ctuXPosInCtus == tileXPosInCtus )
     {
-#if JVET_Z0118_GDR
-      cs.motionLut.lut0.resize(0);      
-      cs.motionLut.lutIbc0.resize(0);
-
-      if (cs.isGdrEnabled())
-      {
-        cs.motionLut.lut1.resize(0);
-        cs.motionLut.lutIbc1.resize(0);
-      }
-#else
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
-#endif
-
-#if JVET_Z0139_HIST_AFF   
-      for (int i = 0; i < 2 * MAX_NUM_AFFHMVP_ENTRIES_ONELIST; i++)
-      {
-#if JVET_Z0118_GDR
-        cs.motionLut.lutAff0[i].resize(0);
-        if (cs.isGdrEnabled())
-        {
-          cs.motionLut.lutAff1[i].resize(0);
-        }
-#else
-        cs.motionLut.lutAff[i].resize(0);
-#endif
-      }
-#if JVET_Z0118_GDR
-      cs.motionLut.lutAffInherit0.resize(0);
-      if (cs.isGdrEnabled())
-      {
-        cs.motionLut.lutAffInherit1.resize(0);
-      }
-#else
-      cs.motionLut.lutAffInherit.resize(0);
-#endif
-#endif
-#if !JVET_Z0153_IBC_EXT_REF
-      cs.resetIBCBuffer = true;
-#endif
-    }
-#if JVET_AD0188_CCP_MERGE
-    if (ctuXPosInCtus == tileXPosInCtus)
-    {
-#if JVET_Z0118_GDR
-      cs.ccpLut.lutCCP0.resize(0);
-      cs.ccpLut.lutCCP1.resize(0);
-#else
-      cs.ccpLut.lutCCP.resize(0);
-#endif
+      resetCtuRowHistory( cs );
     }
-#endif
-#if JVET_AG0058_EIP
-    if (ctuXPosInCtus == tileXPosInCtus)
-    {
-#if JVET_Z0118_GDR
-      cs.eipLut.lutEip0.resize(0);
-      cs.eipLut.lutEip1.resize(0);
-#else
-      cs.eipLut.lutEip.resize(0);
-#endif
-    }
-#endif
     if( !cs.slice->isIntra() )
     {
       pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
@@ -522,7 +628,10 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     cabacReader.setBinBuffer( getBinVector(ctuXPosInCtus) );
 #endif
 
-    cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    {
+      StageTimer parseTimer( m_stageTimes, STAGE_PARSE );
+      cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    }
 
 #if JVET_AG0117_CABAC_SPATIAL_TUNING
     // Done with data collection for this CTU
@@ -614,4 +723,703 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   slice->stopProcessingTimer();
 }
 
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+// pads the reference pictures around a subpicture treated as a picture, for the CTUs of a slice decoded concurrently
+static void extendRefSubPicBorders( Slice* slice, const SubPic& subPic )
+{
+  for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+  {
+    for( int idx = 0; idx < slice->getNumRefIdx( (RefPicList)rlist ); idx++ )
+    {
+      Picture *refPic = slice->getRefPic( (RefPicList)rlist, idx );
+#if JVET_S0258_SUBPIC_CONSTRAINTS
+      if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+#else
+      if( !refPic->getSubPicSaved() && refPic->numSubpics > 1 )
+#endif
+      {
+        refPic->saveSubPicBorder( refPic->getPOC(), subPic.getSubPicLeft(), subPic.getSubPicTop(), subPic.getSubPicWidthInLumaSample(), subPic.getSubPicHeightInLumaSample() );
+        refPic->extendSubPicBorder( refPic->getPOC(), subPic.getSubPicLeft(), subPic.getSubPicTop(), subPic.getSubPicWidthInLumaSample(), subPic.getSubPicHeightInLumaSample() );
+        refPic->setSubPicSaved( true );
+      }
+    }
+  }
+}
+
+static void restoreRefSubPicBorders( Slice* slice, const SubPic& subPic )
+{
+  for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+  {
+    for( int idx = 0; idx < slice->getNumRefIdx( (RefPicList)rlist ); idx++ )
+    {
+      Picture *refPic = slice->getRefPic( (RefPicList)rlist, idx );
+      if( refPic->getSubPicSaved() )
+      {
+        refPic->restoreSubPicBorder( refPic->getPOC(), subPic.getSubPicLeft(), subPic.getSubPicTop(), subPic.getSubPicWidthInLumaSample(), subPic.getSubPicHeightInLumaSample() );
+        refPic->setSubPicSaved( false );
+      }
+    }
+  }
+}
+
+bool DecSlice::xUseParallelSubstreams( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const
+{
+  const SPS& sps = *slice->getSPS();
+
+  if( m_numSubstreamThreads <= 1 || numSubstreams <= 1 || !sps.getEntryPointsPresentFlag() || debugCTU >= 0 || g_mctsDecCheckEnabled )
+  {
+    return false;
+  }
+  // the IBC reference buffer and the GDR clean/dirty state follow the CTUs in decoding order, without the extended IBC
+  // reference area every CTU row requests the reset of the IBC buffer
+#if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
+  if( slice->getUseIBC() || !JVET_Z0153_IBC_EXT_REF )
+#else
+  if( sps.getIBCFlag() || !JVET_Z0153_IBC_EXT_REF )
+#endif
+  {
+    return false;
+  }
+#if JVET_Z0118_GDR
+  if( slice->getPic()->cs->isGdrEnabled() )
+  {
+    return false;
+  }
+#endif
+#if JVET_AG0196_CABAC_RETRAIN
+  // the bins are dumped in decoding order
+  if( CabacRetrain::activate )
+  {
+    return false;
+  }
+#endif
+#if JVET_V0130_INTRA_TMP
+  // the template matching search is not restricted to the tile, above the CTU it reaches into the tile to the right
+  if( sps.getUseIntraTMP() )
+  {
+    const PPS&     pps          = *slice->getPPS();
+    const unsigned widthInCtus  = pps.pcv->widthInCtus;
+    const unsigned firstTileCol = pps.ctuToTileCol( slice->getCtuAddrInSlice( 0 ) % widthInCtus );
+    for( unsigned ctuIdx = 1; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+    {
+      if( pps.ctuToTileCol( slice->getCtuAddrInSlice( ctuIdx ) % widthInCtus ) != firstTileCol )
+      {
+        return false;
+      }
+    }
+  }
+#endif
+  return true;
+}
+
+// decodes the substreams of a slice concurrently, each by one thread at a time; a CTU is parsed under a lock on the
+// coding structure and reconstructed without it once the CTUs of other substreams it refers to are reconstructed
+void DecSlice::xDecompressSubstreams( Slice* slice, const std::vector<InputBitstream*>& substreams
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+                                    , Ctx& storedCtx
+#endif
+                                    )
+{
+  Picture*             pic               = slice->getPic();
+  CodingStructure&     cs                = *pic->cs;
+  const SPS*           sps               = slice->getSPS();
+  const PPS*           pps               = slice->getPPS();
+  const PreCalcValues& pcv               = *cs.pcv;
+  const unsigned       widthInCtus       = pcv.widthInCtus;
+  const unsigned       maxCUSize         = sps->getMaxCUWidth();
+  const unsigned       numCtuInSlice     = slice->getNumCtuInSlice();
+  const bool           wavefrontsEnabled = sps->getEntropyCodingSyncEnabledFlag();
+  const uint32_t       lag               = CS::getWavefrontLag( *sps );
+#if JVET_V0130_INTRA_TMP
+  const bool           useTmp            = sps->getUseIntraTMP();
+#else
+  const bool           useTmp            = false;
+#endif
+
+  struct Substream
+  {
+    unsigned      firstCtu;                       ///< index of the first CTU of the substream in the slice
+    unsigned      numCtus;
+    int           prevQP[MAX_NUM_CHANNEL_TYPE];
+    CtuRowHistory history;
+    Ctx           syncCtx;                        ///< state after the first CTU of a WPP row, for the row below
+    PLTBuf        syncPLT;
+  };
+  std::vector<Substream> streams;
+  // substream of each CTU of the picture and its index there, -1 for the CTUs of other slices
+  std::vector<int>       ctuSubstream( pcv.sizeInCtus, -1 );
+  std::vector<unsigned>  ctuIdxInSubstream( pcv.sizeInCtus, 0 );
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+  // CTU of the slice that filled the bin buffer of the column before, -1 if none
+  std::vector<int>       prevCtuInColumn( pcv.sizeInCtus, -1 );
+  std::vector<int>       lastCtuInColumn( widthInCtus, -1 );
+#endif
+  bool startSubstream = true;
+  for( unsigned ctuIdx = 0; ctuIdx < numCtuInSlice; ctuIdx++ )
+  {
+    const unsigned ctuRsAddr     = slice->getCtuAddrInSlice( ctuIdx );
+    const unsigned ctuXPosInCtus = ctuRsAddr % widthInCtus;
+    const unsigned ctuYPosInCtus = ctuRsAddr / widthInCtus;
+    const unsigned tileColIdx    = pps->ctuToTileCol( ctuXPosInCtus );
+    const unsigned tileRowIdx    = pps->ctuToTileRow( ctuYPosInCtus );
+
+    if( startSubstream )
+    {
+      streams.emplace_back();
+      streams.back().firstCtu = ctuIdx;
+      streams.back().numCtus  = 0;
+      startSubstream          = false;
+    }
+    ctuSubstream     [ctuRsAddr] = (int)streams.size() - 1;
+    ctuIdxInSubstream[ctuRsAddr] = streams.back().numCtus++;
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+    prevCtuInColumn[ctuRsAddr]     = lastCtuInColumn[ctuXPosInCtus];
+    lastCtuInColumn[ctuXPosInCtus] = ctuRsAddr;
+#endif
+    // end of tile, end of WPP CTU row
+    startSubstream = ctuXPosInCtus + 1 == pps->getTileColumnBd( tileColIdx ) + pps->getTileColumnWidth( tileColIdx ) &&
+                     ( ctuYPosInCtus + 1 == pps->getTileRowBd( tileRowIdx ) + pps->getTileRowHeight( tileRowIdx ) || wavefrontsEnabled );
+  }
+  CHECK( streams.size() != substreams.size(), "Number of substreams does not match the entry points" );
+
+  const int numThreads = std::min<int>( m_numSubstreamThreads, (int)streams.size() );
+  std::vector<CABACReader*> cabacReaders( numThreads );
+  std::vector<DecCu*>       cuDecoders  ( numThreads );
+  std::vector<StageTimes*>  stageTimes  ( numThreads );
+  cabacReaders[0] = m_CABACDecoder->getCABACReader( 0 );
+  cuDecoders  [0] = m_pcCuDecoder;
+  stageTimes  [0] = m_stageTimes;
+  for( int jId = 1; jId < numThreads; jId++ )
+  {
+    CHECK( m_reshaper == nullptr, "Substream decoders not initialized" );
+    SubstreamDecoder& dec = *m_substreamDecoders[jId - 1];
+    dec.reshaper = *m_reshaper;
+    dec.trQuant.getQuant()->setUseScalingList( slice->getExplicitScalingListUsed() );
+    dec.stageTimes.reset();
+    dec.cuDecoder.setStageTimes( m_stageTimes ? &dec.stageTimes : nullptr );
+    dec.interPred.setStageTimes( m_stageTimes ? &dec.stageTimes : nullptr );
+    cabacReaders[jId] = dec.cabacDecoder.getCABACReader( 0 );
+    cuDecoders  [jId] = &dec.cuDecoder;
+    stageTimes  [jId] = m_stageTimes ? &dec.stageTimes : nullptr;
+  }
+
+  const SubPic& curSubPic = pps->getSubPicFromPos( Position( ( slice->getCtuAddrInSlice( 0 ) % widthInCtus ) * maxCUSize, ( slice->getCtuAddrInSlice( 0 ) / widthInCtus ) * maxCUSize ) );
+  const bool    padSubPic = pps->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag();
+  if( padSubPic )
+  {
+    extendRefSubPicBorders( slice, curSubPic );
+  }
+
+  if( slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( true, cs );
+  }
+
+  CS::reserveUnitsOfPicture( cs );
+  const unsigned firstCU = (unsigned)cs.cus.size();
+  const unsigned firstPU = (unsigned)cs.pus.size();
+  const unsigned firstTU = (unsigned)cs.tus.size();
+
+  // the IBC buffer is not used, its pending reset is left to the next slice decoded in one thread
+  const bool resetIBCBuffer = cs.resetIBCBuffer;
+  cs.resetIBCBuffer         = false;
+
+  // the first substream was already started for the slice, each thread starts its substreams itself
+  substreams[0]->resetToStart();
+
+  std::vector<unsigned>   progress( streams.size(), 0 );   ///< number of reconstructed CTUs of each substream
+  std::mutex              picLock;
+  std::mutex              progressLock;
+  std::condition_variable progressChanged;
+  std::exception_ptr      failure;
+  bool                    failed        = false;
+  size_t                  nextSubstream = 0;
+
+  auto waitForCtu = [&]( const int substream, const unsigned ctuRsAddr )
+  {
+    const int ctuStream = ctuSubstream[ctuRsAddr];
+    if( ctuStream < 0 || ctuStream == substream )
+    {
+      return true;
+    }
+    CHECK( ctuStream > substream, "Substream depends on a later one" );
+    std::unique_lock<std::mutex> lock( progressLock );
+    progressChanged.wait( lock, [&]() { return failed || progress[ctuStream] > ctuIdxInSubstream[ctuRsAddr]; } );
+    return !failed;
+  };
+
+  auto decodeSubstreams = [&]( const int jId )
+  {
+    CABACReader& cabacReader = *cabacReaders[jId];
+    DecCu&       cuDecoder   = *cuDecoders[jId];
+
+    while( true )
+    {
+      int s;
+      {
+        std::lock_guard<std::mutex> lock( progressLock );
+        if( failed || nextSubstream == streams.size() )
+        {
+          return;
+        }
+        s = (int)nextSubstream++;
+      }
+      Substream& stream = streams[s];
+      CodingStructure::setThreadHistory( &stream.history );
+      cs.resetPrevPLT( stream.history.prevPLT );
+      stream.prevQP[0] = stream.prevQP[1] = slice->getSliceQp();
+      cabacReader.initBitstream( substreams[s] );
+      {
+        std::lock_guard<std::mutex> lock( picLock );
+        cabacReader.initCtxModels( *slice );
+      }
+
+      for( unsigned k = 0; k < stream.numCtus; k++ )
+      {
+        const unsigned ctuIdx         = stream.firstCtu + k;
+        const unsigned ctuRsAddr      = slice->getCtuAddrInSlice( ctuIdx );
+        const unsigned ctuXPosInCtus  = ctuRsAddr % widthInCtus;
+        const unsigned ctuYPosInCtus  = ctuRsAddr / widthInCtus;
+        const unsigned tileColIdx     = pps->ctuToTileCol( ctuXPosInCtus );
+        const unsigned tileRowIdx     = pps->ctuToTileRow( ctuYPosInCtus );
+        const unsigned tileXPosInCtus = pps->getTileColumnBd( tileColIdx );
+        const unsigned tileYPosInCtus = pps->getTileRowBd( tileRowIdx );
+        const unsigned tileColWidth   = pps->getTileColumnWidth( tileColIdx );
+        const unsigned tileIdx        = pps->getTileIdx( ctuXPosInCtus, ctuYPosInCtus );
+        const Position pos( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize );
+        const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+        // the WPP row above has to be ahead by the wavefront lag, the template matching search also reaches into the
+        // tile above
+        if( ctuYPosInCtus > 0 && ( ctuYPosInCtus > tileYPosInCtus ? wavefrontsEnabled : useTmp )
+            && !waitForCtu( s, ( ctuYPosInCtus - 1 ) * widthInCtus + std::min( ctuXPosInCtus + lag - 1, tileXPosInCtus + tileColWidth - 1 ) ) )
+        {
+          return;
+        }
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+        if( prevCtuInColumn[ctuRsAddr] >= 0 && !waitForCtu( s, prevCtuInColumn[ctuRsAddr] ) )
+        {
+          return;
+        }
+#endif
+
+        if( ctuXPosInCtus == tileXPosInCtus )
+        {
+          resetCtuRowHistory( cs );
+        }
+
+        {
+          std::lock_guard<std::mutex> lock( picLock );
+
+          if( wavefrontsEnabled && ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus != tileYPosInCtus
+              && cs.getCURestricted( pos.offset( 0, -1 ), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+          {
+            const Substream& above = streams[ctuSubstream[ctuRsAddr - widthInCtus]];
+            cabacReader.getCtx() = above.syncCtx;
+            cs.setPrevPLT( above.syncPLT );
+          }
+#if JVET_V0094_BILATERAL_FILTER
+          if( ctuRsAddr == 0 )
+          {
+            cabacReader.bif( COMPONENT_Y, cs );
+#if JVET_X0071_CHROMA_BILATERAL_FILTER
+            cabacReader.bif( COMPONENT_Cb, cs );
+            cabacReader.bif( COMPONENT_Cr, cs );
+#endif
+          }
+#endif
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+          if( ctuYPosInCtus )
+          {
+            cabacReader.updateCtxs( getBinVector( ctuXPosInCtus ) );
+          }
+          cabacReader.setBinBuffer( getBinVector( ctuXPosInCtus ) );
+#endif
+
+          cs.breakCUChain();
+          {
+            StageTimer parseTimer( stageTimes[jId], STAGE_PARSE );
+            cabacReader.coding_tree_unit( cs, ctuArea, stream.prevQP, ctuRsAddr );
+          }
+
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+          cabacReader.setBinBuffer( nullptr );
+#endif
+        }
+
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+        if( storeContexts( slice, ctuXPosInCtus, ctuYPosInCtus ) )
+        {
+          storedCtx = cabacReader.getCtx();
+        }
+#endif
+        // the sub-stream ends with the slice, the tile or the WPP CTU row
+        if( k + 1 == stream.numCtus )
+        {
+          unsigned binVal = cabacReader.terminating_bit();
+          CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+          cabacReader.remaining_bytes( ctuIdx + 1 < numCtuInSlice );
+#endif
+        }
+
+        cuDecoder.decompressCtu( cs, ctuArea );
+
+        if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+        {
+          stream.syncCtx = cabacReader.getCtx();
+          cs.storePrevPLT( stream.syncPLT );
+        }
+
+        {
+          std::lock_guard<std::mutex> lock( progressLock );
+          progress[s] = k + 1;
+        }
+        progressChanged.notify_all();
+      }
+    }
+  };
+
+  auto runThread = [&]( const int jId )
+  {
+    try
+    {
+      decodeSubstreams( jId );
+    }
+    catch( ... )
+    {
+      std::lock_guard<std::mutex> lock( progressLock );
+      if( !failed )
+      {
+        failure = std::current_exception();
+        failed  = true;
+      }
+      progressChanged.notify_all();
+    }
+    CodingStructure::setThreadHistory( nullptr );
+  };
+
+  cs.useThreadHistory( true );
+  std::vector<std::thread> threads;
+  for( int jId = 1; jId < numThreads; jId++ )
+  {
+    threads.emplace_back( runThread, jId );
+  }
+  runThread( 0 );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+  cs.useThreadHistory( false );
+  if( m_stageTimes )
+  {
+    for( int jId = 1; jId < numThreads; jId++ )
+    {
+      m_stageTimes->add( m_substreamDecoders[jId - 1]->stageTimes );
+    }
+  }
+  if( failure )
+  {
+    std::rethrow_exception( failure );
+  }
+
+  // restore the coding order of the units and the state after the last CTU
+  std::vector<int> ctuRank( pcv.sizeInCtus, 0 );
+  for( unsigned ctuIdx = 0; ctuIdx < numCtuInSlice; ctuIdx++ )
+  {
+    ctuRank[slice->getCtuAddrInSlice( ctuIdx )] = ctuIdx;
+  }
+  cs.sortUnitsInCtuOrder( firstCU, firstPU, firstTU, ctuRank );
+  streams.back().history.load( cs );
+  pic->m_prevQP[0]  = streams.back().prevQP[0];
+  pic->m_prevQP[1]  = streams.back().prevQP[1];
+  cs.resetIBCBuffer = resetIBCBuffer;
+
+  if( padSubPic )
+  {
+    restoreRefSubPicBorders( slice, curSubPic );
+  }
+}
+#endif
+
+#if ENABLE_PIPELINED_CTU_DECODING
+bool DecSlice::xUsePipelinedCtus( const Slice* slice, const int debugCTU ) const
+{
+  if( m_parseAheadCtus <= 0 || slice->getNumCtuInSlice() <= 1 || debugCTU >= 0 )
+  {
+    return false;
+  }
+#if JVET_Z0118_GDR
+  // the reconstruction switches the coding structure between the clean and the dirty buffers of the GDR picture
+  if( slice->getPic()->cs->isGdrEnabled() )
+  {
+    return false;
+  }
+#endif
+  return true;
+}
+
+// parses the CTUs of a slice in a separate thread while the calling thread reconstructs them, at most m_parseAheadCtus
+// CTUs ahead; the parsed units wait in the coding structure of the picture. The parsing does not read reconstructed
+// samples or the motion derived by DecCu, the DIMD and TIMD modes are derived in the reconstruction. The history based
+// motion, CCP and EIP predictors belong to the reconstruction, the palette predictor and the QP prediction to the
+// parsing.
+void DecSlice::xDecompressPipelined( Slice* slice, const std::vector<InputBitstream*>& substreams
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+                                   , Ctx& storedCtx
+#endif
+                                   )
+{
+  Picture*             pic               = slice->getPic();
+  CodingStructure&     cs                = *pic->cs;
+  const SPS*           sps               = slice->getSPS();
+  const PPS*           pps               = slice->getPPS();
+  const PreCalcValues& pcv               = *cs.pcv;
+  const unsigned       widthInCtus       = pcv.widthInCtus;
+  const unsigned       maxCUSize         = sps->getMaxCUWidth();
+  const unsigned       numCtuInSlice     = slice->getNumCtuInSlice();
+  const bool           wavefrontsEnabled = sps->getEntropyCodingSyncEnabledFlag();
+  const bool           entryPointPresent = sps->getEntryPointsPresentFlag();
+  CABACReader&         cabacReader       = *m_CABACDecoder->getCABACReader( 0 );
+
+  const SubPic& curSubPic = pps->getSubPicFromPos( Position( ( slice->getCtuAddrInSlice( 0 ) % widthInCtus ) * maxCUSize, ( slice->getCtuAddrInSlice( 0 ) / widthInCtus ) * maxCUSize ) );
+  const bool    padSubPic = pps->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag();
+  if( padSubPic )
+  {
+    extendRefSubPicBorders( slice, curSubPic );
+  }
+
+  if( slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( true, cs );
+  }
+
+  CS::reserveUnitsOfPicture( cs );
+  const unsigned firstCU = (unsigned)cs.cus.size();
+  const unsigned firstPU = (unsigned)cs.pus.size();
+  const unsigned firstTU = (unsigned)cs.tus.size();
+
+  StageTimes              parseTimes;
+  unsigned                numParsed        = 0;
+  unsigned                numReconstructed = 0;
+  std::mutex              progressLock;
+  std::condition_variable progressChanged;
+  std::exception_ptr      failure;
+  bool                    failed           = false;
+
+  auto setFailed = [&]()
+  {
+    std::lock_guard<std::mutex> lock( progressLock );
+    if( !failed )
+    {
+      failure = std::current_exception();
+      failed  = true;
+    }
+    progressChanged.notify_all();
+  };
+
+  auto parseCtus = [&]()
+  {
+    unsigned subStrmId = 0;
+
+    for( unsigned ctuIdx = 0; ctuIdx < numCtuInSlice; ctuIdx++ )
+    {
+      {
+        std::unique_lock<std::mutex> lock( progressLock );
+        progressChanged.wait( lock, [&]() { return failed || ctuIdx < numReconstructed + m_parseAheadCtus; } );
+        if( failed )
+        {
+          return;
+        }
+      }
+
+      const unsigned ctuRsAddr      = slice->getCtuAddrInSlice( ctuIdx );
+      const unsigned ctuXPosInCtus  = ctuRsAddr % widthInCtus;
+      const unsigned ctuYPosInCtus  = ctuRsAddr / widthInCtus;
+      const unsigned tileColIdx     = pps->ctuToTileCol( ctuXPosInCtus );
+      const unsigned tileRowIdx     = pps->ctuToTileRow( ctuYPosInCtus );
+      const unsigned tileXPosInCtus = pps->getTileColumnBd( tileColIdx );
+      const unsigned tileYPosInCtus = pps->getTileRowBd( tileRowIdx );
+      const unsigned tileColWidth   = pps->getTileColumnWidth( tileColIdx );
+      const unsigned tileRowHeight  = pps->getTileRowHeight( tileRowIdx );
+      const unsigned tileIdx        = pps->getTileIdx( ctuXPosInCtus, ctuYPosInCtus );
+      const Position pos( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize );
+      const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+      DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+
+      cabacReader.initBitstream( substreams[subStrmId] );
+
+      if( ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
+      {
+        if( ctuIdx != 0 )
+        {
+          cabacReader.initCtxModels( *slice );
+          cs.resetPrevPLT( cs.prevPLT );
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+      }
+      else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+      {
+        if( ctuIdx != 0 )
+        {
+          cabacReader.initCtxModels( *slice );
+          cs.resetPrevPLT( cs.prevPLT );
+        }
+        if( cs.getCURestricted( pos.offset( 0, -1 ), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+        {
+          cabacReader.getCtx() = m_entropyCodingSyncContextState;
+          cs.setPrevPLT( m_palettePredictorSyncState );
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+      }
+#if JVET_V0094_BILATERAL_FILTER
+      if( ctuRsAddr == 0 )
+      {
+        cabacReader.bif( COMPONENT_Y, cs );
+#if JVET_X0071_CHROMA_BILATERAL_FILTER
+        cabacReader.bif( COMPONENT_Cb, cs );
+        cabacReader.bif( COMPONENT_Cr, cs );
+#endif
+      }
+#endif
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+      if( ctuYPosInCtus )
+      {
+        cabacReader.updateCtxs( getBinVector( ctuXPosInCtus ) );
+      }
+      cabacReader.setBinBuffer( getBinVector( ctuXPosInCtus ) );
+#endif
+
+      // the CTU reconstructed meanwhile keeps the end of its CU chain
+      cs.breakCUChain();
+      {
+        StageTimer parseTimer( m_stageTimes ? &parseTimes : nullptr, STAGE_PARSE );
+        cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+      }
+
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+      cabacReader.setBinBuffer( nullptr );
+#endif
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+      if( storeContexts( slice, ctuXPosInCtus, ctuYPosInCtus ) )
+      {
+        storedCtx = cabacReader.getCtx();
+      }
+#endif
+      if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+      {
+        m_entropyCodingSyncContextState = cabacReader.getCtx();
+        cs.storePrevPLT( m_palettePredictorSyncState );
+      }
+
+      if( ctuIdx == numCtuInSlice - 1 )
+      {
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( false );
+#endif
+      }
+      else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + tileColWidth ) &&
+               ( ctuYPosInCtus + 1 == tileYPosInCtus + tileRowHeight || wavefrontsEnabled ) )
+      {
+        // end of tile, end of WPP CTU row
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+        if( entryPointPresent )
+        {
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+          cabacReader.remaining_bytes( true );
+#endif
+          subStrmId++;
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock( progressLock );
+        numParsed = ctuIdx + 1;
+      }
+      progressChanged.notify_all();
+    }
+  };
+
+  std::thread parseThread( [&]()
+  {
+    try
+    {
+      parseCtus();
+    }
+    catch( ... )
+    {
+      setFailed();
+    }
+  } );
+
+  try
+  {
+    for( unsigned ctuIdx = 0; ctuIdx < numCtuInSlice; ctuIdx++ )
+    {
+      {
+        std::unique_lock<std::mutex> lock( progressLock );
+        progressChanged.wait( lock, [&]() { return failed || ctuIdx < numParsed; } );
+        if( failed )
+        {
+          break;
+        }
+      }
+
+      const unsigned ctuRsAddr     = slice->getCtuAddrInSlice( ctuIdx );
+      const unsigned ctuXPosInCtus = ctuRsAddr % widthInCtus;
+      const unsigned ctuYPosInCtus = ctuRsAddr / widthInCtus;
+      const UnitArea ctuArea( cs.area.chromaFormat, Area( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize, maxCUSize, maxCUSize ) );
+
+      if( ctuXPosInCtus == pps->getTileColumnBd( pps->ctuToTileCol( ctuXPosInCtus ) ) )
+      {
+        resetCtuRowHistory( cs );
+      }
+      if( !cs.slice->isIntra() )
+      {
+        pic->mctsInfo.init( &cs, ctuRsAddr );
+      }
+
+      m_pcCuDecoder->decompressCtu( cs, ctuArea );
+
+      {
+        std::lock_guard<std::mutex> lock( progressLock );
+        numReconstructed = ctuIdx + 1;
+      }
+      progressChanged.notify_all();
+    }
+  }
+  catch( ... )
+  {
+    setFailed();
+  }
+  parseThread.join();
+
+  if( m_stageTimes )
+  {
+    m_stageTimes->add( parseTimes );
+  }
+  if( failure )
+  {
+    std::rethrow_exception( failure );
+  }
+
+  // link the CUs of consecutive CTUs again
+  std::vector<int> ctuRank( pcv.sizeInCtus, 0 );
+  for( unsigned ctuIdx = 0; ctuIdx < numCtuInSlice; ctuIdx++ )
+  {
+    ctuRank[slice->getCtuAddrInSlice( ctuIdx )] = ctuIdx;
+  }
+  cs.sortUnitsInCtuOrder( firstCU, firstPU, firstTU, ctuRank );
+
+  if( padSubPic )
+  {
+    restoreRefSubPicBorders( slice, curSubPic );
+  }
+}
+#endif
+
 //! \}
@@ -54,6 +54,21 @@
 // Class definition
 // ====================================================================================================================
 
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+/// tools of an additional thread decoding substreams of a slice
+struct SubstreamDecoder
+{
+  CABACDecoder    cabacDecoder;
+  IntraPrediction intraPred;
+  InterPrediction interPred;
+  TrQuant         trQuant;
+  RdCost          rdCost;
+  Reshape         reshaper;
+  DecCu           cuDecoder;
+  StageTimes      stageTimes;
+};
+
+#endif
 /// slice decoder class
 class DecSlice
 {
@@ -61,18 +76,28 @@ private:
   // access channel
   CABACDecoder*   m_CABACDecoder;
   DecCu*          m_pcCuDecoder;
+  StageTimes*     m_stageTimes;
 
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   PLTBuf          m_palettePredictorSyncState;      /// palette predictor storage at wavefront/WPP
 #if JVET_AG0117_CABAC_SPATIAL_TUNING
   std::vector<BinStoreVector> m_binVectors;
 #endif
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  int                            m_numSubstreamThreads;
+  std::vector<SubstreamDecoder*> m_substreamDecoders;   ///< tools of the threads besides the calling one
+  Reshape*                       m_reshaper;            ///< reshaper of the calling thread, copied to the others for each slice
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  int                            m_parseAheadCtus;      ///< CTUs the parsing thread may be ahead of the reconstruction, 0: no parsing thread
+#endif
 
 public:
   DecSlice();
   virtual ~DecSlice();
 
   void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  void  setStageTimes     ( StageTimes* stageTimes ) { m_stageTimes = stageTimes; }
 #if JVET_AG0117_CABAC_SPATIAL_TUNING
   BinStoreVector* getBinVector ( int id ) { return &m_binVectors[id]; }
   void  create                 ( int width, int iMaxCUWidth );
@@ -82,6 +107,13 @@ public:
   void  destroy           ();
 
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  void  setNumSubstreamThreads( int numThreads );
+  void  initSubstreamDecoders ( const SPS& sps, Reshape* reshaper, const Quant* scalingListQuant );
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  void  setParseAheadCtus     ( int numCtus )        { m_parseAheadCtus = numCtus; }
+#endif
 
 #if JVET_AG0098_AMVP_WITH_SBTMVP
   std::map<int, uint32_t> m_amvpSbTmvpArea;
@@ -106,6 +138,24 @@ public:
     return false;
   }
 #endif
+
+private:
+#if ENABLE_PARALLEL_SUBSTREAM_DECODING
+  bool  xUseParallelSubstreams( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const;
+  void  xDecompressSubstreams ( Slice* slice, const std::vector<InputBitstream*>& substreams
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+                              , Ctx& storedCtx
+#endif
+                              );
+#endif
+#if ENABLE_PIPELINED_CTU_DECODING
+  bool  xUsePipelinedCtus     ( const Slice* slice, const int debugCTU ) const;
+  void  xDecompressPipelined  ( Slice* slice, const std::vector<InputBitstream*>& substreams
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+                              , Ctx& storedCtx
+#endif
+                              );
+#endif
 };
 
 //! \}
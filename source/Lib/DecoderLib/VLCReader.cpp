@@ -2581,6 +2581,10 @@ void HLSyntaxReader::parseSPS(SPS* pcSPS)
 #if JVET_AG0112_REGRESSION_BASED_GPM_BLENDING
       READ_FLAG(uiCode, "sps_gpm_blend_flag");
       pcSPS->setUseGeoBlend(uiCode != 0);
+#endif
+#if GPM_CURVE
+      READ_FLAG(uiCode, "sps_gpm_curve_flag");
+      pcSPS->setUseGeoCurve(uiCode != 0);
 #endif
       if (pcSPS->getMaxNumMergeCand() >= 3)
       {
@@ -2686,6 +2690,21 @@ void HLSyntaxReader::parseSPS(SPS* pcSPS)
 #if JVET_AB0155_SGPM
   READ_FLAG(uiCode, "sps_sgpm_enabled_flag");                       pcSPS->setUseSgpm(uiCode != 0);
 #endif
+#if GPM_BLEND
+#if JVET_AB0155_SGPM
+  if (pcSPS->getUseGeo() || pcSPS->getUseSgpm())
+#else
+  if (pcSPS->getUseGeo())
+#endif
+  {
+    READ_FLAG(uiCode, "sps_gpm_tanh_blend_flag");
+    pcSPS->setUseGeoTanhBlend(uiCode != 0);
+  }
+  else
+  {
+    pcSPS->setUseGeoTanhBlend(true);
+  }
+#endif
 #if JVET_AD0082_TMRL_CONFIG
   READ_FLAG(uiCode, "sps_tmrl_enabled_flag");                       pcSPS->setUseTmrl(uiCode != 0);
 #endif
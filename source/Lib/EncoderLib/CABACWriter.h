@@ -537,6 +537,20 @@ public:
 
   CABACWriter*                getCABACWriter          ( const SPS*   sps   )        { return m_CABACWriter   [0]; }
   CABACWriter*                getCABACEstimator       ( const SPS*   sps   )        { return m_CABACEstimator[0]; }
+#if ENABLE_FRAME_PARALLELISM && JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+  // writers and estimators use the context state store of another encoder, the own store is only released
+  void                        shareCABACDataStore     ( CABACEncoder& other )
+  {
+    m_CABACWriterStd.m_CABACDataStore    = other.m_CABACDataStore;
+    m_CABACEstimatorStd.m_CABACDataStore = other.m_CABACDataStore;
+
+    for( int i = 0; i < BPM_NUM - 1; i++ )
+    {
+      m_CABACWriter[i]->m_CABACDataStore    = other.m_CABACDataStore;
+      m_CABACEstimator[i]->m_CABACDataStore = other.m_CABACDataStore;
+    }
+  }
+#endif
 private:
   BinEncoder_Std      m_BinEncoderStd;
   BitEstimator_Std    m_BitEstimatorStd;
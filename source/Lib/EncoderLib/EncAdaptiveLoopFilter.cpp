@@ -1506,7 +1506,7 @@ void EncAdaptiveLoopFilter::ALFProcess( CodingStructure& cs, const double *lambd
             int scaleY = getChannelTypeScaleY(CHANNEL_TYPE_CHROMA, m_chromaFormat);
             const Area blkSrcChroma(0, 0, w >> scaleX, h >> scaleY);
             const Area blkDstChroma( xStart >> scaleX, yStart >> scaleY, w >> scaleX, h >> scaleY );
-            deriveFixedFilterChroma( m_classifier, buf, bufDb, blkDstChroma, blkSrcChroma, cs, -1, MAX_NUM_COMPONENT );
+            deriveFixedFilterChroma( m_classifier, buf, bufDb, blkDstChroma, blkSrcChroma, cs, -1, MAX_NUM_COMPONENT, m_laplacian );
 #endif
 #if JVET_X0071_ALF_BAND_CLASSIFIER
             deriveClassification( m_classifier, buf.get( COMPONENT_Y ), 
@@ -1516,7 +1516,7 @@ void EncAdaptiveLoopFilter::ALFProcess( CodingStructure& cs, const double *lambd
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
               bufDb.get( COMPONENT_Y ), 0,
 #endif
-              blkDst, blkSrc, cs, -1, ALF_NUM_CLASSIFIER );
+              blkDst, blkSrc, cs, -1, ALF_NUM_CLASSIFIER, m_laplacian );
 #else
             deriveClassification( m_classifier, buf.get( COMPONENT_Y ), blkDst, blkSrc 
 #if ALF_IMPROVEMENT
@@ -1540,7 +1540,7 @@ void EncAdaptiveLoopFilter::ALFProcess( CodingStructure& cs, const double *lambd
         int scaleX = getChannelTypeScaleX(CHANNEL_TYPE_CHROMA, m_chromaFormat);
         int scaleY = getChannelTypeScaleY(CHANNEL_TYPE_CHROMA, m_chromaFormat);
         Area blkChroma(xPos >> scaleX, yPos >> scaleY, width >> scaleX, height >> scaleY);
-        deriveFixedFilterChroma( m_classifier, recYuv, recYuvBeforeDb, blkChroma, blkChroma, cs, -1, MAX_NUM_COMPONENT );
+        deriveFixedFilterChroma( m_classifier, recYuv, recYuvBeforeDb, blkChroma, blkChroma, cs, -1, MAX_NUM_COMPONENT, m_laplacian );
 #endif
 #if JVET_X0071_ALF_BAND_CLASSIFIER
         deriveClassification( m_classifier, recLuma, 
@@ -1550,7 +1550,7 @@ void EncAdaptiveLoopFilter::ALFProcess( CodingStructure& cs, const double *lambd
 #if JVET_AE0139_ALF_IMPROVED_FIXFILTER
           m_tempBufBeforeDb.get( COMPONENT_Y ), 0,
 #endif
-          blk, blk , cs, -1, ALF_NUM_CLASSIFIER );
+          blk, blk , cs, -1, ALF_NUM_CLASSIFIER, m_laplacian );
 #else
         deriveClassification( m_classifier, recLuma, blk, blk 
 #if ALF_IMPROVEMENT
@@ -526,6 +526,13 @@ protected:
   bool      m_ciipTimd;
 #endif
   bool      m_Geo;
+#if GPM_CURVE
+  bool      m_geoCurve;
+  int       m_geoCurvePruning;
+#endif
+#if GPM_BLEND
+  bool      m_geoTanhBlend;
+#endif
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_HashME;
@@ -1008,6 +1015,7 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  std::string m_modeStatsFilename;                            ///< filename for the per test mode time and RD win statistics (JSON), empty to disable.
   int       m_ImvMode;
   int       m_Imv4PelFast;
   std::string m_decodeBitstreams[2];                          ///< filename for decode bitstreams.
@@ -1025,6 +1033,16 @@ protected:
   int         m_numSplitThreads;
   bool        m_forceSingleSplitThread;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  int         m_numWppThreads;                                ///< number of threads encoding the CTU rows of a slice
+  bool        m_ensureWppBitEqual;                            ///< reset the CTU row state as in wavefront-parallel encoding also with one thread
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  int         m_numFrameThreads;                              ///< number of pictures of a GOP compressed concurrently
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  int         m_numLoopFilterThreads;                         ///< number of threads deblocking a picture
+#endif
 
   bool        m_alf;                                          ///< Adaptive Loop Filter
 
@@ -1771,6 +1789,16 @@ public:
 #endif
   void      setUseGeo                       ( bool b )       { m_Geo = b; }
   bool      getUseGeo                       ()         const { return m_Geo; }
+#if GPM_CURVE
+  void      setUseGeoCurve                  ( bool b )       { m_geoCurve = b; }
+  bool      getUseGeoCurve                  ()         const { return m_geoCurve; }
+  void      setGeoCurvePruning              ( int i )        { m_geoCurvePruning = i; }
+  int       getGeoCurvePruning              ()         const { return m_geoCurvePruning; }
+#endif
+#if GPM_BLEND
+  void      setUseGeoTanhBlend              ( bool b )       { m_geoTanhBlend = b; }
+  bool      getUseGeoTanhBlend              ()         const { return m_geoTanhBlend; }
+#endif
   void      setAllowDisFracMMVD             ( bool b )       { m_allowDisFracMMVD = b;    }
   bool      getAllowDisFracMMVD             ()         const { return m_allowDisFracMMVD; }
   void      setUseHashME                    ( bool b )       { m_HashME = b; }
@@ -2735,6 +2763,8 @@ public:
   const std::string& getSummaryOutFilename() const                   { return m_summaryOutFilename; }
   void         setSummaryPicFilenameBase(const std::string &s)       { m_summaryPicFilenameBase = s; }
   const std::string& getSummaryPicFilenameBase() const               { return m_summaryPicFilenameBase; }
+  void         setModeStatsFilename(const std::string &s)            { m_modeStatsFilename = s; }
+  const std::string& getModeStatsFilename() const                    { return m_modeStatsFilename; }
 
   void         setSummaryVerboseness(uint32_t v)                         { m_summaryVerboseness = v; }
   uint32_t         getSummaryVerboseness( ) const                        { return m_summaryVerboseness; }
@@ -2765,6 +2795,21 @@ public:
   int          getNumSplitThreads()                            const { return m_numSplitThreads; }
   void         setForceSingleSplitThread( bool b )                   { m_forceSingleSplitThread = b; }
   int          getForceSingleSplitThread()                     const { return m_forceSingleSplitThread; }
+#endif
+#if ENABLE_WPP_PARALLELISM
+  void         setNumWppThreads( int n )                             { m_numWppThreads = n; }
+  int          getNumWppThreads()                              const { return m_numWppThreads; }
+  void         setEnsureWppBitEqual( bool b )                        { m_ensureWppBitEqual = b; }
+  bool         getEnsureWppBitEqual()                          const { return m_ensureWppBitEqual; }
+  bool         getUseWppParallelism()                          const { return m_numWppThreads > 1 || m_ensureWppBitEqual; }
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  void         setNumFrameThreads( int n )                           { m_numFrameThreads = n; }
+  int          getNumFrameThreads()                            const { return m_numFrameThreads; }
+#endif
+#if ENABLE_PARALLEL_DEBLOCKING
+  void         setNumLoopFilterThreads( int n )                      { m_numLoopFilterThreads = n; }
+  int          getNumLoopFilterThreads()                       const { return m_numLoopFilterThreads; }
 #endif
   void         setUseALF( bool b ) { m_alf = b; }
   bool         getUseALF()                                      const { return m_alf; }
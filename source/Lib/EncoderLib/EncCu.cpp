@@ -52,6 +52,7 @@
 #include <stdio.h>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 
 
 //! \ingroup EncoderLib
@@ -60,8 +61,17 @@
 // ====================================================================================================================
 #if JVET_Y0065_GPM_INTRA
 EncCu::EncCu()
+#if JVET_W0097_GPM_MMVD_TM && GPM_CURVE
+  : m_geoCurveNumTested ( 0 )
+  , m_geoCurveNumSkipped( 0 )
+#endif
 #else
-EncCu::EncCu() : m_GeoModeTest
+EncCu::EncCu() :
+#if JVET_W0097_GPM_MMVD_TM && GPM_CURVE
+  m_geoCurveNumTested ( 0 ),
+  m_geoCurveNumSkipped( 0 ),
+#endif
+  m_GeoModeTest
 {
   GeoMotionInfo(0, 1), GeoMotionInfo(1, 0),GeoMotionInfo(0, 2), GeoMotionInfo(1, 2), GeoMotionInfo(2, 0),
   GeoMotionInfo(2, 1), GeoMotionInfo(0, 3),GeoMotionInfo(1, 3), GeoMotionInfo(2, 3), GeoMotionInfo(3, 0),
@@ -98,11 +108,39 @@ EncCu::EncCu() : m_GeoModeTest
   m_includeMoreMMVDCandFirstPass = false;
   m_maxNumGPMDirFirstPass = 64;
   m_numCandPerPar = 5;
+#endif
+  m_modeStats = nullptr;
+#if ENABLE_WPP_PARALLELISM
+  m_wppPicLock              = nullptr;
+  m_reusedUniMVs            = nullptr;
+  m_isReusedUniMVsFilled    = nullptr;
+#if INTER_LIC
+  m_reusedUniMVsLIC         = nullptr;
+  m_isReusedUniMVsFilledLIC = nullptr;
+#endif
 #endif
 }
 
 void EncCu::create( EncCfg* encCfg )
 {
+  m_modeStats = encCfg->getModeStatsFilename().empty() ? nullptr : new EncModeStats;
+#if ENABLE_WPP_PARALLELISM
+#if ENABLE_FRAME_PARALLELISM
+  if( encCfg->getNumWppThreads() > 1 || encCfg->getNumFrameThreads() > 1 )
+#else
+  if( encCfg->getNumWppThreads() > 1 )
+#endif
+  {
+    // each CU encoder stack keeps its own reused uni-prediction MVs, the global tables are used otherwise
+    m_reusedUniMVs            = new ReusedUniMvs      [REUSED_UNI_MVS_SIZE];
+    m_isReusedUniMVsFilled    = new ReusedUniMvsFilled[REUSED_UNI_MVS_SIZE];
+#if INTER_LIC
+    m_reusedUniMVsLIC         = new ReusedUniMvsLIC      [REUSED_UNI_MVS_LIC_SIZE];
+    m_isReusedUniMVsFilledLIC = new ReusedUniMvsFilledLIC[REUSED_UNI_MVS_LIC_SIZE];
+#endif
+  }
+#endif
+
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER
   m_bilateralFilter = new BilateralFilter();;
   m_bilateralFilter->create();
@@ -318,6 +356,30 @@ void EncCu::create( EncCfg* encCfg )
 
 void EncCu::destroy()
 {
+  delete m_modeStats;
+  m_modeStats = nullptr;
+#if ENABLE_WPP_PARALLELISM
+  delete[] m_reusedUniMVs;
+  delete[] m_isReusedUniMVsFilled;
+  m_reusedUniMVs            = nullptr;
+  m_isReusedUniMVsFilled    = nullptr;
+#if INTER_LIC
+  delete[] m_reusedUniMVsLIC;
+  delete[] m_isReusedUniMVsFilledLIC;
+  m_reusedUniMVsLIC         = nullptr;
+  m_isReusedUniMVsFilledLIC = nullptr;
+#endif
+#endif
+
+#if JVET_W0097_GPM_MMVD_TM && GPM_CURVE
+  if (m_geoCurveNumTested > 0 && m_pcEncCfg->getGeoCurvePruning() > 0)
+  {
+    msg(INFO, "GPM curve pruning (level %d): %llu of %llu curve split directions skipped\n", m_pcEncCfg->getGeoCurvePruning(),
+        (unsigned long long) m_geoCurveNumSkipped, (unsigned long long) m_geoCurveNumTested);
+  }
+  m_geoCurveNumTested  = 0;
+  m_geoCurveNumSkipped = 0;
+#endif
   unsigned numWidths  = gp_sizeIdxInfo->numWidths();
   unsigned numHeights = gp_sizeIdxInfo->numHeights();
 
@@ -504,17 +566,25 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
   m_CABACEstimator->setEncCu(this);
   m_ctxCache           = pcEncLib->getCtxCache( PARL_PARAM0( tId ) );
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
+#if ENABLE_FRAME_PARALLELISM
+  m_pcSliceEncoder     = pcEncLib->getSliceEncoder( tId / pcEncLib->getNumWppThreads() );
+#else
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
+#endif
 #if ENABLE_SPLIT_PARALLELISM
   m_pcEncLib           = pcEncLib;
   m_dataId             = tId;
 #endif
-  m_pcLoopFilter       = pcEncLib->getLoopFilter();
+  m_pcLoopFilter       = pcEncLib->getLoopFilter( PARL_PARAM0( tId ) );
 
 #if !JVET_AG0164_AFFINE_GPM
   m_GeoCostList.init(GEO_NUM_PARTITION_MODE, m_pcEncCfg->getMaxNumGeoCand());
 #endif
   m_AFFBestSATDCost = MAX_DOUBLE;
+#if JVET_W0097_GPM_MMVD_TM && GPM_CURVE
+  m_geoCurveNumTested  = 0;
+  m_geoCurveNumSkipped = 0;
+#endif
 
   DecCu::init( m_pcTrQuant, m_pcIntraSearch, m_pcInterSearch );
 
@@ -550,14 +620,31 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
 // Public member functions
 // ====================================================================================================================
 
+#if ENABLE_WPP_PARALLELISM
+/** binds the reused uni-prediction MV tables of the calling thread to the storage of this CU encoder stack
+ */
+void EncCu::selectReusedUniMvs()
+{
+  if( m_reusedUniMVs )
+  {
+    g_reusedUniMVs            = m_reusedUniMVs;
+    g_isReusedUniMVsFilled    = m_isReusedUniMVsFilled;
+#if INTER_LIC
+    g_reusedUniMVsLIC         = m_reusedUniMVsLIC;
+    g_isReusedUniMVsFilledLIC = m_isReusedUniMVsFilledLIC;
+#endif
+  }
+}
+
+#endif
 void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[] )
 {
   m_modeCtrl->initCTUEncoding( *cs.slice );
 #if !INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
   cs.treeType = TREE_D;
 #endif
-  cs.slice->m_mapPltCost[0].clear();
-  cs.slice->m_mapPltCost[1].clear();
+  m_modeCtrl->m_mapPltCost[0].clear();
+  m_modeCtrl->m_mapPltCost[1].clear();
 #if ENABLE_SPLIT_PARALLELISM
   if( m_pcEncCfg->getNumSplitThreads() > 1 )
   {
@@ -596,7 +683,12 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   partitioner.initCtu(area, CH_L, *cs.slice);
   if (m_pcEncCfg->getIBCMode())
   {
+#if ENABLE_WPP_PARALLELISM
+    // every CTU row starts from the same IBC search state when the rows are compressed in parallel
+    if (area.lx() == 0 && (area.ly() == 0 || m_pcEncCfg->getUseWppParallelism()))
+#else
     if (area.lx() == 0 && area.ly() == 0)
+#endif
     {
       m_pcInterSearch->resetIbcSearch();
     }
@@ -624,15 +716,47 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   CodingStructure *tempCS = m_pTempCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
   CodingStructure *bestCS = m_pBestCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
 
+#if ENABLE_WPP_PARALLELISM
+  // the picture level structure is shared by the CTU rows and only modified under the picture lock, the history tables
+  // of the row are kept in m_rowHistory; the CTU is compressed without the lock, its neighbours in finished CTUs are
+  // looked up through unit vectors reserved for the whole picture and CU chains that end with their CTU
+  const bool useRowHistory = m_pcEncCfg->getUseWppParallelism();
+  std::unique_lock<std::mutex> picLock;
+  if( m_wppPicLock )
+  {
+    picLock = std::unique_lock<std::mutex>( *m_wppPicLock );
+  }
+  if( useRowHistory )
+  {
+    m_rowHistory.load( cs );
+  }
+#endif
   cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
   cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
   tempCS->currQP[CH_L] = bestCS->currQP[CH_L] =
   tempCS->baseQP       = bestCS->baseQP       = currQP[CH_L];
   tempCS->prevQP[CH_L] = bestCS->prevQP[CH_L] = prevQP[CH_L];
+#if ENABLE_WPP_PARALLELISM
+  if( picLock )
+  {
+    picLock.unlock();
+  }
+#endif
 
   xCompressCU(tempCS, bestCS, partitioner);
-  cs.slice->m_mapPltCost[0].clear();
-  cs.slice->m_mapPltCost[1].clear();
+  m_modeCtrl->m_mapPltCost[0].clear();
+  m_modeCtrl->m_mapPltCost[1].clear();
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppPicLock )
+  {
+    picLock.lock();
+  }
+  if( useRowHistory )
+  {
+    m_rowHistory.load( cs );
+    cs.breakCUChain();
+  }
+#endif
   // all signals were already copied during compression if the CTU was split - at this point only the structures are copied to the top level CS
   const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
   cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType), copyUnsplitCTUSignals,
@@ -649,13 +773,43 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
     tempCS->currQP[CH_C] = bestCS->currQP[CH_C] =
     tempCS->baseQP       = bestCS->baseQP       = currQP[CH_C];
     tempCS->prevQP[CH_C] = bestCS->prevQP[CH_C] = prevQP[CH_C];
+#if ENABLE_WPP_PARALLELISM
+    if( useRowHistory )
+    {
+      m_rowHistory.store( cs );
+    }
+    if( picLock )
+    {
+      picLock.unlock();
+    }
+#endif
 
     xCompressCU(tempCS, bestCS, partitioner);
 
+#if ENABLE_WPP_PARALLELISM
+    if( m_wppPicLock )
+    {
+      picLock.lock();
+    }
+    if( useRowHistory )
+    {
+      m_rowHistory.load( cs );
+    }
+#endif
     const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
     cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType),
                        copyUnsplitCTUSignals, false, false, copyUnsplitCTUSignals, true);
   }
+#if ENABLE_WPP_PARALLELISM
+  if( useRowHistory )
+  {
+    m_rowHistory.store( cs );
+  }
+  if( picLock )
+  {
+    picLock.unlock();
+  }
+#endif
 
   if (m_pcEncCfg->getUseRateCtrl())
   {
@@ -1196,6 +1350,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     m_bestBcwCost[0] = m_bestBcwCost[1] = std::numeric_limits<double>::max();
     m_bestBcwIdx[0] = m_bestBcwIdx[1] = -1;
   }
+  EncTestModeType bestModeType = ETM_INVALID; // test mode which produced bestCS, only tracked for the mode statistics
   do
   {
     for (int i = compBegin; i < (compBegin + numComp); i++)
@@ -1206,6 +1361,8 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     }
     EncTestMode currTestMode = m_modeCtrl->currTestMode();
     currTestMode.maxCostAllowed = maxCostAllowed;
+    const double bestCostBeforeMode = bestCS->cost;
+    const std::chrono::steady_clock::time_point modeStartTime = m_modeStats ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
 #if INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
     if (pps.getUseDQP() && CS::isDualITree(*tempCS) && isChroma(partitioner.chType))
 #else
@@ -1606,8 +1763,24 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     {
       THROW( "Don't know how to handle mode: type = " << currTestMode.type << ", options = " << currTestMode.opts );
     }
+
+    if( m_modeStats )
+    {
+      // the time of the split modes includes the sub-CUs
+      const auto modeTime = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - modeStartTime );
+      m_modeStats->addCall( currTestMode.type, partitioner.currArea().lwidth(), partitioner.currArea().lheight(), slice.getTLayer(), modeTime.count() );
+      if( bestCS->cost < bestCostBeforeMode )
+      {
+        bestModeType = currTestMode.type;
+      }
+    }
   } while( m_modeCtrl->nextMode( *tempCS, partitioner ) );
 
+  if( m_modeStats && bestModeType != ETM_INVALID )
+  {
+    m_modeStats->addWin( bestModeType, partitioner.currArea().lwidth(), partitioner.currArea().lheight(), slice.getTLayer() );
+  }
+
 
   //////////////////////////////////////////////////////////////////////////
   // Finishing CU
@@ -3509,7 +3682,7 @@ void EncCu::xCheckPLT(CodingStructure *&tempCS, CodingStructure *&bestCS, Partit
   tempCS->useDbCost = m_pcEncCfg->getUseEncDbOpt();
 
   const Area currCuArea = cu.block(getFirstComponentOfChannel(partitioner.chType));
-  cu.slice->m_mapPltCost[isChroma(partitioner.chType)][currCuArea.pos()][currCuArea.size()] = tempCS->cost;
+  m_modeCtrl->m_mapPltCost[isChroma(partitioner.chType)][currCuArea.pos()][currCuArea.size()] = tempCS->cost;
 #if WCG_EXT
   DTRACE_MODE_COST(*tempCS, m_pcRdCost->getLambda(true));
 #else
@@ -8386,6 +8559,53 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
 }
 
 #if JVET_W0097_GPM_MMVD_TM
+#if GPM_CURVE
+void EncCu::xPruneGeoCurveSplitDirs(const int maskVariant, const int wIdx, const int hIdx, const double (&splitDirCost)[GEO_NUM_PARTITION_MODE], bool (&isPruned)[GEO_NUM_PARTITION_MODE])
+{
+  std::fill_n(isPruned, GEO_NUM_PARTITION_MODE, false);
+
+  double bestStraightCost = MAX_DOUBLE;
+  double bestStraightAngleCost[GEO_NUM_ANGLES];
+  std::fill_n(bestStraightAngleCost, GEO_NUM_ANGLES, MAX_DOUBLE);
+  int    numCurve = 0;
+  for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
+  {
+    if (g_geoMaskView[maskVariant][splitDir][hIdx][wIdx].isCurve)
+    {
+      numCurve++;
+      continue;
+    }
+    const int angle = g_geoParams[splitDir][0];
+    bestStraightCost             = std::min(bestStraightCost, splitDirCost[splitDir]);
+    bestStraightAngleCost[angle] = std::min(bestStraightAngleCost[angle], splitDirCost[splitDir]);
+  }
+  m_geoCurveNumTested += numCurve;
+
+  const int level = m_pcEncCfg->getGeoCurvePruning();
+  if (level == 0 || numCurve == 0)
+  {
+    return;
+  }
+
+  // both levels drop curves well above the best straight split, level 2 also requires them to beat the straight
+  // splits of their own angle
+  const double bound = bestStraightCost * 1.25;
+  for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
+  {
+    if (!g_geoMaskView[maskVariant][splitDir][hIdx][wIdx].isCurve)
+    {
+      continue;
+    }
+    if (splitDirCost[splitDir] > bound
+      || (level >= 2 && splitDirCost[splitDir] >= bestStraightAngleCost[g_geoParams[splitDir][0]]))
+    {
+      isPruned[splitDir] = true;
+      m_geoCurveNumSkipped++;
+    }
+  }
+}
+
+#endif
 void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode, bool isSecondPass)
 {
   int numSATDCands = (m_fastGpmMmvdSearch && isSecondPass) ? 60 : 70;
@@ -9079,7 +9299,7 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
   int hIdx = floorLog2(cu.lheight()) - GEO_MIN_CU_LOG2;
   Distortion sadSmall = 0, sadLarge = 0;
   int maskStride = 0, maskStride2 = 0, stepX = 1;
-  Pel* sadMask;
+  const Pel* sadMask;
   static_vector<int, GEO_NUM_PARTITION_MODE> selGeoModeList;
   static_vector<double, GEO_NUM_PARTITION_MODE> selGeoModeRDList;
   static_vector<int, 5> mergeCandList0[GEO_NUM_PARTITION_MODE];
@@ -9094,49 +9314,28 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
   static_vector<double, GEO_MAX_NUM_INTRA_CANDS> intraSadCostList0[GEO_NUM_PARTITION_MODE];
   static_vector<double, GEO_MAX_NUM_INTRA_CANDS> intraSadCostList1[GEO_NUM_PARTITION_MODE];
 #endif
-
-  for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
-  {
-    int16_t angle = g_geoParams[splitDir][0];
-    if (g_angle2mirror[angle] == 2)
-    {
-      stepX = 1;
-      maskStride = -GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-      if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-      {
-        sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-      }
-#endif
-    }
-    else if (g_angle2mirror[angle] == 1)
-    {
-      stepX = -1;
-      maskStride2 = cu.lwidth();
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-#if GPM_CURVE
-      if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-      {
-        sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-      }
+#if JVET_AG0164_AFFINE_GPM
+  Distortion sadPart0[GEO_MAX_ALL_INTER_UNI_CANDS][GEO_NUM_PARTITION_MODE];
+#else
+  Distortion sadPart0[GEO_MAX_NUM_UNI_CANDS][GEO_NUM_PARTITION_MODE];
 #endif
-    }
-    else
+  for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
+  {
+    if (mrgDuplicated[mergeCand])
     {
-      stepX = 1;
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-      if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-      {
-        sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-      }
-#endif
+      continue;
     }
+    m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
+    m_pcRdCost->getGeoSADAllSplits(distParam, sps.getGeoMaskVariant(), sadPart0[mergeCand]);
+  }
+
+  for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
+  {
+    const GeoMaskView& maskView = g_geoMaskView[sps.getGeoMaskVariant()][splitDir][hIdx][wIdx];
+    stepX       = maskView.stepX;
+    maskStride  = maskView.stride;
+    maskStride2 = -maskView.stepX * (int)cu.lwidth();
+    sadMask     = maskView.sadMask;
 
 #if JVET_AG0164_AFFINE_GPM
     for (uint8_t mergeCand = 0; mergeCand < GEO_MAX_ALL_INTER_UNI_CANDS + GEO_MAX_NUM_INTRA_CANDS; mergeCand++)
@@ -9172,8 +9371,7 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
       {
 #endif
 #endif
-      m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, sadMask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-      sadLarge = distParam.distFunc(distParam);
+      sadLarge = sadPart0[mergeCand][splitDir];
 
 #if JVET_AG0164_AFFINE_GPM
       tempCost = (double)sadLarge + (isAffine? geoAffMergeIdxCost[mergeIdx]: geoMergeIdxCost[mergeIdx]) + geoMMVDFlagCost[0];
@@ -9246,6 +9444,25 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
       }
 #endif
     }
+  }
+
+#if GPM_CURVE
+  double splitDirCost[GEO_NUM_PARTITION_MODE];
+  bool   isCurvePruned[GEO_NUM_PARTITION_MODE];
+  for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
+  {
+    splitDirCost[splitDir] = sadCostList0[splitDir][0] + sadCostList1[splitDir][0];
+  }
+  xPruneGeoCurveSplitDirs(sps.getGeoMaskVariant(), wIdx, hIdx, splitDirCost, isCurvePruned);
+#endif
+  for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
+  {
+#if GPM_CURVE
+    if (isCurvePruned[splitDir])
+    {
+      continue;
+    }
+#endif
     updateCandList(splitDir, (sadCostList0[splitDir][0] + sadCostList1[splitDir][0]), selGeoModeList, selGeoModeRDList, GEO_NUM_PARTITION_MODE);
   }
 
@@ -9272,6 +9489,12 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
 
   for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
   {
+#if GPM_CURVE
+    if (isCurvePruned[splitDir])
+    {
+      continue;
+    }
+#endif
 #if JVET_Y0065_GPM_INTRA
     int numCandMerge0 = min(m_numCandPerPar, (int)mergeCandList0[splitDir].size());
     int numCandIntra0 = (int)intraCandList0[splitDir].size();
@@ -10547,46 +10770,11 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
       {
         continue;
       }
-      int16_t angle = g_geoParams[splitDir][0];
-      if (g_angle2mirror[angle] == 2)
-      {
-        stepX = 1;
-        maskStride = -GEO_WEIGHT_MASK_SIZE;
-        maskStride2 = -(int)cu.lwidth();
-        sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-        if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-        {
-          sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-        }
-#endif
-      }
-      else if (g_angle2mirror[angle] == 1)
-      {
-        stepX = -1;
-        maskStride2 = cu.lwidth();
-        maskStride = GEO_WEIGHT_MASK_SIZE;
-        sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-#if GPM_CURVE
-        if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-        {
-          sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-        }
-#endif
-      }
-      else
-      {
-        stepX = 1;
-        maskStride = GEO_WEIGHT_MASK_SIZE;
-        maskStride2 = -(int)cu.lwidth();
-        sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-        if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-        {
-          sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-        }
-#endif
-      }
+      const GeoMaskView& maskView = g_geoMaskView[sps.getGeoMaskVariant()][splitDir][hIdx][wIdx];
+      stepX       = maskView.stepX;
+      maskStride  = maskView.stride;
+      maskStride2 = -maskView.stepX * (int)cu.lwidth();
+      sadMask     = maskView.sadMask;
 #if JVET_AG0164_AFFINE_GPM
       for (uint8_t mergeCand = 0; mergeCand < numRegularGpmMergeCand; mergeCand++)
 #else
@@ -10864,46 +11052,11 @@ void EncCu::xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStruct
 
       for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
       {
-        int16_t angle = g_geoParams[splitDir][0];
-        if (g_angle2mirror[angle] == 2)
-        {
-          stepX = 1;
-          maskStride = -GEO_WEIGHT_MASK_SIZE;
-          maskStride2 = -(int)cu.lwidth();
-          sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-          if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-          {
-            sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-          }
-#endif
-        }
-        else if (g_angle2mirror[angle] == 1)
-        {
-          stepX = -1;
-          maskStride2 = cu.lwidth();
-          maskStride = GEO_WEIGHT_MASK_SIZE;
-          sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-#if GPM_CURVE
-          if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-          {
-            sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-          }
-#endif
-        }
-        else
-        {
-          stepX = 1;
-          maskStride = GEO_WEIGHT_MASK_SIZE;
-          maskStride2 = -(int)cu.lwidth();
-          sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-          if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-          {
-            sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-          }
-#endif
-        }
+        const GeoMaskView& maskView = g_geoMaskView[sps.getGeoMaskVariant()][splitDir][hIdx][wIdx];
+        stepX       = maskView.stepX;
+        maskStride  = maskView.stride;
+        maskStride2 = -maskView.stepX * (int)cu.lwidth();
+        sadMask     = maskView.sadMask;
         for (uint8_t mergeCand = 0; mergeCand < maxNumTmMrgCand; mergeCand++)
         {
           if (mrgDuplicated[mergeCand])
@@ -12927,40 +13080,20 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
     return;
   }
 
-  int wIdx = floorLog2(cu.lwidth()) - GEO_MIN_CU_LOG2;
-  int hIdx = floorLog2(cu.lheight()) - GEO_MIN_CU_LOG2;
+  Distortion sadPart0[GEO_MAX_NUM_UNI_CANDS][GEO_NUM_PARTITION_MODE];
+  for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
+  {
+    m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
+    m_pcRdCost->getGeoSADAllSplits(distParam, sps.getGeoMaskVariant(), sadPart0[mergeCand]);
+  }
   for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
   {
-    int maskStride = 0, maskStride2 = 0;
-    int stepX = 1;
-    Pel* sadMask;
-    int16_t angle = g_geoParams[splitDir][0];
-    if (g_angle2mirror[angle] == 2)
-    {
-      maskStride = -GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-    else if (g_angle2mirror[angle] == 1)
-    {
-      stepX = -1;
-      maskStride2 = cu.lwidth();
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-    }
-    else
-    {
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
     Distortion sadSmall = 0, sadLarge = 0;
     for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
     {
       int bitsCand = mergeCand + 1;
 
-      m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, sadMask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-      sadLarge = distParam.distFunc(distParam);
+      sadLarge = sadPart0[mergeCand][splitDir];
       m_GeoCostList.insert(splitDir, 0, mergeCand, (double)sadLarge + (double)bitsCand * sqrtLambdaForFirstPass);
       sadSmall = sadWholeBlk[mergeCand] - sadLarge;
       m_GeoCostList.insert(splitDir, 1, mergeCand, (double)sadSmall + (double)bitsCand * sqrtLambdaForFirstPass);
@@ -15036,27 +15169,12 @@ void EncCu::xCheckSATDCostGeoMerge(CodingStructure *&tempCS, CodingUnit &cu, Pre
     {
       int maskStride = 0, maskStride2 = 0;
       int stepX = 1;
-      Pel* sadMask;
-      int16_t angle = g_geoParams[splitDir][0];
-      if (g_angle2mirror[angle] == 2)
-      {
-        maskStride = -GEO_WEIGHT_MASK_SIZE;
-        maskStride2 = -(int)cu.lwidth();
-        sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-      }
-      else if (g_angle2mirror[angle] == 1)
-      {
-        stepX = -1;
-        maskStride2 = cu.lwidth();
-        maskStride = GEO_WEIGHT_MASK_SIZE;
-        sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-      }
-      else
-      {
-        maskStride = GEO_WEIGHT_MASK_SIZE;
-        maskStride2 = -(int)cu.lwidth();
-        sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-      }
+      const Pel* sadMask;
+      const GeoMaskView& maskView = g_geoMaskView[cu.cs->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+      stepX       = maskView.stepX;
+      maskStride  = maskView.stride;
+      maskStride2 = -maskView.stepX * (int)cu.lwidth();
+      sadMask     = maskView.sadMask;
       Distortion sadSmall = 0, sadLarge = 0;
       for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
       {
@@ -18077,45 +18195,12 @@ void EncCu::xCheckRDCostIBCModeMerge2Nx2N(CodingStructure *&tempCS, CodingStruct
           }
           int maskStride = 0, maskStride2 = 0;
           int stepX = 1;
-          Pel* sadMask;
-          int16_t angle = g_geoParams[splitDir][0];
-          if (g_angle2mirror[angle] == 2)
-          {
-            maskStride = -GEO_WEIGHT_MASK_SIZE;
-            maskStride2 = -(int)cu.lwidth();
-            sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-            if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-            {
-              sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-            }
-#endif
-          }
-          else if (g_angle2mirror[angle] == 1)
-          {
-            stepX = -1;
-            maskStride2 = cu.lwidth();
-            maskStride = GEO_WEIGHT_MASK_SIZE;
-            sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-#if GPM_CURVE
-            if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-            {
-              sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-            }
-#endif
-          }
-          else
-          {
-            maskStride = GEO_WEIGHT_MASK_SIZE;
-            maskStride2 = -(int)cu.lwidth();
-            sadMask = &g_geoEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-#if GPM_CURVE
-            if(g_geoParams[splitDir][1] == 0 && wIdx == hIdx && wIdx >= GEO_CURVE_MIN_CU_IDX && CU::isGeoCURVEAvailable(splitDir,cu.lwidth()))
-            {
-              sadMask = &g_geoCurveEncSadMask[g_angle2mask[g_geoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-            }
-#endif
-          }
+          const Pel* sadMask;
+          const GeoMaskView& maskView = g_geoMaskView[tempCS->sps->getGeoMaskVariant()][splitDir][hIdx][wIdx];
+          stepX       = maskView.stepX;
+          maskStride  = maskView.stride;
+          maskStride2 = -maskView.stepX * (int)cu.lwidth();
+          sadMask     = maskView.sadMask;
           Distortion sadSmall = 0, sadLarge = 0;
           double tempCost = 0;
 #if JVET_AA0070_RRIBC
@@ -58,6 +58,9 @@
 #include "InterSearch.h"
 #include "RateCtrl.h"
 #include "EncModeCtrl.h"
+#include "EncModeStats.h"
+
+#include <mutex>
 //! \ingroup EncoderLib
 //! \{
 
@@ -298,7 +301,18 @@ private:
   CABACWriter*          m_CABACEstimator;
   RateCtrl*             m_pcRateCtrl;
   IbcHashMap            m_ibcHashMap;
+#if ENABLE_WPP_PARALLELISM
+  std::mutex*           m_wppPicLock;                                 ///< guards the picture level structure while CTU rows are compressed in parallel
+  CtuRowHistory         m_rowHistory;
+  ReusedUniMvs*         m_reusedUniMVs;
+  ReusedUniMvsFilled*   m_isReusedUniMVsFilled;
+#if INTER_LIC
+  ReusedUniMvsLIC*      m_reusedUniMVsLIC;
+  ReusedUniMvsFilledLIC* m_isReusedUniMVsFilledLIC;
+#endif
+#endif
   EncModeCtrl          *m_modeCtrl;
+  EncModeStats         *m_modeStats;                                  ///< per test mode time and RD wins, nullptr unless ModeStatsFilename is set
 
 #if JVET_Y0065_GPM_INTRA
   PelStorage            m_acMergeBuffer[GEO_NUM_RDO_BUFFER];
@@ -353,6 +367,10 @@ private:
   bool                  m_includeMoreMMVDCandFirstPass;
   int                   m_maxNumGPMDirFirstPass;
   int                   m_numCandPerPar;
+#if GPM_CURVE
+  uint64_t              m_geoCurveNumTested;                          ///< curve split directions seen by the GPM first pass
+  uint64_t              m_geoCurveNumSkipped;                         ///< curve split directions removed by GeoCurvePruning
+#endif
 #if TM_MRG
   PelStorage            m_acGeoMergeTmpBuffer[GEO_TM_MAX_NUM_CANDS];
   PelStorage            m_acGeoSADTmpBuffer[GEO_TM_MAX_NUM_CANDS];
@@ -474,6 +492,7 @@ public:
   int   updateCtuDataISlice ( const CPelBuf buf );
 
   EncModeCtrl* getModeCtrl  () { return m_modeCtrl; }
+  const EncModeStats* getModeStats() const { return m_modeStats; }
 
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER
   BilateralFilter *m_bilateralFilter;
@@ -485,6 +504,11 @@ public:
   double getAFFBestSATDCost()              { return m_AFFBestSATDCost; }
   IbcHashMap& getIbcHashMap()              { return m_ibcHashMap;        }
   EncCfg*     getEncCfg()            const { return m_pcEncCfg;          }
+#if ENABLE_WPP_PARALLELISM
+  void           setWppPicLock( std::mutex* picLock ) { m_wppPicLock = picLock; }
+  CtuRowHistory& getRowHistory()                      { return m_rowHistory;    }
+  void           selectReusedUniMvs();
+#endif
 
   EncCu();
   ~EncCu();
@@ -690,6 +714,9 @@ protected:
 #endif
 #if JVET_W0097_GPM_MMVD_TM
   void xCheckRDCostMergeGeoComb2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode, bool isSecondPass = false);
+#if GPM_CURVE
+  void xPruneGeoCurveSplitDirs(const int maskVariant, const int wIdx, const int hIdx, const double (&splitDirCost)[GEO_NUM_PARTITION_MODE], bool (&isPruned)[GEO_NUM_PARTITION_MODE]);
+#endif
 #else
   void xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode);
 #endif
@@ -51,6 +51,9 @@
 #include <deque>
 #include <chrono>
 #include <cinttypes>
+#if ENABLE_FRAME_PARALLELISM
+#include <thread>
+#endif
 
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_codingstruct.h"
@@ -93,6 +96,10 @@ EncGOP::EncGOP()
 
   m_pcCfg               = NULL;
   m_pcSliceEncoder      = NULL;
+  m_pcCABACEncoder      = NULL;
+  m_pcCtxCache          = NULL;
+  m_pcRdCost            = NULL;
+  m_pcInterSearch       = NULL;
   m_pcListPic           = NULL;
   m_HLSWriter           = NULL;
   m_bSeqFirst           = true;
@@ -216,6 +223,10 @@ void EncGOP::init ( EncLib* pcEncLib )
   m_pcCfg                = pcEncLib;
   m_seiEncoder.init(m_pcCfg, pcEncLib, this);
   m_pcSliceEncoder       = pcEncLib->getSliceEncoder();
+  m_pcCABACEncoder       = pcEncLib->getCABACEncoder();
+  m_pcCtxCache           = pcEncLib->getCtxCache();
+  m_pcRdCost             = pcEncLib->getRdCost();
+  m_pcInterSearch        = pcEncLib->getInterSearch();
   m_pcListPic            = pcEncLib->getListPic();
   m_HLSWriter            = pcEncLib->getHLSWriter();
   m_pcLoopFilter         = pcEncLib->getLoopFilter();
@@ -250,7 +261,16 @@ void EncGOP::init ( EncLib* pcEncLib )
   }
   pcEncLib->getALF()->setAlfWSSD(alfWSSD);
 #endif
+#if ENABLE_FRAME_PARALLELISM
+  // with frame threads the LMCS model of the picture being set up is kept in the additional reshaper
+  m_pcReshaper = pcEncLib->getReshaper( pcEncLib->getNumFrameThreads() > 1 ? pcEncLib->getNumCuEncStacks() : 0 );
+  m_firstFrameJobPicId = 0;
+  m_nextFrameJob       = 0;
+  m_frameSetupTurn     = 0;
+  m_frameWriteTurn     = 0;
+#else
   m_pcReshaper = pcEncLib->getReshaper();
+#endif
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
   const bool calculateHdrMetrics = m_pcEncLib->getCalcluateHdrMetrics();
@@ -2369,6 +2389,12 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
     }
 
     pcSlice->applyReferencePictureListBasedMarking( rcListPic, pcSlice->getRPL0(), pcSlice->getRPL1(), pcSlice->getPic()->layerId, *(pcSlice->getPPS()));
+#if ENABLE_FRAME_PARALLELISM
+    if( isFrameParallel() )
+    {
+      xWaitForFrameReferences( picIdInGOP, pcSlice );
+    }
+#endif
 
     if(pcSlice->getTLayer() > 0
       && !(pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL     // Check if not a leading picture
@@ -3325,6 +3351,16 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
         pcPic->fillSliceLossyLosslessArray(sliceLosslessArray, mixedLossyLossless);
       }
 
+#if ENABLE_FRAME_PARALLELISM
+      if( isFrameParallel() && pcPic->cs->sps->getUseLmcs() )
+      {
+        // the model of the next pictures is derived in the reshaper of the EncLib while this picture is compressed
+        FrameJob& job = xGetFrameJob( pocCurr );
+        job.reshaper  = m_pcEncLib->getReshaper( job.firstCuEncStack );
+        job.reshaper->copyState( *m_pcReshaper );
+        m_pcReshaper  = job.reshaper;
+      }
+#endif
       for(uint32_t sliceIdx = 0; sliceIdx < pcPic->cs->pps->getNumSlicesInPic(); sliceIdx++ )
       {
         pcSlice->setSliceMap( pcPic->cs->pps->getSliceMap( sliceIdx ) );
@@ -3389,16 +3425,20 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
 #endif
         {
           clipMv = clipMvInSubpic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(true);
+          m_pcInterSearch->setClipMvInSubPic(true);
         }
         else
         {
           clipMv = clipMvInPic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(false);
+          m_pcInterSearch->setClipMvInSubPic(false);
         }
 
         m_pcSliceEncoder->precompressSlice( pcPic );
         m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+#if ENABLE_FRAME_PARALLELISM
+        // the picture header may have been replaced by a copy owned by the picture
+        picHeader = pcPic->cs->picHeader;
+#endif
 
         if(sliceIdx < pcPic->cs->pps->getNumSlicesInPic() - 1)
         {
@@ -3417,6 +3457,12 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
       }
 
       duData.clear();
+#if ENABLE_FRAME_PARALLELISM
+      if( isFrameParallel() )
+      {
+        xWaitForFrameWriteTurn( pcPic );
+      }
+#endif
 
 #if DUMP_BEFORE_INLOOP
       if( m_pcEncLib->getDumpBeforeInloop() )
@@ -3674,13 +3720,13 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
 #endif
       {
         bool sliceEnabled[MAX_NUM_COMPONENT];
-        m_pcSAO->initCABACEstimator( m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice );
+        m_pcSAO->initCABACEstimator( m_pcCABACEncoder, m_pcCtxCache, pcSlice );
 #if JVET_V0094_BILATERAL_FILTER
-        BIFCabacEstImp est(m_pcEncLib->getCABACEncoder()->getCABACEstimator(cs.slice->getSPS()));
+        BIFCabacEstImp est(m_pcCABACEncoder->getCABACEstimator(cs.slice->getSPS()));
 #endif      
         m_pcSAO->SAOProcess( cs, sliceEnabled, pcSlice->getLambdas(),
 #if ENABLE_QPA
-                             (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost (PARL_PARAM0 (0))->getChromaWeight() : 0.0),
+                             (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcRdCost->getChromaWeight() : 0.0),
 #endif
                              m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoCtuBoundary(), m_pcCfg->getSaoGreedyMergeEnc()
 #if JVET_V0094_BILATERAL_FILTER
@@ -3717,7 +3763,7 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
 #if JVET_W0066_CCSAO
       if ( pcSlice->getSPS()->getCCSAOEnabledFlag() )
       {
-        m_pcSAO->initCABACEstimator( m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice );
+        m_pcSAO->initCABACEstimator( m_pcCABACEncoder, m_pcCtxCache, pcSlice );
         m_pcSAO->CCSAOProcess( cs, pcSlice->getLambdas(), m_pcCfg->getIntraPeriod() );
 
         //assign CCSAO slice header
@@ -3763,10 +3809,10 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
         {
           pcPic->slices[s]->setTileGroupAlfEnabledFlag(COMPONENT_Y, false);
         }
-        m_pcALF->initCABACEstimator(m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice, m_pcEncLib->getApsMap());
+        m_pcALF->initCABACEstimator(m_pcCABACEncoder, m_pcCtxCache, pcSlice, m_pcEncLib->getApsMap());
         m_pcALF->ALFProcess(cs, pcSlice->getLambdas()
 #if ENABLE_QPA
-          , (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost(PARL_PARAM0(0))->getChromaWeight() : 0.0)
+          , (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcRdCost->getChromaWeight() : 0.0)
 #endif
           , pcPic, uiNumSliceSegments
 #if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
@@ -4602,10 +4648,16 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyTemporaryCsData();
 #if JVET_AA0096_MC_BOUNDARY_PADDING
-    m_pcFrameMcPadPrediction->init(m_pcEncLib->getRdCost(), pcSlice->getSPS()->getChromaFormatIdc(),
+    m_pcFrameMcPadPrediction->init(m_pcRdCost, pcSlice->getSPS()->getChromaFormatIdc(),
                                    pcSlice->getSPS()->getMaxCUHeight(), NULL, pcPic->getPicWidthInLumaSamples());
     m_pcFrameMcPadPrediction->mcFramePad(pcPic, *(pcPic->slices[0]));
     m_pcFrameMcPadPrediction->destroy();
+#endif
+#if ENABLE_FRAME_PARALLELISM
+    if( isFrameParallel() )
+    {
+      xFinishFrameJob( pcPic );
+    }
 #endif
   } // iGOPid-loop
 
@@ -4614,6 +4666,348 @@ void EncGOP::compressGOP(int iPOCLast, int iNumPicRcvd, PicList &rcListPic, std:
   CHECK( m_iNumPicCoded > 1, "Unspecified error" );
 }
 
+#if ENABLE_FRAME_PARALLELISM
+namespace
+{
+  /// thrown in the frame threads waiting for other pictures after a frame thread has failed
+  struct FrameJobAborted {};
+}
+
+void EncGOP::compressGOPFrameParallel( int iPOCLast, int iNumPicRcvd, PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRec,
+                                       const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
+#if MSSIM_UNIFORM_METRICS_LOG
+                                       const bool printMSSSIM,
+#endif
+                                       const int firstPicIdInGOP, const int numPicIds, const int numFrameThreads )
+{
+  const int numThreads    = std::min( numFrameThreads, numPicIds );
+  const int numWppThreads = m_pcEncLib->getNumWppThreads();
+
+  m_frameJobs.assign( numPicIds, FrameJob() );
+  m_frameThreadJobs.assign( numThreads, nullptr );
+  m_firstFrameJobPicId = firstPicIdInGOP;
+  m_nextFrameJob       = 0;
+  m_frameSetupTurn     = 0;
+  m_frameWriteTurn     = 0;
+  m_frameFailure       = nullptr;
+
+  auto runFrameThread = [&]( const int fId )
+  {
+    std::unique_lock<std::mutex> lock( m_frameMutex );
+    m_pcEncLib->getCuEncoder( fId * numWppThreads )->selectReusedUniMvs();
+
+    while( !m_frameFailure && m_nextFrameJob < numPicIds )
+    {
+      const int jobId          = m_nextFrameJob++;
+      FrameJob& job            = m_frameJobs[jobId];
+      job.lock                 = &lock;
+      job.firstCuEncStack      = fId * numWppThreads;
+      job.sliceEncoder         = m_pcEncLib->getSliceEncoder( fId );
+      job.reshaper             = m_pcEncLib->getReshaper( m_pcEncLib->getNumCuEncStacks() );
+      m_frameThreadJobs[fId]   = &job;
+      try
+      {
+        xWaitForFrameJobs( job, [&]() { return m_frameSetupTurn == jobId; } );
+        compressGOP( iPOCLast, iNumPicRcvd, rcListPic, rcListPicYuvRec, false, false, snr_conversion, printFrameMSE,
+#if MSSIM_UNIFORM_METRICS_LOG
+                     printMSSSIM,
+#endif
+                     false, firstPicIdInGOP + jobId );
+
+        // pictures behind the last frame to be encoded are skipped
+        if( !job.setupDone )
+        {
+          job.setupDone = true;
+          m_frameSetupTurn++;
+          m_frameCond.notify_all();
+        }
+        if( !job.finished )
+        {
+          xWaitForFrameJobs( job, [&]() { return m_frameWriteTurn == jobId; } );
+          job.finished = true;
+          m_frameWriteTurn++;
+          m_frameCond.notify_all();
+        }
+      }
+      catch( const FrameJobAborted& )
+      {
+      }
+      catch( ... )
+      {
+        if( !lock.owns_lock() )
+        {
+          lock.lock();
+        }
+        if( !m_frameFailure )
+        {
+          m_frameFailure = std::current_exception();
+        }
+        m_frameCond.notify_all();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for( int fId = 1; fId < numThreads; fId++ )
+  {
+    threads.emplace_back( runFrameThread, fId );
+  }
+  runFrameThread( 0 );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  m_frameJobs.clear();
+  m_frameThreadJobs.clear();
+  m_pcSliceEncoder = m_pcEncLib->getSliceEncoder();
+  m_pcLoopFilter   = m_pcEncLib->getLoopFilter();
+  m_pcReshaper     = m_pcEncLib->getReshaper( m_pcEncLib->getNumCuEncStacks() );
+  m_pcCABACEncoder = m_pcEncLib->getCABACEncoder();
+  m_pcCtxCache     = m_pcEncLib->getCtxCache();
+  m_pcRdCost       = m_pcEncLib->getRdCost();
+  m_pcInterSearch  = m_pcEncLib->getInterSearch();
+
+  if( m_frameFailure )
+  {
+    std::rethrow_exception( m_frameFailure );
+  }
+}
+
+void EncGOP::startFrameSlice( const int frameThreadId, Slice* slice )
+{
+  FrameJob& job   = *m_frameThreadJobs[frameThreadId];
+  const int jobId = int( &job - &m_frameJobs[0] );
+  Picture*  pic   = slice->getPic();
+
+  if( !job.setupDone )
+  {
+    // the CABAC states and statistics loaded by the slice have to be stored by the preceding pictures in coding order
+    const SliceType sliceType = slice->getSliceType();
+    CABACDataStore* store     = m_pcSliceEncoder->getCABACDataStore();
+
+    xWaitForFrameJobs( job, [&]()
+    {
+      bool waitAll = slice->getPendingRasInit();
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+      if( slice->getSPS()->getTempCabacInitMode() && !slice->isIntra() )
+      {
+        // states still to be stored may evict the state of this slice from the buffer
+        std::vector<std::pair<int, int>> newKeys;
+        for( int k = 0; k < jobId; k++ )
+        {
+          for( const auto& key: m_frameJobs[k].ctxStoreKeys )
+          {
+            if( !m_frameJobs[k].finished && key.first == sliceType && !store->hasEntry( sliceType, key.second.first, key.second.second )
+              && std::find( newKeys.begin(), newKeys.end(), key.second ) == newKeys.end() )
+            {
+              newKeys.push_back( key.second );
+            }
+          }
+        }
+        waitAll |= store->getNumEntries( sliceType ) + (int)newKeys.size() > TEMP_CABAC_BUFFER_SIZE;
+      }
+      if( slice->getPPS()->getCabacInitPresentFlag() && !slice->isIntra() )
+      {
+        // the initialization table of the previous picture is used unless the states are loaded
+        waitAll |= m_pcCfg->getUsePerceptQPA() || !slice->getSPS()->getTempCabacInitMode() || !store->hasEntry( sliceType, slice->getTLayer(), slice->getSliceQp() );
+      }
+#else
+      waitAll |= slice->getPPS()->getCabacInitPresentFlag() && !slice->isIntra();
+#endif
+      for( int k = 0; k < jobId; k++ )
+      {
+        if( !m_frameJobs[k].finished && ( waitAll || m_frameJobs[k].tLayer == job.tLayer ) )
+        {
+          return false;
+        }
+      }
+      return true;
+    } );
+
+    if( !slice->getPendingRasInit() )
+    {
+      slice->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
+    }
+
+    // the header of the EncLib is set up by the next pictures while this picture is compressed
+    job.masterPicHeader = pic->cs->picHeader;
+    job.picHeader       = *job.masterPicHeader;
+    if( job.masterPicHeader->getRPL0() == job.masterPicHeader->getLocalRPL0() )
+    {
+      job.picHeader.setRPL0( job.picHeader.getLocalRPL0() );
+    }
+    if( job.masterPicHeader->getRPL1() == job.masterPicHeader->getLocalRPL1() )
+    {
+      job.picHeader.setRPL1( job.picHeader.getLocalRPL1() );
+    }
+    pic->cs->picHeader = &job.picHeader;
+  }
+  for( Slice* picSlice: pic->slices )
+  {
+    picSlice->setPicHeader( &job.picHeader );
+  }
+}
+
+void EncGOP::releaseFrameSetup( const int frameThreadId, const Slice* slice )
+{
+  FrameJob& job = *m_frameThreadJobs[frameThreadId];
+  if( !slice->isIntra() )
+  {
+    job.ctxStoreKeys.push_back( std::make_pair( slice->getSliceType(), std::make_pair( slice->getTLayer(), slice->getSliceQp() ) ) );
+  }
+  if( !job.setupDone )
+  {
+    job.referenced = slice->getPic()->referenced;
+    job.setupDone  = true;
+    m_frameSetupTurn++;
+  }
+  m_frameCond.notify_all();
+  job.lock->unlock();
+}
+
+void EncGOP::acquireFrameSetup( const int frameThreadId )
+{
+  FrameJob& job = *m_frameThreadJobs[frameThreadId];
+  job.lock->lock();
+  if( m_frameFailure )
+  {
+    throw FrameJobAborted();
+  }
+  xSelectFrameJob( job );
+}
+
+EncGOP::FrameJob& EncGOP::xGetFrameJob( const int poc )
+{
+  for( auto& job: m_frameJobs )
+  {
+    if( job.poc == poc )
+    {
+      return job;
+    }
+  }
+  THROW( "No frame job for POC " << poc );
+}
+
+void EncGOP::xSelectFrameJob( const FrameJob& job )
+{
+  m_pcSliceEncoder = job.sliceEncoder;
+  m_pcReshaper     = job.reshaper;
+  m_pcLoopFilter   = m_pcEncLib->getLoopFilter  ( job.firstCuEncStack );
+  m_pcCABACEncoder = m_pcEncLib->getCABACEncoder( job.firstCuEncStack );
+  m_pcCtxCache     = m_pcEncLib->getCtxCache    ( job.firstCuEncStack );
+  m_pcRdCost       = m_pcEncLib->getRdCost      ( job.firstCuEncStack );
+  m_pcInterSearch  = m_pcEncLib->getInterSearch ( job.firstCuEncStack );
+}
+
+template<typename Ready>
+void EncGOP::xWaitForFrameJobs( FrameJob& job, Ready ready )
+{
+  m_frameCond.wait( *job.lock, [&]() { return m_frameFailure || ready(); } );
+  if( m_frameFailure )
+  {
+    throw FrameJobAborted();
+  }
+  // the members have been switched by the other frame threads meanwhile
+  xSelectFrameJob( job );
+}
+
+void EncGOP::xWaitForFrameReferences( const int picIdInGOP, Slice* slice )
+{
+  const int jobId = picIdInGOP - m_firstFrameJobPicId;
+  FrameJob& job   = m_frameJobs[jobId];
+  job.poc         = slice->getPOC();
+  job.intra       = slice->isIntra();
+  job.depth       = slice->getDepth();
+  job.tLayer      = slice->getTLayer();
+
+  // pictures deriving a new LMCS model update the luma weights of the distortion shared by all pictures
+  bool newLmcsModel = false;
+  if( slice->getSPS()->getUseLmcs() && !job.intra )
+  {
+    int modIP = job.poc - job.poc / m_pcCfg->getReshapeCW().rspFpsToIp * m_pcCfg->getReshapeCW().rspFpsToIp;
+    newLmcsModel = m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_PQ || ( m_pcCfg->getReshapeCW().updateCtrl == 2 && modIP == 0 );
+  }
+  job.barrier = job.intra || slice->isIRAP() || newLmcsModel;
+
+  // the adaptive max BT size is derived from the preceding pictures of the same depth
+  const bool useAMaxBT     = m_pcCfg->getUseAMaxBT() && !job.intra;
+  const bool waitAllAMaxBT = useAMaxBT && m_bInitAMaxBT && slice->getPOC() > m_uiPrevISlicePOC;
+
+  xWaitForFrameJobs( job, [&]()
+  {
+    for( int k = 0; k < jobId; k++ )
+    {
+      const FrameJob& other = m_frameJobs[k];
+      if( other.finished || other.poc == NOT_VALID )
+      {
+        continue;
+      }
+      if( job.barrier || other.barrier || waitAllAMaxBT
+        || slice->isPOCInRefPicList( slice->getRPL0(), other.poc ) || slice->isPOCInRefPicList( slice->getRPL1(), other.poc )
+        || ( useAMaxBT && !other.intra && other.depth == job.depth ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  } );
+}
+
+void EncGOP::xWaitForFrameWriteTurn( Picture* pic )
+{
+  FrameJob& job   = xGetFrameJob( pic->getPOC() );
+  const int jobId = int( &job - &m_frameJobs[0] );
+  xWaitForFrameJobs( job, [&]() { return m_frameWriteTurn == jobId; } );
+
+  // picture level state the sequential encoder has when the picture is written
+  m_iNumPicCoded = 0;
+  std::swap( pic->referenced, job.referenced );
+  for( uint32_t sliceIdx = 0; sliceIdx < pic->cs->pps->getNumSlicesInPic(); sliceIdx++ )
+  {
+    if( !pic->slices[sliceIdx]->getPendingRasInit() )
+    {
+      pic->slices[sliceIdx]->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
+    }
+  }
+#if JVET_AG0098_AMVP_WITH_SBTMVP
+  for( uint32_t sliceIdx = 0; sliceIdx < pic->cs->pps->getNumSlicesInPic(); sliceIdx++ )
+  {
+    if( pic->slices[sliceIdx]->getAmvpSbTmvpEnabledFlag() )
+    {
+      g_picAmvpSbTmvpEnabledArea = 0;
+    }
+  }
+#endif
+}
+
+void EncGOP::xFinishFrameJob( Picture* pic )
+{
+  FrameJob& job = xGetFrameJob( pic->getPOC() );
+  std::swap( pic->referenced, job.referenced );
+
+  // the initialization table of the last written picture is used by all frame threads
+  for( int fId = 0; fId < m_pcEncLib->getNumFrameThreads(); fId++ )
+  {
+    m_pcEncLib->getSliceEncoder( fId )->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
+  }
+
+  // the copy of the picture header is released with the job
+  if( job.masterPicHeader )
+  {
+    pic->cs->picHeader = job.masterPicHeader;
+    for( Slice* slice: pic->slices )
+    {
+      slice->setPicHeader( job.masterPicHeader );
+    }
+  }
+
+  job.finished = true;
+  m_frameWriteTurn++;
+  m_frameCond.notify_all();
+}
+#endif
+
 void EncGOP::printOutSummary(uint32_t uiNumAllPicCoded, bool isField, const bool printMSEBasedSNR,
                              const bool printSequenceMSE,
 #if MSSIM_UNIFORM_METRICS_LOG
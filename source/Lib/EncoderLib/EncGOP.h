@@ -60,6 +60,11 @@
 #include "Analyze.h"
 #include "RateCtrl.h"
 #include <vector>
+#if ENABLE_FRAME_PARALLELISM
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#endif
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER
 #include "BilateralFilter.h"
 #endif
@@ -102,6 +107,28 @@ class EncGOP
     int accumNalsDU;
   };
 
+#if ENABLE_FRAME_PARALLELISM
+  /// a picture of the GOP compressed by one of the frame threads
+  struct FrameJob
+  {
+    std::unique_lock<std::mutex>* lock            = nullptr;   ///< lock of m_frameMutex held by the frame thread while not compressing the CTUs
+    int                           firstCuEncStack = 0;         ///< first CU encoder stack of the frame thread
+    EncSlice*                     sliceEncoder    = nullptr;
+    EncReshape*                   reshaper        = nullptr;
+    int                           poc             = NOT_VALID; ///< valid when the references of the picture are known
+    bool                          barrier         = false;     ///< the following pictures are not started before this picture is finished
+    bool                          intra           = false;
+    int                           depth           = 0;
+    int                           tLayer          = 0;
+    std::vector<std::pair<SliceType, std::pair<int, int>>> ctxStoreKeys; ///< slice type, TLayer and QP of the CABAC states stored by the picture
+    bool                          referenced      = false;     ///< marking of the picture when it was set up, later pictures may unmark it
+    bool                          setupDone       = false;     ///< the next picture may be set up
+    bool                          finished        = false;     ///< filtered, written and available as reference
+    PicHeader*                    masterPicHeader = nullptr;   ///< header of the EncLib, set up by the next pictures while this picture is compressed
+    PicHeader                     picHeader;                   ///< copy of the master header used by the picture
+  };
+#endif
+
 private:
 
   Analyze                 m_gcAnalyzeAll;
@@ -137,6 +164,10 @@ private:
   EncLib*                 m_pcEncLib;
   EncCfg*                 m_pcCfg;
   EncSlice*               m_pcSliceEncoder;
+  CABACEncoder*           m_pcCABACEncoder;
+  CtxCache*               m_pcCtxCache;
+  RdCost*                 m_pcRdCost;
+  InterSearch*            m_pcInterSearch;
   PicList*                m_pcListPic;
 
   HLSWriter*              m_HLSWriter;
@@ -196,6 +227,19 @@ private:
   int                     m_lastGdrIntervalPoc;  
 #endif
 
+#if ENABLE_FRAME_PARALLELISM
+  // pictures of the GOP compressed concurrently, empty when the pictures are compressed one after the other
+  std::vector<FrameJob>   m_frameJobs;
+  std::vector<FrameJob*>  m_frameThreadJobs;                    ///< picture of each frame thread
+  int                     m_firstFrameJobPicId;                 ///< picIdInGOP of m_frameJobs[0]
+  int                     m_nextFrameJob;                       ///< next picture taken by a frame thread
+  int                     m_frameSetupTurn;                     ///< picture allowed to be set up
+  int                     m_frameWriteTurn;                     ///< picture allowed to be filtered and written
+  std::mutex              m_frameMutex;
+  std::condition_variable m_frameCond;
+  std::exception_ptr      m_frameFailure;
+#endif
+
 #if JVET_O0756_CALCULATE_HDRMETRICS
 
   hdrtoolslib::Frame **m_ppcFrameOrg;
@@ -228,6 +272,21 @@ public:
                       const bool printMSSSIM,
 #endif
                       bool isEncodeLtRef, const int picIdInGOP);
+#if ENABLE_FRAME_PARALLELISM
+  /// compresses the pictures [firstPicIdInGOP, firstPicIdInGOP + numPicIds) with numFrameThreads threads, the pictures
+  /// are set up and written in coding order, the CTUs of pictures not referencing each other are compressed concurrently
+  void  compressGOPFrameParallel( int iPOCLast, int iNumPicRcvd, PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRec,
+                                  const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
+#if MSSIM_UNIFORM_METRICS_LOG
+                                  const bool printMSSSIM,
+#endif
+                                  const int firstPicIdInGOP, const int numPicIds, const int numFrameThreads );
+  bool  isFrameParallel() const { return !m_frameJobs.empty(); }
+  // called by the slice encoder of a frame thread
+  void  startFrameSlice  ( const int frameThreadId, Slice* slice );
+  void  releaseFrameSetup( const int frameThreadId, const Slice* slice );
+  void  acquireFrameSetup( const int frameThreadId );
+#endif
   void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, OutputBitstream* pcBitstreamRedirect);
 
 
@@ -295,6 +354,15 @@ protected:
   void  xInitGOP          ( int iPOCLast, int iNumPicRcvd, bool isField
     , bool isEncodeLtRef
   );
+#if ENABLE_FRAME_PARALLELISM
+  FrameJob& xGetFrameJob           ( const int poc );
+  void  xSelectFrameJob            ( const FrameJob& job );
+  template<typename Ready>
+  void  xWaitForFrameJobs          ( FrameJob& job, Ready ready );
+  void  xWaitForFrameReferences    ( const int picIdInGOP, Slice* slice );
+  void  xWaitForFrameWriteTurn     ( Picture* pic );
+  void  xFinishFrameJob            ( Picture* pic );
+#endif
   void  xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic );
   void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice);
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
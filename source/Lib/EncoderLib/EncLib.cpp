@@ -101,11 +101,17 @@ void EncLib::create( const int layerId )
   m_iPOCLast = m_compositeRefEnabled ? -2 : -1;
   // create processing unit classes
   m_cGOPEncoder.        create( );
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #if ENABLE_SPLIT_PARALLELISM
   m_numCuEncStacks  = m_numSplitThreads == 1 ? 1 : NUM_RESERVERD_SPLIT_JOBS;
+#elif ENABLE_FRAME_PARALLELISM
+  // frame thread f uses the stacks [f * NumWppThreads, (f + 1) * NumWppThreads)
+  m_numCuEncStacks  = m_numWppThreads * m_numFrameThreads;
 #else
-  m_numCuEncStacks  = 1;
+  m_numCuEncStacks  = m_numWppThreads;
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  m_cSliceEncoder   = new EncSlice           [m_numFrameThreads];
 #endif
 
   m_cCuEncoder      = new EncCu              [m_numCuEncStacks];
@@ -118,6 +124,7 @@ void EncLib::create( const int layerId )
   m_CABACEncoder    = new CABACEncoder       [m_numCuEncStacks];
   m_cRdCost         = new RdCost             [m_numCuEncStacks];
   m_ctxCache        = new CtxCache           [m_numCuEncStacks];
+  m_cLoopFilter     = new LoopFilter         [m_numCuEncStacks];
 
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
@@ -126,31 +133,44 @@ void EncLib::create( const int layerId )
     m_bilateralFilter[jId].    create();
 #endif
 
+    // every stack needs its own picture buffer for the deblocking of the CU candidates
+    m_cLoopFilter[jId].create( floorLog2( m_maxCUWidth ) - MIN_CU_LOG2 );
+#if ENABLE_PARALLEL_DEBLOCKING
+    m_cLoopFilter[jId].setNumThreads( m_numLoopFilterThreads );
+#endif
+
+    if( !m_bLoopFilterDisable && m_encDbOpt )
+    {
+      m_cLoopFilter[jId].initEncPicYuvBuffer( m_chromaFormatIDC, Size( getSourceWidth(), getSourceHeight() ), getMaxCUWidth() );
+    }
   }
 #else
   m_cCuEncoder.         create( this );
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER
   m_bilateralFilter.    create();
 #endif
-#endif
-#if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  m_cInterSearch.cacheAssign( &m_cacheModel );
-#endif
 
   m_cLoopFilter.create(floorLog2(m_maxCUWidth) - MIN_CU_LOG2);
+#if ENABLE_PARALLEL_DEBLOCKING
+  m_cLoopFilter.setNumThreads( m_numLoopFilterThreads );
+#endif
 
   if (!m_bLoopFilterDisable && m_encDbOpt)
   {
     m_cLoopFilter.initEncPicYuvBuffer(m_chromaFormatIDC, Size(getSourceWidth(), getSourceHeight()), getMaxCUWidth());
   }
+#endif
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+  getInterSearch()->cacheAssign( &m_cacheModel );
+#endif
 
-#if ENABLE_SPLIT_PARALLELISM
-  m_cReshaper = new EncReshape[m_numCuEncStacks];
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  m_cReshaper = new EncReshape[getNumReshapers()];
 #endif
   if (m_lmcsEnabled)
   {
-#if ENABLE_SPLIT_PARALLELISM
-    for (int jId = 0; jId < m_numCuEncStacks; jId++)
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    for (int jId = 0; jId < getNumReshapers(); jId++)
     {
       m_cReshaper[jId].createEnc(getSourceWidth(), getSourceHeight(), m_maxCUWidth, m_maxCUHeight, m_bitDepth[COMPONENT_Y]);
     }
@@ -224,10 +244,22 @@ void EncLib::create( const int layerId )
 
 void EncLib::destroy ()
 {
+  if( !m_modeStatsFilename.empty() )
+  {
+    xWriteModeStats();
+  }
+
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
+#if ENABLE_FRAME_PARALLELISM
+  for( int fId = 0; fId < m_numFrameThreads; fId++ )
+  {
+    m_cSliceEncoder[fId].destroy();
+  }
+#else
   m_cSliceEncoder.      destroy();
-#if ENABLE_SPLIT_PARALLELISM
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cCuEncoder[jId].destroy();
@@ -240,17 +272,24 @@ void EncLib::destroy ()
     m_cEncALF.destroy();
   }
   m_cEncSAO.            destroy();
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for( int jId = 0; jId < m_numCuEncStacks; jId++ )
+  {
+    m_cLoopFilter[jId].destroy();
+  }
+#else
   m_cLoopFilter.        destroy();
+#endif
   m_cRateCtrl.          destroy();
-#if ENABLE_SPLIT_PARALLELISM
-  for (int jId = 0; jId < m_numCuEncStacks; jId++)
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for (int jId = 0; jId < getNumReshapers(); jId++)
   {
     m_cReshaper[jId].   destroy();
   }
 #else
   m_cReshaper.          destroy();
 #endif
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cInterSearch[jId].   destroy();
@@ -267,7 +306,7 @@ void EncLib::destroy ()
 #endif
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   delete[] m_cCuEncoder;
   delete[] m_cInterSearch;
   delete[] m_cIntraSearch;
@@ -278,11 +317,39 @@ void EncLib::destroy ()
   delete[] m_CABACEncoder;
   delete[] m_cRdCost;
   delete[] m_ctxCache;
+  delete[] m_cLoopFilter;
+  delete[] m_cReshaper;
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  delete[] m_cSliceEncoder;
 #endif
 
   return;
 }
 
+void EncLib::xWriteModeStats()
+{
+  EncModeStats modeStats;
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  for( int jId = 0; jId < m_numCuEncStacks; jId++ )
+  {
+    if( m_cCuEncoder[jId].getModeStats() )
+    {
+      modeStats.merge( *m_cCuEncoder[jId].getModeStats() );
+    }
+  }
+#else
+  if( m_cCuEncoder.getModeStats() )
+  {
+    modeStats.merge( *m_cCuEncoder.getModeStats() );
+  }
+#endif
+  if( !modeStats.writeJson( m_modeStatsFilename ) )
+  {
+    msg( WARNING, "Could not write the test mode statistics to %s\n", m_modeStatsFilename.c_str() );
+  }
+}
+
 void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
 {
   m_AUWriterIf = auWriterIf;
@@ -321,7 +388,7 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
     m_cRateCtrl.initHrdParam(sps0.getGeneralHrdParameters(), sps0.getOlsHrdParameters(), m_iFrameRate, m_RCInitialCpbFullness);
   }
 #endif
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     m_cRdCost[jId].setCostMode ( m_costMode );
@@ -657,8 +724,22 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // initialize processing unit classes
   m_cGOPEncoder.  init( this );
+#if ENABLE_FRAME_PARALLELISM
+  for( int fId = 0; fId < m_numFrameThreads; fId++ )
+  {
+    m_cSliceEncoder[fId].init( this, sps0, fId * m_numWppThreads, m_numWppThreads );
+  }
+#if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT
+  // the stored context states follow the coding order of all pictures, not of the pictures of one frame thread
+  for( int jId = 1; jId < m_numCuEncStacks; jId++ )
+  {
+    m_CABACEncoder[jId].shareCABACDataStore( m_CABACEncoder[0] );
+  }
+#endif
+#else
   m_cSliceEncoder.init( this, sps0 );
-#if ENABLE_SPLIT_PARALLELISM
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
     // precache a few objects
@@ -706,10 +787,16 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
                               getUseCompositeRef(),
                               m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize, &m_cRdCost[jId], cabacEstimator, getCtxCache( jId )
                            , &m_cReshaper[jId]
+#if JVET_Z0153_IBC_EXT_REF
+                           , pps0.getPicWidthInLumaSamples()
+#endif
     );
 
     // link temporary buffets from intra search with inter search to avoid unnecessary memory overhead
     m_cInterSearch[jId].setTempBuffers( m_cIntraSearch[jId].getSplitCSBuf(), m_cIntraSearch[jId].getFullCSBuf(), m_cIntraSearch[jId].getSaveCSBuf() );
+#if JVET_AE0159_FIBC || JVET_AE0059_INTER_CCCM || JVET_AE0078_IBC_LIC_EXTENSION || JVET_AF0073_INTER_CCP_MERGE
+    m_cInterSearch[jId].setIntraPrediction( &m_cIntraSearch[jId] );
+#endif
   }
 #else  // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_cCuEncoder.   init( this, sps0 );
@@ -756,11 +843,10 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
-#endif // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-
 #if JVET_AE0159_FIBC || JVET_AE0059_INTER_CCCM || JVET_AE0078_IBC_LIC_EXTENSION || JVET_AF0073_INTER_CCP_MERGE
   m_cInterSearch.setIntraPrediction(&m_cIntraSearch);
 #endif
+#endif // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_iMaxRefPicNum = 0;
 
 #if ER_CHROMA_QP_WCG_PPS
@@ -833,7 +919,7 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
   {
     quant->setFlatScalingList(maxLog2TrDynamicRange, sps.getBitDepths());
     quant->setUseScalingList(false);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for( int jId = 1; jId < m_numCuEncStacks; jId++ )
     {
       getTrQuant( jId )->getQuant()->setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
@@ -846,11 +932,13 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
     aps.getScalingList().setDefaultScalingList ();
     quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
     quant->setUseScalingList(true);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for( int jId = 1; jId < m_numCuEncStacks; jId++ )
     {
       getTrQuant( jId )->getQuant()->setUseScalingList( true );
     }
+#endif
+#if ENABLE_SPLIT_PARALLELISM
     sps.setDisableScalingMatrixForLfnstBlks(getDisableScalingMatrixForLfnstBlks());
 #endif
   }
@@ -866,7 +954,7 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
     aps.getScalingList().setChromaScalingListPresentFlag((sps.getChromaFormatIdc()!=CHROMA_400));
     quant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
     quant->setUseScalingList(true);
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
     for( int jId = 1; jId < m_numCuEncStacks; jId++ )
     {
       getTrQuant( jId )->getQuant()->setUseScalingList( true );
@@ -1214,6 +1302,20 @@ bool EncLib::encodePrep(bool flush, PelStorage* pcPicYuvOrg, const InputColourSp
 bool EncLib::encode( const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut, int& iNumEncoded )
 {
   // compress GOP
+#if ENABLE_FRAME_PARALLELISM
+  if( m_numFrameThreads > 1 )
+  {
+    // the remaining pictures of the GOP at once
+    const int numPicIds = m_iPOCLast ? m_iGOPSize - m_picIdInGOP : 1;
+    m_cGOPEncoder.compressGOPFrameParallel( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, snrCSC, m_printFrameMSE,
+#if MSSIM_UNIFORM_METRICS_LOG
+                                            m_printMSSSIM,
+#endif
+                                            m_picIdInGOP, numPicIds, m_numFrameThreads );
+    m_picIdInGOP += numPicIds - 1;
+  }
+  else
+#endif
   m_cGOPEncoder.compressGOP(m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut, false, false, snrCSC,
                             m_printFrameMSE,
 #if MSSIM_UNIFORM_METRICS_LOG
@@ -2018,6 +2120,12 @@ void EncLib::xInitSPS( SPS& sps )
   sps.setUseGeo                ( m_Geo );
 #if JVET_AG0112_REGRESSION_BASED_GPM_BLENDING
   sps.setUseGeoBlend           ( true );
+#endif
+#if GPM_CURVE
+  sps.setUseGeoCurve           ( m_Geo && m_geoCurve );
+#endif
+#if GPM_BLEND
+  sps.setUseGeoTanhBlend       ( m_geoTanhBlend );
 #endif
   sps.setUseMMVD               ( m_MMVD );
   sps.setFpelMmvdEnabledFlag   (( m_MMVD ) ? m_allowDisFracMMVD : false);
@@ -83,7 +83,7 @@ private:
   int                       m_layerId;
 
   // encoder search
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   InterSearch              *m_cInterSearch;                       ///< encoder search class
   IntraSearch              *m_cIntraSearch;                       ///< encoder search class
 #else
@@ -91,7 +91,7 @@ private:
   IntraSearch               m_cIntraSearch;                       ///< encoder search class
 #endif
   // coding tool
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #if JVET_V0094_BILATERAL_FILTER || JVET_X0071_CHROMA_BILATERAL_FILTER
   BilateralFilter          *m_bilateralFilter;
 #endif
@@ -102,17 +102,21 @@ private:
 #endif
   TrQuant                   m_cTrQuant;                           ///< transform & quantization class
 #endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  LoopFilter               *m_cLoopFilter;                        ///< deblocking filter class
+#else
   LoopFilter                m_cLoopFilter;                        ///< deblocking filter class
+#endif
   EncSampleAdaptiveOffset   m_cEncSAO;                            ///< sample adaptive offset class
   EncAdaptiveLoopFilter     m_cEncALF;
   HLSWriter                 m_HLSWriter;                          ///< CAVLC encoder
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   CABACEncoder             *m_CABACEncoder;
 #else
   CABACEncoder              m_CABACEncoder;
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncReshape               *m_cReshaper;                        ///< reshaper class
 #else
   EncReshape                m_cReshaper;                        ///< reshaper class
@@ -124,8 +128,12 @@ private:
 
   // processing unit
   EncGOP                    m_cGOPEncoder;                        ///< GOP encoder
+#if ENABLE_FRAME_PARALLELISM
+  EncSlice                 *m_cSliceEncoder;                      ///< slice encoder of each frame thread
+#else
   EncSlice                  m_cSliceEncoder;                      ///< slice encoder
-#if ENABLE_SPLIT_PARALLELISM
+#endif
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu                    *m_cCuEncoder;                         ///< CU encoder
 #else
   EncCu                     m_cCuEncoder;                         ///< CU encoder
@@ -136,7 +144,7 @@ private:
   ParameterSetMap<APS>&     m_apsMap;                             ///< APS. This is the base value. This is copied to PicSym
   PicHeader                 m_picHeader;                          ///< picture header
   // RD cost computation
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   RdCost                   *m_cRdCost;                            ///< RD cost computation class
   CtxCache                 *m_ctxCache;                           ///< buffer for temporarily stored context models
 #else
@@ -148,7 +156,7 @@ private:
 
   AUWriterIf*               m_AUWriterIf;
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   int                       m_numCuEncStacks;
 #endif
 
@@ -174,8 +182,6 @@ private:
 public:
   SPS*                      getSPS( int spsId ) { return m_spsMap.getPS( spsId ); };
   APS**                     getApss() { return m_apss; }
-  Ctx                       m_entropyCodingSyncContextState;      ///< leave in addition to vector for compatibility
-  PLTBuf                    m_palettePredictorSyncState;
 #if JVET_AC0096 || JVET_AG0116
   int                       m_gopRprPpsId;
 #endif
@@ -192,6 +198,7 @@ protected:
   void  xInitHrdParameters(SPS &sps);                 ///< initialize HRDParameters parameters
 
   void  xInitRPL(SPS &sps, bool isFieldCoding);           ///< initialize SPS from encoder options
+  void  xWriteModeStats();                                ///< write the test mode statistics of all CU encoders
 
 public:
   EncLib( EncLibCommon* encLibCommon );
@@ -208,7 +215,7 @@ public:
 
   AUWriterIf*             getAUWriterIf         ()              { return   m_AUWriterIf;           }
   PicList*                getListPic            ()              { return  &m_cListPic;             }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   InterSearch*            getInterSearch        ( int jId = 0 ) { return  &m_cInterSearch[jId];    }
   IntraSearch*            getIntraSearch        ( int jId = 0 ) { return  &m_cIntraSearch[jId];    }
 
@@ -216,6 +223,7 @@ public:
   BilateralFilter*        getBilateralFilter    ( int jId = 0 ) { return  &m_bilateralFilter[jId]; }
 #endif
   TrQuant*                getTrQuant            ( int jId = 0 ) { return  &m_cTrQuant[jId];        }
+  LoopFilter*             getLoopFilter         ( int jId = 0 ) { return  &m_cLoopFilter[jId];     }
 #else
   InterSearch*            getInterSearch        ()              { return  &m_cInterSearch;         }
   IntraSearch*            getIntraSearch        ()              { return  &m_cIntraSearch;         }
@@ -224,31 +232,35 @@ public:
   BilateralFilter*        getBilateralFilter    ()              { return  &m_bilateralFilter;      }
 #endif
   TrQuant*                getTrQuant            ()              { return  &m_cTrQuant;             }
-#endif
   LoopFilter*             getLoopFilter         ()              { return  &m_cLoopFilter;          }
+#endif
   EncSampleAdaptiveOffset* getSAO               ()              { return  &m_cEncSAO;              }
   EncAdaptiveLoopFilter*  getALF                ()              { return  &m_cEncALF;              }
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
+#if ENABLE_FRAME_PARALLELISM
+  EncSlice*               getSliceEncoder       ( int fId = 0 ) { return  &m_cSliceEncoder[fId];   }
+#else
   EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder;        }
+#endif
   EncHRD*                 getHRD                ()              { return  &m_encHRD;               }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu*                  getCuEncoder          ( int jId = 0 ) { return  &m_cCuEncoder[jId];      }
 #else
   EncCu*                  getCuEncoder          ()              { return  &m_cCuEncoder;           }
 #endif
   HLSWriter*              getHLSWriter          ()              { return  &m_HLSWriter;            }
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   CABACEncoder*           getCABACEncoder       ( int jId = 0 ) { return  &m_CABACEncoder[jId];    }
 
   RdCost*                 getRdCost             ( int jId = 0 ) { return  &m_cRdCost[jId];         }
   CtxCache*               getCtxCache           ( int jId = 0 ) { return  &m_ctxCache[jId];        }
 #else
   CABACEncoder*           getCABACEncoder       ()              { return  &m_CABACEncoder;         }
-#if JVET_AA0096_MC_BOUNDARY_PADDING
-  InterPrediction *         getFrameMcPadPredSearch() { return &m_cFrameMcPadPredSearch; }
-#endif
   RdCost*                 getRdCost             ()              { return  &m_cRdCost;              }
   CtxCache*               getCtxCache           ()              { return  &m_ctxCache;             }
+#endif
+#if JVET_AA0096_MC_BOUNDARY_PADDING
+  InterPrediction *         getFrameMcPadPredSearch() { return &m_cFrameMcPadPredSearch; }
 #endif
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
 
@@ -263,13 +275,19 @@ public:
   const PPS* getPPS( int Id ) { return m_ppsMap.getPS( Id); }
   const APS*             getAPS(int Id) { return m_apsMap.getPS(Id); }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void                   setNumCuEncStacks( int n )             { m_numCuEncStacks = n; }
   int                    getNumCuEncStacks()              const { return m_numCuEncStacks; }
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncReshape*            getReshaper( int jId = 0 )             { return  &m_cReshaper[jId]; }
+#if ENABLE_FRAME_PARALLELISM
+  // with frame threads the LMCS model is derived in an additional reshaper and copied to the stacks of each picture
+  int                    getNumReshapers()                const { return m_numCuEncStacks + ( m_numFrameThreads > 1 ? 1 : 0 ); }
+#else
+  int                    getNumReshapers()                const { return m_numCuEncStacks; }
+#endif
 #else
   EncReshape*            getReshaper()                          { return  &m_cReshaper; }
 #endif
@@ -46,6 +46,7 @@
 #include "InterSearch.h"
 
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 //////////////////////////////////////////////////////////////////////////
@@ -347,6 +348,8 @@ protected:
 
 public:
 
+  std::unordered_map< Position, std::unordered_map< Size, double> > m_mapPltCost[2];  ///< palette RD-cost per CU area of the current CTU
+
   virtual ~EncModeCtrl              () {}
 
   virtual void create               ( const EncCfg& cfg )                                                                   = 0;
@@ -0,0 +1,181 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2023, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file     EncModeStats.cpp
+    \brief    per test mode encoder time and RD win statistics
+*/
+
+#include "EncModeStats.h"
+
+#include <cstdio>
+
+//! \ingroup EncoderLib
+//! \{
+
+EncModeStats::EncModeStats()
+{
+  reset();
+}
+
+void EncModeStats::reset()
+{
+  const Entry empty = { 0, 0, 0 };
+  m_entries.assign( ETM_INVALID * NUM_ENTRIES_PER_MODE, empty );
+}
+
+EncModeStats::Entry& EncModeStats::xEntry( EncTestModeType type, int width, int height, int tLayer )
+{
+  CHECK( type >= ETM_INVALID, "Invalid test mode type" );
+  return m_entries[xIndex( type, std::min( floorLog2( width ), MAX_CU_DEPTH ), std::min( floorLog2( height ), MAX_CU_DEPTH ), std::min( tLayer, MAX_TLAYER - 1 ) )];
+}
+
+void EncModeStats::addCall( EncTestModeType type, int width, int height, int tLayer, uint64_t timeNs )
+{
+  Entry& entry = xEntry( type, width, height, tLayer );
+  entry.calls++;
+  entry.timeNs += timeNs;
+}
+
+void EncModeStats::addWin( EncTestModeType type, int width, int height, int tLayer )
+{
+  xEntry( type, width, height, tLayer ).wins++;
+}
+
+void EncModeStats::merge( const EncModeStats& other )
+{
+  for( size_t i = 0; i < m_entries.size(); i++ )
+  {
+    m_entries[i].calls  += other.m_entries[i].calls;
+    m_entries[i].wins   += other.m_entries[i].wins;
+    m_entries[i].timeNs += other.m_entries[i].timeNs;
+  }
+}
+
+const char* EncModeStats::getModeName( EncTestModeType type )
+{
+  switch( type )
+  {
+  case ETM_HASH_INTER:         return "HASH_INTER";
+  case ETM_MERGE_SKIP:         return "MERGE_SKIP";
+  case ETM_INTER_ME:           return "INTER_ME";
+#if !MERGE_ENC_OPT
+  case ETM_AFFINE:             return "AFFINE";
+#endif
+#if AFFINE_MMVD && !MERGE_ENC_OPT
+  case ETM_AF_MMVD:            return "AF_MMVD";
+#endif
+#if TM_MRG && !MERGE_ENC_OPT
+  case ETM_MERGE_TM:           return "MERGE_TM";
+#endif
+  case ETM_MERGE_GEO:          return "MERGE_GEO";
+  case ETM_INTRA:              return "INTRA";
+  case ETM_PALETTE:            return "PALETTE";
+  case ETM_SPLIT_QT:           return "SPLIT_QT";
+  case ETM_SPLIT_BT_H:         return "SPLIT_BT_H";
+  case ETM_SPLIT_BT_V:         return "SPLIT_BT_V";
+  case ETM_SPLIT_TT_H:         return "SPLIT_TT_H";
+  case ETM_SPLIT_TT_V:         return "SPLIT_TT_V";
+  case ETM_POST_DONT_SPLIT:    return "POST_DONT_SPLIT";
+#if REUSE_CU_RESULTS
+  case ETM_RECO_CACHED:        return "RECO_CACHED";
+#endif
+  case ETM_TRIGGER_IMV_LIST:   return "TRIGGER_IMV_LIST";
+  case ETM_IBC:                return "IBC";
+  case ETM_IBC_MERGE:          return "IBC_MERGE";
+#if MULTI_HYP_PRED
+  case ETM_INTER_MULTIHYP:     return "INTER_MULTIHYP";
+#endif
+  default:                     return "INVALID";
+  }
+}
+
+/** writes one record per tested (mode, CU size, temporal layer) and the per mode totals,
+    the time of the split modes includes the coding of their sub-CUs
+ */
+bool EncModeStats::writeJson( const std::string& fileName ) const
+{
+  FILE* file = fopen( fileName.c_str(), "w" );
+  if( file == nullptr )
+  {
+    return false;
+  }
+
+  fprintf( file, "{\n  \"modes\": [" );
+  bool first = true;
+  for( int type = 0; type < ETM_INVALID; type++ )
+  {
+    for( int log2Width = 0; log2Width < NUM_SIZES; log2Width++ )
+    {
+      for( int log2Height = 0; log2Height < NUM_SIZES; log2Height++ )
+      {
+        for( int tLayer = 0; tLayer < MAX_TLAYER; tLayer++ )
+        {
+          const Entry& entry = m_entries[xIndex( type, log2Width, log2Height, tLayer )];
+          if( entry.calls == 0 && entry.wins == 0 )
+          {
+            continue;
+          }
+          fprintf( file, "%s\n    { \"mode\": \"%s\", \"width\": %d, \"height\": %d, \"tLayer\": %d, \"calls\": %llu, \"wins\": %llu, \"timeMs\": %.3f }",
+                   first ? "" : ",", getModeName( EncTestModeType( type ) ), 1 << log2Width, 1 << log2Height, tLayer,
+                   (unsigned long long) entry.calls, (unsigned long long) entry.wins, entry.timeNs * 1e-6 );
+          first = false;
+        }
+      }
+    }
+  }
+  fprintf( file, "\n  ],\n  \"totals\": [" );
+  first = true;
+  for( int type = 0; type < ETM_INVALID; type++ )
+  {
+    Entry        total   = { 0, 0, 0 };
+    const Entry* entries = &m_entries[xIndex( type, 0, 0, 0 )];
+    for( int i = 0; i < NUM_ENTRIES_PER_MODE; i++ )
+    {
+      total.calls  += entries[i].calls;
+      total.wins   += entries[i].wins;
+      total.timeNs += entries[i].timeNs;
+    }
+    if( total.calls == 0 && total.wins == 0 )
+    {
+      continue;
+    }
+    fprintf( file, "%s\n    { \"mode\": \"%s\", \"calls\": %llu, \"wins\": %llu, \"timeMs\": %.3f }", first ? "" : ",",
+             getModeName( EncTestModeType( type ) ), (unsigned long long) total.calls, (unsigned long long) total.wins, total.timeNs * 1e-6 );
+    first = false;
+  }
+  fprintf( file, "\n  ]\n}\n" );
+  fclose( file );
+  return true;
+}
+
+//! \}
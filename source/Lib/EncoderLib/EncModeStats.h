@@ -0,0 +1,82 @@
+/* The copyright in this software is being made available under the BSD
+* License, included below. This software may be subject to other third party
+* and contributor rights, including patent rights, and no such rights are
+* granted under this license.
+*
+* Copyright (c) 2010-2023, ITU/ISO/IEC
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*  * Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*  * Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+*    be used to endorse or promote products derived from this software without
+*    specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+* BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+* THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file     EncModeStats.h
+    \brief    per test mode encoder time and RD win statistics (header)
+*/
+
+#ifndef __ENCMODESTATS__
+#define __ENCMODESTATS__
+
+#include <string>
+#include <vector>
+#include "CommonLib/CommonDef.h"
+#include "EncModeCtrl.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+/// wall time, number of calls and number of RD wins of every EncTestModeType, by CU size and temporal layer
+class EncModeStats
+{
+public:
+  EncModeStats();
+
+  void reset();
+  void addCall( EncTestModeType type, int width, int height, int tLayer, uint64_t timeNs );
+  void addWin ( EncTestModeType type, int width, int height, int tLayer );
+  void merge  ( const EncModeStats& other );
+  bool writeJson( const std::string& fileName ) const;
+
+  static const char* getModeName( EncTestModeType type );
+
+private:
+  struct Entry
+  {
+    uint64_t calls;
+    uint64_t wins;
+    uint64_t timeNs;
+  };
+
+  static const int NUM_SIZES           = MAX_CU_DEPTH + 1;
+  static const int NUM_ENTRIES_PER_MODE = NUM_SIZES * NUM_SIZES * MAX_TLAYER;
+
+  static int xIndex( int type, int log2Width, int log2Height, int tLayer ) { return ( ( type * NUM_SIZES + log2Width ) * NUM_SIZES + log2Height ) * MAX_TLAYER + tLayer; }
+  Entry&     xEntry( EncTestModeType type, int width, int height, int tLayer );
+
+  std::vector<Entry> m_entries;   ///< [type][log2Width][log2Height][tLayer]
+};
+
+//! \}
+
+#endif // __ENCMODESTATS__
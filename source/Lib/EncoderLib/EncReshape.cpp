@@ -1403,7 +1403,7 @@ void EncReshape::adjustLmcsPivot()
   }
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void EncReshape::copyState(const EncReshape &other)
 {
   m_srcReshaped     = other.m_srcReshaped;
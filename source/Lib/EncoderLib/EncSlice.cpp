@@ -46,6 +46,12 @@
 
 
 #include <math.h>
+#if ENABLE_WPP_PARALLELISM
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
 
 //! \ingroup EncoderLib
 //! \{
@@ -91,19 +97,43 @@ void EncSlice::destroy()
 #endif
 }
 
+#if ENABLE_FRAME_PARALLELISM
+void EncSlice::init( EncLib* pcEncLib, const SPS& sps, const int firstCuEncStack, const int numCuEncStacks )
+#else
 void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
+#endif
 {
   m_pcCfg             = pcEncLib;
   m_pcLib             = pcEncLib;
   m_pcListPic         = pcEncLib->getListPic();
+#if ENABLE_FRAME_PARALLELISM
+  m_firstCuEncStack   = firstCuEncStack;
+  m_numCuEncStacks    = numCuEncStacks;
+#if JVET_AG0098_AMVP_WITH_SBTMVP
+  // the statistics follow the coding order of all pictures
+  shareAmvpSbTmvpStatArea( *pcEncLib->getSliceEncoder() );
+#endif
+#elif ENABLE_WPP_PARALLELISM
+  m_firstCuEncStack   = 0;
+  m_numCuEncStacks    = pcEncLib->getNumCuEncStacks();
+#endif
 
   m_pcGOPEncoder      = pcEncLib->getGOPEncoder();
+#if ENABLE_WPP_PARALLELISM
+  m_pcCuEncoder       = pcEncLib->getCuEncoder    ( m_firstCuEncStack );
+  m_pcInterSearch     = pcEncLib->getInterSearch  ( m_firstCuEncStack );
+  m_CABACWriter       = pcEncLib->getCABACEncoder ( m_firstCuEncStack )->getCABACWriter   (&sps);
+  m_CABACEstimator    = pcEncLib->getCABACEncoder ( m_firstCuEncStack )->getCABACEstimator(&sps);
+  m_pcTrQuant         = pcEncLib->getTrQuant      ( m_firstCuEncStack );
+  m_pcRdCost          = pcEncLib->getRdCost       ( m_firstCuEncStack );
+#else
   m_pcCuEncoder       = pcEncLib->getCuEncoder();
   m_pcInterSearch     = pcEncLib->getInterSearch();
   m_CABACWriter       = pcEncLib->getCABACEncoder()->getCABACWriter   (&sps);
   m_CABACEstimator    = pcEncLib->getCABACEncoder()->getCABACEstimator(&sps);
   m_pcTrQuant         = pcEncLib->getTrQuant();
   m_pcRdCost          = pcEncLib->getRdCost();
+#endif
 
   // create lambda and QP arrays
   m_vdRdPicLambda.resize(m_pcCfg->getDeltaQpRD() * 2 + 1 );
@@ -848,6 +878,13 @@ void EncSlice::initEncSlice(Picture* pcPic, const int pocLast, const int pocCurr
   {
     m_pcCuEncoder->getIbcHashMap().destroy();
     m_pcCuEncoder->getIbcHashMap().init( pcPic->cs->pps->getPicWidthInLumaSamples(), pcPic->cs->pps->getPicHeightInLumaSamples() );
+#if ENABLE_WPP_PARALLELISM
+    for( int jId = m_firstCuEncStack + 1; jId < m_firstCuEncStack + m_numCuEncStacks; jId++ )
+    {
+      m_pcLib->getCuEncoder( jId )->getIbcHashMap().destroy();
+      m_pcLib->getCuEncoder( jId )->getIbcHashMap().init( pcPic->cs->pps->getPicWidthInLumaSamples(), pcPic->cs->pps->getPicHeightInLumaSamples() );
+    }
+#endif
   }
 #if JVET_Z0118_GDR
   if (m_pcCfg->getGdrEnabled())
@@ -1595,6 +1632,14 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
   m_uiPicDist       = 0;
 
   pcSlice->setSliceQpBase( pcSlice->getSliceQp() );
+#if ENABLE_FRAME_PARALLELISM
+  const int frameThreadId = m_firstCuEncStack / m_numCuEncStacks;
+  if( m_pcGOPEncoder->isFrameParallel() )
+  {
+    // waits for the preceding pictures storing the CABAC states and statistics loaded by this slice
+    m_pcGOPEncoder->startFrameSlice( frameThreadId, pcSlice );
+  }
+#endif
 #if JVET_Z0135_TEMP_CABAC_WIN_WEIGHT 
   m_CABACEstimator->m_CABACDataStore->updateBufferState( pcSlice );
 #endif
@@ -1673,6 +1718,10 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
     {
       pcSlice->setAmvpSbTmvpEnabledFlag(true);
 
+#if ENABLE_FRAME_PARALLELISM
+      // the area is counted when the slice is written, the frame threads reset it when the picture is written
+      if( !m_pcGOPEncoder->isFrameParallel() )
+#endif
       g_picAmvpSbTmvpEnabledArea = 0;
       uint32_t prevEnabledArea;
       bool isExist = loadAmvpSbTmvpStatArea(pcSlice->getTLayer(), prevEnabledArea);
@@ -1795,14 +1844,37 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 #endif
   m_pcInterSearch->resetAffineMVList();
   m_pcInterSearch->resetUniMvList();
+#if ENABLE_WPP_PARALLELISM
+  ::memset(g_isReusedUniMVsFilled, 0, sizeof(ReusedUniMvsFilled) * REUSED_UNI_MVS_SIZE);
+#if INTER_LIC
+  if (pcSlice->getUseLIC())
+  {
+    ::memset(g_isReusedUniMVsFilledLIC, 0, sizeof(ReusedUniMvsFilledLIC) * REUSED_UNI_MVS_LIC_SIZE);
+  }
+#endif
+#else
   ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
 #if INTER_LIC
   if (pcSlice->getUseLIC())
   {
     ::memset(g_isReusedUniMVsFilledLIC, 0, sizeof(g_isReusedUniMVsFilledLIC));
   }
+#endif
+#endif
+#if ENABLE_FRAME_PARALLELISM
+  if( m_pcGOPEncoder->isFrameParallel() )
+  {
+    // the next picture may be set up while the CTUs of this slice are compressed
+    m_pcGOPEncoder->releaseFrameSetup( frameThreadId, pcSlice );
+  }
 #endif
   encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, m_pcLib );
+#if ENABLE_FRAME_PARALLELISM
+  if( m_pcGOPEncoder->isFrameParallel() )
+  {
+    m_pcGOPEncoder->acquireFrameSetup( frameThreadId );
+  }
+#endif
   if (checkPLTRatio) m_pcLib->checkPltStats( pcPic );
 }
 
@@ -1985,7 +2057,9 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   pcPic->lumaClpRngforQuant.max = max(pelMax, pelMaxOF);
 #endif
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_WPP_PARALLELISM
+  const int       dataId          = m_firstCuEncStack;
+#elif ENABLE_SPLIT_PARALLELISM
   const int       dataId          = 0;
 #endif
   CABACWriter*    pCABACWriter    = pEncLib->getCABACEncoder( PARL_PARAM0( dataId ) )->getCABACEstimator( pcSlice->getSPS() );
@@ -2113,6 +2187,17 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   }
 #endif
 
+#if ENABLE_WPP_PARALLELISM
+  if( pCfg->getUseWppParallelism() )
+  {
+    xEncodeCtuRowsWpp( pcPic, pEncLib );
+#if JVET_AC0162_ALF_RESIDUAL_SAMPLES_INPUT
+    pcPic->setResiBufPLT();
+#endif
+    return;
+  }
+#endif
+
   // for every CTU in the slice
   for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
   {
@@ -2236,8 +2321,8 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       if( cs.getCURestricted( pos.offset(0, -1), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
       {
         // Top is available, we use it.
-        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextState;
-        cs.setPrevPLT(pEncLib->m_palettePredictorSyncState);
+        pCABACWriter->getCtx() = m_entropyCodingSyncContextState;
+        cs.setPrevPLT(m_palettePredictorSyncState);
       }
       prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
     }
@@ -2325,7 +2410,7 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     if (pcSlice->getSPS()->getUseLmcs())
 #endif
     {
-      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc());
+      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(PARL_PARAM0(dataId)), pcSlice->getSPS()->getChromaFormatIdc());
 
 #if ENABLE_SPLIT_PARALLELISM
       for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
@@ -2382,8 +2467,8 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     // Store probabilities of first CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
     if( cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && pEncLib->getEntropyCodingSyncEnabledFlag() )
     {
-      pEncLib->m_entropyCodingSyncContextState = pCABACWriter->getCtx();
-      cs.storePrevPLT(pEncLib->m_palettePredictorSyncState);
+      m_entropyCodingSyncContextState = pCABACWriter->getCtx();
+      cs.storePrevPLT(m_palettePredictorSyncState);
     }
 
     int actualBits = int(cs.fracBits >> SCALE_BITS);
@@ -2472,6 +2557,362 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 //  m_uiPicDist       = cs.dist;
 
 }
+#if ENABLE_WPP_PARALLELISM
+/** compresses the CTU rows of the slice wavefront-parallel, row r is compressed by CU encoder stack r % NumWppThreads
+ *
+ * Every CTU row starts from the same state: the slice contexts synchronized with the row above, empty history tables
+ * and search caches. A row only proceeds while the row above is the wavefront lag ahead, the whole row above is waited
+ * for when IBC is used and at the first row of a tile. The units of the picture are put back into CTU order at the end,
+ * so the result does not depend on the number of threads.
+ */
+void EncSlice::xEncodeCtuRowsWpp( Picture* pcPic, EncLib* pEncLib )
+{
+  CodingStructure&     cs          = *pcPic->cs;
+  Slice*               pcSlice     = cs.slice;
+  const PreCalcValues& pcv         = *cs.pcv;
+  const uint32_t       widthInCtus = pcv.widthInCtus;
+  EncCfg*              pCfg        = pEncLib;
+#if ENABLE_QPA
+  const int            iQPIndex    = pcSlice->getSliceQpBase();
+#endif
+
+  struct CtuRow
+  {
+    uint32_t firstCtu;      ///< index of the first CTU of the row in the slice
+    uint32_t numCtus;
+    bool     waitComplete;  ///< the previous row has to be finished before the row starts
+  };
+  std::vector<CtuRow> rows;
+  for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+    if( rows.empty() || cs.pps->ctuIsTileColBd( ctuRsAddr % widthInCtus ) )
+    {
+      rows.push_back( CtuRow{ ctuIdx, 0, cs.pps->ctuIsTileRowBd( ctuRsAddr / widthInCtus ) } );
+    }
+    rows.back().numCtus++;
+  }
+  const int numRows    = (int)rows.size();
+  const int numThreads = std::min( pCfg->getNumWppThreads(), numRows );
+
+#if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
+  const bool useIbc = pcSlice->getUseIBC();
+#else
+  const bool useIbc = pcSlice->getSPS()->getIBCFlag();
+#endif
+  const uint32_t lag = CS::getWavefrontLag( *pcSlice->getSPS() );
+
+  // state every CTU row starts from
+  CABACWriter* pSliceWriter = pEncLib->getCABACEncoder( m_firstCuEncStack )->getCABACEstimator( pcSlice->getSPS() );
+  pSliceWriter->initCtxModels( *pcSlice );
+  const Ctx sliceCtx = pSliceWriter->getCtx();
+  CtuRowHistory rowStartHistory;
+  rowStartHistory.store( cs );
+  rowStartHistory.motionLut = LutMotionCand();
+  cs.resetPrevPLT( rowStartHistory.prevPLT );
+
+  std::vector<Ctx>    rowSyncCtx( numRows );
+  std::vector<PLTBuf> rowSyncPLT( numRows );
+  std::vector<uint32_t> rowProgress( numRows, 0 );
+  std::mutex              picLock;
+  std::mutex              progressLock;
+  std::condition_variable progressChanged;
+  std::exception_ptr      failure;
+  bool                    failed = false;
+
+  CS::reserveUnitsOfPicture( cs );
+  const unsigned firstCU = (unsigned)cs.cus.size();
+  const unsigned firstPU = (unsigned)cs.pus.size();
+  const unsigned firstTU = (unsigned)cs.tus.size();
+
+  const uint32_t firstCtuRsAddr = pcSlice->getCtuAddrInSlice( 0 );
+  const SubPic  &curSubPic      = pcSlice->getPPS()->getSubPicFromPos( Position( ( firstCtuRsAddr % widthInCtus ) * pcv.maxCUWidth, ( firstCtuRsAddr / widthInCtus ) * pcv.maxCUHeight ) );
+  const bool    padSubPic = pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag();
+  if( padSubPic )
+  {
+    for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+    {
+      for( int idx = 0; idx < pcSlice->getNumRefIdx( (RefPicList)rlist ); idx++ )
+      {
+        Picture *refPic = pcSlice->getRefPic( (RefPicList)rlist, idx );
+#if JVET_S0258_SUBPIC_CONSTRAINTS
+        if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+#else
+        if( !refPic->getSubPicSaved() && refPic->numSubpics > 1 )
+#endif
+        {
+          refPic->saveSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->extendSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->setSubPicSaved( true );
+        }
+      }
+    }
+  }
+
+  if( pcSlice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( false, cs );
+  }
+  for( int jId = 0; jId < numThreads; jId++ )
+  {
+    EncCu* cuEncoder = pEncLib->getCuEncoder( m_firstCuEncStack + jId );
+    if( jId > 0 )
+    {
+      pEncLib->getRdCost( m_firstCuEncStack + jId )->copyState( *pEncLib->getRdCost( m_firstCuEncStack ) );
+      pEncLib->getRdCost( m_firstCuEncStack + jId )->setLosslessRDCost( pcSlice->isLossless() );
+      pEncLib->getTrQuant( m_firstCuEncStack + jId )->copyState( *pEncLib->getTrQuant( m_firstCuEncStack ) );
+      pEncLib->getInterSearch( m_firstCuEncStack + jId )->copyState( *pEncLib->getInterSearch( m_firstCuEncStack ) );
+      if( pCfg->getLmcs() )
+      {
+        pEncLib->getReshaper( m_firstCuEncStack + jId )->copyState( *pEncLib->getReshaper( m_firstCuEncStack ) );
+      }
+      cuEncoder->getModeCtrl()->setFastDeltaQp( m_pcCuEncoder->getModeCtrl()->getFastDeltaQp() );
+      cuEncoder->getModeCtrl()->setPltEnc( m_pcCuEncoder->getModeCtrl()->getPltEnc() );
+    }
+    if( pcSlice->getSliceType() == B_SLICE )
+    {
+      pEncLib->getInterSearch( m_firstCuEncStack + jId )->initWeightIdxBits();
+    }
+#if !JVET_V0094_BILATERAL_FILTER && !JVET_X0071_CHROMA_BILATERAL_FILTER
+    if( pcSlice->getSPS()->getUseLmcs() )
+#endif
+    {
+      cuEncoder->setDecCuReshaperInEncCU( pEncLib->getReshaper( m_firstCuEncStack + jId ), pcSlice->getSPS()->getChromaFormatIdc() );
+    }
+    cuEncoder->setWppPicLock( numThreads > 1 ? &picLock : nullptr );
+  }
+
+  auto waitForRow = [&]( const int row, const uint32_t numCtus )
+  {
+    std::unique_lock<std::mutex> lock( progressLock );
+    progressChanged.wait( lock, [&]() { return failed || rowProgress[row] >= numCtus; } );
+    return !failed;
+  };
+
+  auto compressRows = [&]( const int jId )
+  {
+    EncCu*         cuEncoder    = pEncLib->getCuEncoder( m_firstCuEncStack + jId );
+    CABACWriter*   pCABACWriter = pEncLib->getCABACEncoder( m_firstCuEncStack + jId )->getCABACEstimator( pcSlice->getSPS() );
+#if ENABLE_QPA && !ENABLE_QPA_SUB_CTU
+    TrQuant*       pTrQuant     = pEncLib->getTrQuant( m_firstCuEncStack + jId );
+    RdCost*        pRdCost      = pEncLib->getRdCost( m_firstCuEncStack + jId );
+#endif
+    InterSearch*   pInterSearch = pEncLib->getInterSearch( m_firstCuEncStack + jId );
+    CtuRowHistory& history      = cuEncoder->getRowHistory();
+
+    cuEncoder->selectReusedUniMvs();
+#if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
+    if( jId > 0 && ( ( !pcSlice->isIntra() && pcSlice->getSPS()->getFpelMmvdEnabledFlag() ) || ( pcSlice->getUseIBC() && pCfg->getIBCHashSearch() ) ) )
+#else
+    if( jId > 0 && ( ( !pcSlice->isIntra() && pcSlice->getSPS()->getFpelMmvdEnabledFlag() ) || ( pcSlice->getSPS()->getIBCFlag() && pCfg->getIBCHashSearch() ) ) )
+#endif
+    {
+#if JVET_AA0070_RRIBC
+      cuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getTrueOrigBuf(), CS::isDualITree( cs ) );
+#else
+      cuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getTrueOrigBuf() );
+#endif
+    }
+
+    for( int r = jId; r < numRows; r += numThreads )
+    {
+      const CtuRow& row = rows[r];
+      int prevQP[2];
+      int currQP[2];
+      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+      currQP[0] = currQP[1] = pcSlice->getSliceQp();
+
+      for( uint32_t k = 0; k < row.numCtus; k++ )
+      {
+        const uint32_t ctuRsAddr     = pcSlice->getCtuAddrInSlice( row.firstCtu + k );
+        const uint32_t ctuXPosInCtus = ctuRsAddr % widthInCtus;
+        const uint32_t ctuYPosInCtus = ctuRsAddr / widthInCtus;
+        const Position pos( ctuXPosInCtus * pcv.maxCUWidth, ctuYPosInCtus * pcv.maxCUHeight );
+        const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
+
+        if( r > 0 && !waitForRow( r - 1, row.waitComplete || useIbc ? rows[r - 1].numCtus : std::min( k + lag, rows[r - 1].numCtus ) ) )
+        {
+          return;
+        }
+
+        if( k == 0 )
+        {
+          pCABACWriter->getCtx() = sliceCtx;
+          pCABACWriter->start();
+          history = rowStartHistory;
+          if( r > 0 && !row.waitComplete )
+          {
+            std::lock_guard<std::mutex> lock( picLock );
+            if( cs.getCURestricted( pos.offset( 0, -1 ), pos, pcSlice->getIndependentSliceIdx(), cs.pps->getTileIdx( pos ), CH_L ) )
+            {
+              pCABACWriter->getCtx() = rowSyncCtx[r - 1];
+              history.prevPLT        = rowSyncPLT[r - 1];
+            }
+          }
+          pInterSearch->resetAffineMVList();
+          pInterSearch->resetUniMvList();
+          ::memset( g_isReusedUniMVsFilled, 0, sizeof( ReusedUniMvsFilled ) * REUSED_UNI_MVS_SIZE );
+#if INTER_LIC
+          if( pcSlice->getUseLIC() )
+          {
+            ::memset( g_isReusedUniMVsFilledLIC, 0, sizeof( ReusedUniMvsFilledLIC ) * REUSED_UNI_MVS_LIC_SIZE );
+          }
+#endif
+        }
+
+#if ENABLE_QPA && !ENABLE_QPA_SUB_CTU
+#if RDOQ_CHROMA_LAMBDA
+        double oldLambdaArray[MAX_NUM_COMPONENT] = { 0.0 };
+#endif
+        const double oldLambda = pRdCost->getLambda();
+#endif
+#if ENABLE_QPA
+        if( pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP() )
+        {
+          const int    adaptedQP = pcPic->m_iOffsetCtu[ctuRsAddr];
+          const double newLambda = pcSlice->getLambdas()[0] * pow( 2.0, double( adaptedQP - iQPIndex ) / 3.0 );
+          pcPic->m_uEnerHpCtu[ctuRsAddr] = newLambda; // for ALF and SAO
+#if !ENABLE_QPA_SUB_CTU
+#if RDOQ_CHROMA_LAMBDA
+          pTrQuant->getLambdas( oldLambdaArray ); // save the old lambdas
+          const double lambdaArray[MAX_NUM_COMPONENT] = { newLambda / pRdCost->getDistortionWeight( COMPONENT_Y ),
+                                                          newLambda / pRdCost->getDistortionWeight( COMPONENT_Cb ),
+                                                          newLambda / pRdCost->getDistortionWeight( COMPONENT_Cr ) };
+          pTrQuant->setLambdas( lambdaArray );
+#else
+          pTrQuant->setLambda( newLambda );
+#endif
+          pRdCost->setLambda( newLambda, pcSlice->getSPS()->getBitDepths() );
+#endif
+          currQP[0] = currQP[1] = adaptedQP;
+        }
+#endif
+
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+        if( ctuYPosInCtus )
+        {
+          pCABACWriter->updateCtxs( getBinVector( ctuXPosInCtus ) );
+        }
+        pCABACWriter->setBinBuffer( nullptr );
+#endif
+
+        if( pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU() )
+        {
+          cuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+        }
+
+        {
+          std::lock_guard<std::mutex> lock( picLock );
+          history.load( cs );
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+          pCABACWriter->setBinBuffer( getBinVector( ctuXPosInCtus ) );
+#endif
+#if K0149_BLOCK_STATISTICS
+          getAndStoreBlockStatistics( cs, ctuArea );
+#endif
+          pCABACWriter->resetBits();
+          pCABACWriter->coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr, true, true );
+          const int numberOfWrittenBits = int( pCABACWriter->getEstFracBits() >> SCALE_BITS );
+#if JVET_AG0117_CABAC_SPATIAL_TUNING
+          pCABACWriter->setBinBuffer( nullptr );
+#endif
+          pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
+          if( k == 0 )
+          {
+            rowSyncCtx[r] = pCABACWriter->getCtx();
+            cs.storePrevPLT( rowSyncPLT[r] );
+          }
+          history.store( cs );
+        }
+
+#if ENABLE_QPA && !ENABLE_QPA_SUB_CTU
+        if( pCfg->getUsePerceptQPA() && pcSlice->getPPS()->getUseDQP() )
+        {
+#if RDOQ_CHROMA_LAMBDA
+          pTrQuant->setLambdas( oldLambdaArray );
+#else
+          pTrQuant->setLambda( oldLambda );
+#endif
+          pRdCost->setLambda( oldLambda, pcSlice->getSPS()->getBitDepths() );
+        }
+#endif
+        {
+          std::lock_guard<std::mutex> lock( progressLock );
+          rowProgress[r] = k + 1;
+        }
+        progressChanged.notify_all();
+      }
+    }
+  };
+
+  auto runThread = [&]( const int jId )
+  {
+    try
+    {
+      compressRows( jId );
+    }
+    catch( ... )
+    {
+      std::lock_guard<std::mutex> lock( progressLock );
+      if( !failed )
+      {
+        failure = std::current_exception();
+        failed  = true;
+      }
+      progressChanged.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for( int jId = 1; jId < numThreads; jId++ )
+  {
+    threads.emplace_back( runThread, jId );
+  }
+  runThread( 0 );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+  for( int jId = 0; jId < numThreads; jId++ )
+  {
+    pEncLib->getCuEncoder( m_firstCuEncStack + jId )->setWppPicLock( nullptr );
+  }
+  if( failure )
+  {
+    std::rethrow_exception( failure );
+  }
+
+  // restore the coding order of the units and the picture level state of the last CTU
+  std::vector<int> ctuRank( pcv.sizeInCtus, 0 );
+  for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    ctuRank[pcSlice->getCtuAddrInSlice( ctuIdx )] = ctuIdx;
+  }
+  cs.sortUnitsInCtuOrder( firstCU, firstPU, firstTU, ctuRank );
+  pEncLib->getCuEncoder( m_firstCuEncStack + ( numRows - 1 ) % numThreads )->getRowHistory().load( cs );
+
+  m_uiPicTotalBits = cs.fracBits >> SCALE_BITS;
+  m_uiPicDist      = cs.dist;
+
+  if( padSubPic )
+  {
+    for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+    {
+      for( int idx = 0; idx < pcSlice->getNumRefIdx( (RefPicList)rlist ); idx++ )
+      {
+        Picture *refPic = pcSlice->getRefPic( (RefPicList)rlist, idx );
+        if( refPic->getSubPicSaved() )
+        {
+          refPic->restoreSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->setSubPicSaved( false );
+        }
+      }
+    }
+  }
+}
+
+#endif
+
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
 {
 
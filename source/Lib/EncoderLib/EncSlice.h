@@ -99,6 +99,10 @@ private:
 #if JVET_AG0117_CABAC_SPATIAL_TUNING
   std::vector<BinStoreVector> m_binVectors;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  int                     m_firstCuEncStack;                    ///< first CU encoder stack of the EncLib used by this slice encoder
+  int                     m_numCuEncStacks;                     ///< number of CU encoder stacks used by this slice encoder
+#endif
 
 public:
   double  initializeLambda(const Slice* slice, const int GOPid, const int refQP, const double dQP); // called by calculateLambda() and updateLambda()
@@ -120,7 +124,11 @@ public:
 
   void    create              ( int iWidth, int iHeight, ChromaFormat chromaFormat, uint32_t iMaxCUWidth, uint32_t iMaxCUHeight, uint8_t uhTotalDepth );
   void    destroy             ();
+#if ENABLE_FRAME_PARALLELISM
+  void    init                ( EncLib* pcEncLib, const SPS& sps, const int firstCuEncStack, const int numCuEncStacks );
+#else
   void    init                ( EncLib* pcEncLib, const SPS& sps );
+#endif
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   void    initEncSlice        ( Picture*  pcPic, const int pocLast, const int pocCurr,
@@ -154,23 +162,27 @@ public:
 #endif
 
 #if JVET_AG0098_AMVP_WITH_SBTMVP
-  std::map<int, uint32_t> m_amvpSbTmvpArea;
+  std::map<int, uint32_t>  m_ownAmvpSbTmvpArea;
+  std::map<int, uint32_t>* m_amvpSbTmvpArea = &m_ownAmvpSbTmvpArea;   ///< may be the statistics of another slice encoder
+#if ENABLE_FRAME_PARALLELISM
+  void shareAmvpSbTmvpStatArea( EncSlice& other ) { m_amvpSbTmvpArea = other.m_amvpSbTmvpArea; }
+#endif
   void clearAmvpSbTmvpStatArea(const Slice* slice)
   {
     if (slice->getPendingRasInit() || slice->isInterGDR())
     {
-      m_amvpSbTmvpArea.clear();
+      m_amvpSbTmvpArea->clear();
     }
   }
   void storeAmvpSbTmvpStatArea(const int Tlayer, const uint32_t enabledArea)
   {
-    m_amvpSbTmvpArea[Tlayer] = enabledArea;
+    (*m_amvpSbTmvpArea)[Tlayer] = enabledArea;
   }
   bool loadAmvpSbTmvpStatArea(const int Tlayer, uint32_t& enabledArea)
   {
-    if (m_amvpSbTmvpArea.find(Tlayer) != m_amvpSbTmvpArea.end())
+    if (m_amvpSbTmvpArea->find(Tlayer) != m_amvpSbTmvpArea->end())
     {
-      enabledArea = m_amvpSbTmvpArea[Tlayer];
+      enabledArea = (*m_amvpSbTmvpArea)[Tlayer];
       return true;
     }
     return false;
@@ -178,6 +190,9 @@ public:
 #endif
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+#if ENABLE_WPP_PARALLELISM
+  void    xEncodeCtuRowsWpp            ( Picture* pcPic, EncLib* pEncLib );
+#endif
 };
 
 //! \}
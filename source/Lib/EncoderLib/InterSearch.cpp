@@ -407,10 +407,11 @@ void InterSearch::setTempBuffers( CodingStructure ****pSplitCS, CodingStructure
   m_pSaveCS  = pSaveCS;
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void InterSearch::copyState( const InterSearch& other )
 {
   memcpy( m_aaiAdaptSR, other.m_aaiAdaptSR, sizeof( m_aaiAdaptSR ) );
+  m_clipMvInSubPic = other.m_clipMvInSubPic;
 }
 #endif
 
@@ -4142,7 +4143,7 @@ bool InterSearch::predIBCSearch(CodingUnit& cu, Partitioner& partitioner, const
       pu.bvdSuffixInfo.initPrefixes(pu.mvd[REF_PIC_LIST_0], pu.cu->imv, true);
 
 #if JVET_AD0208_IBC_ADAPT_FOR_CAM_CAPTURED_CONTENTS
-      static std::vector<Mv> cMvdDerivedVec;
+      static thread_local std::vector<Mv> cMvdDerivedVec;
       cMvdDerivedVec.resize(0);
 #else
       std::vector<Mv> cMvdDerivedVec;
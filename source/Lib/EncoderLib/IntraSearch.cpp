@@ -3150,8 +3150,8 @@ void IntraSearch::getPredForCCPMrgFusion(PredictionUnit& pu, PelBuf& predCb, Pel
   if (pu.ccpMergeFusionType == 0)
   {
     const int                         bitDepth = pu.cu->slice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA);
-    static CccmModel cccmModelCb[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
-    static CccmModel cccmModelCr[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
+    static thread_local CccmModel cccmModelCb[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
+    static thread_local CccmModel cccmModelCr[2] = { CccmModel(CCCM_NUM_PARAMS, bitDepth), CccmModel(CCCM_NUM_PARAMS, bitDepth) };
     pu2.cccmFlag = 1;
 #if JVET_AC0054_GLCCCM
     pu2.glCccmFlag = 0;
@@ -3161,7 +3161,7 @@ void IntraSearch::getPredForCCPMrgFusion(PredictionUnit& pu, PelBuf& predCb, Pel
 #endif
 #if MMLM
     pu2.intraDir[1] = MMLM_CHROMA_IDX;
-    static int modelThr = 0;
+    static thread_local int modelThr = 0;
 
     modelThr = xCccmCalcRefAver(pu2);
     xCccmCalcModels(pu2, cccmModelCb[0], cccmModelCr[0], 1, modelThr);
@@ -3232,6 +3232,9 @@ void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner
   const TempCtx ctxStart  ( m_ctxCache, m_CABACEstimator->getCtx() );
 
   cs.setDecomp( cs.area.Cb(), false );
+#if CCP_LUMA_REF_CACHE
+  setCcpLumaRefCache( true );
+#endif
 
   double    bestCostSoFar = maxCostAllowed;
 #if !INTRA_RM_SMALL_BLOCK_SIZE_CONSTRAINTS
@@ -6449,6 +6452,9 @@ void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner
     pu.ccpMergeFusionType = bestCcpMergeFusionType;
 #endif
   }
+#if CCP_LUMA_REF_CACHE
+  setCcpLumaRefCache( false );
+#endif
 
   //----- restore context models -----
   m_CABACEstimator->getCtx() = ctxStart;
@@ -1634,6 +1634,9 @@ void HLSWriter::codeSPS( const SPS* pcSPS )
     {
 #if JVET_AG0112_REGRESSION_BASED_GPM_BLENDING
       WRITE_FLAG(pcSPS->getUseGeoBlend() ? 1 : 0, "sps_gpm_blend_flag");
+#endif
+#if GPM_CURVE
+      WRITE_FLAG(pcSPS->getUseGeoCurve() ? 1 : 0, "sps_gpm_curve_flag");
 #endif
       CHECK(pcSPS->getMaxNumMergeCand() < pcSPS->getMaxNumGeoCand(),
             "The number of GPM candidates must not be greater than the number of merge candidates");
@@ -1723,6 +1726,16 @@ void HLSWriter::codeSPS( const SPS* pcSPS )
 #if JVET_AB0155_SGPM
   WRITE_FLAG(pcSPS->getUseSgpm() ? 1 : 0, "sps_sgpm_enabled_flag");
 #endif
+#if GPM_BLEND
+#if JVET_AB0155_SGPM
+  if (pcSPS->getUseGeo() || pcSPS->getUseSgpm())
+#else
+  if (pcSPS->getUseGeo())
+#endif
+  {
+    WRITE_FLAG(pcSPS->getUseGeoTanhBlend() ? 1 : 0, "sps_gpm_tanh_blend_flag");
+  }
+#endif
 #if JVET_AD0082_TMRL_CONFIG
   WRITE_FLAG(pcSPS->getUseTmrl() ? 1 : 0, "sps_tmrl_enabled_flag");
 #endif